@@ -2,11 +2,12 @@
 
 BLEService  mainService   = BLEService        (0x1ff7);
 BLECharacteristic GATTone = BLECharacteristic (0x01);
+BLECharacteristic GATTbulk = BLECharacteristic (0x02); // bulk download (lib/transmit/bulk_transfer.hh) and session statistics (lib/session_stats/session_stats_control.hh)
 
 
 
 
-void setupMainService(void) {
+void setupMainService(write_cb_t bulk_write) {
   
   mainService.begin();
 
@@ -14,6 +15,13 @@ void setupMainService(void) {
   GATTone.setPermission(SECMODE_OPEN, SECMODE_NO_ACCESS);
   GATTone.setFixedLen(0);
   GATTone.begin();
+
+  // Host requests and acknowledgements are written, chunks come back as notifications
+  GATTbulk.setProperties(CHR_PROPS_NOTIFY | CHR_PROPS_WRITE_WO_RESP);
+  GATTbulk.setPermission(SECMODE_OPEN, SECMODE_OPEN);
+  GATTbulk.setMaxLen(BLE_GATT_ATT_MTU_MAX - 3);
+  GATTbulk.setWriteCallback(bulk_write);
+  GATTbulk.begin();
 }
 
 
@@ -31,4 +39,17 @@ void startAdvertising(void) {
 }
 
 
+// Non-connectable advertising of one zone broadcast payload, restarted for each new one
+void startBroadcast(const uint8_t* data, uint8_t size) {
+
+  Bluefruit.Advertising.stop();
+  Bluefruit.Advertising.clearData();
+  Bluefruit.Advertising.setType(BLE_GAP_ADV_TYPE_NONCONNECTABLE_NONSCANNABLE_UNDIRECTED);
+  Bluefruit.Advertising.addFlags(BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE);
+  Bluefruit.Advertising.addData(BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA, data, size);
+  Bluefruit.Advertising.setInterval(160, 160); // 100 ms, the shortest for non-connectable legacy advertising
+  Bluefruit.Advertising.start(0);
+}
+
+
 // ----------------------------------------
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+#include "i_clock.hh"
+#include <Arduino.h> // for micros, delay
+
+class ArduinoClock : public IClock {
+public:
+    uint32_t now_us() override {
+        return micros();
+    }
+
+    // delay() blocks the loop task in FreeRTOS; with nothing else to run, the idle task puts the
+    // nRF52 into System-ON sleep (WFE) until the RTC-driven tick that ends the delay.
+    void sleep_until_us(uint32_t wake_us) override {
+        const int32_t remaining = static_cast<int32_t>(wake_us - micros());
+        if (remaining >= 1000) {
+            delay(remaining / 1000);
+        }
+    }
+};
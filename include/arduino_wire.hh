@@ -7,6 +7,7 @@ class Wire : public IWire
 public:
     ~Wire() = default; 
     void begin() override;
+    void end() override;
     void setClock(uint32_t freq) override;
     int endTransmission(bool stop)  override;
     void beginTransmission(uint8_t address) override;
@@ -18,4 +19,8 @@ public:
     int peek() override;
     void flush() override;
     void delayMicroseconds(int us) override;
+    uint32_t micros() override;
+    void drive_scl(bool high) override;
+    void drive_sda(bool high) override;
+    bool read_sda() override;
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+#include <bluefruit.h>
+#include "i_bulk_link.hh"
+
+// Bulk transfer messages as notifications of one characteristic
+class BleBulkLink : public IBulkLink {
+public:
+    explicit BleBulkLink(BLECharacteristic& characteristic) : characteristic_(characteristic) {}
+
+    // ATT MTU negotiated by the central, minus the 3-byte notification header
+    std::size_t max_message() const override {
+        BLEConnection* connection = Bluefruit.Connection(Bluefruit.connHandle());
+        return connection ? connection->getMtu() - 3 : 20;
+    }
+
+    // Waits for a free SoftDevice transmit buffer, so only call it from a low-priority task.
+    bool send(const uint8_t* data, std::size_t size) override {
+        if (!Bluefruit.connected() || !characteristic_.notifyEnabled()) {
+            return false;
+        }
+        return characteristic_.notify(data, static_cast<uint16_t>(size));
+    }
+
+private:
+    BLECharacteristic& characteristic_;
+};
@@ -1,9 +1,50 @@
 #pragma once
 #include <cstdint>
 
+constexpr uint8_t ble_protocol_version = 2;
+constexpr uint8_t frame_header_packet_id = 0xFF;
+
+// Column temperatures, one notification per 8 columns
 struct DataPack {
   uint8_t  protocol;       // version of protocol
   uint8_t  packet_id;      // 0..3 → which quarter of the data this is
-  uint8_t reserved;       // future use or alignment
-  int16_t  temps[8];       // 4 averaged temperatures (°C × 10)
+  uint8_t  sequence;       // low byte of the frame sequence, matches the FrameHeaderPack before it
+  int16_t  temps[8];       // 8 averaged temperatures (°C × 10), INT16_MIN outside the region of interest
+} __attribute__((packed));
+
+// Sent before the DataPacks of a frame (packet_id = frame_header_packet_id), same length
+struct FrameHeaderPack {
+  uint8_t  protocol;
+  uint8_t  packet_id;      // frame_header_packet_id
+  uint32_t sequence;       // frame number, gaps are dropped frames
+  uint32_t timestamp_us;   // data-ready time, device clock
+  uint32_t sent_us;        // notification time, device clock
+  int16_t  ta;             // ambient temperature (°C × 100)
+  uint16_t vdd;            // supply voltage (mV)
+  uint8_t  sub_page;
+} __attribute__((packed));
+
+constexpr uint32_t serial_frame_magic = 0x4D524654; // "TFRM" on the wire
+
+// What follows a SerialFrameHeader
+enum class SerialPayload : uint8_t {
+  Temperatures = 0,  // rows × columns floats, °C, row-major
+  Image = 1,         // rows × columns floats, compensated IR image (~To⁴ − Ta⁴, K⁴)
+  FrameWords = 2,    // the driver's raw frame words (uint16), for host computation
+  EepromWords = 3,   // the sensor EEPROM image (uint16), sent before the first FrameWords
+};
+
+// Precedes each record on the serial port
+struct SerialFrameHeader {
+  uint32_t magic;          // serial_frame_magic, to find record boundaries
+  uint32_t sequence;
+  uint32_t timestamp_us;   // data-ready time, device clock
+  uint32_t sent_us;        // time the record was written, device clock
+  float    ta;             // °C
+  float    vdd;            // V
+  uint8_t  sub_page;
+  uint8_t  rows;           // sensor geometry
+  uint8_t  columns;
+  uint8_t  payload;        // SerialPayload
+  uint16_t payload_bytes;  // bytes following this header
 } __attribute__((packed));
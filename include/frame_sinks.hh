@@ -0,0 +1,228 @@
+#pragma once
+#include <bluefruit.h>
+#include <cstring>
+#include "data_pack.hh"
+#include "deadband_policy.hh"
+#include "frame_dispatcher.hh"
+#include "session_recorder.hh"
+#include "sink_queue.hh"
+#include "zone_broadcast.hh"
+
+// A SerialFrameHeader describing the record that follows it, sent_us is set when it is written
+SerialFrameHeader makeSerialHeader(SerialPayload payload, const mlx90641::FrameHeader& header, uint8_t rows,
+                                   uint8_t columns, size_t payload_bytes);
+
+// Binary serial records and text log lines share the port, so only one task writes to it: the
+// sinks below queue their records, and FrameDispatcher::service() writes them from the same
+// task that drains the logger (see serviceOutputs() in main.cpp).
+
+// SerialFrameHeader and the pixel array, the records scripts/vizualisation/serial.py reads.
+// Holds one record: a frame published while the previous one is still being written is dropped.
+// The pixels are copied rather than referenced: a record takes longer to write (~70 ms at
+// 115200 baud) than a subpage, and the driver converts the next subpage into the same array.
+template <typename Traits>
+class SerialFrameSink : public IFrameSink {
+public:
+    SinkResult consume(const FrameView& frame) override {
+        if (queue_.free_slots() == 0) {
+            return SinkResult::Dropped;
+        }
+        const SerialPayload payload = frame.content == frame_content_image ? SerialPayload::Image
+                                                                           : SerialPayload::Temperatures;
+        Record& record = queue_.slot();
+        record.header = makeSerialHeader(payload, *frame.header, frame.rows, frame.columns, sizeof(record.pixels));
+        std::memcpy(record.pixels, frame.pixels, sizeof(record.pixels));
+        queue_.push();
+        return SinkResult::Sent;
+    }
+
+    bool service() override {
+        Record* record = queue_.front();
+        if (!record) {
+            return false;
+        }
+        record->header.sent_us = micros();
+        Serial.write((const uint8_t*)record, sizeof(*record)); // waits for the UART
+        queue_.pop();
+        return true;
+    }
+
+private:
+    struct Record {
+        SerialFrameHeader header;
+        float pixels[Traits::num_pixels];
+    } __attribute__((packed));
+
+    SinkQueue<Record, 1> queue_;
+};
+
+// Host offload: the driver's raw frame words, and every eeprom_resend_frames the EEPROM image
+// the host calibrates with (lib/host_offload), in place of SerialFrameSink's temperatures.
+// The EEPROM is read again from the sensor in consume(), ~40 ms of I2C at 400 kHz.
+template <typename Sensor>
+class HostOffloadSink : public IFrameSink {
+public:
+    // Repeated so a host attaching mid-stream can calibrate (~30 s at 32 Hz)
+    static constexpr uint32_t eeprom_resend_frames = 1024;
+
+    explicit HostOffloadSink(Sensor& sensor) : sensor_(sensor), frames_since_eeprom_(0) {}
+
+    SinkResult consume(const FrameView& frame) override {
+        if (frames_since_eeprom_ == 0 && eeprom_.free_slots() > 0) {
+            queue_eeprom(*frame.header, frame.rows, frame.columns);
+        }
+        frames_since_eeprom_ = (frames_since_eeprom_ + 1) % eeprom_resend_frames;
+        if (frames_.free_slots() == 0) {
+            return SinkResult::Dropped;
+        }
+        FrameRecord& record = frames_.slot();
+        record.header = makeSerialHeader(SerialPayload::FrameWords, *frame.header, frame.rows, frame.columns,
+                                         sizeof(record.words));
+        std::memcpy(record.words, sensor_.frame_words().data(), sizeof(record.words));
+        frames_.push();
+        return SinkResult::Sent;
+    }
+
+    bool service() override {
+        EepromRecord* eeprom = eeprom_.front(); // before any frame it calibrates
+        if (eeprom) {
+            write(eeprom);
+            eeprom_.pop();
+            return true;
+        }
+        FrameRecord* record = frames_.front();
+        if (!record) {
+            return false;
+        }
+        write(record);
+        frames_.pop();
+        return true;
+    }
+
+private:
+    struct FrameRecord {
+        SerialFrameHeader header;
+        uint16_t words[Sensor::frame_data_size];
+    } __attribute__((packed));
+
+    struct EepromRecord {
+        SerialFrameHeader header;
+        uint16_t words[Sensor::ee_data_size];
+    } __attribute__((packed));
+
+    // In 32-word reads, rather than keeping a second copy of the EEPROM in RAM
+    void queue_eeprom(const mlx90641::FrameHeader& header, uint8_t rows, uint8_t columns) {
+        constexpr size_t chunk_words = 32;
+        EepromRecord& record = eeprom_.slot();
+        record.header = makeSerialHeader(SerialPayload::EepromWords, header, rows, columns, sizeof(record.words));
+        for (size_t first = 0; first < Sensor::ee_data_size; first += chunk_words) {
+            uint16_t chunk[chunk_words];
+            const size_t count = Sensor::ee_data_size - first < chunk_words ? Sensor::ee_data_size - first
+                                                                             : chunk_words;
+            if (sensor_.read_eeprom(first, count, chunk) != 0) {
+                std::memset(chunk, 0, sizeof(chunk)); // keeps the record length, the host rejects the image
+            }
+            std::memcpy(record.words + first, chunk, count * sizeof(uint16_t));
+        }
+        eeprom_.push();
+    }
+
+    template <typename Record>
+    static void write(Record* record) {
+        record->header.sent_us = micros();
+        Serial.write((const uint8_t*)record, sizeof(*record)); // waits for the UART
+    }
+
+    Sensor& sensor_;
+    uint32_t frames_since_eeprom_;
+    SinkQueue<FrameRecord, 1> frames_;
+    SinkQueue<EepromRecord, 1> eeprom_;
+};
+
+// First pixels as text, for debugging
+class DebugPrintSink : public IFrameSink {
+public:
+    SinkResult consume(const FrameView& frame) override;
+    bool service() override;
+
+private:
+    struct Pixels {
+        float values[10];
+    };
+
+    SinkQueue<Pixels, 2> queue_;
+};
+
+// Frame header and column means as DataPack notifications, to a connected central. Packets
+// whose columns stayed within the dead-band are skipped. A frame whose packets do not all fit
+// in the queue is dropped before the dead-band policy sees it.
+class BleZoneSink : public IFrameSink {
+public:
+    BleZoneSink(BLECharacteristic& characteristic, DeadbandPolicy& policy)
+        : characteristic_(characteristic), policy_(policy), first_zone_(0), packet_count_(0) {}
+
+    // Zones [first_zone, first_zone + 8 × packet_count) are the columns
+    void set_columns(uint8_t first_zone, uint8_t column_count) {
+        first_zone_ = first_zone;
+        packet_count_ = column_count / 8;
+    }
+
+    SinkResult consume(const FrameView& frame) override;
+    bool service() override;
+
+private:
+    // One notification, a FrameHeaderPack or a DataPack
+    struct Packet {
+        uint8_t size;
+        uint8_t data[sizeof(FrameHeaderPack) > sizeof(DataPack) ? sizeof(FrameHeaderPack) : sizeof(DataPack)];
+    };
+    static constexpr size_t queue_packets = 16; // three MLX90640 frames: a header and 4 data packets each
+
+    void queue_header(Packet& packet, const mlx90641::FrameHeader& header);
+
+    BLECharacteristic& characteristic_;
+    DeadbandPolicy& policy_;
+    uint8_t first_zone_;
+    uint8_t packet_count_;
+    SinkQueue<Packet, queue_packets> queue_;
+};
+
+// Column means in rotating advertising data, for any number of scanners without a connection.
+// The advertising data is replaced from service(); frames published before it took the last
+// payload are dropped (the zones still update the broadcaster).
+class BroadcastSink : public IFrameSink {
+public:
+    typedef void (*Advertise)(const uint8_t* data, uint8_t size);
+
+    BroadcastSink(ZoneBroadcaster& broadcaster, Advertise advertise)
+        : broadcaster_(broadcaster), advertise_(advertise), first_zone_(0), zone_count_(0) {}
+
+    void set_zones(uint8_t first_zone, uint8_t zone_count) {
+        first_zone_ = first_zone;
+        zone_count_ = zone_count;
+    }
+
+    SinkResult consume(const FrameView& frame) override;
+    bool service() override;
+
+private:
+    struct Payload {
+        uint8_t data[zone_broadcast_data_bytes];
+    };
+
+    ZoneBroadcaster& broadcaster_;
+    Advertise advertise_;
+    uint8_t first_zone_;
+    uint8_t zone_count_;
+    SinkQueue<Payload, 1> queue_;
+};
+
+// Zone means to the flash session recorder while no central is connected
+class RecorderSink : public IFrameSink {
+public:
+    explicit RecorderSink(SessionRecorder& recorder) : recorder_(recorder) {}
+    SinkResult consume(const FrameView& frame) override;
+
+private:
+    SessionRecorder& recorder_;
+};
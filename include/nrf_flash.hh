@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include "i_flash.hh"
+
+#ifndef FLASH_LOG_PAGES
+#define FLASH_LOG_PAGES 12
+#endif
+#ifndef FLASH_LOG_ADDRESS
+// Start of the session recording region: the FLASH_LOG_PAGES pages right below InternalFS
+// (0x6D000 on the nRF52832 Feather), 0x61000 by default. The linker still lets the application
+// grow into it: scripts/memory/flash_check.py fails the build when it does.
+#define FLASH_LOG_ADDRESS (0x6D000 - FLASH_LOG_PAGES * 4096)
+#endif
+
+/// @brief Internal flash region written through the SoftDevice flash API.
+///
+/// The SoftDevice schedules flash operations between radio events and reports their end as a
+/// SoC event the Bluefruit library consumes, so completion is detected by reading the region
+/// back. The nRF52832 halts the CPU while the NVMC erases a page (~85 ms): only call this from
+/// a low-priority task.
+class NrfFlash : public IFlash {
+public:
+    static constexpr uint32_t flash_page_size = 4096;
+
+    uint32_t page_size() const override { return flash_page_size; }
+    uint32_t page_count() const override { return FLASH_LOG_PAGES; }
+    bool erase_page(uint32_t page) override;
+    bool write(uint32_t offset, const void* data, std::size_t size) override;
+    bool read(uint32_t offset, void* data, std::size_t size) override;
+
+private:
+    bool write_words(uint32_t offset, const uint32_t* words, uint32_t count);
+};
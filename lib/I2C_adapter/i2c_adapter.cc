@@ -2,88 +2,298 @@
 
 int I2CAdapter::init(int freq) {
     wire_.begin();
-    wire_.setClock(1000 * freq); // freq in kHz
+    set_frequency(freq);
     wire_.delayMicroseconds(1000); // wait for 5 ms
     return 0;
 }
 
 void I2CAdapter::set_frequency(int freq) {
+    frequency_khz_ = freq;
+    speed_index_ = num_speeds - 1;
+    for (std::size_t i = 0; i < num_speeds; i++) {
+        if (speed_khz(i) <= freq) {
+            speed_index_ = i;
+            break;
+        }
+    }
+    window_transactions_ = 0;
+    window_errors_ = 0;
     wire_.setClock(1000 * freq); // freq in kHz
-} 
+}
+
+I2CStatus I2CAdapter::tune_speed(uint8_t device_address, uint16_t start_register, const uint16_t* expected,
+                                 int max_khz) {
+    I2CStatus status = I2CStatus::Success;
+    for (std::size_t speed = 0; speed < num_speeds; speed++) {
+        if (speed_khz(speed) > max_khz) {
+            continue;
+        }
+        set_frequency(speed_khz(speed));
+        status = I2CStatus::Success;
+        for (uint8_t read = 0; read < speed_validation_reads && status == I2CStatus::Success; read++) {
+            uint16_t words[speed_validation_words];
+            status = read_chunk(device_address, start_register, 2 * speed_validation_words, words);
+            for (std::size_t i = 0; status == I2CStatus::Success && i < speed_validation_words; i++) {
+                if (words[i] != expected[i]) {
+                    status = I2CStatus::VerifyMismatch;
+                }
+            }
+            if (status != I2CStatus::Success) {
+                speed_stats_[speed].errors++;
+            }
+        }
+        if (status == I2CStatus::Success) {
+            return finish(status);
+        }
+    }
+    return finish(status);
+}
+
+void I2CAdapter::begin_frame() {
+    frame_deadline_us_ = wire_.micros() + frame_budget_us();
+    frame_active_ = true;
+}
 
-int I2CAdapter::read(uint8_t device_address,
+I2CStatus I2CAdapter::read(uint8_t device_address,
                       uint16_t start_register,
                       std::size_t length,
                       uint16_t* buffer) {
-    char cmd[2] = {0,0};
-    uint16_t *p; 
+    uint16_t *p;
     p = buffer;
-    
+
     int total_bytes = 2*length;
     const int div = 32;
     int factor = (int)(total_bytes)/div;
     int remainder = (total_bytes)%div;
     if(remainder!=0) factor++;
-    
+
     for(int j = 0 ; j < factor ; j++){
         uint16_t address = start_register+(j*div)/2;
-        cmd[0] = address >> 8;
-        cmd[1] = address & 0x00FF;
-
-        wire_.endTransmission();
-        wire_.delayMicroseconds(5);
-        wire_.beginTransmission(device_address);
-        
-        int written1 = wire_.write(cmd[0]);
-        int written2 = wire_.write(cmd[1]);
-        
-        int end = wire_.endTransmission(0);
-        if(end == 2 || end == 3) return -1;
-        if(end == 1 || end == 4) return -2;
-            
         int num_bytes = div;
         if(j == (factor-1) && remainder!=0) num_bytes = remainder;
-            
-        num_bytes = wire_.requestFrom((int)device_address,num_bytes);
-        if(!num_bytes) return -1;
-        
-        for(int i = 0 ; i < num_bytes/2 ; i++){
-            if(wire_.available()){		
-                 uint16_t high = wire_.read()<<8;
-                 uint16_t low = wire_.read();
-                 *p++ = high + low;
+
+        I2CStatus status = I2CStatus::Success;
+        for (uint8_t attempt = 0;; attempt++) {
+            status = read_chunk(device_address, address, num_bytes, p);
+            if (status == I2CStatus::Success) {
+                break;
+            }
+            const I2CStatus recovery = recover(status, attempt);
+            if (recovery != I2CStatus::Success) {
+                return finish(recovery);
             }
         }
+        p += num_bytes/2;
     }
-    return 0;
+    return finish(I2CStatus::Success);
 }
 
-int I2CAdapter::write(uint8_t device_address,
+I2CStatus I2CAdapter::write(uint8_t device_address,
                        uint16_t reg,
                        uint16_t value) {
+    for (uint8_t attempt = 0;; attempt++) {
+        const I2CStatus status = write_once(device_address, reg, value);
+        if (status == I2CStatus::Success) {
+            return finish(status);
+        }
+        const I2CStatus recovery = recover(status, attempt);
+        if (recovery != I2CStatus::Success) {
+            return finish(recovery);
+        }
+    }
+}
+
+I2CStatus I2CAdapter::clear_bus() {
+    const int half_period_us = 5; // 100 kHz
+    stats_.bus_clears++;
+    wire_.end();
+    wire_.drive_sda(true);
+    for (uint8_t pulse = 0; pulse < bus_clear_pulses && !wire_.read_sda(); pulse++) {
+        wire_.drive_scl(false);
+        wire_.delayMicroseconds(half_period_us);
+        wire_.drive_scl(true);
+        wire_.delayMicroseconds(half_period_us);
+    }
+    // STOP: SDA rises while SCL is high
+    wire_.drive_scl(false);
+    wire_.drive_sda(false);
+    wire_.delayMicroseconds(half_period_us);
+    wire_.drive_scl(true);
+    wire_.delayMicroseconds(half_period_us);
+    wire_.drive_sda(true);
+    wire_.delayMicroseconds(half_period_us);
+    const bool released = wire_.read_sda();
+
+    wire_.begin();
+    wire_.setClock(1000 * frequency_khz_);
+    return released ? I2CStatus::Success : I2CStatus::BusStuck;
+}
+
+I2CStatus I2CAdapter::read_chunk(uint8_t device_address, uint16_t address, int num_bytes, uint16_t* buffer) {
+    char cmd[2] = {0,0};
+    I2CStatus status = check_bus();
+    if (status != I2CStatus::Success) {
+        return status;
+    }
+
+    cmd[0] = address >> 8;
+    cmd[1] = address & 0x00FF;
+
+    const uint32_t start_us = wire_.micros();
+    wire_.endTransmission();
+    wire_.delayMicroseconds(5);
+    wire_.beginTransmission(device_address);
+
+    wire_.write(cmd[0]);
+    wire_.write(cmd[1]);
+
+    const int end = wire_.endTransmission(0);
+    int received = 0;
+    if (end == 0) {
+        received = wire_.requestFrom(device_address, num_bytes);
+    }
+    status = end_transaction(end, start_us);
+    if (status != I2CStatus::Success) {
+        return status;
+    }
+    if (received < num_bytes) {
+        return I2CStatus::ShortRead;
+    }
+
+    for (int i = 0; i < num_bytes/2; i++) {
+        if (wire_.available()) {
+             uint16_t high = wire_.read()<<8;
+             uint16_t low = wire_.read();
+             buffer[i] = high + low;
+        }
+    }
+    return I2CStatus::Success;
+}
+
+I2CStatus I2CAdapter::write_once(uint8_t device_address, uint16_t reg, uint16_t value) {
     char cmd[4] = {0,0,0,0};
-    static uint16_t dataCheck;
+    uint16_t dataCheck; // per call: several sensors share the adapter
+
+    I2CStatus status = check_bus();
+    if (status != I2CStatus::Success) {
+        return status;
+    }
 
     cmd[0] = reg >> 8;
     cmd[1] = reg & 0x00FF;
     cmd[2] = value >> 8;
     cmd[3] = value & 0x00FF;
-    
+
+    const uint32_t start_us = wire_.micros();
     wire_.endTransmission();
     wire_.beginTransmission(device_address);
-    
+
     wire_.delayMicroseconds(5);
 
     wire_.write(cmd,4);
-    
-    wire_.endTransmission(); 
-    
-    if(read(device_address, reg, 1, &dataCheck) != 0) return -1;
-    
+
+    status = end_transaction(wire_.endTransmission(), start_us);
+    if (status != I2CStatus::Success) {
+        return status;
+    }
+
+    status = read_chunk(device_address, reg, 2, &dataCheck);
+    if (status != I2CStatus::Success) {
+        return status;
+    }
+
     if ( dataCheck != value)
     {
-        return -2;
-    }    
-    
-    return 0;
-}
\ No newline at end of file
+        return I2CStatus::VerifyMismatch;
+    }
+
+    return I2CStatus::Success;
+}
+
+// A device interrupted mid-byte (reset, brown-out) keeps SDA low, and starting a
+// transaction then never completes.
+I2CStatus I2CAdapter::check_bus() {
+    if (wire_.read_sda()) {
+        return I2CStatus::Success;
+    }
+    return clear_bus();
+}
+
+// `end` is the Wire endTransmission() result: 1 data too long, 2 address NACK, 3 data NACK,
+// 4 other error, 5 timeout.
+I2CStatus I2CAdapter::end_transaction(int end, uint32_t start_us) {
+    stats_.transactions++;
+    speed_stats_[speed_index_].transactions++;
+    if (++window_transactions_ >= recovery_.speed_window) {
+        window_transactions_ = 0;
+        window_errors_ = 0;
+    }
+    const uint32_t elapsed_us = wire_.micros() - start_us;
+    if (elapsed_us > stats_.max_transaction_us) {
+        stats_.max_transaction_us = elapsed_us;
+    }
+
+    if (end == 5 || elapsed_us > recovery_.transaction_timeout_us) {
+        stats_.timeouts++;
+        return I2CStatus::Timeout;
+    }
+    if (end == 2) {
+        stats_.nacks++;
+        return I2CStatus::AddressNack;
+    }
+    if (end == 3) {
+        stats_.nacks++;
+        return I2CStatus::DataNack;
+    }
+    if (end != 0) {
+        return I2CStatus::BusError;
+    }
+    return I2CStatus::Success;
+}
+
+// Success if the failed transaction should be attempted again, the status to report otherwise.
+I2CStatus I2CAdapter::recover(I2CStatus failure, uint8_t attempt) {
+    // A readback mismatch is not a bus fault (self-clearing bits), and a stuck bus was
+    // already cleared once.
+    if (failure == I2CStatus::VerifyMismatch || failure == I2CStatus::BusStuck) {
+        return failure;
+    }
+    // An absent or busy device NACKs its address at any speed.
+    if (failure != I2CStatus::AddressNack) {
+        count_error();
+    }
+    if (attempt >= recovery_.max_retries) {
+        return failure;
+    }
+    if (frame_active_ && static_cast<int32_t>(wire_.micros() - frame_deadline_us_) >= 0) {
+        stats_.budget_exceeded++;
+        return I2CStatus::BudgetExceeded;
+    }
+    if (failure == I2CStatus::Timeout || failure == I2CStatus::BusError) {
+        const I2CStatus cleared = clear_bus();
+        if (cleared != I2CStatus::Success) {
+            return cleared;
+        }
+    }
+    stats_.retries++;
+    return I2CStatus::Success;
+}
+
+I2CStatus I2CAdapter::finish(I2CStatus status) {
+    last_status_ = status;
+    return status;
+}
+
+// Errors at the current speed; too many in one window move to the next slower speed.
+void I2CAdapter::count_error() {
+    speed_stats_[speed_index_].errors++;
+    window_errors_++;
+    if (recovery_.speed_error_limit == 0 || window_errors_ < recovery_.speed_error_limit) {
+        return;
+    }
+    if (speed_index_ + 1 < num_speeds) {
+        stats_.speed_downgrades++;
+        set_frequency(speed_khz(speed_index_ + 1));
+    }
+    window_errors_ = 0;
+}
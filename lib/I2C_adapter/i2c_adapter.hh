@@ -1,26 +1,93 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <vector>
 #include "i_wire.hh"
 
+#ifndef I2C_MAX_SPEED_KHZ
+// Fastest clock tune_speed() tries. The nRF52832 TWIM stops at 400 kHz; define 1000 for
+// Fast-mode Plus on a controller that supports it.
+#define I2C_MAX_SPEED_KHZ 400
+#endif
+
+/// @brief Result of an I2C transfer, 0 is success.
+enum class I2CStatus {
+    Success = 0,
+    AddressNack,     // no device acknowledged the address
+    DataNack,        // the device did not acknowledge a data byte
+    Timeout,         // the peripheral timed out, or the transaction took longer than the transaction timeout
+    BusError,        // other peripheral error (arbitration lost, ...)
+    ShortRead,       // the device returned fewer bytes than requested
+    VerifyMismatch,  // the written register reads back a different value
+    BusStuck,        // SDA still held low after a bus clear
+    BudgetExceeded,  // the frame latency budget ran out before the transfer succeeded
+};
+
+/// @brief Retry limits of I2CAdapter.
+struct I2CRecoveryConfig {
+    uint8_t max_retries;              // per transaction, after the first attempt
+    uint32_t transaction_timeout_us;  // completed transactions that took longer count as Timeout
+    uint32_t frame_budget_us;         // no more retries once a frame read took this long, at 400 kHz
+    uint8_t speed_error_limit;        // step the clock down after this many errors in a window, 0: never
+    uint16_t speed_window;            // transactions per error-rate window
+};
+
+/// @brief Error counters of I2CAdapter, for diagnostics.
+struct I2CStats {
+    uint32_t transactions;
+    uint32_t retries;
+    uint32_t nacks;
+    uint32_t timeouts;
+    uint32_t bus_clears;
+    uint32_t budget_exceeded;
+    uint32_t max_transaction_us;
+    uint32_t speed_downgrades;
+};
+
+/// @brief Traffic at one bus speed, see I2CAdapter::speed_stats().
+struct I2CSpeedStats {
+    uint32_t transactions;
+    uint32_t errors;
+};
+
 /// @brief Abstract interface for I2C communication
-/// 
+///
 /// @note Uses an IWire instance for low-level operations
 /// @note This provides the ability to interface with the Arduino Wire library or a mock of it for testing
+///
+/// Failed transactions are retried on their own (one 32-byte chunk, not the whole transfer),
+/// after a bus clear if the failure suggests a device is holding the bus. SDA is checked
+/// before each transaction so a stuck bus is cleared instead of started on. When errors pile
+/// up at one speed, the clock steps down to the next slower one.
+///
+/// The transaction timeout classifies a transaction once Wire returns, it cannot interrupt
+/// one: the SDA check before each transaction is what keeps a held bus from hanging it.
 class I2CAdapter {
 public:
-    I2CAdapter(IWire& wire) : wire_(wire) {}
+    static constexpr uint8_t bus_clear_pulses = 9;
+    static I2CRecoveryConfig default_recovery() { return {2, 5000, 20000, 4, 256}; }
+
+    /// Speeds tune_speed() and the automatic step-down choose from, fastest first.
+    static constexpr std::size_t num_speeds = 3;
+    static int speed_khz(std::size_t index) { return index == 0 ? 1000 : index == 1 ? 400 : 100; }
+    /// Known words compared by tune_speed(), one transaction.
+    static constexpr std::size_t speed_validation_words = 16;
+    static constexpr uint8_t speed_validation_reads = 8;
+
+    I2CAdapter(IWire& wire, const I2CRecoveryConfig& recovery = default_recovery())
+        : wire_(wire), recovery_(recovery), stats_(), speed_stats_(), last_status_(I2CStatus::Success),
+          frequency_khz_(100), speed_index_(num_speeds - 1), window_transactions_(0), window_errors_(0),
+          frame_deadline_us_(0), frame_active_(false) {}
      ~I2CAdapter() = default;
 
     // Read `length` 16-bit words starting from `start_register`
-     int read(uint8_t device_address,
+     I2CStatus read(uint8_t device_address,
                       uint16_t start_register,
                       std::size_t length,
                       uint16_t* buffer);
 
-    // Write a 16-bit word to a register
-     int write(uint8_t device_address,
+    // Write a 16-bit word to a register and read it back
+     I2CStatus write(uint8_t device_address,
                        uint16_t reg,
                        uint16_t value);
 
@@ -30,6 +97,64 @@ public:
     // Set I2C bus frequency in kHz
      void set_frequency(int freq);
 
+    /// @brief Selects the fastest speed up to `max_khz` at which `expected`, words already read
+    /// at a safe speed, reads back identically speed_validation_reads times.
+    /// @param expected speed_validation_words words found at `start_register`.
+    /// @return Success with the speed set, or the last failure with the slowest speed set.
+    I2CStatus tune_speed(uint8_t device_address, uint16_t start_register, const uint16_t* expected,
+                         int max_khz = I2C_MAX_SPEED_KHZ);
+
+    /// @brief Current bus clock in kHz, after any automatic step-down.
+    int frequency_khz() const { return frequency_khz_; }
+    const I2CSpeedStats& speed_stats(std::size_t index) const { return speed_stats_[index]; }
+
+    /// @brief Standard bus clear (UM10204 3.1.16): up to 9 SCL pulses until the device
+    /// releases SDA, a STOP, then the peripheral is restarted at the current frequency.
+    /// @return Success, or BusStuck if SDA is still low.
+    I2CStatus clear_bus();
+
+    /// @brief Starts the latency budget of a frame read: retries stop once it is spent.
+    void begin_frame();
+    /// @brief The frame budget at the current clock: a frame read takes 4 times as long at 100 kHz.
+    uint32_t frame_budget_us() const
+    {
+        if (frequency_khz_ >= 400 || frequency_khz_ <= 0) {
+            return recovery_.frame_budget_us;
+        }
+        return static_cast<uint32_t>(uint64_t(recovery_.frame_budget_us) * 400 / frequency_khz_);
+    }
+    void end_frame() { frame_active_ = false; }
+
+    I2CStatus last_status() const { return last_status_; }
+    const I2CStats& stats() const { return stats_; }
+    void reset_stats()
+    {
+        stats_ = I2CStats();
+        speed_stats_.fill(I2CSpeedStats());
+    }
+    const I2CRecoveryConfig& recovery() const { return recovery_; }
+    void set_recovery(const I2CRecoveryConfig& recovery) { recovery_ = recovery; }
+
 protected:
     IWire& wire_;
+
+private:
+    I2CStatus read_chunk(uint8_t device_address, uint16_t address, int num_bytes, uint16_t* buffer);
+    I2CStatus write_once(uint8_t device_address, uint16_t reg, uint16_t value);
+    I2CStatus check_bus();
+    I2CStatus end_transaction(int end, uint32_t start_us);
+    I2CStatus recover(I2CStatus failure, uint8_t attempt);
+    I2CStatus finish(I2CStatus status);
+    void count_error();
+
+    I2CRecoveryConfig recovery_;
+    I2CStats stats_;
+    std::array<I2CSpeedStats, num_speeds> speed_stats_;
+    I2CStatus last_status_;
+    int frequency_khz_;
+    std::size_t speed_index_;        // ladder entry the current frequency is counted under
+    uint16_t window_transactions_;
+    uint8_t window_errors_;
+    uint32_t frame_deadline_us_;
+    bool frame_active_;
 };
@@ -6,8 +6,9 @@
 
 class IWire {
 public:
-    virtual ~IWire() = default; 
+    virtual ~IWire() = default;
     virtual void begin() = 0;
+    virtual void end() = 0;
     virtual void setClock(uint32_t freq) = 0;
     virtual int endTransmission(bool stop = true) = 0;
     virtual void beginTransmission(uint8_t address) = 0;
@@ -19,4 +20,12 @@ public:
     virtual int peek() = 0;
     virtual void flush() = 0;
     virtual void delayMicroseconds(int us) = 0;
-};
\ No newline at end of file
+    virtual uint32_t micros() = 0;
+
+    // Direct line access for the bus clear, only used between end() and begin().
+    // Lines are open drain: true releases the line (pulled high), false drives it low.
+    virtual void drive_scl(bool high) = 0;
+    virtual void drive_sda(bool high) = 0;
+    // Level of SDA, readable while the I2C peripheral owns the pin
+    virtual bool read_sda() = 0;
+};
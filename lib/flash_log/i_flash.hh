@@ -0,0 +1,22 @@
+// Abstract class to represent a region of internal flash
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @brief A region of NOR flash: erased bytes read 0xFF and writes can only clear bits, so a
+/// word is written once between erases of its page.
+///
+/// Calls may block while the flash operation runs; callers keep them off the acquisition path.
+class IFlash {
+public:
+    virtual ~IFlash() = default;
+    virtual uint32_t page_size() const = 0;
+    virtual uint32_t page_count() const = 0;
+    /// @brief Erases page `page` (0 to page_count() - 1) of the region.
+    virtual bool erase_page(uint32_t page) = 0;
+    /// @brief Programs `size` bytes at `offset` from the start of the region. Offset and size
+    /// are multiples of 4 and the range is erased.
+    virtual bool write(uint32_t offset, const void* data, std::size_t size) = 0;
+    virtual bool read(uint32_t offset, void* data, std::size_t size) = 0;
+};
@@ -0,0 +1,398 @@
+#include "session_recorder.hh"
+#include <cmath>
+#include <cstring>
+
+// Record: a length byte, then `length` bytes: a flags byte (bit 0: full record) and varints.
+//   full:  sequence, timestamp_us, zigzag ta, zone count (byte), zigzag zones
+//   delta: sequence step, timestamp step (mod 2^32), zigzag ta step, zigzag zone steps
+// Length 0 pads a batch to the flash word size; 0xFF is erased flash, the end of the page.
+
+namespace {
+
+constexpr uint8_t flag_full = 0x01;
+constexpr uint8_t padding = 0x00;
+constexpr uint8_t erased = 0xFF;
+
+struct PageHeader {
+    uint32_t magic;
+    uint32_t sequence;
+};
+
+std::size_t put_varint(uint32_t value, uint8_t* out)
+{
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+uint32_t zigzag(int32_t value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value)
+{
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+bool get_varint(const uint8_t* data, std::size_t size, std::size_t& pos, uint32_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35 && pos < size; shift += 7) {
+        const uint8_t byte = data[pos++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool read_header(IFlash& flash, uint32_t page, PageHeader& header)
+{
+    return flash.read(page * flash.page_size(), &header, sizeof(header)) && header.magic == SessionRecorder::page_magic &&
+           header.sequence != 0xFFFFFFFF;
+}
+
+// Pages with a valid header; `oldest` and `newest` by page sequence.
+uint32_t scan_pages(IFlash& flash, uint32_t& oldest, uint32_t& newest, uint32_t& newest_sequence)
+{
+    uint32_t used = 0;
+    uint32_t oldest_sequence = 0;
+    for (uint32_t page = 0; page < flash.page_count(); page++) {
+        PageHeader header;
+        if (!read_header(flash, page, header)) {
+            continue;
+        }
+        if (used == 0 || header.sequence < oldest_sequence) {
+            oldest = page;
+            oldest_sequence = header.sequence;
+        }
+        if (used == 0 || header.sequence > newest_sequence) {
+            newest = page;
+            newest_sequence = header.sequence;
+        }
+        used++;
+    }
+    return used;
+}
+
+// Decodes one record body into `frame`, using `previous` as the delta base.
+bool decode(const uint8_t* body, std::size_t size, bool have_previous, const RecordedFrame& previous,
+            RecordedFrame& frame)
+{
+    std::size_t pos = 1;
+    uint32_t values[3];
+    for (uint32_t& value : values) {
+        if (!get_varint(body, size, pos, value)) {
+            return false;
+        }
+    }
+    if (body[0] & flag_full) {
+        if (pos >= size || body[pos] > RecordedFrame::max_zones) {
+            return false;
+        }
+        frame.sequence = values[0];
+        frame.timestamp_us = values[1];
+        frame.ta = static_cast<int16_t>(unzigzag(values[2]));
+        frame.zone_count = body[pos++];
+    } else {
+        if (!have_previous) {
+            return false;
+        }
+        frame.sequence = previous.sequence + values[0];
+        frame.timestamp_us = previous.timestamp_us + values[1];
+        frame.ta = static_cast<int16_t>(previous.ta + unzigzag(values[2]));
+        frame.zone_count = previous.zone_count;
+    }
+    for (uint8_t zone = 0; zone < frame.zone_count; zone++) {
+        uint32_t value;
+        if (!get_varint(body, size, pos, value)) {
+            return false;
+        }
+        const int32_t base = (body[0] & flag_full) ? 0 : previous.zones[zone];
+        frame.zones[zone] = static_cast<int16_t>(base + unzigzag(value));
+    }
+    return pos == size;
+}
+
+// Reads the record at `offset` of a page: length byte first, then the body into `body`.
+// @return the record length, padding (0) or erased (0xFF) at the end of the page.
+uint8_t read_record(IFlash& flash, uint32_t page, uint32_t offset, uint8_t* body)
+{
+    if (offset >= flash.page_size()) {
+        return erased;
+    }
+    uint8_t length;
+    if (!flash.read(page * flash.page_size() + offset, &length, 1)) {
+        return erased;
+    }
+    if (length == padding || length == erased) {
+        return length;
+    }
+    if (offset + 1 + length > flash.page_size() || !flash.read(page * flash.page_size() + offset + 1, body, length)) {
+        return erased;
+    }
+    return length;
+}
+
+} // namespace
+
+SessionRecorder::SessionRecorder(IFlash& flash, IClock* clock)
+    : flash_(flash), clock_(clock), queue_(), enqueue_pos_(0), dequeue_pos_(0), flush_requested_(false),
+      mounted_(false), page_open_(false), page_(0), page_sequence_(0), used_pages_(0), batch_offset_(0),
+      batch_size_(0), batch_(), have_previous_(false), previous_(), stats_(), dropped_(0), remaining_bytes_(0)
+{
+}
+
+RecorderStatus SessionRecorder::mount()
+{
+    uint32_t oldest = 0;
+    uint32_t newest = 0;
+    uint32_t newest_sequence = 0;
+    used_pages_ = scan_pages(flash_, oldest, newest, newest_sequence);
+    page_open_ = false;
+    have_previous_ = false;
+    batch_size_ = 0;
+    if (used_pages_ == 0) {
+        page_ = flash_.page_count() - 1; // the first page opened is page 0
+        page_sequence_ = 0;
+    } else {
+        // Continue after the last whole record of the newest page; new records start with a full one.
+        page_ = newest;
+        page_sequence_ = newest_sequence;
+        uint32_t offset = page_header_bytes;
+        uint8_t body[256];
+        uint8_t length;
+        while ((length = read_record(flash_, page_, offset, body)) != erased) {
+            offset += length == padding ? 1 : 1 + length;
+        }
+        offset = (offset + 3) & ~3u;
+        // Stopped on a damaged record rather than erased flash: leave the rest of the page alone.
+        uint32_t word = 0;
+        page_open_ = offset < flash_.page_size() && flash_.read(page_ * flash_.page_size() + offset, &word, 4) &&
+                     word == 0xFFFFFFFF;
+        batch_offset_ = page_ * flash_.page_size() + offset;
+    }
+    mounted_ = true;
+    update_remaining();
+    return RecorderStatus::Success;
+}
+
+bool SessionRecorder::record(uint32_t sequence, uint32_t timestamp_us, float ta, const int16_t* zones,
+                             std::size_t zone_count)
+{
+    const uint32_t position = enqueue_pos_.load(std::memory_order_relaxed);
+    if (position - dequeue_pos_.load(std::memory_order_acquire) >= queue_capacity) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Slot& slot = queue_[position % queue_capacity];
+    slot.sequence = sequence;
+    slot.timestamp_us = timestamp_us;
+    slot.ta = std::isfinite(ta) ? static_cast<int16_t>(lroundf(ta * 100.0f)) : 0;
+    slot.zone_count = static_cast<uint8_t>(zone_count < RecordedFrame::max_zones ? zone_count : RecordedFrame::max_zones);
+    std::memcpy(slot.zones.data(), zones, slot.zone_count * sizeof(int16_t));
+    enqueue_pos_.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool SessionRecorder::service()
+{
+    if (!mounted_) {
+        return false;
+    }
+    bool worked = false;
+    uint32_t position = dequeue_pos_.load(std::memory_order_relaxed);
+    while (position != enqueue_pos_.load(std::memory_order_acquire)) {
+        append(queue_[position % queue_capacity]);
+        dequeue_pos_.store(++position, std::memory_order_release);
+        worked = true;
+    }
+    if (flush_requested_.exchange(false, std::memory_order_acq_rel) && batch_size_ > 0) {
+        write_batch();
+        worked = true;
+    }
+    return worked;
+}
+
+RecorderStats SessionRecorder::stats() const
+{
+    RecorderStats stats = stats_;
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SessionRecorder::append(const Slot& slot)
+{
+    uint8_t record[max_record_bytes];
+    bool key = !have_previous_ || slot.zone_count != previous_.zone_count;
+    std::size_t size = encode(slot, key, record);
+    const uint32_t page_end = (page_ + 1) * flash_.page_size();
+    // Rounded up for the padding a batch write may add.
+    if (!page_open_ || ((batch_offset_ + batch_size_ + 3) & ~3u) + size > page_end) {
+        if (batch_size_ > 0 && !write_batch()) {
+            return;
+        }
+        if (!open_next_page()) {
+            return;
+        }
+        if (!key) {
+            key = true;
+            size = encode(slot, key, record);
+        }
+    }
+    if (batch_size_ + size > batch_bytes && !write_batch()) {
+        return;
+    }
+    std::memcpy(batch_.data() + batch_size_, record, size);
+    batch_size_ += size;
+    previous_ = slot;
+    have_previous_ = true;
+    stats_.records++;
+    if (batch_size_ == batch_bytes) {
+        write_batch();
+    }
+    update_remaining();
+}
+
+std::size_t SessionRecorder::encode(const Slot& slot, bool key, uint8_t* out) const
+{
+    std::size_t size = 1; // length, set below
+    out[size++] = key ? flag_full : 0;
+    if (key) {
+        size += put_varint(slot.sequence, out + size);
+        size += put_varint(slot.timestamp_us, out + size);
+        size += put_varint(zigzag(slot.ta), out + size);
+        out[size++] = slot.zone_count;
+    } else {
+        size += put_varint(slot.sequence - previous_.sequence, out + size);
+        size += put_varint(slot.timestamp_us - previous_.timestamp_us, out + size);
+        size += put_varint(zigzag(slot.ta - previous_.ta), out + size);
+    }
+    for (uint8_t zone = 0; zone < slot.zone_count; zone++) {
+        const int32_t base = key ? 0 : previous_.zones[zone];
+        size += put_varint(zigzag(slot.zones[zone] - base), out + size);
+    }
+    out[0] = static_cast<uint8_t>(size - 1);
+    return size;
+}
+
+bool SessionRecorder::open_next_page()
+{
+    const uint32_t next = (page_ + 1) % flash_.page_count();
+    PageHeader header;
+    const bool holds_records = read_header(flash_, next, header);
+    const uint32_t start_us = clock_ ? clock_->now_us() : 0;
+    if (!flash_.erase_page(next)) {
+        flash_error();
+        return false;
+    }
+    stats_.pages_erased++;
+    if (holds_records) {
+        stats_.pages_overwritten++;
+    } else {
+        used_pages_++;
+    }
+    page_ = next;
+    page_sequence_++;
+    header.magic = page_magic;
+    header.sequence = page_sequence_;
+    const bool written = flash_.write(page_ * flash_.page_size(), &header, sizeof(header));
+    if (clock_) {
+        stats_.busy_us += clock_->now_us() - start_us;
+    }
+    if (!written) {
+        flash_error();
+        return false;
+    }
+    page_open_ = true;
+    have_previous_ = false;
+    batch_offset_ = page_ * flash_.page_size() + page_header_bytes;
+    return true;
+}
+
+bool SessionRecorder::write_batch()
+{
+    while (batch_size_ % 4 != 0) {
+        batch_[batch_size_++] = padding;
+    }
+    const uint32_t start_us = clock_ ? clock_->now_us() : 0;
+    const bool written = flash_.write(batch_offset_, batch_.data(), batch_size_);
+    if (clock_) {
+        stats_.busy_us += clock_->now_us() - start_us;
+    }
+    if (!written) {
+        flash_error();
+        return false;
+    }
+    stats_.bytes_written += static_cast<uint32_t>(batch_size_);
+    batch_offset_ += static_cast<uint32_t>(batch_size_);
+    batch_size_ = 0;
+    update_remaining();
+    return true;
+}
+
+// The batch is lost and the page abandoned: the next record opens a new page.
+void SessionRecorder::flash_error()
+{
+    stats_.flash_errors++;
+    batch_size_ = 0;
+    page_open_ = false;
+    have_previous_ = false;
+}
+
+void SessionRecorder::update_remaining()
+{
+    const uint32_t usable = flash_.page_size() - page_header_bytes;
+    const uint32_t free_pages = flash_.page_count() - used_pages_;
+    uint32_t in_page = 0;
+    if (page_open_) {
+        in_page = (page_ + 1) * flash_.page_size() - batch_offset_ - static_cast<uint32_t>(batch_size_);
+    }
+    remaining_bytes_.store(in_page + free_pages * usable, std::memory_order_relaxed);
+}
+
+RecordingReader::RecordingReader(IFlash& flash)
+    : flash_(flash), first_page_(0), pages_left_(0), page_(0), offset_(0), have_previous_(false), previous_()
+{
+    uint32_t newest = 0;
+    uint32_t newest_sequence = 0;
+    const uint32_t used = scan_pages(flash_, first_page_, newest, newest_sequence);
+    // Pages are used in ring order, from the oldest to the newest.
+    pages_left_ = used == 0 ? 0 : (newest + flash_.page_count() - first_page_) % flash_.page_count() + 1;
+    page_ = first_page_;
+    offset_ = SessionRecorder::page_header_bytes;
+}
+
+bool RecordingReader::next(RecordedFrame& frame)
+{
+    uint8_t body[256];
+    while (pages_left_ > 0) {
+        PageHeader header;
+        const uint8_t length = read_header(flash_, page_, header) ? read_record(flash_, page_, offset_, body) : erased;
+        if (length == erased) {
+            page_ = (page_ + 1) % flash_.page_count();
+            pages_left_--;
+            offset_ = SessionRecorder::page_header_bytes;
+            have_previous_ = false;
+            continue;
+        }
+        if (length == padding) {
+            offset_++;
+            continue;
+        }
+        offset_ += 1 + length;
+        if (decode(body, length, have_previous_, previous_, frame)) {
+            previous_ = frame;
+            have_previous_ = true;
+            return true;
+        }
+        have_previous_ = false; // deltas after a damaged record cannot be decoded
+    }
+    return false;
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "i_clock.hh"
+#include "i_flash.hh"
+
+/// @brief One recorded frame: zone summaries, not pixels.
+struct RecordedFrame {
+    static constexpr std::size_t max_zones = 32;
+
+    uint32_t sequence;
+    uint32_t timestamp_us;
+    int16_t ta;                               // °C × 100
+    uint8_t zone_count;
+    std::array<int16_t, max_zones> zones;     // °C × 10, as ZoneReducer::means()
+};
+
+/// @brief Counters of SessionRecorder, for diagnostics and the write throughput
+/// (bytes_written over busy_us).
+struct RecorderStats {
+    uint32_t records;            // written to flash (or to the batch about to be)
+    uint32_t dropped;            // the RAM queue was full
+    uint32_t bytes_written;
+    uint32_t pages_erased;
+    uint32_t pages_overwritten;  // erased while holding the oldest records
+    uint32_t flash_errors;
+    uint32_t busy_us;            // time spent in flash operations, with a clock
+};
+
+enum class RecorderStatus {
+    Success = 0,
+    FlashError,
+};
+
+/// @brief Log-structured recording of zone summaries to flash, for the time no BLE central
+/// is connected.
+///
+/// record() only copies the frame into a bounded lock-free queue and never touches the flash,
+/// so it is safe on the acquisition path; service(), from a low-priority task, encodes queued
+/// frames and writes them in batches of batch_bytes. When the queue is full the frame is
+/// dropped and counted.
+///
+/// Pages are used as a ring in address order, each starting with a header holding a growing
+/// page sequence number, so every page is erased once per pass over the region (even wear)
+/// and mount() finds the newest page without any metadata page. When the region is full the
+/// oldest page is reused. Records are delta-coded against the previous one (zigzag varints),
+/// each page starting with a full record, so any page decodes on its own.
+class SessionRecorder {
+public:
+    static constexpr std::size_t queue_capacity = 8; // frames, power of two
+    static constexpr std::size_t batch_bytes = 256;
+    static constexpr uint32_t page_magic = 0x474F4C54; // "TLOG" on flash
+    static constexpr std::size_t page_header_bytes = 8;
+
+    explicit SessionRecorder(IFlash& flash, IClock* clock = nullptr);
+
+    /// @brief Finds where the last session stopped. Call once before service().
+    RecorderStatus mount();
+
+    /// @brief Queues one frame. Never blocks.
+    /// @return false if the queue was full (the frame is dropped).
+    bool record(uint32_t sequence, uint32_t timestamp_us, float ta, const int16_t* zones, std::size_t zone_count);
+
+    /// @brief Writes the partial batch at the next service(), e.g. before a download.
+    void request_flush() { flush_requested_.store(true, std::memory_order_release); }
+
+    /// @brief Encodes queued frames and writes full batches. Only called from one task.
+    /// @return true if there was anything to do.
+    bool service();
+
+    /// @brief Bytes that can be written before the oldest records are overwritten.
+    uint32_t remaining_bytes() const { return remaining_bytes_.load(std::memory_order_relaxed); }
+    RecorderStats stats() const;
+    /// @brief Static RAM of the recorder (queue and batch buffer).
+    static constexpr std::size_t memory_bytes() { return sizeof(SessionRecorder); }
+
+private:
+    struct Slot {
+        uint32_t sequence;
+        uint32_t timestamp_us;
+        int16_t ta;
+        uint8_t zone_count;
+        std::array<int16_t, RecordedFrame::max_zones> zones;
+    };
+
+    static constexpr std::size_t max_record_bytes = 2 + 3 * 5 + 1 + 3 * RecordedFrame::max_zones;
+
+    void append(const Slot& slot);
+    std::size_t encode(const Slot& slot, bool key, uint8_t* out) const;
+    bool open_next_page();
+    bool write_batch();
+    void update_remaining();
+    void flash_error();
+
+    IFlash& flash_;
+    IClock* clock_;
+    std::array<Slot, queue_capacity> queue_;
+    std::atomic<uint32_t> enqueue_pos_;
+    std::atomic<uint32_t> dequeue_pos_;
+    std::atomic<bool> flush_requested_;
+
+    // Consumer state
+    bool mounted_;
+    bool page_open_;
+    uint32_t page_;              // current page
+    uint32_t page_sequence_;     // of the current page
+    uint32_t used_pages_;        // pages holding records
+    uint32_t batch_offset_;      // region offset the batch is written to
+    std::size_t batch_size_;
+    std::array<uint8_t, batch_bytes> batch_;
+    bool have_previous_;         // delta base in the current page
+    Slot previous_;
+
+    RecorderStats stats_;
+    std::atomic<uint32_t> dropped_;
+    std::atomic<uint32_t> remaining_bytes_;
+};
+
+/// @brief Reads recorded frames back, oldest first.
+class RecordingReader {
+public:
+    explicit RecordingReader(IFlash& flash);
+
+    /// @brief Decodes the next frame.
+    /// @return false after the newest one.
+    bool next(RecordedFrame& frame);
+
+private:
+    bool load_page(uint32_t page);
+
+    IFlash& flash_;
+    uint32_t first_page_;
+    uint32_t pages_left_;        // including the current one
+    uint32_t page_;
+    uint32_t offset_;            // within the page
+    bool have_previous_;
+    RecordedFrame previous_;
+};
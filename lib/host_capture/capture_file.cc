@@ -0,0 +1,236 @@
+#include "capture_file.hh"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "offload_engine.hh"
+
+namespace {
+
+uint64_t align8(uint64_t offset)
+{
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+bool write_all(std::FILE* file, const void* data, std::size_t size)
+{
+    return size == 0 || std::fwrite(data, 1, size, file) == size;
+}
+
+bool pad_to(std::FILE* file, uint64_t offset)
+{
+    static const uint8_t zeros[8] = {};
+    const long position = std::ftell(file);
+    return position >= 0 && write_all(file, zeros, offset - static_cast<uint64_t>(position));
+}
+
+} // namespace
+
+CaptureWriter::~CaptureWriter()
+{
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+CaptureStatus CaptureWriter::open(const char* path, uint8_t rows, uint8_t columns, SerialPayload payload,
+                                  std::size_t payload_bytes, const uint16_t* calibration, std::size_t calibration_words)
+{
+    file_ = std::fopen(path, "wb");
+    if (!file_) {
+        return CaptureStatus::IoError;
+    }
+    header_ = CaptureFileHeader();
+    header_.magic = capture_file_magic;
+    header_.version = capture_file_version;
+    header_.header_bytes = sizeof(CaptureFileHeader);
+    header_.rows = rows;
+    header_.columns = columns;
+    header_.payload = static_cast<uint8_t>(payload);
+    if (calibration && calibration_words >= 10) {
+        std::memcpy(header_.sensor_id, calibration + 7, sizeof(header_.sensor_id));
+    }
+    header_.calibration_bytes = static_cast<uint32_t>(calibration ? calibration_words * sizeof(uint16_t) : 0);
+    header_.record_bytes = static_cast<uint32_t>(sizeof(CaptureRecordHeader) + payload_bytes);
+    header_.records_offset = align8(sizeof(CaptureFileHeader) + header_.calibration_bytes);
+    index_.clear();
+    last_timestamp_us_ = 0;
+    wraps_ = 0;
+    // index_offset stays 0 until finish(): an interrupted capture is reported Truncated.
+    if (!write_all(file_, &header_, sizeof(header_)) || !write_all(file_, calibration, header_.calibration_bytes) ||
+        !pad_to(file_, header_.records_offset)) {
+        return CaptureStatus::IoError;
+    }
+    return CaptureStatus::Success;
+}
+
+CaptureStatus CaptureWriter::append(const CaptureRecordHeader& record, const void* payload, std::size_t payload_bytes)
+{
+    if (sizeof(record) + payload_bytes != header_.record_bytes) {
+        return CaptureStatus::WrongSize;
+    }
+    if (!index_.empty() && record.timestamp_us < last_timestamp_us_) {
+        wraps_++;
+    }
+    last_timestamp_us_ = record.timestamp_us;
+    if (!write_all(file_, &record, sizeof(record)) || !write_all(file_, payload, payload_bytes)) {
+        return CaptureStatus::IoError;
+    }
+    index_.push_back((wraps_ << 32) | record.timestamp_us);
+    header_.frame_count++;
+    return CaptureStatus::Success;
+}
+
+CaptureStatus CaptureWriter::finish()
+{
+    header_.index_offset = align8(header_.records_offset + header_.frame_count * header_.record_bytes);
+    const bool written = pad_to(file_, header_.index_offset) &&
+                         write_all(file_, index_.data(), index_.size() * sizeof(uint64_t)) &&
+                         std::fseek(file_, 0, SEEK_SET) == 0 && write_all(file_, &header_, sizeof(header_));
+    const bool closed = std::fclose(file_) == 0;
+    file_ = nullptr;
+    return written && closed ? CaptureStatus::Success : CaptureStatus::IoError;
+}
+
+CaptureStatus CaptureReader::open(const char* path)
+{
+    close();
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return CaptureStatus::IoError;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return CaptureStatus::IoError;
+    }
+    if (info.st_size < static_cast<off_t>(sizeof(CaptureFileHeader))) {
+        ::close(fd);
+        return CaptureStatus::Truncated;
+    }
+    void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file
+    if (mapping == MAP_FAILED) {
+        return CaptureStatus::IoError;
+    }
+    data_ = static_cast<const uint8_t*>(mapping);
+    size_ = static_cast<std::size_t>(info.st_size);
+    std::memcpy(&header_, data_, sizeof(header_));
+
+    CaptureStatus status = CaptureStatus::Success;
+    if (header_.magic != capture_file_magic) {
+        status = CaptureStatus::BadMagic;
+    } else if (header_.version != capture_file_version || header_.header_bytes < sizeof(CaptureFileHeader)) {
+        status = CaptureStatus::UnsupportedVersion;
+    } else if (header_.record_bytes < sizeof(CaptureRecordHeader) ||
+               header_.records_offset < header_.header_bytes + static_cast<uint64_t>(header_.calibration_bytes)) {
+        status = CaptureStatus::WrongSize;
+    } else if (header_.index_offset == 0 || header_.index_offset % 8 != 0 ||
+               header_.index_offset < header_.records_offset + header_.frame_count * header_.record_bytes ||
+               header_.index_offset + header_.frame_count * sizeof(uint64_t) > size_) {
+        status = CaptureStatus::Truncated;
+    }
+    if (status != CaptureStatus::Success) {
+        close();
+        return status;
+    }
+    index_ = reinterpret_cast<const uint64_t*>(data_ + header_.index_offset);
+    madvise(const_cast<uint8_t*>(data_), size_, MADV_SEQUENTIAL);
+    return CaptureStatus::Success;
+}
+
+void CaptureReader::close()
+{
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    header_ = CaptureFileHeader();
+    index_ = nullptr;
+}
+
+const uint16_t* CaptureReader::calibration() const
+{
+    return header_.calibration_bytes ? reinterpret_cast<const uint16_t*>(data_ + header_.header_bytes) : nullptr;
+}
+
+CaptureFrame CaptureReader::frame(uint64_t n) const
+{
+    const uint8_t* record = data_ + header_.records_offset + n * header_.record_bytes;
+    CaptureFrame frame;
+    frame.record = reinterpret_cast<const CaptureRecordHeader*>(record);
+    frame.payload = record + sizeof(CaptureRecordHeader);
+    frame.time_us = index_[n];
+    return frame;
+}
+
+uint64_t CaptureReader::find_time(uint64_t time_us) const
+{
+    return std::lower_bound(index_, index_ + header_.frame_count, time_us) - index_;
+}
+
+CaptureStatus convert_serial_capture(std::FILE* input, const char* path, CaptureConversion& conversion)
+{
+    conversion = CaptureConversion();
+    SerialRecordParser parser;
+    SerialFrameHeader header;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> eeprom;
+    CaptureWriter writer;
+    bool opened = false;
+    uint8_t kind = 0;
+    uint8_t rows = 0;
+    uint8_t columns = 0;
+    std::vector<uint8_t> chunk(1 << 16);
+    std::size_t read;
+    while ((read = std::fread(chunk.data(), 1, chunk.size(), input)) > 0) {
+        parser.feed(chunk.data(), read);
+        while (parser.next(header, payload)) {
+            const bool frame_words = header.payload == static_cast<uint8_t>(SerialPayload::FrameWords);
+            if (header.payload == static_cast<uint8_t>(SerialPayload::EepromWords)) {
+                if (eeprom.empty()) {
+                    eeprom = payload;
+                }
+                continue;
+            }
+            // Raw frames are useless without the calibration sent ahead of them.
+            if (!opened && !(frame_words && eeprom.empty())) {
+                const uint16_t* calibration = reinterpret_cast<const uint16_t*>(eeprom.data());
+                const CaptureStatus status =
+                    writer.open(path, header.rows, header.columns, static_cast<SerialPayload>(header.payload),
+                                payload.size(), eeprom.empty() ? nullptr : calibration, eeprom.size() / 2);
+                if (status != CaptureStatus::Success) {
+                    return status;
+                }
+                opened = true;
+                kind = header.payload;
+                rows = header.rows;
+                columns = header.columns;
+            }
+            if (!opened || header.payload != kind || header.rows != rows || header.columns != columns) {
+                conversion.skipped_records++;
+                continue;
+            }
+            CaptureRecordHeader record = CaptureRecordHeader();
+            record.sequence = header.sequence;
+            record.timestamp_us = header.timestamp_us;
+            record.ta = header.ta;
+            record.vdd = header.vdd;
+            record.sub_page = header.sub_page;
+            const CaptureStatus status = writer.append(record, payload.data(), payload.size());
+            if (status == CaptureStatus::WrongSize) {
+                conversion.skipped_records++;
+            } else if (status != CaptureStatus::Success) {
+                return status;
+            }
+        }
+    }
+    if (!opened) {
+        return CaptureStatus::NoFrames;
+    }
+    conversion.frames = writer.frame_count();
+    return writer.finish();
+}
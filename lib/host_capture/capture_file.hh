@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "data_pack.hh"
+
+/// Capture files (.tcap) hold one session of frames from one sensor:
+///
+///   CaptureFileHeader
+///   calibration blob     calibration_bytes, the sensor EEPROM image when it was captured
+///   frame records        frame_count × record_bytes: CaptureRecordHeader + payload
+///   time index           frame_count uint64, device time of each frame in µs
+///
+/// Records have a fixed size, so frame N is at records_offset + N × record_bytes, and the
+/// time index is sorted, so the frame at time T is a binary search. Sections start 8-byte
+/// aligned and everything is little-endian.
+constexpr uint32_t capture_file_magic = 0x50414354; // "TCAP" on disk
+constexpr uint16_t capture_file_version = 1;
+
+struct CaptureFileHeader {
+    uint32_t magic;              // capture_file_magic
+    uint16_t version;            // capture_file_version
+    uint16_t header_bytes;       // sizeof(CaptureFileHeader)
+    uint16_t sensor_id[3];       // device ID (EEPROM words 7-9), 0 without calibration
+    uint8_t  rows;
+    uint8_t  columns;
+    uint8_t  payload;            // SerialPayload of every record
+    uint8_t  reserved[3];
+    uint32_t calibration_bytes;
+    uint32_t record_bytes;       // CaptureRecordHeader + payload
+    uint64_t frame_count;
+    uint64_t records_offset;
+    uint64_t index_offset;       // 0 while the file is being written
+} __attribute__((packed));
+
+struct CaptureRecordHeader {
+    uint32_t sequence;
+    uint32_t timestamp_us;       // device clock, wraps every 71 minutes (the index does not)
+    float    ta;                 // °C
+    float    vdd;                // V
+    uint8_t  sub_page;
+    uint8_t  reserved[3];
+} __attribute__((packed));
+
+enum class CaptureStatus {
+    Success = 0,
+    IoError,             // the file cannot be opened, mapped or written
+    BadMagic,            // not a capture file
+    UnsupportedVersion,
+    Truncated,           // shorter than its header says, or never finished
+    WrongSize,           // a record or calibration that does not match the file
+    NoFrames,            // nothing to convert in a serial capture
+};
+
+/// @brief Writes a capture file front to back; finish() appends the time index.
+class CaptureWriter {
+public:
+    CaptureWriter() : file_(nullptr), header_(), last_timestamp_us_(0), wraps_(0) {}
+    ~CaptureWriter();
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /// @param calibration EEPROM image (may be null), its words 7-9 become the sensor ID.
+    CaptureStatus open(const char* path, uint8_t rows, uint8_t columns, SerialPayload payload,
+                       std::size_t payload_bytes, const uint16_t* calibration, std::size_t calibration_words);
+    CaptureStatus append(const CaptureRecordHeader& record, const void* payload, std::size_t payload_bytes);
+    CaptureStatus finish();
+
+    uint64_t frame_count() const { return header_.frame_count; }
+
+private:
+    std::FILE* file_;
+    CaptureFileHeader header_;
+    std::vector<uint64_t> index_;
+    uint32_t last_timestamp_us_;
+    uint64_t wraps_;
+};
+
+/// @brief One frame of a CaptureReader, pointing into the mapping.
+struct CaptureFrame {
+    const CaptureRecordHeader* record;
+    const uint8_t* payload;
+    uint64_t time_us;            // unwrapped device time
+};
+
+/// @brief Read-only, memory-mapped view of a capture file.
+///
+/// open() checks the header and section bounds only: frames are read in place, so opening
+/// costs the same for a minute or a day of frames and scanning runs from the page cache.
+class CaptureReader {
+public:
+    CaptureReader() : data_(nullptr), size_(0), header_(), index_(nullptr) {}
+    ~CaptureReader() { close(); }
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    CaptureStatus open(const char* path);
+    void close();
+
+    const CaptureFileHeader& header() const { return header_; }
+    uint64_t frame_count() const { return header_.frame_count; }
+    const uint16_t* calibration() const;
+    std::size_t calibration_words() const { return header_.calibration_bytes / sizeof(uint16_t); }
+    std::size_t payload_bytes() const { return header_.record_bytes - sizeof(CaptureRecordHeader); }
+
+    /// @brief Frame `n` < frame_count().
+    CaptureFrame frame(uint64_t n) const;
+    /// @brief The first frame at or after `time_us` (unwrapped device time), frame_count() if none.
+    uint64_t find_time(uint64_t time_us) const;
+
+private:
+    const uint8_t* data_;
+    std::size_t size_;
+    CaptureFileHeader header_;
+    const uint64_t* index_;
+};
+
+/// @brief Counters of convert_serial_capture().
+struct CaptureConversion {
+    uint64_t frames;
+    uint64_t skipped_records;    // other payload kinds or sensor geometries
+};
+
+/// @brief Converts a serial byte stream (SerialFrameHeader records, see serial.py) to a capture
+/// file. Keeps the records of the first frame kind seen (temperatures, image or raw frame
+/// words); an EEPROM image record becomes the calibration blob. `input` is read in chunks.
+CaptureStatus convert_serial_capture(std::FILE* input, const char* path, CaptureConversion& conversion);
@@ -0,0 +1,125 @@
+#include "batch_processor.hh"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace {
+
+const uint16_t* frame_at(const RawFrameSpan& frames, std::size_t n)
+{
+    return reinterpret_cast<const uint16_t*>(frames.first + n * frames.stride_bytes);
+}
+
+} // namespace
+
+template <typename Traits>
+struct BasicBatchProcessor<Traits>::Job {
+    const RawFrameSpan& frames;
+    float* temps;
+    float* ambients;
+    Output output;
+    std::size_t chunk_frames;
+    std::atomic<std::size_t> next_chunk;
+};
+
+template <typename Traits>
+OffloadStatus BasicBatchProcessor<Traits>::load_eeprom(const uint16_t* words, std::size_t count)
+{
+    // Checked once here, so the workers' calibration cannot fail.
+    std::unique_ptr<Engine> engine(new Engine());
+    const OffloadStatus status = engine->load_eeprom(words, count);
+    calibrated_ = status == OffloadStatus::Success;
+    if (calibrated_) {
+        eeprom_.assign(words, words + count);
+    }
+    return status;
+}
+
+template <typename Traits>
+OffloadStatus BasicBatchProcessor<Traits>::process(const RawFrameSpan& frames, float* temps, float* ambients,
+                                                   Output output)
+{
+    stats_ = BatchStats();
+    if (!calibrated_) {
+        return OffloadStatus::NotCalibrated;
+    }
+    if (frames.count > 1 && frames.stride_bytes < Traits::frame_words * sizeof(uint16_t)) {
+        return OffloadStatus::WrongSize;
+    }
+    const std::size_t chunk_frames = std::max<std::size_t>(options_.chunk_frames, 1);
+    const std::size_t chunks = (frames.count + chunk_frames - 1) / chunk_frames;
+    unsigned threads = options_.threads ? options_.threads : std::max(std::thread::hardware_concurrency(), 1u);
+    threads = static_cast<unsigned>(std::max<std::size_t>(std::min<std::size_t>(threads, chunks), 1));
+
+    Job job = {frames, temps, ambients, output, chunk_frames, {0}};
+    std::vector<BatchStats> worker_stats(threads, BatchStats());
+    std::vector<std::thread> workers;
+    for (unsigned worker = 1; worker < threads; worker++) {
+        workers.emplace_back(&BasicBatchProcessor::run_worker, this, std::ref(job), std::ref(worker_stats[worker]));
+    }
+    run_worker(job, worker_stats[0]); // the calling thread is a worker too
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    stats_.threads = threads;
+    for (const BatchStats& worker : worker_stats) {
+        stats_.frames += worker.frames;
+        stats_.chunks += worker.chunks;
+        stats_.warmup_frames += worker.warmup_frames;
+    }
+    return OffloadStatus::Success;
+}
+
+template <typename Traits>
+void BasicBatchProcessor<Traits>::run_worker(Job& job, BatchStats& stats) const
+{
+    // Heap allocated: an MLX90640 engine is tens of KB.
+    std::unique_ptr<Engine> engine(new Engine());
+    engine->load_eeprom(eeprom_.data(), eeprom_.size());
+    while (true) {
+        const std::size_t first = job.next_chunk.fetch_add(1, std::memory_order_relaxed) * job.chunk_frames;
+        if (first >= job.frames.count) {
+            return;
+        }
+        const std::size_t last = std::min(first + job.chunk_frames, job.frames.count);
+        std::size_t n = warmup_start(job.frames, first);
+        for (; n < last; n++) {
+            engine->process_frame(frame_at(job.frames, n), Traits::frame_words, job.output);
+            if (n < first) {
+                stats.warmup_frames++;
+                continue;
+            }
+            std::memcpy(job.temps + n * num_pixels, engine->temps().data(), num_pixels * sizeof(float));
+            if (job.ambients) {
+                job.ambients[n] = engine->ambient();
+            }
+        }
+        stats.frames += last - first;
+        stats.chunks++;
+    }
+}
+
+// The first frame to process for the engine to hold what it would after frame first - 1:
+// the pixels of each subpage come from its last frame before `first`.
+template <typename Traits>
+std::size_t BasicBatchProcessor<Traits>::warmup_start(const RawFrameSpan& frames, std::size_t first) const
+{
+    if (Traits::subpage_covers_all_pixels || first == 0) {
+        return first;
+    }
+    const uint16_t sub_page = frame_at(frames, first - 1)[Traits::frame_sub_page];
+    for (std::size_t n = first - 1; n-- > 0;) {
+        if (frame_at(frames, n)[Traits::frame_sub_page] != sub_page) {
+            return n;
+        }
+    }
+    // No frame of the other subpage yet: its pixels are at their initial values, in this
+    // engine too since a worker claims chunks in increasing order.
+    return first - 1;
+}
+
+template class BasicBatchProcessor<MLX90641Traits>;
+template class BasicBatchProcessor<MLX90640Traits>;
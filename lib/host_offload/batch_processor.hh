@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "offload_engine.hh"
+
+/// @brief Raw frames in memory, e.g. the records of a mapped capture file: `count` frames of
+/// MLXSensor::frame_words(), the first at `first` and each `stride_bytes` after the previous
+/// (2-byte aligned).
+struct RawFrameSpan {
+    const uint8_t* first;
+    std::size_t count;
+    std::size_t stride_bytes;
+};
+
+/// @brief Parallelism of BasicBatchProcessor.
+struct BatchOptions {
+    unsigned threads;            // workers, 0: one per hardware thread
+    std::size_t chunk_frames;    // frames a worker claims at a time
+};
+
+/// @brief Counters of the last BasicBatchProcessor::process().
+struct BatchStats {
+    uint64_t frames;
+    uint64_t chunks;
+    uint64_t warmup_frames;      // processed again to rebuild the other subpage's pixels
+    unsigned threads;
+};
+
+/// @brief Replays a whole session of raw frames through the driver's own calculation, on
+/// every core.
+///
+/// Each worker owns a BasicOffloadEngine calibrated from the same EEPROM image and claims
+/// chunks of consecutive frames from a shared counter, so a slow chunk never holds up the
+/// others. Results go straight to their place in the output array, so the output is the same
+/// whatever the thread count and bit for bit what one engine fed the frames in order computes.
+///
+/// On sensors whose subpages each cover half of the pixels (MLX90640), a frame's other half
+/// comes from the previous subpage: a chunk starts by processing again the frames since the
+/// last one of the other subpage before it, usually one.
+template <typename Traits>
+class BasicBatchProcessor {
+public:
+    using Engine = BasicOffloadEngine<Traits>;
+    using Output = typename Engine::Output;
+    static constexpr std::size_t num_pixels = Traits::num_pixels;
+    static BatchOptions default_options() { return {0, 64}; }
+
+    explicit BasicBatchProcessor(const BatchOptions& options = default_options())
+        : options_(options), calibrated_(false), stats_() {}
+
+    /// @brief Calibrates from an EEPROM image as read by MLXSensor::read_eeprom().
+    OffloadStatus load_eeprom(const uint16_t* words, std::size_t count);
+
+    /// @brief Converts every frame of `frames`.
+    /// @param temps num_pixels values per frame, in frame order.
+    /// @param ambients One Ta per frame, may be null.
+    /// @return WrongSize if the stride is shorter than a frame.
+    OffloadStatus process(const RawFrameSpan& frames, float* temps, float* ambients = nullptr,
+                          Output output = Output::Temperature);
+
+    bool calibrated() const { return calibrated_; }
+    const BatchOptions& options() const { return options_; }
+    void set_options(const BatchOptions& options) { options_ = options; }
+    const BatchStats& stats() const { return stats_; }
+
+private:
+    struct Job;
+
+    void run_worker(Job& job, BatchStats& stats) const;
+    std::size_t warmup_start(const RawFrameSpan& frames, std::size_t first) const;
+
+    BatchOptions options_;
+    std::vector<uint16_t> eeprom_;
+    bool calibrated_;
+    BatchStats stats_;
+};
+
+using BatchProcessor = BasicBatchProcessor<MLX90641Traits>;
@@ -0,0 +1,72 @@
+#include "offload_engine.hh"
+#include <algorithm>
+#include <cstring>
+
+template <typename Traits>
+OffloadStatus BasicOffloadEngine<Traits>::load_eeprom(const uint16_t* words, std::size_t count)
+{
+    if (count != Sensor::ee_data_size) {
+        return OffloadStatus::WrongSize;
+    }
+    std::array<uint16_t, Sensor::ee_data_size> eeprom;
+    std::copy(words, words + count, eeprom.begin());
+    calibrated_ = sensor_.init_from_eeprom(eeprom);
+    return calibrated_ ? OffloadStatus::Success : OffloadStatus::InvalidEeprom;
+}
+
+template <typename Traits>
+OffloadStatus BasicOffloadEngine<Traits>::process_frame(const uint16_t* words, std::size_t count, Output output)
+{
+    if (count != Sensor::frame_data_size) {
+        return OffloadStatus::WrongSize;
+    }
+    if (!calibrated_) {
+        return OffloadStatus::NotCalibrated;
+    }
+    std::array<uint16_t, Sensor::frame_data_size> frame;
+    std::copy(words, words + count, frame.begin());
+    sensor_.load_frame(frame);
+    sensor_.calculate(output);
+    return OffloadStatus::Success;
+}
+
+void SerialRecordParser::feed(const uint8_t* data, std::size_t size)
+{
+    buffer_.erase(buffer_.begin(), buffer_.begin() + start_);
+    start_ = 0;
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+bool SerialRecordParser::next(SerialFrameHeader& header, std::vector<uint8_t>& payload)
+{
+    uint8_t magic[sizeof(serial_frame_magic)];
+    std::memcpy(magic, &serial_frame_magic, sizeof(magic));
+    while (true) {
+        const std::vector<uint8_t>::iterator found =
+            std::search(buffer_.begin() + start_, buffer_.end(), magic, magic + sizeof(magic));
+        if (found == buffer_.end()) {
+            // The tail may be the start of a magic cut by the feed() boundary.
+            start_ = std::max(start_, buffer_.size() - std::min(buffer_.size(), sizeof(magic) - 1));
+            return false;
+        }
+        start_ = found - buffer_.begin();
+        if (buffer_.size() - start_ < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, buffer_.data() + start_, sizeof(header));
+        if (header.payload_bytes > max_payload_bytes) {
+            start_++; // not a record start, look for the next magic
+            continue;
+        }
+        if (buffer_.size() - start_ < sizeof(header) + header.payload_bytes) {
+            return false;
+        }
+        const uint8_t* first = buffer_.data() + start_ + sizeof(header);
+        payload.assign(first, first + header.payload_bytes);
+        start_ += sizeof(header) + header.payload_bytes;
+        return true;
+    }
+}
+
+template class BasicOffloadEngine<MLX90641Traits>;
+template class BasicOffloadEngine<MLX90640Traits>;
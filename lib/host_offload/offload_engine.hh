@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "data_pack.hh"
+#include "i2c_adapter.hh"
+#include "mlx90641_driver.hh"
+
+enum class OffloadStatus {
+    Success = 0,
+    WrongSize,       // the word count does not match the sensor model
+    InvalidEeprom,   // the image failed the Hamming or validity checks
+    NotCalibrated,   // a frame arrived before any EEPROM image
+};
+
+/// @brief IWire with nothing attached: every transfer is NACKed. The offload engine's
+/// sensor never uses the bus.
+class DetachedWire : public IWire {
+public:
+    void begin() override {}
+    void end() override {}
+    void setClock(uint32_t) override {}
+    int endTransmission(bool = true) override { return 2; }
+    void beginTransmission(uint8_t) override {}
+    uint8_t requestFrom(uint8_t, std::size_t) override { return 0; }
+    std::size_t write(uint8_t) override { return 0; }
+    std::size_t write(const char*, std::size_t) override { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+    void delayMicroseconds(int) override {}
+    uint32_t micros() override { return 0; }
+    void drive_scl(bool) override {}
+    void drive_sda(bool) override {}
+    bool read_sda() override { return true; }
+};
+
+/// @brief Host side of the firmware's HOST_OFFLOAD mode: computes temperatures from the raw
+/// frame words and EEPROM image the device streams.
+///
+/// The work is done by an MLXSensor that is never attached to a bus (init_from_eeprom() and
+/// load_frame()), so the host runs the driver's own calibration and To code and gets the
+/// values the device would have computed.
+template <typename Traits>
+class BasicOffloadEngine {
+public:
+    using Sensor = mlx90641::MLXSensor<Traits>;
+    using Output = typename Sensor::Output;
+
+    BasicOffloadEngine() : i2c_(wire_), sensor_(i2c_), calibrated_(false) {}
+
+    /// @brief Calibrates from an EEPROM image as read by MLXSensor::read_eeprom().
+    OffloadStatus load_eeprom(const uint16_t* words, std::size_t count);
+
+    /// @brief Converts one frame of MLXSensor::frame_words().
+    OffloadStatus process_frame(const uint16_t* words, std::size_t count, Output output = Output::Temperature);
+
+    bool calibrated() const { return calibrated_; }
+    const std::array<float, Traits::num_pixels>& temps() const { return sensor_.get_temps(); }
+    float ambient() const { return sensor_.get_ambient(); }
+    /// @brief The sensor doing the work, e.g. to set a region of interest.
+    Sensor& sensor() { return sensor_; }
+
+private:
+    DetachedWire wire_;
+    I2CAdapter i2c_;
+    Sensor sensor_;
+    bool calibrated_;
+};
+
+using OffloadEngine = BasicOffloadEngine<MLX90641Traits>;
+
+/// @brief Splits a captured serial stream into SerialFrameHeader records.
+///
+/// Bytes outside records (text logs, a record cut at the start of the capture) are skipped by
+/// searching for serial_frame_magic.
+class SerialRecordParser {
+public:
+    static constexpr std::size_t max_payload_bytes = 4096;
+
+    SerialRecordParser() : start_(0) {}
+
+    void feed(const uint8_t* data, std::size_t size);
+
+    /// @brief Extracts the next complete record.
+    /// @return false until a whole record is buffered.
+    bool next(SerialFrameHeader& header, std::vector<uint8_t>& payload);
+
+private:
+    std::vector<uint8_t> buffer_;
+    std::size_t start_;   // consumed bytes at the front of buffer_, dropped by the next feed()
+};
@@ -0,0 +1,72 @@
+#include "deferred_logger.hh"
+
+static_assert((DeferredLogger::capacity & (DeferredLogger::capacity - 1)) == 0, "capacity must be a power of two");
+
+DeferredLogger::DeferredLogger(IClock& clock, Level level)
+    : Logger(level), clock_(clock), enqueue_pos_(0), dequeue_pos_(0), overruns_(0)
+{
+    binary_ = true;
+    for (std::size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+}
+
+void DeferredLogger::log(Level level, const char* message)
+{
+    if (!enabled(level)) {
+        return;
+    }
+    log_record(level, log_message_id(message), nullptr, 0);
+}
+
+void DeferredLogger::log_record(Level level, uint32_t message_id, const uint32_t* args, std::size_t arg_count)
+{
+    uint32_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & (capacity - 1)];
+        const uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The consumer has not freed this slot yet: the ring is full.
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    LogRecord& record = cell->record;
+    record.message_id = message_id;
+    record.timestamp_us = clock_.now_us();
+    record.level = static_cast<uint8_t>(level);
+    record.arg_count = static_cast<uint8_t>(arg_count > LogRecord::max_args ? LogRecord::max_args : arg_count);
+    for (uint8_t i = 0; i < record.arg_count; ++i) {
+        record.args[i] = args[i];
+    }
+    cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+std::size_t DeferredLogger::drain(uint8_t* out, std::size_t size)
+{
+    std::size_t used = 0;
+    for (;;) {
+        Cell& cell = cells_[dequeue_pos_ & (capacity - 1)];
+        const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(sequence - (dequeue_pos_ + 1)) < 0) {
+            break; // empty, or the producer that claimed this slot is still writing
+        }
+        const std::size_t written = encode_log_record(cell.record, out + used, size - used);
+        if (written == 0) {
+            break; // output full, keep the record for the next drain
+        }
+        used += written;
+        cell.sequence.store(dequeue_pos_ + capacity, std::memory_order_release);
+        dequeue_pos_++;
+    }
+    return used;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "i_clock.hh"
+#include "log_record.hh"
+#include "logger.hh"
+
+/// @brief Logger that defers all formatting to the host.
+///
+/// Call sites only store a LogRecord (message ID, timestamp, raw argument words) into a
+/// lock-free ring buffer; a low-priority task calls drain() to ship the encoded records,
+/// and tools/log_decoder turns them back into text with the build's string table.
+///
+/// The ring is a bounded multi-producer queue (per-slot sequence numbers), so records can
+/// come from several tasks. When it is full the record is dropped and counted as an
+/// overrun; logging never blocks.
+class DeferredLogger : public Logger {
+public:
+    static constexpr std::size_t capacity = 32; // records, power of two
+
+    DeferredLogger(IClock& clock, Level level = Level::INFO);
+
+    /// @brief Text path for direct log() calls: recorded under the message's hash with no arguments.
+    void log(Level level, const char* message) override;
+
+    void log_record(Level level, uint32_t message_id, const uint32_t* args, std::size_t arg_count) override;
+
+    /// @brief Moves as many whole encoded records as fit into `out`.
+    /// @return Bytes written. Must only be called from one consumer task.
+    std::size_t drain(uint8_t* out, std::size_t size);
+
+    /// @brief Records dropped because the ring was full.
+    uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        LogRecord record;
+    };
+
+    IClock& clock_;
+    std::array<Cell, capacity> cells_;
+    std::atomic<uint32_t> enqueue_pos_;
+    uint32_t dequeue_pos_;
+    std::atomic<uint32_t> overruns_;
+};
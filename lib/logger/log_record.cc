@@ -0,0 +1,178 @@
+#include "log_record.hh"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+void put_u32(uint8_t* out, uint32_t value)
+{
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t get_u32(const uint8_t* in)
+{
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+uint8_t checksum(const uint8_t* data, std::size_t size)
+{
+    uint8_t sum = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        sum = static_cast<uint8_t>(sum + data[i]);
+    }
+    return sum;
+}
+
+bool is_flag(char c)
+{
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool is_length(char c)
+{
+    return c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L';
+}
+
+} // namespace
+
+std::size_t encode_log_record(const LogRecord& record, uint8_t* out, std::size_t capacity)
+{
+    const uint8_t arg_count = record.arg_count > LogRecord::max_args ? LogRecord::max_args : record.arg_count;
+    const std::size_t size = log_record_header_size + 4 * arg_count + 1;
+    if (capacity < size) {
+        return 0;
+    }
+    out[0] = log_record_sync;
+    out[1] = static_cast<uint8_t>((record.level << 4) | arg_count);
+    put_u32(out + 2, record.message_id);
+    put_u32(out + 6, record.timestamp_us);
+    for (uint8_t i = 0; i < arg_count; ++i) {
+        put_u32(out + log_record_header_size + 4 * i, record.args[i]);
+    }
+    out[size - 1] = checksum(out + 1, size - 2);
+    return size;
+}
+
+LogDecodeStatus decode_log_record(const uint8_t* data, std::size_t size, LogRecord& record, std::size_t& consumed)
+{
+    consumed = 0;
+    if (size < 2) {
+        return LogDecodeStatus::NeedMoreData;
+    }
+    const uint8_t arg_count = data[1] & 0x0F;
+    if (data[0] != log_record_sync || arg_count > LogRecord::max_args) {
+        consumed = 1;
+        return LogDecodeStatus::BadSync;
+    }
+    const std::size_t record_size = log_record_header_size + 4 * arg_count + 1;
+    if (size < record_size) {
+        return LogDecodeStatus::NeedMoreData;
+    }
+    if (checksum(data + 1, record_size - 2) != data[record_size - 1]) {
+        consumed = 1;
+        return LogDecodeStatus::BadChecksum;
+    }
+    record.level = data[1] >> 4;
+    record.arg_count = arg_count;
+    record.message_id = get_u32(data + 2);
+    record.timestamp_us = get_u32(data + 6);
+    for (uint8_t i = 0; i < arg_count; ++i) {
+        record.args[i] = get_u32(data + log_record_header_size + 4 * i);
+    }
+    consumed = record_size;
+    return LogDecodeStatus::Success;
+}
+
+void format_log_record(const char* format, const uint32_t* args, std::size_t arg_count, char* out, std::size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    std::size_t used = 0;
+    std::size_t next_arg = 0;
+    out[0] = '\0';
+
+    while (*format && used + 1 < size) {
+        if (*format != '%') {
+            out[used++] = *format++;
+            continue;
+        }
+        if (format[1] == '%') {
+            out[used++] = '%';
+            format += 2;
+            continue;
+        }
+
+        // Copy one conversion specification, minus length modifiers (every word is 32 bits).
+        char spec[16];
+        std::size_t spec_len = 0;
+        spec[spec_len++] = *format++;
+        while ((is_flag(*format) || is_digit(*format) || *format == '.') && spec_len < sizeof(spec) - 2) {
+            spec[spec_len++] = *format++;
+        }
+        while (is_length(*format)) {
+            format++;
+        }
+        const char conversion = *format;
+        if (conversion == '\0') {
+            break;
+        }
+        format++;
+        spec[spec_len++] = conversion;
+        spec[spec_len] = '\0';
+
+        if (next_arg >= arg_count) {
+            out[used++] = '?'; // record was truncated to max_args
+            continue;
+        }
+        const uint32_t word = args[next_arg++];
+
+        int written = 0;
+        switch (conversion) {
+        case 'd':
+        case 'i':
+            written = snprintf(out + used, size - used, spec, static_cast<int>(static_cast<int32_t>(word)));
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            written = snprintf(out + used, size - used, spec, static_cast<unsigned int>(word));
+            break;
+        case 'c':
+            written = snprintf(out + used, size - used, spec, static_cast<int>(word & 0xFF));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G': {
+            float value;
+            std::memcpy(&value, &word, sizeof(value));
+            written = snprintf(out + used, size - used, spec, static_cast<double>(value));
+            break;
+        }
+        default:
+            written = snprintf(out + used, size - used, "<str>");
+            break;
+        }
+        if (written < 0) {
+            break;
+        }
+        used += static_cast<std::size_t>(written);
+        if (used >= size) {
+            used = size - 1;
+        }
+    }
+    out[used] = '\0';
+}
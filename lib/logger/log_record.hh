@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @brief One binary log record: message ID, timestamp and raw argument words.
+///
+/// The format string never leaves the firmware; host tools map message_id back to it with
+/// the string table generated at build time (scripts/logging/generate_log_strings.py).
+struct LogRecord {
+    static constexpr std::size_t max_args = 6;
+
+    uint32_t message_id;
+    uint32_t timestamp_us;
+    uint8_t level;
+    uint8_t arg_count;
+    uint32_t args[max_args];
+};
+
+/// Wire format (little-endian):
+///   [0]        sync byte 0xA5
+///   [1]        level << 4 | arg_count
+///   [2..5]     message_id
+///   [6..9]     timestamp_us
+///   [10..]     arg_count × 4-byte argument words
+///   [last]     checksum: 8-bit sum of bytes [1..last-1]
+constexpr uint8_t log_record_sync = 0xA5;
+constexpr std::size_t log_record_header_size = 10;
+constexpr std::size_t log_record_max_size = log_record_header_size + 4 * LogRecord::max_args + 1;
+
+enum class LogDecodeStatus {
+    Success = 0,
+    NeedMoreData,
+    BadSync,
+    BadChecksum,
+};
+
+/// @brief Serializes `record` into `out`.
+/// @return Bytes written, 0 if `capacity` is too small.
+std::size_t encode_log_record(const LogRecord& record, uint8_t* out, std::size_t capacity);
+
+/// @brief Parses one record from the start of `data`.
+///
+/// `consumed` is set to the bytes to skip: the record size on success, 1 on BadSync or
+/// BadChecksum so the caller can resynchronize, 0 when more data is needed.
+LogDecodeStatus decode_log_record(const uint8_t* data, std::size_t size, LogRecord& record, std::size_t& consumed);
+
+/// @brief Formats a printf-style `format` with raw argument words.
+///
+/// Supports the d/i/u/x/X/o/c/f/F/e/E/g/G conversions with flags, width and precision.
+/// Words are interpreted as int32/uint32 or float bits according to the conversion;
+/// %s prints "<str>" because strings are not captured in binary records.
+void format_log_record(const char* format, const uint32_t* args, std::size_t arg_count, char* out, std::size_t size);
@@ -0,0 +1,16 @@
+#include "logger.hh"
+#include <cstdarg>
+#include <cstdio>
+
+void Logger::logf(Level level, const char* format, ...)
+{
+    if (!enabled(level)) {
+        return;
+    }
+    char message[max_message_length];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    log(level, message);
+}
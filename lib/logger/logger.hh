@@ -1,19 +1,140 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Compile-time minimum log level. Statements below it are removed by the preprocessor,
+// arguments and formatting included. Set with e.g. -DLOG_MIN_LEVEL=LOG_LEVEL_INFO.
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
 
 class Logger {
 public:
     enum class Level {
-        DEBUG,
-        INFO,
-        WARN,
-        ERROR
+        DEBUG = LOG_LEVEL_DEBUG,
+        INFO = LOG_LEVEL_INFO,
+        WARN = LOG_LEVEL_WARN,
+        ERROR = LOG_LEVEL_ERROR
     };
 
-    Logger(Level level = Level::INFO) : log_level_(level) {}
+    // Longest formatted message, larger ones are truncated
+    static constexpr int max_message_length = 128;
+
+    Logger(Level level = Level::INFO) : log_level_(level), binary_(false) {}
     virtual ~Logger() = default;
     
     virtual void log(Level level, const char* message) = 0;
 
+    // Binary loggers receive the message ID and raw 32-bit argument words instead of text
+    virtual void log_record(Level, uint32_t /* message_id */, const uint32_t* /* args */, std::size_t /* arg_count */) {}
+
+    // Runtime filter, checked before any formatting happens
+    bool enabled(Level level) const { return level >= log_level_; }
+
+    // True for loggers that take log_record() instead of formatted text
+    bool binary() const { return binary_; }
+
+    void set_level(Level level) { log_level_ = level; }
+
+    // printf-style logging, formats only if `level` passes the runtime filter
+    void logf(Level level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
   protected:
     Level log_level_;
-};
\ No newline at end of file
+    bool binary_;
+};
+
+// FNV-1a hash of a format string, used as its message ID in binary logs
+constexpr uint32_t log_message_id(const char* format, uint32_t hash = 2166136261u)
+{
+    return *format ? log_message_id(format + 1, (hash ^ static_cast<uint8_t>(*format)) * 16777619u) : hash;
+}
+
+// Forces the message ID of a string literal to be computed at compile time
+#define LOG_MESSAGE_ID(format) (std::integral_constant<uint32_t, log_message_id(format)>::value)
+
+// Raw 32-bit argument word: integers as-is, floating point as float bits
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, uint32_t>::type log_word(T value)
+{
+    return static_cast<uint32_t>(value);
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, uint32_t>::type log_word(T value)
+{
+    const float narrowed = static_cast<float>(value);
+    uint32_t word;
+    std::memcpy(&word, &narrowed, sizeof(word));
+    return word;
+}
+
+// A binary record cannot carry the string behind a pointer, so %s and pointer arguments do not compile.
+template <typename T>
+uint32_t log_word(const T*)
+{
+    static_assert(!std::is_same<T, T>::value, "log arguments must be numbers, binary log records cannot carry strings");
+    return 0;
+}
+
+// Logging through an optional logger (nullptr drops the message)
+inline void log_format(Logger* logger, Logger::Level level, uint32_t message_id, const char* message)
+{
+    if (!logger || !logger->enabled(level)) {
+        return;
+    }
+    if (logger->binary()) {
+        logger->log_record(level, message_id, nullptr, 0);
+    } else {
+        logger->log(level, message);
+    }
+}
+
+template <typename... Args>
+void log_format(Logger* logger, Logger::Level level, uint32_t message_id, const char* format, Args... args)
+{
+    if (!logger || !logger->enabled(level)) {
+        return;
+    }
+    if (logger->binary()) {
+        const uint32_t words[] = {log_word(args)...};
+        logger->log_record(level, message_id, words, sizeof...(Args));
+    } else {
+        logger->logf(level, format, args...);
+    }
+}
+
+#define LOG_AT_LEVEL(logger, level, format, ...) \
+    log_format((logger), (level), LOG_MESSAGE_ID(format), format, ##__VA_ARGS__)
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(logger, format, ...) LOG_AT_LEVEL(logger, Logger::Level::DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(logger, format, ...) do { } while (0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(logger, format, ...) LOG_AT_LEVEL(logger, Logger::Level::INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(logger, format, ...) do { } while (0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(logger, format, ...) LOG_AT_LEVEL(logger, Logger::Level::WARN, format, ##__VA_ARGS__)
+#else
+#define LOG_WARN(logger, format, ...) do { } while (0)
+#endif
+
+#if LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(logger, format, ...) LOG_AT_LEVEL(logger, Logger::Level::ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(logger, format, ...) do { } while (0)
+#endif
@@ -0,0 +1,78 @@
+#include "queued_logger.hh"
+#include <cstdio>
+#include <cstring>
+
+static_assert((QueuedLogger::capacity & (QueuedLogger::capacity - 1)) == 0, "capacity must be a power of two");
+
+namespace {
+
+const char* level_name(Logger::Level level)
+{
+    switch (level) {
+        case Logger::Level::DEBUG: return "DEBUG";
+        case Logger::Level::INFO: return "INFO";
+        case Logger::Level::WARN: return "WARN";
+        case Logger::Level::ERROR: return "ERROR";
+    }
+    return "";
+}
+
+} // namespace
+
+QueuedLogger::QueuedLogger(Level level) : Logger(level), enqueue_pos_(0), dequeue_pos_(0), overruns_(0)
+{
+    for (std::size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+}
+
+void QueuedLogger::log(Level level, const char* message)
+{
+    if (!enabled(level)) {
+        return;
+    }
+    uint32_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & (capacity - 1)];
+        const uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The writer task has not sent this line yet: the ring is full.
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The message is at most max_message_length - 1 characters, so the line ending always fits.
+    const int length = snprintf(cell->text, sizeof(cell->text), "%s: %.*s\r\n", level_name(level),
+                                max_message_length - 1, message);
+    cell->length = static_cast<uint8_t>(length < 0 ? 0 : length);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+std::size_t QueuedLogger::drain(uint8_t* out, std::size_t size)
+{
+    std::size_t used = 0;
+    for (;;) {
+        Cell& cell = cells_[dequeue_pos_ & (capacity - 1)];
+        const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(sequence - (dequeue_pos_ + 1)) < 0) {
+            break; // empty, or the producer that claimed this slot is still writing
+        }
+        if (cell.length > size - used) {
+            break; // output full, keep the line for the next drain
+        }
+        std::memcpy(out + used, cell.text, cell.length);
+        used += cell.length;
+        cell.sequence.store(dequeue_pos_ + capacity, std::memory_order_release);
+        dequeue_pos_++;
+    }
+    return used;
+}
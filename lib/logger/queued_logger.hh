@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "logger.hh"
+
+/// @brief Text logger whose lines are written out by the task that owns the serial port.
+///
+/// log() formats "LEVEL: message\r\n" into a lock-free ring buffer and returns; the serial
+/// writer task calls drain() between two binary frame records, so a log line never lands
+/// inside one. Like DeferredLogger, the ring takes lines from several tasks, and a line
+/// that finds it full is dropped and counted instead of blocking the caller.
+class QueuedLogger : public Logger {
+public:
+    static constexpr std::size_t capacity = 8;                            // lines, power of two
+    static constexpr std::size_t max_line = max_message_length + 9;       // "ERROR: " + message + "\r\n"
+
+    explicit QueuedLogger(Level level = Level::INFO);
+
+    void log(Level level, const char* message) override;
+
+    /// @brief Moves as many whole lines as fit into `out`, which should hold at least max_line bytes.
+    /// @return Bytes written. Must only be called from one consumer task.
+    std::size_t drain(uint8_t* out, std::size_t size);
+
+    /// @brief Lines dropped because the ring was full.
+    uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        uint8_t length;
+        char text[max_line];
+    };
+
+    std::array<Cell, capacity> cells_;
+    std::atomic<uint32_t> enqueue_pos_;
+    uint32_t dequeue_pos_;
+    std::atomic<uint32_t> overruns_;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+namespace mlx90641 {
+
+/// @brief Acquisition metadata of one frame, stamped by the driver when it first saw the
+/// data-ready flag and completed from the frame's own Ta/Vdd words.
+///
+/// Every subpage the driver sees become ready gets the next sequence number, so a gap in the
+/// sequence of delivered frames is a frame that was read but failed, replaced by the next
+/// subpage during the read, or not forwarded. Subpages the firmware never polled in time are
+/// not numbered; they show as timestamp gaps longer than the subpage period.
+struct FrameHeader {
+    uint32_t sequence;
+    uint32_t timestamp_us;  // IClock time of the data-ready observation, 0 without a clock
+    uint8_t sub_page;
+    float ta;               // ambient (sensor die) temperature, °C
+    float vdd;              // supply voltage, V
+};
+
+} // namespace mlx90641
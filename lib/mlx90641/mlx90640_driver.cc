@@ -0,0 +1,209 @@
+#include "mlx90641_driver.hh"
+#include <cmath>
+
+// MLX90640 parts of MLXSensor, following the Melexis MLX90640 reference calculation. Only the
+// pixels of the current subpage (chess or interleaved pattern) are converted; the others keep
+// the temperature of the previous subpage.
+
+namespace mlx90641 {
+
+namespace {
+
+// Row parity, as the Melexis ilPattern.
+int il_pattern(int pixel_number)
+{
+    return (pixel_number / static_cast<int>(MLX90640Traits::num_columns)) % 2;
+}
+
+// Column pair parity correction used with ilChessC[1] when the readout pattern differs from calibration.
+int conversion_pattern(int pixel_number)
+{
+    return ((pixel_number + 2) / 4 - (pixel_number + 3) / 4 + (pixel_number + 1) / 4 - pixel_number / 4) *
+           (1 - 2 * il_pattern(pixel_number));
+}
+
+float signed_word(uint16_t word)
+{
+    float value = word;
+    if(value > 32767)
+    {
+        value = value - 65536;
+    }
+    return value;
+}
+
+} // namespace
+
+template <>
+void MLXSensor<MLX90640Traits>::log_calibration() const
+{
+    LOG_DEBUG(logger_,
+        "Critical params - ksTo[1]: %.6f, tgc: %.6f, cpAlpha: %.6f, alpha[0]: %.6f",
+        calibration_parameters_.ksTo[1],
+        calibration_parameters_.tgc,
+        calibration_parameters_.cpAlpha[0],
+        calibration_parameters_.alpha[0]);
+}
+
+template <>
+void MLXSensor<MLX90640Traits>::calculate_to(float emissivity, float tr, Reducer* reducer)
+{
+    float vdd;
+    float ta;
+    float ta4;
+    float tr4;
+    float ta_tr;
+    float gain;
+    float ir_data_cp[2];
+    float ir_data;
+    float alpha_compensated;
+    float sx;
+    float to;
+    float alpha_corr_r[4];
+    int8_t range;
+    uint16_t sub_page;
+    uint8_t mode;
+
+    sub_page = frame_data_[MLX90640Traits::frame_sub_page];
+    vdd = get_vdd();
+    ta = get_ta();
+    ta4 = pow((ta + 273.15), (double)4);
+    tr4 = pow((tr + 273.15), (double)4);
+    ta_tr = tr4 - (tr4-ta4)/emissivity;
+
+    alpha_corr_r[0] = 1 / (1 + calibration_parameters_.ksTo[0] * 40);
+    alpha_corr_r[1] = 1 ;
+    alpha_corr_r[2] = (1 + calibration_parameters_.ksTo[1] * calibration_parameters_.ct[2]);
+    alpha_corr_r[3] = alpha_corr_r[2] * (1 + calibration_parameters_.ksTo[2] * (calibration_parameters_.ct[3] - calibration_parameters_.ct[2]));
+
+    //------------------------- Gain calculation -----------------------------------
+    gain = calibration_parameters_.gainEE / signed_word(frame_data_[MLX90640Traits::frame_gain]);
+
+    //------------------------- To calculation -------------------------------------
+    mode = (frame_data_[MLX90640Traits::frame_control] & 0x1000) >> 5;
+
+    ir_data_cp[0] = signed_word(frame_data_[MLX90640Traits::frame_cp(0)]) * gain;
+    ir_data_cp[1] = signed_word(frame_data_[MLX90640Traits::frame_cp(1)]) * gain;
+
+    ir_data_cp[0] = ir_data_cp[0] - calibration_parameters_.cpOffset[0] * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
+    if(mode == calibration_parameters_.calibrationModeEE)
+    {
+        ir_data_cp[1] = ir_data_cp[1] - calibration_parameters_.cpOffset[1] * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
+    }
+    else
+    {
+        ir_data_cp[1] = ir_data_cp[1] - (calibration_parameters_.cpOffset[1] + calibration_parameters_.ilChessC[0]) * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
+    }
+
+    for( int pixel_number = 0; pixel_number < static_cast<int>(num_pixels); pixel_number++)
+    {
+        if(!converted_.test(pixel_number))
+        {
+            continue;
+        }
+        if(MLX90640Traits::pixel_sub_page(pixel_number, mode != 0) == sub_page)
+        {
+            ir_data = signed_word(frame_data_[pixel_number]) * gain;
+
+            ir_data = ir_data - calibration_parameters_.offset[pixel_number]*(1 + calibration_parameters_.kta[pixel_number]*(ta - 25))*(1 + calibration_parameters_.kv[pixel_number]*(vdd - 3.3));
+            if(mode != calibration_parameters_.calibrationModeEE)
+            {
+                ir_data = ir_data + calibration_parameters_.ilChessC[2] * (2 * il_pattern(pixel_number) - 1) - calibration_parameters_.ilChessC[1] * conversion_pattern(pixel_number);
+            }
+
+            ir_data = ir_data - calibration_parameters_.tgc * ir_data_cp[sub_page];
+
+            ir_data = ir_data / emissivity;
+
+            alpha_compensated = (calibration_parameters_.alpha[pixel_number] - calibration_parameters_.tgc * calibration_parameters_.cpAlpha[sub_page])*(1 + calibration_parameters_.KsTa * (ta - 25));
+
+            sx = alpha_compensated * alpha_compensated * alpha_compensated * (ir_data + alpha_compensated * ta_tr);
+            sx = sqrt(sqrt(sx)) * calibration_parameters_.ksTo[1];
+
+            to = sqrt(sqrt(ir_data/(alpha_compensated * (1 - calibration_parameters_.ksTo[1] * 273.15) + sx) + ta_tr)) - 273.15;
+
+            if(to < calibration_parameters_.ct[1])
+            {
+                range = 0;
+            }
+            else if(to < calibration_parameters_.ct[2])
+            {
+                range = 1;
+            }
+            else if(to < calibration_parameters_.ct[3])
+            {
+                range = 2;
+            }
+            else
+            {
+                range = 3;
+            }
+
+            to = sqrt(sqrt(ir_data / (alpha_compensated * alpha_corr_r[range] * (1 + calibration_parameters_.ksTo[range] * (to - calibration_parameters_.ct[range]))) + ta_tr)) - 273.15;
+            temps_[pixel_number] = to;
+        }
+        if (reducer && roi_.test(pixel_number) && !is_broken_pixel(pixel_number))
+        {
+            reducer->accumulate(pixel_number, temps_[pixel_number]);
+        }
+    }
+}
+
+template <>
+void MLXSensor<MLX90640Traits>::get_image()
+{
+    float vdd;
+    float ta;
+    float gain;
+    float ir_data_cp[2];
+    float ir_data;
+    float alpha_compensated;
+    uint16_t sub_page;
+    uint8_t mode;
+
+    sub_page = frame_data_[MLX90640Traits::frame_sub_page];
+    vdd = get_vdd();
+    ta = get_ta();
+
+//------------------------- Gain calculation -----------------------------------
+    gain = calibration_parameters_.gainEE / signed_word(frame_data_[MLX90640Traits::frame_gain]);
+
+//------------------------- Image calculation -------------------------------------
+    mode = (frame_data_[MLX90640Traits::frame_control] & 0x1000) >> 5;
+
+    ir_data_cp[0] = signed_word(frame_data_[MLX90640Traits::frame_cp(0)]) * gain;
+    ir_data_cp[1] = signed_word(frame_data_[MLX90640Traits::frame_cp(1)]) * gain;
+
+    ir_data_cp[0] = ir_data_cp[0] - calibration_parameters_.cpOffset[0] * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
+    if(mode == calibration_parameters_.calibrationModeEE)
+    {
+        ir_data_cp[1] = ir_data_cp[1] - calibration_parameters_.cpOffset[1] * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
+    }
+    else
+    {
+        ir_data_cp[1] = ir_data_cp[1] - (calibration_parameters_.cpOffset[1] + calibration_parameters_.ilChessC[0]) * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
+    }
+
+    for( int pixel_number = 0; pixel_number < static_cast<int>(num_pixels); pixel_number++)
+    {
+        if(!converted_.test(pixel_number) || MLX90640Traits::pixel_sub_page(pixel_number, mode != 0) != sub_page)
+        {
+            continue;
+        }
+        ir_data = signed_word(frame_data_[pixel_number]) * gain;
+
+        ir_data = ir_data - calibration_parameters_.offset[pixel_number]*(1 + calibration_parameters_.kta[pixel_number]*(ta - 25))*(1 + calibration_parameters_.kv[pixel_number]*(vdd - 3.3));
+        if(mode != calibration_parameters_.calibrationModeEE)
+        {
+            ir_data = ir_data + calibration_parameters_.ilChessC[2] * (2 * il_pattern(pixel_number) - 1) - calibration_parameters_.ilChessC[1] * conversion_pattern(pixel_number);
+        }
+
+        ir_data = ir_data - calibration_parameters_.tgc * ir_data_cp[sub_page];
+
+        alpha_compensated = (calibration_parameters_.alpha[pixel_number] - calibration_parameters_.tgc * calibration_parameters_.cpAlpha[sub_page]);
+
+        temps_[pixel_number] = ir_data/alpha_compensated;
+    }
+}
+
+} // namespace mlx90641
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+
+namespace mlx90641 {
+
+/// @brief Class containing all MLX90640 EEPROM addresses as constexpr static values
+///
+/// Unlike the MLX90641, most words pack several parameters; the bit fields are given where
+/// each parameter is extracted (see MLX90640EEpromParser).
+class MLX90640EepromAddr {
+public:
+    static constexpr uint16_t calibration_mode = 0x240A;   // also holds the device-select bit
+
+    // Offset parameters
+    static constexpr uint16_t scale_offset = 0x2410;       // alphaPTAT, row/column/remainder offset scales
+    static constexpr uint16_t offset_average = 0x2411;
+    static constexpr uint16_t offset_row = 0x2412;         // 6 words, 4 rows each
+    static constexpr uint16_t offset_column = 0x2418;      // 8 words, 4 columns each
+
+    // Alpha parameters
+    static constexpr uint16_t scale_alpha = 0x2420;        // alpha, row/column/remainder alpha scales
+    static constexpr uint16_t alpha_reference = 0x2421;
+    static constexpr uint16_t alpha_row = 0x2422;          // 6 words, 4 rows each
+    static constexpr uint16_t alpha_column = 0x2428;       // 8 words, 4 columns each
+
+    // Temperature coefficient parameters
+    static constexpr uint16_t gain_ee = 0x2430;
+    static constexpr uint16_t vptat25 = 0x2431;
+    static constexpr uint16_t kv_kt_ptat = 0x2432;
+    static constexpr uint16_t kvdd_vdd25 = 0x2433;
+    static constexpr uint16_t kv_average = 0x2434;          // one nibble per row/column parity
+    static constexpr uint16_t il_chess = 0x2435;
+    static constexpr uint16_t kta_average_odd_column = 0x2436;
+    static constexpr uint16_t kta_average_even_column = 0x2437;
+    static constexpr uint16_t scale_kta_kv = 0x2438;        // also holds resolutionEE
+
+    // Compensation pixel parameters
+    static constexpr uint16_t cp_alpha = 0x2439;
+    static constexpr uint16_t cp_offset = 0x243A;
+    static constexpr uint16_t cp_kv_kta = 0x243B;
+
+    static constexpr uint16_t ks_ta_tgc = 0x243C;
+    static constexpr uint16_t ks_to_ranges_1_2 = 0x243D;
+    static constexpr uint16_t ks_to_ranges_3_4 = 0x243E;
+    static constexpr uint16_t ks_to_scale_ct = 0x243F;
+
+    // Pixel data base address: offset (bits 10-15), alpha (4-9), kta (1-3), outlier flag (0)
+    static constexpr uint16_t pixel = 0x2440;
+};
+
+} // namespace mlx90641
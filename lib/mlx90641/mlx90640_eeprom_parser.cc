@@ -0,0 +1,315 @@
+#include "mlx90640_eeprom_parser.hh"
+#include "sensor_traits.hh"
+
+namespace mlx90641 {
+
+namespace {
+
+constexpr std::size_t num_columns = MLX90640Traits::num_columns;
+
+// Per-pixel averages (kta, kv) are stored per row/column parity: 0 odd row and odd column,
+// 1 odd row and even column, 2 even row and odd column, 3 even row and even column (1-based
+// rows/columns as in the datasheet).
+std::size_t parity_split(std::size_t pixel)
+{
+    return 2 * ((pixel / num_columns) % 2) + pixel % 2;
+}
+
+} // namespace
+
+bool MLX90640EEpromParser::extract_all(ParamsMLX90640& params) const
+{
+    params.kVdd = get_kvdd();
+    params.vdd25 = get_vdd25();
+    params.KvPTAT = get_kv_ptat();
+    params.KtPTAT = get_kt_ptat();
+    params.vPTAT25 = get_vptat25();
+    params.alphaPTAT = get_alpha_ptat();
+    params.gainEE = get_gain_ee();
+    params.tgc = get_tgc();
+    params.emissivityEE = 1.0f; // not calibrated on the MLX90640
+    params.resolutionEE = get_resolution_ee();
+    params.calibrationModeEE = get_calibration_mode_ee();
+    params.KsTa = get_ks_ta();
+    params.ksTo = get_ks_to();
+    params.ct = get_ct();
+    params.alpha = get_alpha();
+    params.offset = get_offset();
+    params.kta = get_kta();
+    params.kv = get_kv();
+    params.cpAlpha = get_cp_alpha();
+    params.cpOffset = get_cp_offset();
+    params.cpKv = get_cp_kv();
+    params.cpKta = get_cp_kta();
+    params.ilChessC = get_il_chess_c();
+    params.brokenPixels = get_deviating_pixels();
+    return true;
+}
+
+int16_t MLX90640EEpromParser::get_kvdd() const
+{
+    // kVdd = (int8_t)(ee_data[51] >> 8) * 32
+    constexpr SingleEepromWord kvdd{{MLX90640EepromAddr::kvdd_vdd25, 8, 8}, 5, true};
+    return scale_by_multiplication(static_cast<int16_t>(extract_param(kvdd)), kvdd.scale_exp);
+}
+
+int16_t MLX90640EEpromParser::get_vdd25() const
+{
+    // vdd25 = ((ee_data[51] & 0x00FF) - 256) * 32 - 8192
+    constexpr SingleEepromWord vdd25{{MLX90640EepromAddr::kvdd_vdd25, 0, 8}, 5, false};
+    return static_cast<int16_t>((extract_param(vdd25) - 256) * (1 << vdd25.scale_exp) - 8192);
+}
+
+float MLX90640EEpromParser::get_kv_ptat() const
+{
+    constexpr SingleEepromWord kv_ptat{{MLX90640EepromAddr::kv_kt_ptat, 10, 6}, 12, true};
+    return scale_by_division(extract_param(kv_ptat), kv_ptat.scale_exp);
+}
+
+float MLX90640EEpromParser::get_kt_ptat() const
+{
+    constexpr SingleEepromWord kt_ptat{{MLX90640EepromAddr::kv_kt_ptat, 0, 10}, 3, true};
+    return scale_by_division(extract_param(kt_ptat), kt_ptat.scale_exp);
+}
+
+std::uint16_t MLX90640EEpromParser::get_vptat25() const
+{
+    constexpr SingleEepromWord vptat25{{MLX90640EepromAddr::vptat25, 0, 16}, 0, false};
+    return static_cast<std::uint16_t>(extract_param(vptat25));
+}
+
+float MLX90640EEpromParser::get_alpha_ptat() const
+{
+    // alphaPTAT = (ee_data[16] >> 12) / 4 + 8
+    constexpr SingleEepromWord alpha_ptat{{MLX90640EepromAddr::scale_offset, 12, 4}, 2, false};
+    return scale_by_division(extract_param(alpha_ptat), alpha_ptat.scale_exp) + 8.0f;
+}
+
+std::int16_t MLX90640EEpromParser::get_gain_ee() const
+{
+    constexpr SingleEepromWord gain_ee{{MLX90640EepromAddr::gain_ee, 0, 16}, 0, true};
+    return static_cast<std::int16_t>(extract_param(gain_ee));
+}
+
+float MLX90640EEpromParser::get_tgc() const
+{
+    constexpr SingleEepromWord tgc{{MLX90640EepromAddr::ks_ta_tgc, 0, 8}, 5, true};
+    return scale_by_division(extract_param(tgc), tgc.scale_exp);
+}
+
+uint8_t MLX90640EEpromParser::get_resolution_ee() const
+{
+    constexpr SingleEepromWord resolution{{MLX90640EepromAddr::scale_kta_kv, 12, 2}, 0, false};
+    return static_cast<uint8_t>(extract_param(resolution));
+}
+
+uint8_t MLX90640EEpromParser::get_calibration_mode_ee() const
+{
+    constexpr SingleEepromWord mode{{MLX90640EepromAddr::calibration_mode, 11, 1}, 0, false};
+    return static_cast<uint8_t>((extract_param(mode) << 7) ^ 0x80);
+}
+
+float MLX90640EEpromParser::get_ks_ta() const
+{
+    constexpr SingleEepromWord ks_ta{{MLX90640EepromAddr::ks_ta_tgc, 8, 8}, 13, true};
+    return scale_by_division(extract_param(ks_ta), ks_ta.scale_exp);
+}
+
+std::array<float, 4> MLX90640EEpromParser::get_ks_to() const
+{
+    constexpr SingleEepromWord ks_to_scale{{MLX90640EepromAddr::ks_to_scale_ct, 0, 4}, 0, false};
+    const uint8_t scale = static_cast<uint8_t>(extract_param(ks_to_scale) + 8);
+    const std::array<SingleEepromWord, 4> ks_to_words = {{
+        SingleEepromWord{{MLX90640EepromAddr::ks_to_ranges_1_2, 0, 8}, scale, true},
+        SingleEepromWord{{MLX90640EepromAddr::ks_to_ranges_1_2, 8, 8}, scale, true},
+        SingleEepromWord{{MLX90640EepromAddr::ks_to_ranges_3_4, 0, 8}, scale, true},
+        SingleEepromWord{{MLX90640EepromAddr::ks_to_ranges_3_4, 8, 8}, scale, true}
+    }};
+    std::array<float, 4> ks_to;
+    for (uint8_t i = 0; i < ks_to.size(); ++i) {
+        ks_to[i] = scale_by_division(extract_param(ks_to_words[i]), ks_to_words[i].scale_exp);
+    }
+    return ks_to;
+}
+
+std::array<std::int16_t, 4> MLX90640EEpromParser::get_ct() const
+{
+    constexpr SingleEepromWord step{{MLX90640EepromAddr::ks_to_scale_ct, 12, 2}, 0, false};
+    constexpr SingleEepromWord ct3{{MLX90640EepromAddr::ks_to_scale_ct, 4, 4}, 0, false};
+    constexpr SingleEepromWord ct4{{MLX90640EepromAddr::ks_to_scale_ct, 8, 4}, 0, false};
+    const int32_t step_value = extract_param(step) * 10;
+    const int32_t ct3_value = extract_param(ct3) * step_value;
+    const int32_t ct4_value = ct3_value + extract_param(ct4) * step_value;
+    return {{-40, 0, static_cast<int16_t>(ct3_value), static_cast<int16_t>(ct4_value)}};
+}
+
+std::array<float, 768> MLX90640EEpromParser::get_alpha() const
+{
+    constexpr SingleEepromWord remainder_scale{{MLX90640EepromAddr::scale_alpha, 0, 4}, 0, false};
+    constexpr SingleEepromWord column_scale{{MLX90640EepromAddr::scale_alpha, 4, 4}, 0, false};
+    constexpr SingleEepromWord row_scale{{MLX90640EepromAddr::scale_alpha, 8, 4}, 0, false};
+    constexpr SingleEepromWord alpha_scale{{MLX90640EepromAddr::scale_alpha, 12, 4}, 0, false};
+    constexpr SingleEepromWord alpha_reference{{MLX90640EepromAddr::alpha_reference, 0, 16}, 0, false};
+
+    const int32_t remainder_multiplier = 1 << extract_param(remainder_scale);
+    const int32_t column_multiplier = 1 << extract_param(column_scale);
+    const int32_t row_multiplier = 1 << extract_param(row_scale);
+    const uint8_t alpha_scale_value = static_cast<uint8_t>(extract_param(alpha_scale) + 30);
+    const int32_t reference = extract_param(alpha_reference);
+
+    std::array<float, 768> alpha;
+    for (std::size_t p = 0; p < alpha.size(); ++p) {
+        const SingleEepromWord pixel{{static_cast<uint16_t>(MLX90640EepromAddr::pixel + p), 4, 6}, 0, true};
+        const int32_t value = reference + extract_nibble(MLX90640EepromAddr::alpha_row, p / num_columns) * row_multiplier +
+                              extract_nibble(MLX90640EepromAddr::alpha_column, p % num_columns) * column_multiplier +
+                              extract_param(pixel) * remainder_multiplier;
+        alpha[p] = scale_by_division(value, alpha_scale_value);
+    }
+    return alpha;
+}
+
+std::array<std::int16_t, 768> MLX90640EEpromParser::get_offset() const
+{
+    constexpr SingleEepromWord remainder_scale{{MLX90640EepromAddr::scale_offset, 0, 4}, 0, false};
+    constexpr SingleEepromWord column_scale{{MLX90640EepromAddr::scale_offset, 4, 4}, 0, false};
+    constexpr SingleEepromWord row_scale{{MLX90640EepromAddr::scale_offset, 8, 4}, 0, false};
+    constexpr SingleEepromWord offset_average{{MLX90640EepromAddr::offset_average, 0, 16}, 0, true};
+
+    const int32_t remainder_multiplier = 1 << extract_param(remainder_scale);
+    const int32_t column_multiplier = 1 << extract_param(column_scale);
+    const int32_t row_multiplier = 1 << extract_param(row_scale);
+    const int32_t average = extract_param(offset_average);
+
+    std::array<std::int16_t, 768> offset;
+    for (std::size_t p = 0; p < offset.size(); ++p) {
+        const SingleEepromWord pixel{{static_cast<uint16_t>(MLX90640EepromAddr::pixel + p), 10, 6}, 0, true};
+        offset[p] = static_cast<std::int16_t>(
+            average + extract_nibble(MLX90640EepromAddr::offset_row, p / num_columns) * row_multiplier +
+            extract_nibble(MLX90640EepromAddr::offset_column, p % num_columns) * column_multiplier +
+            extract_param(pixel) * remainder_multiplier);
+    }
+    return offset;
+}
+
+std::array<float, 768> MLX90640EEpromParser::get_kta() const
+{
+    constexpr SingleEepromWord scale1{{MLX90640EepromAddr::scale_kta_kv, 4, 4}, 0, false};
+    constexpr SingleEepromWord scale2{{MLX90640EepromAddr::scale_kta_kv, 0, 4}, 0, false};
+    constexpr std::array<SingleEepromWord, 4> averages = {{
+        SingleEepromWord{{MLX90640EepromAddr::kta_average_odd_column, 8, 8}, 0, true},  // odd row, odd column
+        SingleEepromWord{{MLX90640EepromAddr::kta_average_even_column, 8, 8}, 0, true}, // odd row, even column
+        SingleEepromWord{{MLX90640EepromAddr::kta_average_odd_column, 0, 8}, 0, true},  // even row, odd column
+        SingleEepromWord{{MLX90640EepromAddr::kta_average_even_column, 0, 8}, 0, true}  // even row, even column
+    }};
+
+    const uint8_t scale1_value = static_cast<uint8_t>(extract_param(scale1) + 8);
+    const int32_t multiplier = 1 << extract_param(scale2);
+    std::array<int32_t, 4> average_values;
+    for (std::size_t i = 0; i < averages.size(); ++i) {
+        average_values[i] = extract_param(averages[i]);
+    }
+
+    std::array<float, 768> kta;
+    for (std::size_t p = 0; p < kta.size(); ++p) {
+        const SingleEepromWord pixel{{static_cast<uint16_t>(MLX90640EepromAddr::pixel + p), 1, 3}, 0, true};
+        kta[p] = scale_by_division(average_values[parity_split(p)] + extract_param(pixel) * multiplier, scale1_value);
+    }
+    return kta;
+}
+
+std::array<float, 768> MLX90640EEpromParser::get_kv() const
+{
+    constexpr SingleEepromWord scale{{MLX90640EepromAddr::scale_kta_kv, 8, 4}, 0, false};
+    constexpr std::array<SingleEepromWord, 4> values = {{
+        SingleEepromWord{{MLX90640EepromAddr::kv_average, 12, 4}, 0, true}, // odd row, odd column
+        SingleEepromWord{{MLX90640EepromAddr::kv_average, 4, 4}, 0, true},  // odd row, even column
+        SingleEepromWord{{MLX90640EepromAddr::kv_average, 8, 4}, 0, true},  // even row, odd column
+        SingleEepromWord{{MLX90640EepromAddr::kv_average, 0, 4}, 0, true}   // even row, even column
+    }};
+
+    const uint8_t scale_value = static_cast<uint8_t>(extract_param(scale));
+    std::array<float, 4> split_values;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        split_values[i] = scale_by_division(extract_param(values[i]), scale_value);
+    }
+
+    std::array<float, 768> kv;
+    for (std::size_t p = 0; p < kv.size(); ++p) {
+        kv[p] = split_values[parity_split(p)];
+    }
+    return kv;
+}
+
+std::array<float, 2> MLX90640EEpromParser::get_cp_alpha() const
+{
+    constexpr SingleEepromWord alpha_scale{{MLX90640EepromAddr::scale_alpha, 12, 4}, 0, false};
+    constexpr SingleEepromWord cp_alpha{{MLX90640EepromAddr::cp_alpha, 0, 10}, 0, true};
+    constexpr SingleEepromWord cp_alpha_ratio{{MLX90640EepromAddr::cp_alpha, 10, 6}, 7, true};
+
+    std::array<float, 2> alpha;
+    alpha[0] = scale_by_division(extract_param(cp_alpha), static_cast<uint8_t>(extract_param(alpha_scale) + 27));
+    alpha[1] = (1 + scale_by_division(extract_param(cp_alpha_ratio), cp_alpha_ratio.scale_exp)) * alpha[0];
+    return alpha;
+}
+
+std::array<std::int16_t, 2> MLX90640EEpromParser::get_cp_offset() const
+{
+    constexpr SingleEepromWord cp_offset{{MLX90640EepromAddr::cp_offset, 0, 10}, 0, true};
+    constexpr SingleEepromWord cp_offset_delta{{MLX90640EepromAddr::cp_offset, 10, 6}, 0, true};
+
+    const int32_t offset = extract_param(cp_offset);
+    return {{static_cast<std::int16_t>(offset), static_cast<std::int16_t>(offset + extract_param(cp_offset_delta))}};
+}
+
+float MLX90640EEpromParser::get_cp_kta() const
+{
+    constexpr SingleEepromWord scale1{{MLX90640EepromAddr::scale_kta_kv, 4, 4}, 0, false};
+    constexpr SingleEepromWord cp_kta{{MLX90640EepromAddr::cp_kv_kta, 0, 8}, 0, true};
+    return scale_by_division(extract_param(cp_kta), static_cast<uint8_t>(extract_param(scale1) + 8));
+}
+
+float MLX90640EEpromParser::get_cp_kv() const
+{
+    constexpr SingleEepromWord scale{{MLX90640EepromAddr::scale_kta_kv, 8, 4}, 0, false};
+    constexpr SingleEepromWord cp_kv{{MLX90640EepromAddr::cp_kv_kta, 8, 8}, 0, true};
+    return scale_by_division(extract_param(cp_kv), static_cast<uint8_t>(extract_param(scale)));
+}
+
+std::array<float, 3> MLX90640EEpromParser::get_il_chess_c() const
+{
+    constexpr SingleEepromWord c1{{MLX90640EepromAddr::il_chess, 0, 6}, 4, true};
+    constexpr SingleEepromWord c2{{MLX90640EepromAddr::il_chess, 6, 5}, 1, true};
+    constexpr SingleEepromWord c3{{MLX90640EepromAddr::il_chess, 11, 5}, 3, true};
+    return {{scale_by_division(extract_param(c1), c1.scale_exp),
+             scale_by_division(extract_param(c2), c2.scale_exp),
+             scale_by_division(extract_param(c3), c3.scale_exp)}};
+}
+
+std::bitset<768> MLX90640EEpromParser::get_deviating_pixels() const
+{
+    std::bitset<768> pixels;
+    for (std::size_t p = 0; p < MLX90640Traits::num_pixels; ++p) {
+        const uint16_t word = eeprom_data_[MLX90640EepromAddr::pixel - eeprom_start_address + p];
+        pixels[p] = word == 0 || (word & 0x0001) != 0;
+    }
+    return pixels;
+}
+
+int32_t MLX90640EEpromParser::extract_nibble(uint16_t first_address, std::size_t index) const
+{
+    const SingleEepromWord nibble{
+        {static_cast<uint16_t>(first_address + index / 4), static_cast<uint8_t>(4 * (index % 4)), 4}, 0, true};
+    return extract_param(nibble);
+}
+
+int32_t MLX90640EEpromParser::extract_param(const SingleEepromWord& word) const
+{
+    const uint32_t mask = (1ul << word.word.bit_width) - 1ul;
+    uint32_t value = (eeprom_data_[word.word.address - eeprom_start_address] >> word.word.start_bit) & mask;
+    if (word.is_signed && (value & (1u << (word.word.bit_width - 1)))) {
+        value -= (1u << word.word.bit_width);
+    }
+    return static_cast<int32_t>(value);
+}
+
+} // namespace mlx90641
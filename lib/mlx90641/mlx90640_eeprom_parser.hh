@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include "mlx90640_eeprom_addr.hh"
+#include "mlx90640_params.hh"
+#include "mlx90641_eeprom_parser.hh"
+
+namespace mlx90641 {
+
+/// @brief Class to extract and hold MLX90640 EEPROM parameters
+///
+/// Same interface as MLX90641EEpromParser. The MLX90640 EEPROM has no Hamming coding and the
+/// same size, so it is read into the same array type.
+class MLX90640EEpromParser {
+public:
+    MLX90640EEpromParser(const std::array<uint16_t, eeprom_size>& eeprom_data)
+        : eeprom_data_(eeprom_data) {}
+
+    /// @brief Extracts all parameters and fills the provided ParamsMLX90640 structure.
+    /// Defective pixels do not fail the extraction, the driver corrects them.
+    bool extract_all(ParamsMLX90640& params) const;
+
+    /// @brief Returns the KVdd calibration coefficient (signed 8-bit, scaled by 2⁵).
+    int16_t get_kvdd() const;
+
+    /// @brief Returns VDD25, the supply voltage reading at 25 °C: (raw - 256) · 2⁵ - 8192.
+    int16_t get_vdd25() const;
+
+    /// @brief Returns KV_PTAT (signed 6-bit, divided by 2¹²).
+    float get_kv_ptat() const;
+
+    /// @brief Returns KT_PTAT (signed 10-bit, divided by 2³).
+    float get_kt_ptat() const;
+
+    /// @brief Returns VPTAT25, the PTAT reading at 25 °C.
+    std::uint16_t get_vptat25() const;
+
+    /// @brief Returns ALPHA_PTAT: 4-bit value divided by 2² plus 8.
+    float get_alpha_ptat() const;
+
+    /// @brief Returns GAIN_EE, the gain reading at calibration (signed 16-bit).
+    std::int16_t get_gain_ee() const;
+
+    /// @brief Returns TGC (signed 8-bit, divided by 2⁵).
+    float get_tgc() const;
+
+    /// @brief Returns the EEPROM-stored ADC resolution setting (0–3).
+    uint8_t get_resolution_ee() const;
+
+    /// @brief Returns the readout pattern used at calibration: 0x80 chess, 0 interleaved.
+    ///
+    /// Compared with bit 12 of the control register (shifted to bit 7) by the To calculation.
+    uint8_t get_calibration_mode_ee() const;
+
+    /// @brief Returns KS_TA (signed 8-bit, divided by 2¹³).
+    float get_ks_ta() const;
+
+    /// @brief Returns KS_TO for the 4 temperature ranges.
+    std::array<float, 4> get_ks_to() const;
+
+    /// @brief Returns the corner temperatures of the 4 ranges: -40, 0, then two from EEPROM.
+    std::array<std::int16_t, 4> get_ct() const;
+
+    /// @brief Returns α for each pixel (768 entries): reference + row + column + pixel terms.
+    std::array<float, 768> get_alpha() const;
+
+    /// @brief Returns the offset of each pixel (768 entries): average + row + column + pixel terms.
+    std::array<std::int16_t, 768> get_offset() const;
+
+    /// @brief Returns KTA for each pixel: an average per row/column parity plus a 3-bit pixel value.
+    std::array<float, 768> get_kta() const;
+
+    /// @brief Returns KV for each pixel: one value per row/column parity.
+    std::array<float, 768> get_kv() const;
+
+    /// @brief Returns CP_ALPHA for subpage 0 and 1.
+    std::array<float, 2> get_cp_alpha() const;
+
+    /// @brief Returns CP_OFFSET for subpage 0 and 1.
+    std::array<std::int16_t, 2> get_cp_offset() const;
+
+    /// @brief Returns CP_KTA, the compensation KTA coefficient.
+    float get_cp_kta() const;
+
+    /// @brief Returns CP_KV, the compensation KV coefficient.
+    float get_cp_kv() const;
+
+    /// @brief Returns the three interleaved/chess pattern correction coefficients.
+    std::array<float, 3> get_il_chess_c() const;
+
+    /// @brief Returns the broken (pixel word 0) and outlier (bit 0 set) pixels.
+    std::bitset<768> get_deviating_pixels() const;
+
+private:
+    /// @brief Signed nibble `index` of a table packing four 4-bit values per word (rows or columns).
+    int32_t extract_nibble(uint16_t first_address, std::size_t index) const;
+
+    /// @brief Extracts a parameter value from a single EEPROM word, sign-extended if signed.
+    int32_t extract_param(const SingleEepromWord& word) const;
+
+    // Referenced, not copied: the parser only lives while the EEPROM dump is valid.
+    const std::array<uint16_t, eeprom_size>& eeprom_data_;
+};
+
+} // namespace mlx90641
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <bitset>
+
+namespace mlx90641 {
+
+/// @brief Struct containing all calibration parameters for the MLX90640 sensor
+///
+/// Field names follow ParamsMLX90641. Differences: four KsTo ranges, a compensation pixel per
+/// subpage, the interleaved/chess correction (ilChessC) and a single offset per pixel.
+struct ParamsMLX90640 {
+        std::int16_t kVdd;
+        std::int16_t vdd25;
+        float KvPTAT;
+        float KtPTAT;
+        std::uint16_t vPTAT25;
+        float alphaPTAT;
+        std::int16_t gainEE;
+        float tgc;
+        float cpKv;
+        float cpKta;
+        std::uint8_t resolutionEE;
+        std::uint8_t calibrationModeEE;
+        float KsTa;
+        std::array<float, 4> ksTo;
+        std::array<std::int16_t, 4> ct;
+        std::array<float, 768> alpha;
+        std::array<std::int16_t, 768> offset;
+        std::array<float, 768> kta;
+        std::array<float, 768> kv;
+        std::array<float, 2> cpAlpha;
+        std::array<std::int16_t, 2> cpOffset;
+        std::array<float, 3> ilChessC;
+        float emissivityEE;
+        std::bitset<768> brokenPixels;  // broken and outlier pixels
+    };
+
+} // namespace mlx90641
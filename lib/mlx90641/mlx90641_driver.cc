@@ -1,114 +1,356 @@
 #include "mlx90641_driver.hh"
 #include "mlx90641_eeprom_parser.hh"
-#include <cstring>
+#include <cstddef>
 #include <cmath>
 #include <cstdio>
 
 namespace mlx90641 {
 
-MLX90641Sensor::MLX90641Sensor(I2CAdapter& i2c_adapter, uint8_t i2c_addr, Logger* logger_ptr)
-    : i2c_(i2c_adapter), i2c_addr_(i2c_addr), ambient_(0.0f), logger_(logger_ptr)
+namespace {
+
+// The driver keeps its int codes: -1 the transaction failed, -2 a written register reads back a
+// different value (expected for self-clearing bits). The typed cause stays available from
+// I2CAdapter::last_status().
+int i2c_error(I2CStatus status)
+{
+    switch (status)
+    {
+        case I2CStatus::Success: return 0;
+        case I2CStatus::VerifyMismatch: return -2;
+        default: return -1;
+    }
+}
+
+} // namespace
+
+template <typename Traits>
+MLXSensor<Traits>::MLXSensor(I2CAdapter& i2c_adapter, uint8_t i2c_addr, Logger* logger_ptr, IClock* clock)
+    : i2c_(i2c_adapter), i2c_addr_(i2c_addr), output_(Output::Temperature), roi_(PixelMask::all()),
+      converted_(PixelMask::all()), read_blocks_((1ul << Traits::ram_blocks) - 1), calibration_parameters_(),
+      ambient_(0.0f), sub_page_(0), logger_(logger_ptr), clock_(clock),
+      publisher_(nullptr), header_(), next_sequence_(0), ready_sequence_(0), ready_us_(0), ready_seen_(false)
 {
     temps_.fill(0.0f);
     ee_data_.fill(0);
     frame_data_.fill(0);
-    std::memset(&calibration_parameters_, 0, sizeof(calibration_parameters_));
 }
 
-bool MLX90641Sensor::init()
+template <typename Traits>
+bool MLXSensor<Traits>::init()
 {
-    log(Logger::Level::DEBUG, "Starting MLX90641 sensor initialization");
+    LOG_DEBUG(logger_, "Starting MLX90641 sensor initialization");
     
-    log(Logger::Level::DEBUG, "Initializing I2C adapter");
-    if (i2c_.init(400) != 0) {
-        log(Logger::Level::ERROR, "Failed to initialize I2C adapter");
+    LOG_DEBUG(logger_, "Initializing I2C adapter");
+    // Standard mode until tune_speed() validated a faster clock
+    if (i2c_.init(100) != 0) {
+        LOG_ERROR(logger_, "Failed to initialize I2C adapter");
         return false;
     }
-    log(Logger::Level::DEBUG, "I2C adapter initialized successfully");
+    LOG_DEBUG(logger_, "I2C adapter initialized successfully");
     
-    log(Logger::Level::DEBUG, "Dumping EEPROM data");
+    LOG_DEBUG(logger_, "Dumping EEPROM data");
     int ee_result = dump_ee();
     if (ee_result != 0) {
-        char msg[64];
-        snprintf(msg, sizeof(msg), "Failed to dump EEPROM data, error: %d", ee_result);
-        log(Logger::Level::ERROR, msg);
+        LOG_ERROR(logger_, "Failed to dump EEPROM data, error: %d", ee_result);
         return false;
     }
-    log(Logger::Level::DEBUG, "EEPROM data dumped successfully");
+    LOG_DEBUG(logger_, "EEPROM data dumped successfully");
+
+    // Words 0-15 are not Hamming coded, so the dump holds them as the sensor returns them.
+    const I2CStatus speed_status = i2c_.tune_speed(i2c_addr_, Traits::eeprom_address, ee_data_.data());
+    if (speed_status != I2CStatus::Success) {
+        LOG_WARN(logger_, "I2C speed validation failed, status %d", static_cast<int>(speed_status));
+    }
+    LOG_INFO(logger_, "I2C clock %d kHz", i2c_.frequency_khz());
     
-    log(Logger::Level::DEBUG, "Extracting calibration parameters");
+    LOG_DEBUG(logger_, "Extracting calibration parameters");
     int param_result = extract_parameters();
     if (param_result != 0) {
-        char msg[64];
-        snprintf(msg, sizeof(msg), "Failed to extract parameters, error: %d", param_result);
-        log(Logger::Level::ERROR, msg);
+        LOG_ERROR(logger_, "Failed to extract parameters, error: %d", param_result);
         return false;
     }
-    log(Logger::Level::DEBUG, "Calibration parameters extracted successfully");
+    LOG_DEBUG(logger_, "Calibration parameters extracted successfully");
     
     // TODO: allow configuration of refresh rate and resolution
-    log(Logger::Level::DEBUG, "Setting resolution to 17-bit (0x03)");
+    LOG_DEBUG(logger_, "Setting resolution to 17-bit (0x03)");
     int res_result = set_resolution(0x03);     // 17-bit resolution
     if (res_result != 0) {
-        char msg[64];
-        snprintf(msg, sizeof(msg), "Failed to set resolution, error: %d", res_result);
-        log(Logger::Level::WARN, msg);
+        LOG_WARN(logger_, "Failed to set resolution, error: %d", res_result);
     } else {
-        log(Logger::Level::DEBUG, "Resolution set successfully");
+        LOG_DEBUG(logger_, "Resolution set successfully");
     }
     
-    log(Logger::Level::DEBUG, "Setting refresh rate to 16Hz (0x06)");
-    int rate_result = set_refresh_rate(0x06);     // 16Hz refresh
+    LOG_DEBUG(logger_, "Setting refresh rate to 0x%02X", default_refresh_rate);
+    int rate_result = set_refresh_rate(default_refresh_rate);
     if (rate_result != 0) {
-        char msg[64];
-        snprintf(msg, sizeof(msg), "Failed to set refresh rate, error: %d", rate_result);
-        log(Logger::Level::WARN, msg);
+        LOG_WARN(logger_, "Failed to set refresh rate, error: %d", rate_result);
     } else {
-        log(Logger::Level::DEBUG, "Refresh rate set successfully");
+        LOG_DEBUG(logger_, "Refresh rate set successfully");
     }
 
-    log(Logger::Level::INFO, "MLX90641 sensor initialization completed successfully");
+    LOG_INFO(logger_, "MLX90641 sensor initialization completed successfully");
     return true;
 }
 
-bool MLX90641Sensor::read_frame()
+template <typename Traits>
+int MLXSensor<Traits>::read_eeprom(std::size_t first_word, std::size_t count, uint16_t* words)
 {
-    if (get_frame_data() != 0)
+    return i2c_error(i2c_.read(i2c_addr_, static_cast<uint16_t>(Traits::eeprom_address + first_word), count, words));
+}
+
+template <typename Traits>
+bool MLXSensor<Traits>::init_from_eeprom(const std::array<uint16_t, ee_data_size>& eeprom)
+{
+    ee_data_ = eeprom;
+    int error = Traits::eeprom_hamming ? hamming_decode() : 0;
+    if (error == 0) {
+        error = extract_parameters();
+    }
+    if (error != 0) {
+        LOG_ERROR(logger_, "Invalid EEPROM image, error: %d", error);
         return false;
-    ambient_ = get_ta();
+    }
+    return true;
+}
+
+template <typename Traits>
+void MLXSensor<Traits>::load_frame(const std::array<uint16_t, frame_data_size>& words)
+{
+    frame_data_ = words;
+    complete_header();
+}
+
+template <typename Traits>
+bool MLXSensor<Traits>::read_frame()
+{
+    // Failed transactions are retried until the frame latency budget is spent.
+    i2c_.begin_frame();
+    // Returns the subpage number on success, a negative error otherwise
+    const int result = get_frame_data();
+    i2c_.end_frame();
+    if (result < 0)
+        return false;
+    complete_header();
     return true;
 }
 
-void MLX90641Sensor::calculate_temps()
+template <typename Traits>
+void MLXSensor<Traits>::calculate_temps(Reducer* reducer)
 {
     float emissivity = get_emissivity();
     float tr = ambient_;
-    calculate_to(emissivity, tr);
+    if (reducer) {
+        reducer->begin_frame();
+    }
+    calculate_to(emissivity, tr, reducer);
     bad_pixels_correction();
+    output_ = Output::Temperature;
+    if (reducer) {
+        // Defective pixels are skipped inside calculate_to and only folded in once corrected.
+        for (std::size_t i = 0; i < correction_.size(); ++i) {
+            const uint16_t pixel_number = correction_.entry(i).target;
+            reducer->accumulate(pixel_number, temps_[pixel_number]);
+        }
+        reducer->end_frame();
+    }
+    publish();
+}
+
+template <typename Traits>
+void MLXSensor<Traits>::calculate_image()
+{
+    get_image();
+    bad_pixels_correction();
+    output_ = Output::Image;
+    publish();
+}
+
+// Straight from the driver's buffers into the publisher's slot, no staging copy
+template <typename Traits>
+void MLXSensor<Traits>::publish()
+{
+    if (!publisher_) {
+        return;
+    }
+    publisher_->begin_write();
+    publisher_->store(offsetof(Snapshot, header), &header_, sizeof(header_));
+    publisher_->store(offsetof(Snapshot, output), &output_, sizeof(output_));
+    publisher_->store(offsetof(Snapshot, temps), temps_.data(), sizeof(temps_));
+    publisher_->end_write();
+}
+
+template <typename Traits>
+void MLXSensor<Traits>::calculate(Output output, Reducer* reducer)
+{
+    if (output == Output::Image) {
+        calculate_image();
+    } else {
+        calculate_temps(reducer);
+    }
+}
+
+template <typename Traits>
+void MLXSensor<Traits>::get_image_int16(std::array<int16_t, num_pixels>& image, float scale) const
+{
+    for (std::size_t pixel_number = 0; pixel_number < num_pixels; ++pixel_number) {
+        const float value = roundf(temps_[pixel_number] * scale);
+        image[pixel_number] = value >= 32767.0f ? 32767 : value <= -32768.0f ? -32768 : static_cast<int16_t>(value);
+    }
 }
 
-std::array<float, MLX90641Sensor::num_pixels> MLX90641Sensor::get_temps() const
+template <typename Traits>
+void MLXSensor<Traits>::set_roi(const PixelMask& roi)
 {
-    return temps_;
+    roi_ = roi;
+    update_roi();
+}
+
+template <typename Traits>
+void MLXSensor<Traits>::set_flagged_pixels(const PixelMask& pixels)
+{
+    flagged_ = pixels;
+    update_roi();
+}
+
+// Compiles the defective-pixel correction and derives the converted pixels and the RAM blocks
+// to read from the ROI and the defective pixels.
+template <typename Traits>
+void MLXSensor<Traits>::update_roi()
+{
+    defective_ = flagged_;
+    for (std::size_t pixel = 0; pixel < num_pixels; ++pixel) {
+        if (calibration_parameters_.brokenPixels[pixel]) {
+            defective_.set(pixel);
+        }
+    }
+    correction_.build(defective_, roi_);
+
+    // Corrected pixels are overwritten by the blend, uncorrected ones stay NaN.
+    converted_ = correction_.sources();
+    for (std::size_t pixel = 0; pixel < num_pixels; ++pixel) {
+        if (roi_.test(pixel) && !defective_.test(pixel)) {
+            converted_.set(pixel);
+        }
+    }
+
+    read_blocks_ = 0;
+    for (uint8_t block = 0; block < Traits::ram_blocks; block++) {
+        const std::size_t first = Traits::block_offset(block);
+        bool needed = first + Traits::block_words(block) > num_pixels; // auxiliary data
+        for (std::size_t pixel = first; !needed && pixel < first + Traits::block_words(block); ++pixel) {
+            needed = converted_.test(pixel);
+        }
+        if (needed) {
+            read_blocks_ |= 1ul << block;
+        }
+    }
+
+    // Nothing writes the other pixels until the ROI changes.
+    for (std::size_t pixel = 0; pixel < num_pixels; ++pixel) {
+        if (!converted_.test(pixel)) {
+            temps_[pixel] = NAN;
+        }
+    }
 }
 
-float MLX90641Sensor::get_ambient() const
+template <typename Traits>
+float MLXSensor<Traits>::get_ambient() const
 {
     return ambient_;
 }
 
+template <typename Traits>
+int MLXSensor<Traits>::poll_data_ready(bool& ready)
+{
+    uint16_t status_register;
+    int error = i2c_error(i2c_.read(i2c_addr_, Traits::status_register, 1, &status_register));
+    if (error != 0)
+        return error;
+    ready = (status_register & 0x0008) != 0;
+    sub_page_ = status_register & 0x0001;
+    if (ready && !ready_seen_)
+        note_data_ready();
+    return 0;
+}
+
+template <typename Traits>
+int MLXSensor<Traits>::set_step_mode(bool enable)
+{
+    uint16_t control_register_1;
+    int error;
+
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
+    if (error == 0)
+    {
+        const uint16_t value = enable ? (control_register_1 | 0x0002) : (control_register_1 & 0xFFFD);
+        error = i2c_error(i2c_.write(i2c_addr_, Traits::control_register, value));
+    }
+    return error;
+}
+
+template <typename Traits>
+int MLXSensor<Traits>::trigger_measurement()
+{
+    // Bit 4 keeps overwrite enabled, bit 5 starts a measurement, data-ready (bit 3) is cleared.
+    int error = i2c_error(i2c_.write(i2c_addr_, Traits::status_register, 0x0030));
+    ready_seen_ = false;
+    // The start bit self-clears, so the write readback is not expected to match.
+    return error == -1 ? error : 0;
+}
+
+template <typename Traits>
+int MLXSensor<Traits>::read_frame_step(uint8_t step)
+{
+    int error;
+    if (step == 0)
+    {
+        // Clear data-ready first so a subpage arriving during the read is detected at the end.
+        error = i2c_error(i2c_.write(i2c_addr_, Traits::status_register, 0x0030));
+        ready_seen_ = false;
+        return error == -1 ? error : 0;
+    }
+    if (step < frame_read_steps - 1)
+    {
+        return (read_blocks_ >> (step - 1)) & 1 ? read_frame_block(sub_page_, step - 1) : 0;
+    }
+
+    error = read_frame_block(sub_page_, step - 1);
+    if (error != 0)
+        return error;
+    uint16_t status_register;
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::status_register, 1, &status_register));
+    if (error != 0)
+        return error;
+    uint16_t control_register_1;
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
+    if (error != 0)
+        return error;
+    frame_data_[Traits::frame_control] = control_register_1;
+    frame_data_[Traits::frame_sub_page] = sub_page_;
+    if (status_register & 0x0008)
+    {
+        sub_page_ = status_register & 0x0001;
+        note_data_ready();
+        return -8;
+    }
+    complete_header();
+    return 0;
+}
+
 // ------------------- Private member functions -------------------
 
-int MLX90641Sensor::dump_ee()
+template <typename Traits>
+int MLXSensor<Traits>::dump_ee()
 {
-    int error = i2c_.read(i2c_addr_, 0x2400, 832, ee_data_.data());
+    int error = i2c_error(i2c_.read(i2c_addr_, Traits::eeprom_address, Traits::eeprom_words, ee_data_.data()));
     
-    if (error == 0)
+    if (error == 0 && Traits::eeprom_hamming)
         error = hamming_decode();
     return error;
 }
 
-int MLX90641Sensor::hamming_decode()
+template <typename Traits>
+int MLXSensor<Traits>::hamming_decode()
 {
     int error = 0;
     int16_t parity[5];
@@ -117,7 +359,7 @@ int MLX90641Sensor::hamming_decode()
     uint16_t data;
     uint16_t mask;
     
-    for (int addr = 16; addr < 832; addr++)
+    for (int addr = 16; addr < static_cast<int>(Traits::eeprom_words); addr++)
     {
         parity[0] = -1;
         parity[1] = -1;
@@ -184,7 +426,8 @@ int MLX90641Sensor::hamming_decode()
     return error;
 }
 
-int MLX90641Sensor::get_frame_data()
+template <typename Traits>
+int MLXSensor<Traits>::get_frame_data()
 {
     uint16_t data_ready = 1;
     uint16_t control_register_1;
@@ -196,104 +439,121 @@ int MLX90641Sensor::get_frame_data()
     data_ready = 0;
     while (data_ready == 0)
     {
-        error = i2c_.read(i2c_addr_, 0x8000, 1, &status_register);
+        error = i2c_error(i2c_.read(i2c_addr_, Traits::status_register, 1, &status_register));
         if (error != 0)
             return error;
         data_ready = status_register & 0x0008;
     }
     sub_page = status_register & 0x0001;
+    if (!ready_seen_)
+        note_data_ready();
         
     while (data_ready != 0 && cnt < 5)
     { 
-        error = i2c_.write(i2c_addr_, 0x8000, 0x0030);
+        error = i2c_error(i2c_.write(i2c_addr_, Traits::status_register, 0x0030));
+        ready_seen_ = false;
         if (error == -1)
             return error;
-        if (sub_page == 0)
-        { 
-            error = i2c_.read(i2c_addr_, 0x0400, 32, frame_data_.data()); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0440, 32, frame_data_.data()+32); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0480, 32, frame_data_.data()+64); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x04C0, 32, frame_data_.data()+96); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0500, 32, frame_data_.data()+128); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0540, 32, frame_data_.data()+160); 
-            if (error != 0) return error;
+        for (uint8_t block = 0; block < Traits::ram_blocks; block++)
+        {
+            if (!((read_blocks_ >> block) & 1))
+            {
+                continue; // no ROI pixel
+            }
+            error = read_frame_block(sub_page, block);
+            if (error != 0)
+            {
+                return error;
+            }
         }
-        else
+        error = i2c_error(i2c_.read(i2c_addr_, Traits::status_register, 1, &status_register));
+        if (error != 0)
         {
-            error = i2c_.read(i2c_addr_, 0x0420, 32, frame_data_.data()); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0460, 32, frame_data_.data()+32); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x04A0, 32, frame_data_.data()+64); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x04E0, 32, frame_data_.data()+96); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0520, 32, frame_data_.data()+128); 
-            if (error != 0) return error;
-            error = i2c_.read(i2c_addr_, 0x0560, 32, frame_data_.data()+160); 
-            if (error != 0) return error;
+            return error;
         }
-        error = i2c_.read(i2c_addr_, 0x0580, 48, frame_data_.data()+192); 
-        if (error != 0) return error;
-        error = i2c_.read(i2c_addr_, 0x8000, 1, &status_register);
-        if (error != 0) return error;
         data_ready = status_register & 0x0008;
         sub_page = status_register & 0x0001;
+        if (data_ready != 0)
+            note_data_ready(); // the subpage just read was replaced, read the new one
         cnt = cnt + 1;
     }
     if (cnt > 4)
         return -8;
-    error = i2c_.read(i2c_addr_, 0x800D, 1, &control_register_1);
-    frame_data_[240] = control_register_1;
-    frame_data_[241] = status_register & 0x0001;
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
+    frame_data_[Traits::frame_control] = control_register_1;
+    frame_data_[Traits::frame_sub_page] = status_register & 0x0001;
     if (error != 0)
         return error;
-    return frame_data_[241];
+    return frame_data_[Traits::frame_sub_page];
+}
+
+// Numbers and timestamps a subpage the first time its data-ready flag is seen.
+template <typename Traits>
+void MLXSensor<Traits>::note_data_ready()
+{
+    ready_sequence_ = next_sequence_++;
+    ready_us_ = clock_ ? clock_->now_us() : 0;
+    ready_seen_ = true;
+}
+
+template <typename Traits>
+void MLXSensor<Traits>::complete_header()
+{
+    ambient_ = get_ta();
+    header_.sequence = ready_sequence_;
+    header_.timestamp_us = ready_us_;
+    header_.sub_page = static_cast<uint8_t>(frame_data_[Traits::frame_sub_page]);
+    header_.ta = ambient_;
+    header_.vdd = get_vdd();
+}
+
+template <typename Traits>
+int MLXSensor<Traits>::read_frame_block(uint8_t sub_page, uint8_t block)
+{
+    return i2c_error(i2c_.read(i2c_addr_, Traits::block_address(sub_page, block), Traits::block_words(block),
+                               frame_data_.data() + Traits::block_offset(block)));
 }
 
-int MLX90641Sensor::extract_parameters()
+template <typename Traits>
+int MLXSensor<Traits>::extract_parameters()
 {
     int error = check_eeprom_valid();
     bool extractions_successful = false;
     if(error == 0)
     {
-        if (logger_) {
-            char debug_msg[512];
-            snprintf(debug_msg, sizeof(debug_msg), 
-                "Raw EEPROM - [34]: 0x%04X, [52]: 0x%04X, [53]: 0x%04X, [54]: 0x%04X, [45]: 0x%04X, [256]: 0x%04X", 
-                ee_data_[34],   // KsTa
-                ee_data_[52],   // ksTo scale
-                ee_data_[53],   // ksTo[0]
-                ee_data_[54],   // ksTo[1]
-                ee_data_[45],   // cpAlpha
-                ee_data_[256]); // alpha[0]
-            log(Logger::Level::DEBUG, debug_msg);
-        }
-
-        extractions_successful = MLX90641EEpromParser(ee_data_).extract_all(calibration_parameters_);
-    
-        if (logger_) {
-            char debug_msg[256];
-            snprintf(debug_msg, sizeof(debug_msg), 
-                "Critical params - ksTo[1]: %.6f, tgc: %.6f, cpAlpha: %.6f, alpha[0]: %.6f", 
-                calibration_parameters_.ksTo[1],
-                calibration_parameters_.tgc,
-                calibration_parameters_.cpAlpha,
-                calibration_parameters_.alpha[0]);
-            log(Logger::Level::DEBUG, debug_msg);
-        }
+        extractions_successful =
+            typename SensorCalibration<Traits>::Parser(ee_data_).extract_all(calibration_parameters_);
+        log_calibration();
+        update_roi(); // the broken pixels are known now
+        LOG_INFO(logger_, "%u defective pixels, %u corrected", static_cast<unsigned>(defective_.count()),
+                 static_cast<unsigned>(correction_.size()));
     }
 
     const bool success = extractions_successful && (error == 0);
     return success ? 0 : -1;
 }
 
-int MLX90641Sensor::set_resolution(uint8_t resolution)
+template <>
+void MLXSensor<MLX90641Traits>::log_calibration() const
+{
+    LOG_DEBUG(logger_,
+        "Raw EEPROM - [34]: 0x%04X, [52]: 0x%04X, [53]: 0x%04X, [54]: 0x%04X, [45]: 0x%04X, [256]: 0x%04X", 
+        ee_data_[34],   // KsTa
+        ee_data_[52],   // ksTo scale
+        ee_data_[53],   // ksTo[0]
+        ee_data_[54],   // ksTo[1]
+        ee_data_[45],   // cpAlpha
+        ee_data_[256]); // alpha[0]
+    LOG_DEBUG(logger_,
+        "Critical params - ksTo[1]: %.6f, tgc: %.6f, cpAlpha: %.6f, alpha[0]: %.6f", 
+        calibration_parameters_.ksTo[1],
+        calibration_parameters_.tgc,
+        calibration_parameters_.cpAlpha,
+        calibration_parameters_.alpha[0]);
+}
+
+template <typename Traits>
+int MLXSensor<Traits>::set_resolution(uint8_t resolution)
 {
     uint16_t control_register_1;
     int value;
@@ -301,30 +561,31 @@ int MLX90641Sensor::set_resolution(uint8_t resolution)
     
     value = (resolution & 0x03) << 10;
     
-    error = i2c_.read(i2c_addr_, 0x800D, 1, &control_register_1);
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
     if (error != 0)
     {
-        log(Logger::Level::ERROR, "Failed to read control register for setting resolution");
+        LOG_ERROR(logger_, "Failed to read control register for setting resolution");
     } 
     if(error == 0)
     {
         value = (control_register_1 & 0xF3FF) | value;
-        error = i2c_.write(i2c_addr_, 0x800D, value);        
+        error = i2c_error(i2c_.write(i2c_addr_, Traits::control_register, value));        
     }    
     if (error != 0)
     {
-        log(Logger::Level::ERROR, "Failed to write control register for setting resolution");
+        LOG_ERROR(logger_, "Failed to write control register for setting resolution");
     }
     return error;
 }
 
-int MLX90641Sensor::get_cur_resolution() const
+template <typename Traits>
+int MLXSensor<Traits>::get_cur_resolution() const
 {
     uint16_t control_register_1;
     int resolution_ram;
     int error;
     
-    error = i2c_.read(i2c_addr_, 0x800D, 1, &control_register_1);
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
     if(error != 0)
     {
         return error;
@@ -334,7 +595,8 @@ int MLX90641Sensor::get_cur_resolution() const
     return resolution_ram; 
 }
 
-int MLX90641Sensor::set_refresh_rate(uint8_t refresh_rate)
+template <typename Traits>
+int MLXSensor<Traits>::set_refresh_rate(uint8_t refresh_rate)
 {
     uint16_t control_register_1;
     int value;
@@ -342,22 +604,23 @@ int MLX90641Sensor::set_refresh_rate(uint8_t refresh_rate)
     
     value = (refresh_rate & 0x07)<<7;
     
-    error = i2c_.read(i2c_addr_, 0x800D, 1, &control_register_1);
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
     if(error == 0)
     {
         value = (control_register_1 & 0xFC7F) | value;
-        error = i2c_.write(i2c_addr_, 0x800D, value);
+        error = i2c_error(i2c_.write(i2c_addr_, Traits::control_register, value));
     }    
     
     return error;
 }
 
-int MLX90641Sensor::get_refresh_rate() const
+template <typename Traits>
+int MLXSensor<Traits>::get_refresh_rate() const
 {
     uint16_t control_register_1;
     int refresh_rate;
     int error;
-    error = i2c_.read(i2c_addr_, 0x800D, 1, &control_register_1);
+    error = i2c_error(i2c_.read(i2c_addr_, Traits::control_register, 1, &control_register_1));
     if(error != 0)
     {
         return error;
@@ -367,7 +630,8 @@ int MLX90641Sensor::get_refresh_rate() const
     return refresh_rate;
 }
 
-void MLX90641Sensor::calculate_to(float emissivity, float tr)
+template <>
+void MLXSensor<MLX90641Traits>::calculate_to(float emissivity, float tr, Reducer* reducer)
 {
     float vdd;
     float ta;
@@ -384,7 +648,7 @@ void MLX90641Sensor::calculate_to(float emissivity, float tr)
     int8_t range;
     uint16_t sub_page;
     
-    sub_page = frame_data_[241];
+    sub_page = frame_data_[MLX90641Traits::frame_sub_page];
     vdd = get_vdd();
     ta = get_ta();
     ta4 = pow((ta + 273.15), (double)4);
@@ -401,7 +665,7 @@ void MLX90641Sensor::calculate_to(float emissivity, float tr)
     alpha_corr_r[7] = alpha_corr_r[6] * (1 + calibration_parameters_.ksTo[6] * (calibration_parameters_.ct[7] - calibration_parameters_.ct[6]));
 
     //------------------------- Gain calculation -----------------------------------
-    gain = frame_data_[202];
+    gain = frame_data_[MLX90641Traits::frame_gain];
     if(gain > 32767)
     {
         gain = gain - 65536;
@@ -410,7 +674,7 @@ void MLX90641Sensor::calculate_to(float emissivity, float tr)
     gain = calibration_parameters_.gainEE / gain;
 
 //------------------------- To calculation -------------------------------------        
-    ir_data_cp = frame_data_[200];  
+    ir_data_cp = frame_data_[MLX90641Traits::frame_cp(0)];  
     if(ir_data_cp > 32767)
     {
         ir_data_cp = ir_data_cp - 65536;
@@ -419,8 +683,12 @@ void MLX90641Sensor::calculate_to(float emissivity, float tr)
 
     ir_data_cp = ir_data_cp - calibration_parameters_.cpOffset * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
     
-    for( int pixel_number = 0; pixel_number < 192; pixel_number++)
+    for( int pixel_number = 0; pixel_number < static_cast<int>(num_pixels); pixel_number++)
     {      
+        if (!converted_.test(pixel_number))
+        {
+            continue;
+        }
         ir_data = frame_data_[pixel_number];
         if(ir_data > 32767)
         {
@@ -477,10 +745,15 @@ void MLX90641Sensor::calculate_to(float emissivity, float tr)
 
         to = sqrt(sqrt(ir_data / (alpha_compensated * alpha_corr_r[range] * (1 + calibration_parameters_.ksTo[range] * (to - calibration_parameters_.ct[range]))) + ta_tr)) - 273.15;
         temps_[pixel_number] = to;
+        if (reducer && roi_.test(pixel_number) && !is_broken_pixel(pixel_number))
+        {
+            reducer->accumulate(pixel_number, to);
+        }
     }
 }
 
-void MLX90641Sensor::get_image()
+template <>
+void MLXSensor<MLX90641Traits>::get_image()
 {
     float vdd;
     float ta;
@@ -491,13 +764,13 @@ void MLX90641Sensor::get_image()
     float image;
     uint16_t sub_page;
     
-    sub_page = frame_data_[241];
+    sub_page = frame_data_[MLX90641Traits::frame_sub_page];
     
     vdd = get_vdd();
     ta = get_ta();
     
 //------------------------- Gain calculation -----------------------------------    
-    gain = frame_data_[202];
+    gain = frame_data_[MLX90641Traits::frame_gain];
     if(gain > 32767)
     {
         gain = gain - 65536;
@@ -506,7 +779,7 @@ void MLX90641Sensor::get_image()
     gain = calibration_parameters_.gainEE / gain; 
   
 //------------------------- Image calculation -------------------------------------    
-    ir_data_cp = frame_data_[200];  
+    ir_data_cp = frame_data_[MLX90641Traits::frame_cp(0)];  
     if(ir_data_cp > 32767)
     {
         ir_data_cp = ir_data_cp - 65536;
@@ -515,8 +788,12 @@ void MLX90641Sensor::get_image()
 
     ir_data_cp = ir_data_cp - calibration_parameters_.cpOffset * (1 + calibration_parameters_.cpKta * (ta - 25)) * (1 + calibration_parameters_.cpKv * (vdd - 3.3));
     
-    for( int pixel_number = 0; pixel_number < 192; pixel_number++)
+    for( int pixel_number = 0; pixel_number < static_cast<int>(num_pixels); pixel_number++)
     {
+        if (!converted_.test(pixel_number))
+        {
+            continue;
+        }
         ir_data = frame_data_[pixel_number];
         if(ir_data > 32767)
         {
@@ -536,26 +813,28 @@ void MLX90641Sensor::get_image()
     }
 }
 
-float MLX90641Sensor::get_vdd() const
+template <typename Traits>
+float MLXSensor<Traits>::get_vdd() const
 {
     float vdd;
     float resolution_correction;
     
     int resolution_ram;    
     
-    vdd = frame_data_[234];
+    vdd = frame_data_[Traits::frame_vdd];
     if(vdd > 32767)
     {
         vdd = vdd - 65536;
     }
-    resolution_ram = (frame_data_[240] & 0x0C00) >> 10;
+    resolution_ram = (frame_data_[Traits::frame_control] & 0x0C00) >> 10;
     resolution_correction = pow(2, (double)calibration_parameters_.resolutionEE) / pow(2, (double)resolution_ram);
     vdd = (resolution_correction * vdd - calibration_parameters_.vdd25) / calibration_parameters_.kVdd + 3.3;
 
     return vdd;
 }
 
-float MLX90641Sensor::get_ta() const
+template <typename Traits>
+float MLXSensor<Traits>::get_ta() const
 {
     float ptat;
     float ptat_art;
@@ -564,13 +843,13 @@ float MLX90641Sensor::get_ta() const
     
     vdd = get_vdd();
     
-    ptat = frame_data_[224];
+    ptat = frame_data_[Traits::frame_ptat];
     if(ptat > 32767)
     {
         ptat = ptat - 65536;
     }
     
-    ptat_art = frame_data_[192];
+    ptat_art = frame_data_[Traits::frame_ptat_art];
     if(ptat_art > 32767)
     {
         ptat_art = ptat_art - 65536;
@@ -583,65 +862,24 @@ float MLX90641Sensor::get_ta() const
     return ta;
 }
 
-int MLX90641Sensor::get_sub_page_number() const
-{
-    return frame_data_[241];
-}
-
-void MLX90641Sensor::bad_pixels_correction()
+template <typename Traits>
+int MLXSensor<Traits>::get_sub_page_number() const
 {
-    float ap[2];
-    uint8_t pix;
-    uint8_t line;
-    uint8_t column;
-    
-    pix = 0;
-    while(calibration_parameters_.brokenPixels[pix]< 65535)
-    {
-        line = calibration_parameters_.brokenPixels[pix]>>5;
-        column = calibration_parameters_.brokenPixels[pix] - (line<<5);
-               
-        if(column == 0)
-        {
-            temps_[calibration_parameters_.brokenPixels[pix]] = temps_[calibration_parameters_.brokenPixels[pix]+1];            
-        }
-        else if(column == 1 || column == 14)
-        {
-            temps_[calibration_parameters_.brokenPixels[pix]] = (temps_[calibration_parameters_.brokenPixels[pix]-1]+temps_[calibration_parameters_.brokenPixels[pix]+1])/2.0;                
-        } 
-        else if(column == 15)
-        {
-            temps_[calibration_parameters_.brokenPixels[pix]] = temps_[calibration_parameters_.brokenPixels[pix]-1];
-        } 
-        else
-        {            
-            ap[0] = temps_[calibration_parameters_.brokenPixels[pix]+1] - temps_[calibration_parameters_.brokenPixels[pix]+2];
-            ap[1] = temps_[calibration_parameters_.brokenPixels[pix]-1] - temps_[calibration_parameters_.brokenPixels[pix]-2];
-            if(fabs(ap[0]) > fabs(ap[1]))
-            {
-                temps_[calibration_parameters_.brokenPixels[pix]] = temps_[calibration_parameters_.brokenPixels[pix]-1] + ap[1];                        
-            }
-            else
-            {
-                temps_[calibration_parameters_.brokenPixels[pix]] = temps_[calibration_parameters_.brokenPixels[pix]+1] + ap[0];                        
-            }
-                    
-        }                      
-     
-        pix = pix + 1;    
-    }    
+    return frame_data_[Traits::frame_sub_page];
 }
 
-float MLX90641Sensor::get_emissivity() const
+template <typename Traits>
+float MLXSensor<Traits>::get_emissivity() const
 {
     return calibration_parameters_.emissivityEE;
 }
 
-int MLX90641Sensor::check_eeprom_valid() const
+template <typename Traits>
+int MLXSensor<Traits>::check_eeprom_valid() const
 {
      int device_select;
      device_select = ee_data_[10] & 0x0040;
-     if(device_select != 0)
+     if((device_select != 0) == Traits::eeprom_device_select)
      {
          return 0;
      }
@@ -649,11 +887,7 @@ int MLX90641Sensor::check_eeprom_valid() const
      return -7;    
  }
 
-void MLX90641Sensor::log(Logger::Level level, const char* message)
-{
-    if (logger_) {
-        logger_->log(level, message);
-    }
-}
+template class MLXSensor<MLX90641Traits>;
+template class MLXSensor<MLX90640Traits>;
 
-} // namespace mlx90641
\ No newline at end of file
+} // namespace mlx90641
@@ -1,53 +1,250 @@
 #pragma once
 #include <array>
 #include <cstdint>
+#include "frame_header.hh"
 #include "i2c_adapter.hh"
-#include "mlx90641_params.hh"
+#include "i_clock.hh"
+#include "mlx90640_eeprom_parser.hh"
+#include "mlx90641_eeprom_parser.hh"
 #include "logger.hh"
+#include "pixel_correction.hh"
+#include "sensor_traits.hh"
+#include "seqlock.hh"
+#include "zone_reducer.hh"
 
 namespace mlx90641 {
-class MLX90641Sensor {
+
+/// @brief Calibration storage and EEPROM parser of each sensor model.
+template <typename Traits>
+struct SensorCalibration;
+
+template <>
+struct SensorCalibration<MLX90641Traits> {
+#ifdef MLX90641_COMPACT_CALIBRATION
+    // alpha, kta and kv kept in their EEPROM bit widths and decoded in the To loop: 1.5 KB less per sensor
+    using Params = CompactParamsMLX90641;
+#else
+    using Params = ParamsMLX90641;
+#endif
+    using Parser = MLX90641EEpromParser;
+};
+
+template <>
+struct SensorCalibration<MLX90640Traits> {
+    using Params = ParamsMLX90640;
+    using Parser = MLX90640EEpromParser;
+};
+
+/// @brief Driver for a Melexis thermopile array described by `Traits` (see sensor_traits.hh).
+///
+/// Bus access, frame reads, Ta/Vdd and the defective-pixel correction are shared; the To
+/// calculation is specialized per sensor below. Use MLX90641Sensor or MLX90640Sensor.
+template <typename Traits>
+class MLXSensor {
 public:
-    static constexpr size_t num_pixels = 192;
-    static constexpr size_t ee_data_size = 832;
-    static constexpr size_t frame_data_size = 834;
+    using SensorTraits = Traits;
+    using Calibration = typename SensorCalibration<Traits>::Params;
+    using Reducer = BasicZoneReducer<Traits>;
+    using PixelMask = BasicPixelMask<Traits>;
+    using Correction = BasicPixelCorrection<Traits>;
 
-    MLX90641Sensor(I2CAdapter& i2c_adapter, uint8_t i2c_addr = 0x33, Logger* logger_ptr = nullptr);
+    static constexpr size_t num_pixels = Traits::num_pixels;
+    static constexpr size_t ee_data_size = Traits::eeprom_words;
+    static constexpr size_t frame_data_size = Traits::frame_words;
+    static constexpr uint8_t default_refresh_rate = Traits::default_refresh_rate;
+    /// Default get_image_int16() scale: -40 .. 170 °C at Ta 25 °C map to about -4900 .. 30600.
+    static constexpr float image_int16_scale = 1e-6f;
+
+    /// @brief What calculate() converts a frame to.
+    enum class Output : uint8_t {
+        Temperature,  // object temperature, °C
+        Image,        // compensated IR signal, not °C
+    };
+
+    /// @brief One processed frame as published to other tasks, see set_publisher().
+    struct Snapshot {
+        FrameHeader header;
+        Output output;
+        std::array<float, num_pixels> temps;
+    };
+    using Publisher = Seqlock<Snapshot>;
+
+    /// @param clock Time base of the frame timestamps (FrameHeader::timestamp_us stays 0 without one).
+    MLXSensor(I2CAdapter& i2c_adapter, uint8_t i2c_addr = 0x33, Logger* logger_ptr = nullptr,
+              IClock* clock = nullptr);
 
     bool init();
+    /// @brief Waits for and reads the next subpage.
+    ///
+    /// A failed RAM block is retried on its own, within the I2CAdapter frame latency budget;
+    /// I2CAdapter::last_status() tells why a read failed.
     bool read_frame();
-    void calculate_temps();
-    std::array<float, num_pixels> get_temps() const;
+    /// @brief Converts the last frame to temperatures.
+    /// @param reducer Optional zone reducer, fed each pixel as it is converted so zone
+    /// results are final when this returns.
+    void calculate_temps(Reducer* reducer = nullptr);
+    /// @brief Converts the last frame to the compensated IR image: the pixel signal corrected for
+    /// gain, offset, Ta, Vdd and the compensation pixel and divided by the pixel sensitivity,
+    /// without the To conversion.
+    ///
+    /// It grows with the object temperature (pixel to pixel up to the ksTo sensitivity
+    /// correction, well under 1 °C), so hot spots, gradients and heat maps come out right at a
+    /// fraction of the calculate_temps() cost. The values are roughly
+    /// To⁴ − Ta⁴ in K⁴ rather than °C, so there is no zone reducer (its results are °C × 10).
+    /// Defective pixels are corrected as in calculate_temps().
+    void calculate_image();
+    /// @brief calculate_temps() or calculate_image(), chosen per frame; `reducer` is only fed
+    /// for temperatures.
+    void calculate(Output output, Reducer* reducer = nullptr);
+    /// @brief What get_temps() holds.
+    Output output() const { return output_; }
+    /// @brief The image from the last calculate_image() times `scale`, rounded and saturated to int16.
+    void get_image_int16(std::array<int16_t, num_pixels>& image, float scale = image_int16_scale) const;
+    /// @brief View of the temperatures from the last calculate_temps(), or the image from the last
+    /// calculate_image(), valid until the next one.
+    ///
+    /// On sensors whose subpages cover half of the pixels (MLX90640), the other half holds the
+    /// values of the previous subpage, in the previous output after a switch.
+    ///
+    /// Only for the task that runs calculate(); other tasks read a Snapshot from the publisher.
+    const std::array<float, num_pixels>& get_temps() const { return temps_; }
     float get_ambient() const;
+    /// @brief Metadata of the last frame read, which get_temps() holds after calculate_temps().
+    const FrameHeader& frame_header() const { return header_; }
+    /// @brief Publishes every frame calculate_temps() or calculate_image() processed to
+    /// `publisher` (nullptr: none), which readers in other tasks copy without ever blocking
+    /// the acquisition.
+    void set_publisher(Publisher* publisher) { publisher_ = publisher; }
+
+    /// @brief Restricts processing to the pixels set in `roi` (region of interest), e.g. the part of
+    /// the field of view the tire covers.
+    ///
+    /// Only ROI pixels are converted and fed to the reducer (zones without any report
+    /// Reducer::no_data), and RAM blocks holding no ROI pixel are not read. Pixels outside the ROI
+    /// read NaN from get_temps(), except the neighbours a defective ROI pixel is blended from,
+    /// which are converted for its correction. Can be called before init().
+    void set_roi(const PixelMask& roi);
+    /// @brief Processes the whole array again.
+    void clear_roi() { set_roi(PixelMask::all()); }
+    const PixelMask& roi() const { return roi_; }
+
+    /// @brief Treats `pixels` (e.g. found noisy at run time) as defective, in addition to the
+    /// broken and outlier pixels of the EEPROM: they are replaced by a blend of their
+    /// neighbours and left out of the zones. An empty mask clears them. Can be called before init().
+    void set_flagged_pixels(const PixelMask& pixels);
+    const PixelMask& flagged_pixels() const { return flagged_; }
+    /// @brief EEPROM and flagged defective pixels. Those inside the ROI that Correction has no
+    /// room or no good neighbour for read NaN.
+    const PixelMask& defective_pixels() const { return defective_; }
+    const Correction& correction() const { return correction_; }
+
+    /// @brief Non-blocking check of the "new data available" status bit.
+    /// @return 0 on success, I2C error otherwise.
+    int poll_data_ready(bool& ready);
+
+    /// @brief Switches between continuous (false) and step (true) measurement mode.
+    int set_step_mode(bool enable);
+
+    /// @brief Starts one measurement in step mode (and clears the data-ready flag).
+    int trigger_measurement();
+
+    /// @brief Incremental version of read_frame() for callers sharing the bus between sensors.
+    ///
+    /// Once poll_data_ready() reported new data, call read_frame_step() with steps
+    /// 0 .. frame_read_steps - 1; each step is one short bus transaction (clear the flag,
+    /// one RAM block, ...). The frame is complete after the last step returns 0.
+    /// @return 0 on success, I2C error, or -8 if the sensor wrote the next subpage during
+    /// the read (the new data is ready, restart at step 0).
+    static constexpr uint8_t frame_read_steps = Traits::ram_blocks + 1;
+    int read_frame_step(uint8_t step);
+
+    /// @brief Raw words of the last frame read (RAM blocks, control register, subpage), for
+    /// computing the temperatures on a host (see lib/host_offload).
+    const std::array<uint16_t, frame_data_size>& frame_words() const { return frame_data_; }
+    /// @brief Reads `count` EEPROM words from `first_word` as stored on the sensor (Hamming coded
+    /// on the MLX90641), in chunks so the caller needs no full-image buffer.
+    /// @return 0 on success, I2C error otherwise.
+    int read_eeprom(std::size_t first_word, std::size_t count, uint16_t* words);
+    /// @brief Host offload: calibrates from an EEPROM image read with read_eeprom() instead of
+    /// from the bus. Does not touch the sensor.
+    bool init_from_eeprom(const std::array<uint16_t, ee_data_size>& eeprom);
+    /// @brief Host offload: takes words from frame_words() on the device as the last frame read.
+    void load_frame(const std::array<uint16_t, frame_data_size>& words);
+
+    uint8_t address() const { return i2c_addr_; }
+    const I2CAdapter& bus() const { return i2c_; }
 
 private:
     int dump_ee();
     int hamming_decode();
     int get_frame_data();
+    void note_data_ready();
+    void complete_header();
+    int read_frame_block(uint8_t sub_page, uint8_t block);
+    void update_roi();
     int extract_parameters();
+    void log_calibration() const;
     int set_resolution(uint8_t resolution);
     int get_cur_resolution() const;
     int set_refresh_rate(uint8_t refresh_rate);
     int get_refresh_rate() const;
-    void calculate_to(float emissivity, float tr);
+    void calculate_to(float emissivity, float tr, Reducer* reducer);
     void get_image();
+    void publish();
     float get_vdd() const;
     float get_ta() const;
     int get_sub_page_number() const;
-    void bad_pixels_correction();
+    void bad_pixels_correction() { correction_.apply(temps_); }
+    bool is_broken_pixel(int pixel_number) const { return defective_.test(pixel_number); }
     float get_emissivity() const;
-    int extract_deviating_pixels();
     int check_eeprom_valid() const;
-    void log(Logger::Level level, const char* message);
 
     I2CAdapter& i2c_;
     uint8_t i2c_addr_;
-    std::array<uint16_t, ee_data_size> ee_data_;
-    std::array<uint16_t, frame_data_size> frame_data_;
+    // The EEPROM dump is only needed until init() has extracted the calibration parameters
+    // and no frame is read before that, so both share one buffer.
+    union {
+        std::array<uint16_t, ee_data_size> ee_data_;
+        std::array<uint16_t, frame_data_size> frame_data_;
+    };
     std::array<float, num_pixels> temps_;
-    ParamsMLX90641 calibration_parameters_;
+    Output output_;
+    PixelMask roi_;
+    PixelMask converted_;  // good roi_ pixels and the neighbours bad_pixels_correction() reads
+    PixelMask flagged_;
+    PixelMask defective_;
+    Correction correction_;
+    uint32_t read_blocks_; // bit per RAM block holding converted pixels or auxiliary data
+    Calibration calibration_parameters_;
     float ambient_;
-    Logger* logger_; 
+    uint8_t sub_page_; // subpage reported by the last status poll
+    Logger* logger_;
+    IClock* clock_;
+    Publisher* publisher_;
+    FrameHeader header_;
+    uint32_t next_sequence_;
+    uint32_t ready_sequence_;  // number and data-ready time of the subpage being read
+    uint32_t ready_us_;
+    bool ready_seen_;          // the pending data-ready flag was already numbered
 
 };
-} // namespace mlx90641
\ No newline at end of file
+
+// Sensor-specific parts, defined in mlx90641_driver.cc and mlx90640_driver.cc.
+template <>
+void MLXSensor<MLX90641Traits>::log_calibration() const;
+template <>
+void MLXSensor<MLX90641Traits>::calculate_to(float emissivity, float tr, Reducer* reducer);
+template <>
+void MLXSensor<MLX90641Traits>::get_image();
+
+template <>
+void MLXSensor<MLX90640Traits>::log_calibration() const;
+template <>
+void MLXSensor<MLX90640Traits>::calculate_to(float emissivity, float tr, Reducer* reducer);
+template <>
+void MLXSensor<MLX90640Traits>::get_image();
+
+using MLX90641Sensor = MLXSensor<MLX90641Traits>;
+using MLX90640Sensor = MLXSensor<MLX90640Traits>;
+
+} // namespace mlx90641
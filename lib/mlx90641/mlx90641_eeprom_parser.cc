@@ -4,7 +4,8 @@
 
 namespace mlx90641 {
 
-bool MLX90641EEpromParser::extract_all(ParamsMLX90641& params) const
+template <typename Params>
+void MLX90641EEpromParser::extract_common(Params& params) const
 {
     params.kVdd = get_kvdd();
     params.vdd25 = get_vdd25();
@@ -19,19 +20,29 @@ bool MLX90641EEpromParser::extract_all(ParamsMLX90641& params) const
     params.KsTa = get_ks_ta();
     params.ksTo = get_ks_to();
     params.ct = get_ct();
-    params.alpha = get_alpha();
     params.offset = get_offset();
-    params.kta = get_kta();
-    params.kv = get_kv();
     params.cpAlpha = get_cp_alpha();
     params.cpOffset = get_cp_offset();
-    params.ct = get_ct();
     params.cpKv = get_cp_kv();
     params.cpKta = get_cp_kta();
     params.brokenPixels = get_broken_pixels();
-    if (params.brokenPixels[0] != 0xFFFF  || params.brokenPixels[1] != 0xFFFF) {
-        return false; // too many broken pixels
-    }
+}
+
+bool MLX90641EEpromParser::extract_all(ParamsMLX90641& params) const
+{
+    extract_common(params);
+    params.alpha = get_alpha();
+    params.kta = get_kta();
+    params.kv = get_kv();
+    return true;
+}
+
+bool MLX90641EEpromParser::extract_all(CompactParamsMLX90641& params) const
+{
+    extract_common(params);
+    params.alpha = get_compact_alpha();
+    params.kta = get_compact_kta();
+    params.kv = get_compact_kv();
     return true;
 }
 
@@ -153,6 +164,16 @@ std::array<float, 8> MLX90641EEpromParser::get_ks_to() const
 }
 
 std::array<float, 192> MLX90641EEpromParser::get_alpha() const
+{
+    const CompactAlpha compact = get_compact_alpha();
+    std::array<float, 192> alpha;
+    for (std::size_t p = 0; p < alpha.size(); ++p) {
+        alpha[p] = compact[p];
+    }
+    return alpha;
+}
+
+CompactAlpha MLX90641EEpromParser::get_compact_alpha() const
 {
     // note: the datasheet shows that the values for alpha_scale_row altern from 
     // a bit-width of 5 and 6, but in the melexis library we see that
@@ -167,8 +188,8 @@ std::array<float, 192> MLX90641EEpromParser::get_alpha() const
     SingleEepromWord{EepromAddr::alpha_scale2, 0, 5, 0, false}    // (eeData[27] & 0x001F) + 20
 };
 
-    std::array<float, 192> alpha;   
-    std::array<float, 6> row_max_alpha_norm;
+    CompactAlpha alpha;
+    std::array<float, 6>& row_max_alpha_norm = alpha.row_scale;
     std::array<std::uint8_t, 6> scale_row_alpha_values;
 
     // Extract scaling factors for each row
@@ -192,12 +213,9 @@ std::array<float, 192> MLX90641EEpromParser::get_alpha() const
         row_max_alpha_norm[i] = row_max_alpha_norm[i] / 2047.0f; // Why 2047? Couldn't find in datasheet
     }
 
-    // Calculate alpha for each pixel
-    for (uint8_t i = 0; i < 6; ++i) {
-        for (uint8_t j = 0; j < 32; ++j) {
-            const uint16_t p = 32 * i + j;
-            alpha[p] = static_cast<float>(eeprom_data_[256 + p]) * row_max_alpha_norm[i];
-        }
+    // Raw 11-bit alpha for each pixel, scaled by its row when decoded
+    for (uint16_t p = 0; p < alpha.raw.size(); ++p) {
+        alpha.raw[p] = eeprom_data_[256 + p];
     }
 
     return alpha;
@@ -221,67 +239,72 @@ std::array<std::int16_t, 8> MLX90641EEpromParser::get_ct() const
 
 std::array<float, 192> MLX90641EEpromParser::get_kta() const
 {
-    constexpr SingleEepromWord kta_avg{EepromAddr::kta_avg, 0, 11, 0, true};
-    constexpr std::array<SingleEepromWord, 2> kta_scale_words = {
-        SingleEepromWord{EepromAddr::kta_scale, 5, 5, 0, false}, 
-        SingleEepromWord{EepromAddr::kta_scale, 0, 5, 0, false}  
-    };
+    const CompactCoefficient compact = get_compact_kta();
     std::array<float, 192> kta;
-    
-    // Extract KTA average
-    int16_t kta_avg_value = static_cast<int16_t>(extract_param(kta_avg));
-    
-    // Extract scale factors
-    uint8_t kta_scale1_value = static_cast<uint8_t>(extract_param(kta_scale_words[0U]));
-    uint8_t kta_scale2_value = static_cast<uint8_t>(extract_param(kta_scale_words[1U]));
+    for (std::size_t i = 0; i < kta.size(); ++i) {
+        kta[i] = compact[i];
+    }
+    return kta;
+}
+
+CompactCoefficient MLX90641EEpromParser::get_compact_kta() const
+{
+    CompactCoefficient kta = get_coefficient_scales(EepromAddr::kta_avg, EepromAddr::kta_scale);
 
     // Extract KTA for each pixel
-    for (uint16_t i = 0U; i < kta.size(); ++i) {
+    for (uint16_t i = 0U; i < kta.raw.size(); ++i) {
         const std::uint16_t address = EepromAddr::kta_pixel + i;
-        const SingleEepromWord word = {address, 5, 6, kta_scale2_value, true};
-        const auto temp_kta = extract_param(word);
-        // Keeping original code from Melexis library because using the 
-        // scaling functions caused issues with truncation and overflow.
-        kta[i] = temp_kta * static_cast<float>(1ULL << kta_scale2_value);
-        kta[i] = kta[i] + kta_avg_value;
-        kta[i] = kta[i] / static_cast<float>(1ULL << kta_scale1_value);
+        const SingleEepromWord word = {address, 5, 6, 0, true};
+        kta.raw[i] = static_cast<std::int8_t>(extract_param(word));
     }
-    
     return kta;
 }
 
 std::array<float, 192> MLX90641EEpromParser::get_kv() const
 {
-    constexpr SingleEepromWord kv_avg{EepromAddr::kv_avg, 0, 11, 0, true};
-    constexpr std::array<SingleEepromWord, 2> kv_scale_words = {
-        SingleEepromWord{EepromAddr::kv_scale, 5, 5, 0, false}, 
-        SingleEepromWord{EepromAddr::kv_scale, 0, 5, 0, false}  
-    };
+    const CompactCoefficient compact = get_compact_kv();
     std::array<float, 192> kv;
+    for (std::size_t i = 0; i < kv.size(); ++i) {
+        kv[i] = compact[i];
+    }
+    return kv;
+}
 
-    // Extract KV average
-    int16_t kv_avg_value = static_cast<int16_t>(extract_param(kv_avg));
-    
-    // Extract scale factors
-    uint8_t kv_scale1_value = static_cast<uint8_t>(extract_param(kv_scale_words[0U]));
-    uint8_t kv_scale2_value = static_cast<uint8_t>(extract_param(kv_scale_words[1U]));
+CompactCoefficient MLX90641EEpromParser::get_compact_kv() const
+{
+    CompactCoefficient kv = get_coefficient_scales(EepromAddr::kv_avg, EepromAddr::kv_scale);
 
-    // Extract KV for each pixel
-    for (uint16_t i = 0U; i < kv.size(); ++i) {
-        // Extract tempKv from eeData[448 + i] & 0x001F
+    // Extract KV for each pixel, eeData[448 + i] & 0x001F
+    for (uint16_t i = 0U; i < kv.raw.size(); ++i) {
         const std::uint16_t address = EepromAddr::kv_pixel + i;
-        const SingleEepromWord word = {address, 0, 5, kv_scale2_value, true};
-        const auto temp_kv = extract_param(word);
-        // Keeping original code from Melexis library because using the 
-        // scaling functions caused issues with truncation and overflow.
-        kv[i] = static_cast<float>(temp_kv) * static_cast<float>(1ULL << kv_scale2_value);
-        kv[i] = kv[i] + static_cast<float>(kv_avg_value);
-        kv[i] = kv[i] / static_cast<float>(1ULL << kv_scale1_value);
+        const SingleEepromWord word = {address, 0, 5, 0, true};
+        kv.raw[i] = static_cast<std::int8_t>(extract_param(word));
     }
-    
     return kv;
 }
 
+CompactCoefficient MLX90641EEpromParser::get_coefficient_scales(std::uint16_t average_address,
+                                                                std::uint16_t scale_address) const
+{
+    const SingleEepromWord average{average_address, 0, 11, 0, true};
+    const std::array<SingleEepromWord, 2> scale_words = {{
+        SingleEepromWord{scale_address, 5, 5, 0, false}, 
+        SingleEepromWord{scale_address, 0, 5, 0, false}  
+    }};
+    const int16_t average_value = static_cast<int16_t>(extract_param(average));
+    const uint8_t scale1_value = static_cast<uint8_t>(extract_param(scale_words[0U]));
+    const uint8_t scale2_value = static_cast<uint8_t>(extract_param(scale_words[1U]));
+
+    // Keeping the float operations of the original Melexis library because using the
+    // scaling functions caused issues with truncation and overflow:
+    // value = (raw * 2^scale2 + average) / 2^scale1
+    CompactCoefficient coefficient;
+    coefficient.multiplier = static_cast<float>(1ULL << scale2_value);
+    coefficient.average = static_cast<float>(average_value);
+    coefficient.divisor = static_cast<float>(1ULL << scale1_value);
+    return coefficient;
+}
+
 float MLX90641EEpromParser::get_cp_kta() const
 {
     constexpr SingleEepromWord cp_kta{EepromAddr::cp_kta, 0, 6, 0, true};
@@ -355,14 +378,12 @@ std::array<std::array<std::int16_t, 192>, 2> MLX90641EEpromParser::get_offset()
     return offset;
 }
 
-std::array<std::uint16_t, 2> MLX90641EEpromParser::get_broken_pixels() const
+std::bitset<192> MLX90641EEpromParser::get_broken_pixels() const
 {
     constexpr std::size_t pixel_count = 192u; // total number of pixels
-    std::array<std::uint16_t, 2> broken_pixels;
-    std::fill(broken_pixels.begin(), broken_pixels.end(), 0xFFFF);
+    std::bitset<192> broken_pixels;
 
-    std::size_t num_broken_pixels = 0u;
-    for (std::size_t i = 0u; i < pixel_count && num_broken_pixels < 3; ++i) 
+    for (std::size_t i = 0u; i < pixel_count; ++i) 
     {
         const uint16_t address1 = EepromAddr::offset_even + i;
         const SingleEepromWord word1 = {address1, 0, 11, 0, false};
@@ -375,8 +396,7 @@ std::array<std::uint16_t, 2> MLX90641EEpromParser::get_broken_pixels() const
         if (extract_param(word1) == 0 && extract_param(word2) == 0 &&
             extract_param(word3) == 0 && extract_param(word4) == 0) 
         {
-        broken_pixels[num_broken_pixels] = i;
-        num_broken_pixels++; 
+        broken_pixels[i] = true;
         }
     }
     
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <bitset>
 #include <cstdint>
 #include "mlx90641_eeprom_addr.hh"
 #include "mlx90641_params.hh"
@@ -62,6 +63,9 @@ public:
     /// @brief Extracts all parameters and fills the provided ParamsMLX90641 structure.
     bool extract_all(ParamsMLX90641& params) const;
 
+    /// @brief Same, keeping alpha, kta and kv in their compact EEPROM-width form.
+    bool extract_all(CompactParamsMLX90641& params) const;
+
     /// @brief Returns the KVdd calibration coefficient (units: LSB/V).
     ///  
     /// KVdd is a temperature coefficient used to compensate for supply-voltage dependence.
@@ -143,6 +147,11 @@ public:
     /// It is stored per pixel in EEPROM and adjusted by row-scaling, normalization, etc.  
     std::array<float, 192> get_alpha() const;
 
+    /// @brief Returns α as the raw 11-bit pixel values and the six row scales.
+    ///
+    /// get_alpha() is this decoded for every pixel.
+    CompactAlpha get_compact_alpha() const;
+
     /// @brief Returns CT (corner temperature) calibration values (8 entries).
     ///  
     /// The CT array holds fixed corner temperatures used in piecewise linear models for pixel correction.  
@@ -154,12 +163,18 @@ public:
     /// Stored in EEPROM (signed), scaled by two stage scales (KTA_scale1 & scale2).  
     std::array<float, 192> get_kta() const;
 
+    /// @brief Returns KTA as the signed 6-bit pixel values with average and scales.
+    CompactCoefficient get_compact_kta() const;
+
     /// @brief Returns KV coefficients for each pixel (192 entries).
     ///  
     /// KV is the temperature coefficient per pixel (how much the sensitivity changes per ambient °C).  
     /// Stored (signed) per pixel in EEPROM and adjusted via scaling factors.  
     std::array<float, 192> get_kv() const;
 
+    /// @brief Returns KV as the signed 5-bit pixel values with average and scales.
+    CompactCoefficient get_compact_kv() const;
+
     /// @brief Returns CP_KTA, the compensation KTA coefficient.
     float get_cp_kta() const;
 
@@ -177,13 +192,20 @@ public:
     /// Provides the per-pixel offset (baseline reading) for subpage 0 and 1 corrections.  
     std::array<std::array<std::int16_t, 192>, 2> get_offset() const;
 
-    /// @brief Returns indices of broken pixels (max 2) that should be masked/ignored.
+    /// @brief Returns the broken pixels, which the driver corrects from their neighbours.
     ///  
     /// Pixels are considered “broken” if all EEPROM offset values at their positions (across subpages) are zero.  
-    std::array<std::uint16_t, 2> get_broken_pixels() const; 
+    std::bitset<192> get_broken_pixels() const; 
 
 
 private: 
+    /// @brief Fills everything but alpha, kta and kv, which depend on the storage form.
+    template <typename Params>
+    void extract_common(Params& params) const;
+
+    /// @brief Reads the shared average and scales of KTA or KV, the per-pixel values are left unset.
+    CompactCoefficient get_coefficient_scales(std::uint16_t average_address, std::uint16_t scale_address) const;
+
     /// @brief Utility function to extract a raw bitfield from a single EEPROM word.
     /// 
     /// This masks and shifts the EEPROM word according to the bit width and start bit.
@@ -232,7 +254,8 @@ private:
     /// @note The combined bit width must not exceed 32 bits.
     int32_t extract_param_array(const DualEepromWord& words) const;
 
-    std::array<uint16_t, eeprom_size> eeprom_data_;
+    // Referenced, not copied: the parser only lives while the EEPROM dump is valid.
+    const std::array<uint16_t, eeprom_size>& eeprom_data_;
 };
 
 } // namespace mlx90641_eeprom
\ No newline at end of file
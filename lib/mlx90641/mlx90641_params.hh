@@ -2,11 +2,44 @@
 
 #include <cstdint>
 #include <array>
+#include <bitset>
 
 namespace mlx90641 {
 
+/// @brief Per-pixel alpha kept as the 11-bit EEPROM value and one scale per row of 32 pixels.
+///
+/// operator[] performs the same float operations as MLX90641EEpromParser::get_alpha(), so the
+/// decoded values are bit-identical to the expanded std::array<float, 192>.
+struct CompactAlpha {
+    std::array<std::uint16_t, 192> raw;
+    std::array<float, 6> row_scale;
+
+    float operator[](std::size_t pixel) const
+    {
+        return static_cast<float>(raw[pixel]) * row_scale[pixel / 32];
+    }
+};
+
+/// @brief Per-pixel kta (6-bit) or kv (5-bit) kept as the signed EEPROM value with the shared
+/// average and the two power-of-two scales; decoded like get_kta() / get_kv().
+struct CompactCoefficient {
+    std::array<std::int8_t, 192> raw;
+    float multiplier;   // 2^scale2
+    float average;
+    float divisor;      // 2^scale1
+
+    float operator[](std::size_t pixel) const
+    {
+        return (static_cast<float>(raw[pixel]) * multiplier + average) / divisor;
+    }
+};
+
 /// @brief Struct containing all calibration parameters for the MLX90641 sensor
-struct ParamsMLX90641{
+///
+/// The per-pixel alpha, kta and kv storage is a parameter: expanded float arrays (fastest To
+/// loop, 2.3 KB) or the compact EEPROM-width forms above (0.8 KB), both indexed the same way.
+template <typename Alpha = std::array<float, 192>, typename Coefficient = std::array<float, 192>>
+struct BasicParamsMLX90641{
         std::int16_t kVdd;
         std::int16_t vdd25;
         float KvPTAT;
@@ -22,14 +55,17 @@ struct ParamsMLX90641{
         float KsTa;
         std::array<float, 8> ksTo;
         std::array<std::int16_t, 8> ct;
-        std::array<float, 192> alpha;    
-        std::array<std::array<std::int16_t, 192>, 2> offset;    
-        std::array<float, 192> kta;    
-        std::array<float, 192> kv;
+        Alpha alpha;
+        std::array<std::array<std::int16_t, 192>, 2> offset;
+        Coefficient kta;
+        Coefficient kv;
         float cpAlpha;
         std::int16_t cpOffset;
-        float emissivityEE; 
-        std::array<std::uint16_t, 2> brokenPixels;
-    }; 
+        float emissivityEE;
+        std::bitset<192> brokenPixels;  // set per pixel whose calibration words are all 0
+    };
+
+using ParamsMLX90641 = BasicParamsMLX90641<>;
+using CompactParamsMLX90641 = BasicParamsMLX90641<CompactAlpha, CompactCoefficient>;
 
-} // namespace mlx90641
\ No newline at end of file
+} // namespace mlx90641
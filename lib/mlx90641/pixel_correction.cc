@@ -0,0 +1,81 @@
+#include "pixel_correction.hh"
+
+namespace {
+
+struct Tap {
+    int8_t row;
+    int8_t column;
+    float weight;
+};
+
+// Candidates in order of preference; the last group is only used if none of the others is good.
+constexpr Tap near_taps[] = {
+    {0, -1, 1.0f}, {0, 1, 1.0f}, {-1, 0, 1.0f}, {1, 0, 1.0f},
+    {-1, -1, 0.70710678f}, {-1, 1, 0.70710678f}, {1, -1, 0.70710678f}, {1, 1, 0.70710678f},
+};
+constexpr Tap far_taps[] = {
+    {0, -2, 0.5f}, {0, 2, 0.5f}, {-2, 0, 0.5f}, {2, 0, 0.5f},
+};
+
+} // namespace
+
+template <typename Traits>
+void BasicPixelCorrection<Traits>::build(const PixelMask& defective, const PixelMask& roi)
+{
+    size_ = 0;
+    sources_ = PixelMask();
+    uncorrected_ = PixelMask();
+    for (std::size_t pixel = 0; pixel < num_pixels; ++pixel) {
+        if (defective.test(pixel) && roi.test(pixel) && (size_ == max_pixels || !add(pixel, defective))) {
+            uncorrected_.set(pixel);
+        }
+    }
+}
+
+template <typename Traits>
+bool BasicPixelCorrection<Traits>::add(std::size_t pixel, const PixelMask& defective)
+{
+    Entry& entry = entries_[size_];
+    entry.target = static_cast<uint16_t>(pixel);
+    entry.taps = 0;
+    const int row = static_cast<int>(pixel / Traits::num_columns);
+    const int column = static_cast<int>(pixel % Traits::num_columns);
+    float total = 0.0f;
+    for (int group = 0; group < 2 && entry.taps == 0; ++group) {
+        const Tap* first = group == 0 ? near_taps : far_taps;
+        const Tap* last = group == 0 ? near_taps + 8 : far_taps + 4;
+        for (const Tap* tap = first; tap != last && entry.taps < max_taps; ++tap) {
+            const int r = row + tap->row;
+            const int c = column + tap->column;
+            if (r < 0 || r >= static_cast<int>(Traits::num_rows) || c < 0 || c >= static_cast<int>(Traits::num_columns)) {
+                continue;
+            }
+            const std::size_t neighbour = static_cast<std::size_t>(r) * Traits::num_columns + c;
+            if (defective.test(neighbour)) {
+                continue;
+            }
+            entry.neighbours[entry.taps] = static_cast<uint16_t>(neighbour);
+            entry.weights[entry.taps] = tap->weight;
+            total += tap->weight;
+            entry.taps++;
+        }
+    }
+    if (entry.taps == 0) {
+        return false;
+    }
+    for (std::size_t tap = 0; tap < max_taps; ++tap) {
+        if (tap < entry.taps) {
+            entry.weights[tap] /= total;
+            sources_.set(entry.neighbours[tap]);
+        } else {
+            // Padding reads a pixel the blend already uses, so a fixed loop adds exactly 0.
+            entry.neighbours[tap] = entry.neighbours[0];
+            entry.weights[tap] = 0.0f;
+        }
+    }
+    size_++;
+    return true;
+}
+
+template class BasicPixelCorrection<MLX90641Traits>;
+template class BasicPixelCorrection<MLX90640Traits>;
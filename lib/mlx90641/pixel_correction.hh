@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "sensor_traits.hh"
+#include "zone_reducer.hh"
+
+#ifndef MLX_MAX_CORRECTED_PIXELS
+// Defective pixels corrected per sensor, 28 bytes each; the ones beyond read NaN.
+#define MLX_MAX_CORRECTED_PIXELS 16
+#endif
+
+/// @brief Defective-pixel correction compiled into a table: each defective pixel is replaced
+/// by a weighted blend of up to four good neighbours.
+///
+/// build() chooses the neighbours once (at init, when the ROI or the flagged pixels change):
+/// the good pixels left, right, above and below (weight 1), then the good diagonals (weight
+/// 1/√2) up to four, or if the whole 3x3 neighbourhood is defective the good pixels two
+/// away in line (weight 1/2). Weights are normalized. Neighbours are never defective
+/// themselves, so clusters and adjacent defects are corrected in any order, and apply() is a
+/// fixed gather-and-blend per pixel with no per-frame geometry.
+template <typename Traits>
+class BasicPixelCorrection {
+public:
+    using PixelMask = BasicPixelMask<Traits>;
+    static constexpr std::size_t num_pixels = Traits::num_pixels;
+    static constexpr std::size_t max_pixels = MLX_MAX_CORRECTED_PIXELS;
+    static constexpr std::size_t max_taps = 4;
+
+    struct Entry {
+        uint16_t target;
+        uint8_t taps;                                // neighbours used, the rest have weight 0
+        std::array<uint16_t, max_taps> neighbours;
+        std::array<float, max_taps> weights;         // sum to 1
+    };
+
+    BasicPixelCorrection() : size_(0) {}
+
+    /// @brief Compiles the correction of the `defective` pixels inside `roi`.
+    void build(const PixelMask& defective, const PixelMask& roi);
+
+    /// @brief Replaces the value of each corrected pixel by the blend of its neighbours.
+    void apply(std::array<float, num_pixels>& values) const
+    {
+        for (std::size_t i = 0; i < size_; ++i) {
+            const Entry& entry = entries_[i];
+            float value = 0.0f;
+            for (std::size_t tap = 0; tap < max_taps; ++tap) {
+                value += entry.weights[tap] * values[entry.neighbours[tap]];
+            }
+            values[entry.target] = value;
+        }
+    }
+
+    std::size_t size() const { return size_; }
+    const Entry& entry(std::size_t i) const { return entries_[i]; }
+    /// @brief Pixels apply() reads.
+    const PixelMask& sources() const { return sources_; }
+    /// @brief Defective ROI pixels without a table entry: beyond max_pixels or no good neighbour.
+    const PixelMask& uncorrected() const { return uncorrected_; }
+
+private:
+    bool add(std::size_t pixel, const PixelMask& defective);
+
+    std::array<Entry, max_pixels> entries_;
+    std::size_t size_;
+    PixelMask sources_;
+    PixelMask uncorrected_;
+};
@@ -0,0 +1,99 @@
+#include "acquisition_scheduler.hh"
+
+namespace {
+// Signed distance from `from` to `to`, correct across the 32-bit wrap of the clock.
+int32_t elapsed(uint32_t from, uint32_t to)
+{
+    return static_cast<int32_t>(to - from);
+}
+} // namespace
+
+AcquisitionScheduler::AcquisitionScheduler(IClock& clock, uint32_t period_us, uint32_t guard_us, Mode mode)
+    : clock_(clock), period_us_(period_us), guard_us_(guard_us < period_us ? guard_us : period_us / 2), mode_(mode),
+      started_(false), start_us_(0), anchor_us_(0), active_start_us_(0), last_active_us_(0), last_done_us_(0), total_active_us_(0),
+      frames_(0), missed_frames_(0)
+{
+}
+
+uint32_t AcquisitionScheduler::subpage_period_us(uint8_t refresh_rate)
+{
+    // Refresh rate code n selects 2^n / 2 Hz
+    return 2000000ul >> (refresh_rate & 0x07);
+}
+
+uint32_t AcquisitionScheduler::wait_for_next_frame()
+{
+    const uint32_t now = clock_.now_us();
+    if (!started_) {
+        // First frame: nothing to align to yet, serve whatever arrives next.
+        started_ = true;
+        start_us_ = now;
+        anchor_us_ = now;
+        active_start_us_ = now;
+        return 0;
+    }
+
+    // Slot k is due at anchor + k * period and its data stays valid until slot k + 1 overwrites it.
+    uint32_t slot = 1;
+    while (elapsed(now, anchor_us_ + (slot + 1) * period_us_) <= 0) {
+        slot++;
+    }
+    const uint32_t missed = slot - 1;
+    missed_frames_ += missed;
+    anchor_us_ += slot * period_us_;
+
+    const uint32_t wake_us = (mode_ == Mode::Step) ? anchor_us_ : anchor_us_ - guard_us_;
+    if (elapsed(now, wake_us) > 0) {
+        clock_.sleep_until_us(wake_us);
+    }
+    active_start_us_ = clock_.now_us();
+    return missed;
+}
+
+void AcquisitionScheduler::wait_for_conversion(uint32_t conversion_us)
+{
+    // Conversion time is spent asleep, it does not count as active time.
+    const uint32_t sleep_start = clock_.now_us();
+    total_active_us_ += static_cast<uint32_t>(elapsed(active_start_us_, sleep_start));
+    clock_.sleep_until_us(sleep_start + conversion_us);
+    active_start_us_ = clock_.now_us();
+}
+
+void AcquisitionScheduler::data_ready_at(uint32_t time_us)
+{
+    if (mode_ == Mode::Continuous) {
+        anchor_us_ = time_us;
+    }
+}
+
+void AcquisitionScheduler::frame_done()
+{
+    const uint32_t now = clock_.now_us();
+    const uint32_t active = static_cast<uint32_t>(elapsed(active_start_us_, now));
+    total_active_us_ += active;
+    last_active_us_ = active;
+    last_done_us_ = now;
+    frames_++;
+}
+
+uint32_t AcquisitionScheduler::average_active_us() const
+{
+    if (frames_ == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(total_active_us_ / frames_);
+}
+
+float AcquisitionScheduler::duty_cycle() const
+{
+    if (frames_ == 0) {
+        return 0.0f;
+    }
+    // Measured up to the end of the last frame so sleep before the next one is not counted yet.
+    const uint32_t span = static_cast<uint32_t>(elapsed(start_us_, last_done_us_));
+    if (span == 0) {
+        return 1.0f;
+    }
+    const float duty = static_cast<float>(total_active_us_) / static_cast<float>(span);
+    return duty > 1.0f ? 1.0f : duty;
+}
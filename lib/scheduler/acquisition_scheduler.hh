@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include "i_clock.hh"
+
+/// @brief Duty-cycled acquisition timing for the MLX90641.
+///
+/// The scheduler keeps a grid of expected data-ready instants, one per subpage, and sleeps
+/// between them so the MCU only wakes shortly (guard time) before new data is available.
+/// In continuous mode the grid is phase-locked to the sensor by reporting when the status
+/// poll first saw new data (data_ready_at). In step mode the grid is the scheduler's own:
+/// each slot is where the caller triggers a measurement, which allows rates below the
+/// sensor's slowest continuous refresh rate.
+///
+/// All timing goes through IClock so the logic can run against a virtual clock.
+class AcquisitionScheduler {
+public:
+    enum class Mode {
+        Continuous,
+        Step,
+    };
+
+    /// @param period_us Time between frames (one subpage in continuous mode).
+    /// @param guard_us How long before the expected data-ready to wake up.
+    AcquisitionScheduler(IClock& clock, uint32_t period_us, uint32_t guard_us = 1000, Mode mode = Mode::Continuous);
+
+    /// @brief Subpage period for an MLX90641 refresh rate code (0 = 0.5 Hz ... 7 = 64 Hz).
+    static uint32_t subpage_period_us(uint8_t refresh_rate);
+
+    /// @brief Sleeps until the next frame is due and starts the active window.
+    /// @return Number of frames that became available and were overwritten before being served.
+    uint32_t wait_for_next_frame();
+
+    /// @brief Step mode only: sleeps for `conversion_us` after the measurement was triggered.
+    void wait_for_conversion(uint32_t conversion_us);
+
+    /// @brief Continuous mode: reports the time at which the status poll first saw new data.
+    void data_ready_at(uint32_t time_us);
+
+    /// @brief Ends the active window opened by wait_for_next_frame.
+    void frame_done();
+
+    uint32_t period_us() const { return period_us_; }
+    Mode mode() const { return mode_; }
+    uint32_t frames() const { return frames_; }
+    uint32_t missed_frames() const { return missed_frames_; }
+    uint32_t last_active_us() const { return last_active_us_; }
+
+    /// @brief Mean active (awake) time per frame in microseconds.
+    uint32_t average_active_us() const;
+
+    /// @brief Fraction of the elapsed time spent awake, 0..1.
+    float duty_cycle() const;
+
+private:
+    IClock& clock_;
+    uint32_t period_us_;
+    uint32_t guard_us_;
+    Mode mode_;
+    bool started_;
+    uint32_t start_us_;
+    uint32_t anchor_us_;       // expected (or observed) time of the last served data-ready
+    uint32_t active_start_us_;
+    uint32_t last_active_us_;
+    uint32_t last_done_us_;
+    uint64_t total_active_us_;
+    uint32_t frames_;
+    uint32_t missed_frames_;
+};
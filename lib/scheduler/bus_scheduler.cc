@@ -0,0 +1,167 @@
+#include "bus_scheduler.hh"
+
+namespace {
+// Signed distance between two wrapping microsecond timestamps.
+int32_t diff_us(uint32_t a, uint32_t b)
+{
+    return static_cast<int32_t>(a - b);
+}
+} // namespace
+
+BusScheduler::BusScheduler(I2CAdapter& i2c, IClock& clock, uint32_t guard_us, uint32_t poll_interval_us)
+    : i2c_(i2c),
+      clock_(clock),
+      guard_us_(guard_us),
+      poll_interval_us_(poll_interval_us),
+      slots_(),
+      count_(0),
+      started_(false),
+      last_us_(0),
+      elapsed_us_(0)
+{
+}
+
+BusStatus BusScheduler::add_slot(void* sensor, const SensorOps& ops, uint32_t period_us, uint8_t& index)
+{
+    if (count_ >= max_sensors) {
+        return BusStatus::TooManySensors;
+    }
+    Slot& slot = slots_[count_];
+    slot = Slot();
+    slot.sensor = sensor;
+    slot.ops = ops;
+    slot.period_us = period_us;
+    slot.ready_us = clock_.now_us();
+    slot.due_us = slot.ready_us;
+    slot.anchored = false;
+    slot.phase = Phase::Waiting;
+    index = static_cast<uint8_t>(count_++);
+    return BusStatus::Success;
+}
+
+uint8_t BusScheduler::step()
+{
+    if (count_ == 0) {
+        return no_sensor;
+    }
+    uint32_t now = clock_.now_us();
+    if (!started_) {
+        started_ = true;
+        last_us_ = now;
+    }
+
+    uint32_t next_due_us = now;
+    int index = pick(now, next_due_us);
+    if (index < 0) {
+        clock_.sleep_until_us(next_due_us);
+        now = clock_.now_us();
+        index = pick(now, next_due_us);
+    }
+
+    uint8_t completed = no_sensor;
+    if (index >= 0) {
+        Slot& slot = slots_[index];
+        completed = run(slot, static_cast<uint8_t>(index));
+        const uint32_t end = clock_.now_us();
+        slot.stats.bus_us += end - now;
+        now = end;
+    }
+    elapsed_us_ += now - last_us_;
+    last_us_ = now;
+    return completed;
+}
+
+float BusScheduler::utilization(uint8_t index) const
+{
+    if (elapsed_us_ == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(slots_[index].stats.bus_us) / static_cast<float>(elapsed_us_);
+}
+
+float BusScheduler::utilization() const
+{
+    float total = 0.0f;
+    for (std::size_t i = 0; i < count_; ++i) {
+        total += utilization(static_cast<uint8_t>(i));
+    }
+    return total;
+}
+
+int BusScheduler::pick(uint32_t now_us, uint32_t& next_due_us) const
+{
+    int best = -1;
+    bool have_next = false;
+    for (std::size_t i = 0; i < count_; ++i) {
+        const Slot& slot = slots_[i];
+        if (diff_us(slot.due_us, now_us) <= 0) {
+            if (best < 0 || diff_us(slot.ready_us, slots_[best].ready_us) < 0) {
+                best = static_cast<int>(i);
+            }
+        } else if (!have_next || diff_us(slot.due_us, next_due_us) < 0) {
+            next_due_us = slot.due_us;
+            have_next = true;
+        }
+    }
+    return best;
+}
+
+uint8_t BusScheduler::run(Slot& slot, uint8_t index)
+{
+    if (slot.phase == Phase::Waiting) {
+        const uint32_t poll_us = clock_.now_us();
+        bool ready = false;
+        slot.stats.polls++;
+        if (slot.ops.poll_data_ready(slot.sensor, ready) != 0) {
+            fail(slot);
+            return no_sensor;
+        }
+        if (!ready) {
+            slot.due_us = clock_.now_us() + poll_interval_us_;
+            return no_sensor;
+        }
+        if (slot.anchored) {
+            const int32_t late = diff_us(poll_us, slot.ready_us);
+            if (late >= static_cast<int32_t>(slot.period_us)) {
+                slot.stats.missed_frames += static_cast<uint32_t>(late) / slot.period_us;
+            }
+        }
+        slot.ready_us = poll_us;
+        slot.due_us = poll_us;
+        slot.anchored = true;
+        slot.phase = Phase::Reading;
+        slot.read_step = 0;
+        return no_sensor;
+    }
+
+    const int error = slot.ops.read_frame_step(slot.sensor, slot.read_step);
+    if (error == -8) {
+        // The next subpage landed while reading this one: it is lost, read the new one.
+        slot.stats.missed_frames++;
+        slot.ready_us = clock_.now_us();
+        slot.read_step = 0;
+        return no_sensor;
+    }
+    if (error != 0) {
+        fail(slot);
+        return no_sensor;
+    }
+    if (++slot.read_step < slot.ops.frame_read_steps) {
+        return no_sensor;
+    }
+
+    slot.stats.frames++;
+    slot.phase = Phase::Waiting;
+    slot.ready_us += slot.period_us;
+    slot.due_us = slot.ready_us - guard_us_;
+    return index;
+}
+
+void BusScheduler::fail(Slot& slot)
+{
+    slot.stats.errors++;
+    slot.phase = Phase::Waiting;
+    slot.anchored = false;
+    slot.ready_us = clock_.now_us();
+    slot.due_us = slot.ready_us + poll_interval_us_;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "i_clock.hh"
+#include "i2c_adapter.hh"
+
+enum class BusStatus {
+    Success = 0,
+    TooManySensors,
+    WrongBus,  // the sensor was constructed on another I2CAdapter
+};
+
+/// @brief Shares one I2C bus between several MLXSensor instances, MLX90641 and MLX90640 alike.
+///
+/// Every sensor has a predicted data-ready time (one subpage period after the last one it
+/// served). step() performs a single bus transaction, a status poll or one block of a
+/// frame read, for the sensor with the earliest data-ready time among those that are due.
+/// A subpage must be read before the sensor overwrites it one period later, so this
+/// earliest-deadline-first order keeps every sensor on time whenever the bus has the
+/// capacity. Polling starts guard_us before the predicted time and the prediction is
+/// re-anchored to when new data was actually seen, which tracks each sensor's own clock.
+class BusScheduler {
+public:
+    static constexpr std::size_t max_sensors = 4;
+    static constexpr uint8_t no_sensor = 0xFF;
+
+    struct SensorStats {
+        uint32_t frames;
+        uint32_t missed_frames;  // subpages overwritten before they were read
+        uint32_t polls;
+        uint32_t errors;
+        uint64_t bus_us;         // time spent in this sensor's transactions
+    };
+
+    /// @param guard_us How long before the predicted data-ready to start polling.
+    /// @param poll_interval_us Time between status polls while waiting for data.
+    BusScheduler(I2CAdapter& i2c, IClock& clock, uint32_t guard_us = 1000, uint32_t poll_interval_us = 500);
+
+    /// @brief Registers a sensor constructed on this scheduler's I2CAdapter.
+    /// @param sensor Any type with poll_data_ready(), read_frame_step(), frame_read_steps and bus()
+    /// like mlx90641::MLXSensor.
+    /// @param period_us Its subpage period, see AcquisitionScheduler::subpage_period_us.
+    template <typename Sensor>
+    BusStatus add_sensor(Sensor& sensor, uint32_t period_us, uint8_t& index)
+    {
+        if (&sensor.bus() != &i2c_) {
+            return BusStatus::WrongBus;
+        }
+        const SensorOps ops = {&poll_data_ready<Sensor>, &read_frame_step<Sensor>, Sensor::frame_read_steps};
+        return add_slot(&sensor, ops, period_us, index);
+    }
+
+    /// @brief Performs the most urgent bus transaction, sleeping first if no sensor is due.
+    /// @return Index of the sensor whose frame just completed, or no_sensor.
+    uint8_t step();
+
+    std::size_t sensor_count() const { return count_; }
+    const SensorStats& stats(uint8_t index) const { return slots_[index].stats; }
+
+    /// @brief Fraction of the elapsed time the bus spent on sensor `index`, 0..1.
+    float utilization(uint8_t index) const;
+
+    /// @brief Fraction of the elapsed time the bus was busy, 0..1.
+    float utilization() const;
+
+private:
+    enum class Phase : uint8_t {
+        Waiting,  // polling status from due_us on
+        Reading,  // frame read in progress, next transaction is read_step
+    };
+
+    // The sensor calls the scheduler makes, bound to the sensor's type by add_sensor().
+    struct SensorOps {
+        int (*poll_data_ready)(void* sensor, bool& ready);
+        int (*read_frame_step)(void* sensor, uint8_t step);
+        uint8_t frame_read_steps;
+    };
+
+    template <typename Sensor>
+    static int poll_data_ready(void* sensor, bool& ready)
+    {
+        return static_cast<Sensor*>(sensor)->poll_data_ready(ready);
+    }
+
+    template <typename Sensor>
+    static int read_frame_step(void* sensor, uint8_t step)
+    {
+        return static_cast<Sensor*>(sensor)->read_frame_step(step);
+    }
+
+    struct Slot {
+        void* sensor;
+        SensorOps ops;
+        uint32_t period_us;
+        uint32_t ready_us;   // predicted (Waiting) or observed (Reading) data-ready time
+        uint32_t due_us;     // earliest time for the next transaction
+        bool anchored;       // ready_us follows an observed data-ready
+        Phase phase;
+        uint8_t read_step;
+        SensorStats stats;
+    };
+
+    BusStatus add_slot(void* sensor, const SensorOps& ops, uint32_t period_us, uint8_t& index);
+    int pick(uint32_t now_us, uint32_t& next_due_us) const;
+    uint8_t run(Slot& slot, uint8_t index);
+    void fail(Slot& slot);
+
+    I2CAdapter& i2c_;
+    IClock& clock_;
+    uint32_t guard_us_;
+    uint32_t poll_interval_us_;
+    std::array<Slot, max_sensors> slots_;
+    std::size_t count_;
+    bool started_;
+    uint32_t last_us_;
+    uint64_t elapsed_us_;
+};
@@ -0,0 +1,13 @@
+// Abstract class to represent the time base used for scheduling
+
+#pragma once
+#include <cstdint>
+
+class IClock {
+public:
+    virtual ~IClock() = default;
+    // Monotonic time in microseconds, wraps around at 2^32
+    virtual uint32_t now_us() = 0;
+    // Low-power sleep until `wake_us` (returns immediately if it is already past)
+    virtual void sleep_until_us(uint32_t wake_us) = 0;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Compile-time description of the Melexis thermopile arrays the firmware supports.
+///
+/// The driver, calibration storage and zone reductions are templates over one of these
+/// structs, so every loop runs over constexpr bounds and each sensor gets its own code. A
+/// traits struct holds:
+/// - geometry: rows, columns, pixels (row-major, pixel = row * num_columns + column);
+/// - EEPROM layout: address, size, Hamming coding, device-select bit;
+/// - RAM map: the blocks read per subpage and where they land in the frame buffer;
+/// - frame layout: the index of each auxiliary value in the frame buffer;
+/// - subpage pattern: which pixels a subpage measurement updates.
+
+/// @brief MLX90641, 16x12 pixels.
+///
+/// Each subpage updates every pixel; the two subpages alternate in 32-word RAM groups
+/// (two pixel rows each), so only the groups of the current subpage are read.
+struct MLX90641Traits {
+    static constexpr const char* name = "MLX90641";
+
+    static constexpr std::size_t num_rows = 12;
+    static constexpr std::size_t num_columns = 16;
+    static constexpr std::size_t num_pixels = num_rows * num_columns;
+
+    static constexpr uint16_t status_register = 0x8000;
+    static constexpr uint16_t control_register = 0x800D;
+    static constexpr uint8_t default_refresh_rate = 0x06; // 32Hz subpages, 16Hz full frames
+
+    static constexpr uint16_t eeprom_address = 0x2400;
+    static constexpr std::size_t eeprom_words = 832;
+    static constexpr bool eeprom_hamming = true;          // 11-bit values with parity in bits 11-15
+    static constexpr bool eeprom_device_select = true;    // value of bit 6 of word 10 on a valid part
+
+    /// Blocks 0-5 hold two pixel rows each (subpage 1 is offset by one row), block 6 the auxiliary data.
+    static constexpr uint8_t ram_blocks = 7;
+    static constexpr uint16_t block_address(uint8_t sub_page, uint8_t block)
+    {
+        return block < 6 ? static_cast<uint16_t>(0x0400 + block * 0x40 + (sub_page ? 0x20 : 0x00)) : 0x0580;
+    }
+    static constexpr std::size_t block_words(uint8_t block) { return block < 6 ? 32 : 48; }
+    static constexpr std::size_t block_offset(uint8_t block) { return block * 32; }
+
+    static constexpr std::size_t frame_ptat_art = 192;
+    static constexpr std::size_t frame_gain = 202;
+    static constexpr std::size_t frame_ptat = 224;
+    static constexpr std::size_t frame_vdd = 234;
+    static constexpr std::size_t frame_control = 240;
+    static constexpr std::size_t frame_sub_page = 241;
+    static constexpr std::size_t frame_words = 242;
+    static constexpr std::size_t frame_cp(uint8_t /*sub_page*/) { return 200; }
+
+    static constexpr bool subpage_covers_all_pixels = true;
+};
+
+/// @brief MLX90640, 32x24 pixels.
+///
+/// Both subpages share the pixel RAM and each updates half of the pixels: alternate rows in
+/// interleaved mode, or a chess pattern (control register bit 12, the default). The whole RAM
+/// is read every subpage.
+struct MLX90640Traits {
+    static constexpr const char* name = "MLX90640";
+
+    static constexpr std::size_t num_rows = 24;
+    static constexpr std::size_t num_columns = 32;
+    static constexpr std::size_t num_pixels = num_rows * num_columns;
+
+    static constexpr uint16_t status_register = 0x8000;
+    static constexpr uint16_t control_register = 0x800D;
+    static constexpr uint8_t default_refresh_rate = 0x05; // 16Hz subpages: the RAM read takes ~37 ms at 400 kHz
+
+    static constexpr uint16_t eeprom_address = 0x2400;
+    static constexpr std::size_t eeprom_words = 832;
+    static constexpr bool eeprom_hamming = false;
+    static constexpr bool eeprom_device_select = false;
+
+    /// 12 blocks of two pixel rows, block 12 the auxiliary data; the same for both subpages.
+    static constexpr uint8_t ram_blocks = 13;
+    static constexpr uint16_t block_address(uint8_t /*sub_page*/, uint8_t block)
+    {
+        return static_cast<uint16_t>(0x0400 + block * 0x40);
+    }
+    static constexpr std::size_t block_words(uint8_t /*block*/) { return 64; }
+    static constexpr std::size_t block_offset(uint8_t block) { return block * 64; }
+
+    static constexpr std::size_t frame_ptat_art = 768;
+    static constexpr std::size_t frame_gain = 778;
+    static constexpr std::size_t frame_ptat = 800;
+    static constexpr std::size_t frame_vdd = 810;
+    static constexpr std::size_t frame_control = 832;
+    static constexpr std::size_t frame_sub_page = 833;
+    static constexpr std::size_t frame_words = 834;
+    static constexpr std::size_t frame_cp(uint8_t sub_page) { return sub_page ? 808 : 776; }
+
+    static constexpr bool subpage_covers_all_pixels = false;
+    /// @brief Subpage measuring `pixel`, in chess or interleaved (row parity) mode.
+    static constexpr uint8_t pixel_sub_page(std::size_t pixel, bool chess)
+    {
+        return static_cast<uint8_t>(chess ? ((pixel / num_columns) ^ pixel) & 1 : (pixel / num_columns) & 1);
+    }
+};
@@ -0,0 +1,50 @@
+#include "session_stats.hh"
+#include <cmath>
+#include <limits>
+
+void RunningStat::reset()
+{
+    count = 0;
+    mean = 0.0f;
+    m2 = 0.0f;
+    min = std::numeric_limits<float>::max();
+    max = -std::numeric_limits<float>::max();
+}
+
+void RunningStat::add(float value)
+{
+    if (!std::isfinite(value)) {
+        return;
+    }
+    count++;
+    const float delta = value - mean;
+    mean += delta / static_cast<float>(count);
+    m2 += delta * (value - mean);
+    if (value < min) {
+        min = value;
+    }
+    if (value > max) {
+        max = value;
+    }
+}
+
+float RunningStat::variance() const
+{
+    if (count < 2) {
+        return 0.0f;
+    }
+    return m2 / static_cast<float>(count - 1);
+}
+
+StatSnapshot make_snapshot(const RunningStat& stat)
+{
+    StatSnapshot snapshot = {0, 0, 0, 0};
+    if (stat.count == 0) {
+        return snapshot;
+    }
+    snapshot.mean = ZoneReducer::to_fixed_point(stat.mean);
+    snapshot.stddev = ZoneReducer::to_fixed_point(std::sqrt(stat.variance()));
+    snapshot.min = ZoneReducer::to_fixed_point(stat.min);
+    snapshot.max = ZoneReducer::to_fixed_point(stat.max);
+    return snapshot;
+}
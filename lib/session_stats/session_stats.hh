@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "zone_reducer.hh"
+
+/// @brief Running statistics of one value using Welford's online algorithm.
+///
+/// Mean and M2 (sum of squared deviations from the mean) are updated incrementally, which
+/// stays numerically stable over long sessions where a naive sum of squares would cancel.
+struct RunningStat {
+    uint32_t count;
+    float mean;
+    float m2;
+    float min;
+    float max;
+
+    void reset();
+
+    /// @brief Folds one sample in. Non-finite samples (invalid pixels) are ignored.
+    void add(float value);
+
+    /// @brief Sample variance, 0 until at least two samples were added.
+    float variance() const;
+};
+
+/// @brief Compact snapshot of one RunningStat, all fields in °C × 10 (DataPack format).
+struct StatSnapshot {
+    int16_t mean;
+    int16_t stddev;
+    int16_t min;
+    int16_t max;
+};
+
+StatSnapshot make_snapshot(const RunningStat& stat);
+
+enum class SessionStatsStatus {
+    Success = 0,
+    OutOfRange,
+};
+
+/// @brief Session statistics for a fixed number of entries (pixels or zones).
+///
+/// Storage is sized at compile time, so the RAM cost of a configuration is known up front
+/// and reported by memory_bytes(). Use PixelSessionStats to track every pixel, or
+/// ZoneSessionStats to track only the zones of a ZoneReducer when RAM is tight.
+template <std::size_t Capacity>
+class SessionStats {
+public:
+    static constexpr std::size_t capacity = Capacity;
+
+    SessionStats() { reset(); }
+
+    /// @brief Clears every entry and the frame counter, e.g. at the start of a track session.
+    void reset()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            stats_[i].reset();
+        }
+        frames_ = 0;
+    }
+
+    /// @brief Updates entries [0, count) from one frame of values, e.g. the driver's temperatures.
+    void update(const float* values, std::size_t count)
+    {
+        if (count > Capacity) {
+            count = Capacity;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            stats_[i].add(values[i]);
+        }
+        frames_++;
+    }
+
+    /// @brief Updates one entry per zone from the reducer's last frame.
+    ///
+    /// Mean and variance are those of the zone mean; min and max follow the zone's coldest and
+    /// hottest pixel so peaks are not averaged away.
+    template <typename Traits>
+    void update(const BasicZoneReducer<Traits>& reducer)
+    {
+        std::size_t count = reducer.zone_count();
+        if (count > Capacity) {
+            count = Capacity;
+        }
+        for (std::size_t zone = 0; zone < count; ++zone) {
+            if (reducer.means()[zone] == BasicZoneReducer<Traits>::no_data) {
+                continue; // no pixel of the zone in this frame
+            }
+            RunningStat& stat = stats_[zone];
+            stat.add(reducer.means()[zone] / ZoneReducer::fixed_point_scale);
+            const float zone_min = reducer.mins()[zone] / ZoneReducer::fixed_point_scale;
+            const float zone_max = reducer.maxs()[zone] / ZoneReducer::fixed_point_scale;
+            if (zone_min < stat.min) {
+                stat.min = zone_min;
+            }
+            if (zone_max > stat.max) {
+                stat.max = zone_max;
+            }
+        }
+        frames_++;
+    }
+
+    const RunningStat& stat(std::size_t index) const { return stats_[index]; }
+
+    /// @brief Number of frames folded in since the last reset.
+    uint32_t frames() const { return frames_; }
+
+    /// @brief Copies entries [first, first + count) into `out` as compact snapshots.
+    SessionStatsStatus snapshot(std::size_t first, std::size_t count, StatSnapshot* out) const
+    {
+        if (first > Capacity || count > Capacity - first) {
+            return SessionStatsStatus::OutOfRange;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = make_snapshot(stats_[first + i]);
+        }
+        return SessionStatsStatus::Success;
+    }
+
+    /// @brief RAM used by this instance, in bytes.
+    static constexpr std::size_t memory_bytes() { return sizeof(SessionStats); }
+
+private:
+    std::array<RunningStat, Capacity> stats_;
+    uint32_t frames_;
+};
+
+/// @brief Statistics of every pixel, or of every zone of a BasicZoneReducer, of the sensor described by `Traits`.
+template <typename Traits>
+using BasicPixelSessionStats = SessionStats<Traits::num_pixels>;
+template <typename Traits>
+using BasicZoneSessionStats = SessionStats<BasicZoneReducer<Traits>::max_zones>;
+
+using PixelSessionStats = BasicPixelSessionStats<MLX90641Traits>;
+using ZoneSessionStats = BasicZoneSessionStats<MLX90641Traits>;
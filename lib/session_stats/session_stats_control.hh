@@ -0,0 +1,126 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "i_bulk_link.hh"
+#include "session_stats.hh"
+
+// Fetching and resetting the session statistics over a message link (the bulk BLE
+// characteristic, next to the bulk download messages).
+//
+// The host writes Fetch, or FetchAndReset at the end of a session; the device answers with
+// one or more Reply messages, each a StatsReplyHeader and `count` StatSnapshot entries.
+
+/// @brief First byte of every statistics message, distinct from the BulkOp values.
+enum class StatsOp : uint8_t {
+    Fetch = 0x20,          // host → device, op only
+    FetchAndReset = 0x21,  // host → device, op only: the reply holds the session that ends
+    Reply = 0x30,          // device → host, StatsReplyHeader + StatSnapshot × count
+};
+
+struct StatsReplyHeader {
+    uint8_t op;              // StatsOp::Reply
+    uint32_t frames;         // frames folded in since the last reset
+    uint16_t first;          // index of the first entry in this message
+    uint16_t count;          // entries in this message
+    uint16_t total;          // entries in the whole reply
+} __attribute__((packed));
+
+/// @brief Device side of the statistics commands for one SessionStats instance.
+///
+/// on_control() is called from the link's receive callback and only latches the command;
+/// on_frame(), from the task that updates the statistics, takes the snapshot (and resets)
+/// between two updates; service(), from a low-priority task, sends the reply.
+template <std::size_t Capacity>
+class SessionStatsControl {
+public:
+    using Stats = SessionStats<Capacity>;
+    static constexpr std::size_t max_message = 247; // largest ATT notification payload
+
+    /// @param entries Entries [0, entries) are reported, e.g. the reducer's zone count.
+    explicit SessionStatsControl(Stats& stats, std::size_t entries = Capacity)
+        : stats_(stats), entries_(entries < Capacity ? entries : Capacity), state_(Idle), reset_(false), frames_(0),
+          next_(0)
+    {
+    }
+
+    void set_entries(std::size_t entries) { entries_ = entries < Capacity ? entries : Capacity; }
+
+    /// @brief Latches a host command. Never blocks.
+    /// @return false if it is not a statistics command, or a reply is still pending (the host retries).
+    bool on_control(const uint8_t* data, std::size_t size)
+    {
+        if (size != 1 || (data[0] != static_cast<uint8_t>(StatsOp::Fetch) &&
+                          data[0] != static_cast<uint8_t>(StatsOp::FetchAndReset))) {
+            return false;
+        }
+        if (state_.load(std::memory_order_acquire) != Idle) {
+            return false;
+        }
+        reset_ = data[0] == static_cast<uint8_t>(StatsOp::FetchAndReset);
+        state_.store(Requested, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Snapshots the statistics for a latched command, then resets them if it asked to.
+    /// Call after SessionStats::update(), from the same task.
+    void on_frame()
+    {
+        if (state_.load(std::memory_order_acquire) != Requested) {
+            return;
+        }
+        stats_.snapshot(0, entries_, reply_.data());
+        frames_ = stats_.frames();
+        if (reset_) {
+            stats_.reset();
+        }
+        next_ = 0;
+        state_.store(Replying, std::memory_order_release);
+    }
+
+    /// @brief Sends the pending reply while the link accepts it.
+    /// @return true if there was anything to send.
+    bool service(IBulkLink& link)
+    {
+        if (state_.load(std::memory_order_acquire) != Replying) {
+            return false;
+        }
+        const std::size_t message_size = link.max_message() < max_message ? link.max_message() : max_message;
+        if (message_size < sizeof(StatsReplyHeader) + sizeof(StatSnapshot)) {
+            return true;
+        }
+        const std::size_t per_message = (message_size - sizeof(StatsReplyHeader)) / sizeof(StatSnapshot);
+        do {
+            const std::size_t count = entries_ - next_ < per_message ? entries_ - next_ : per_message;
+            uint8_t message[max_message];
+            const StatsReplyHeader header = {static_cast<uint8_t>(StatsOp::Reply), frames_,
+                                             static_cast<uint16_t>(next_), static_cast<uint16_t>(count),
+                                             static_cast<uint16_t>(entries_)};
+            std::memcpy(message, &header, sizeof(header));
+            std::memcpy(message + sizeof(header), reply_.data() + next_, count * sizeof(StatSnapshot));
+            if (!link.send(message, sizeof(header) + count * sizeof(StatSnapshot))) {
+                return true; // again on the next call
+            }
+            next_ += count;
+        } while (next_ < entries_);
+        state_.store(Idle, std::memory_order_release);
+        return true;
+    }
+
+private:
+    enum State : uint8_t {
+        Idle,
+        Requested,   // latched by on_control(), waiting for on_frame()
+        Replying,    // reply_ holds the snapshot, service() sends it
+    };
+
+    Stats& stats_;
+    std::size_t entries_;
+    std::atomic<uint8_t> state_;
+    bool reset_;
+    uint32_t frames_;
+    std::size_t next_;
+    std::array<StatSnapshot, Capacity> reply_;
+};
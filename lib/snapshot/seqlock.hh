@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// @brief Latest-value publication from one writer task to any number of reader tasks.
+///
+/// The writer never blocks nor waits for readers: it fills the slot after the newest one and
+/// then makes it the newest. Each slot has a sequence number, odd while it is written; a reader
+/// copies the newest slot and checks the number did not change, so it never returns a torn
+/// value. With Slots = 2 a read only fails if the writer completed a whole value and started
+/// on the slot being read meanwhile, i.e. a read taking longer than the publication period:
+/// try_read() is a single bounded attempt (wait-free), read() retries.
+///
+/// The value is held in relaxed atomic words, so the copies that overlap a write are not data
+/// races in the C++ memory model; on a Cortex-M4 they are plain loads and stores. T must be
+/// trivially copyable.
+template <typename T, std::size_t Slots = 2>
+class Seqlock {
+public:
+    static constexpr std::size_t word_count = (sizeof(T) + 3) / 4;
+
+    Seqlock() : latest_(0), published_(0)
+    {
+        for (Slot& slot : slots_) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+            for (std::atomic<uint32_t>& word : slot.words) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Publishes `value`.
+    void write(const T& value)
+    {
+        begin_write();
+        store(0, &value, sizeof(T));
+        end_write();
+    }
+
+    /// @brief Piecewise write, for a value assembled from several buffers without a staging
+    /// copy: begin_write(), store() every member (e.g. at its offsetof()), end_write().
+    void begin_write()
+    {
+        writing_ = (latest_.load(std::memory_order_relaxed) + 1) % Slots;
+        Slot& slot = slots_[writing_];
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // odd before any word
+    }
+
+    void store(std::size_t offset, const void* data, std::size_t size)
+    {
+        Slot& slot = slots_[writing_];
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            const std::size_t index = offset / 4;
+            const std::size_t shift = offset % 4;
+            const std::size_t count = size < 4 - shift ? size : 4 - shift;
+            uint32_t word = count == 4 ? 0 : slot.words[index].load(std::memory_order_relaxed);
+            std::memcpy(reinterpret_cast<uint8_t*>(&word) + shift, bytes, count);
+            slot.words[index].store(word, std::memory_order_relaxed);
+            offset += count;
+            bytes += count;
+            size -= count;
+        }
+    }
+
+    void end_write()
+    {
+        Slot& slot = slots_[writing_];
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        latest_.store(writing_, std::memory_order_release);
+        published_.fetch_add(1, std::memory_order_release);
+    }
+
+    /// @brief Copies the newest value, one attempt.
+    /// @return false if nothing was published yet or a write overlapped the copy (`value` is then unspecified).
+    bool try_read(T& value) const
+    {
+        if (published_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        const Slot& slot = slots_[latest_.load(std::memory_order_acquire)];
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        uint8_t* out = reinterpret_cast<uint8_t*>(&value);
+        for (std::size_t index = 0; index < word_count; index++) {
+            const uint32_t word = slot.words[index].load(std::memory_order_relaxed);
+            const std::size_t count = sizeof(T) - index * 4 < 4 ? sizeof(T) - index * 4 : 4;
+            std::memcpy(out + index * 4, &word, count);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire); // words before the second check
+        return slot.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    /// @brief Copies the newest value, retrying while writes overlap.
+    /// @param retries Receives the number of failed attempts, optional.
+    /// @return false only if nothing was published yet.
+    bool read(T& value, uint32_t* retries = nullptr) const
+    {
+        uint32_t failed = 0;
+        while (!try_read(value)) {
+            if (published_.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            failed++;
+        }
+        if (retries) {
+            *retries = failed;
+        }
+        return true;
+    }
+
+    /// @brief Values published so far, e.g. to tell whether a new one arrived.
+    uint32_t published() const { return published_.load(std::memory_order_acquire); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        std::array<std::atomic<uint32_t>, word_count> words;
+    };
+
+    std::array<Slot, Slots> slots_;
+    std::atomic<std::size_t> latest_;
+    std::atomic<uint32_t> published_;
+    std::size_t writing_ = 0;  // writer only
+};
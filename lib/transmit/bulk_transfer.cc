@@ -0,0 +1,320 @@
+#include "bulk_transfer.hh"
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t no_resend = 0xFFFFFFFF;
+
+uint16_t chunk_crc(uint32_t offset, const uint8_t* payload, std::size_t size)
+{
+    const uint8_t offset_bytes[4] = {static_cast<uint8_t>(offset), static_cast<uint8_t>(offset >> 8),
+                                     static_cast<uint8_t>(offset >> 16), static_cast<uint8_t>(offset >> 24)};
+    return bulk_crc16(payload, size, bulk_crc16(offset_bytes, sizeof(offset_bytes)));
+}
+
+} // namespace
+
+uint16_t bulk_crc16(const uint8_t* data, std::size_t size, uint16_t crc)
+{
+    for (std::size_t i = 0; i < size; i++) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+BulkSender::BulkSender(IBulkLink& link, IFlash& source, IClock& clock, uint32_t ack_timeout_us)
+    : link_(link), source_(source), clock_(clock), ack_timeout_us_(ack_timeout_us), controls_(), control_write_(0),
+      control_read_(0), active_(false), done_pending_(false), error_pending_(BulkStatus::Success), start_(0), end_(0),
+      next_(0), acked_(0), sent_high_(0), window_(default_window), start_us_(0), progress_us_(0), stats_()
+{
+}
+
+bool BulkSender::on_control(const uint8_t* data, std::size_t size)
+{
+    if (size == 0) {
+        return false;
+    }
+    Control control = {static_cast<BulkOp>(data[0]), 0, 0, 0};
+    switch (control.op) {
+        case BulkOp::Request: {
+            if (size != sizeof(BulkRequest)) {
+                return false;
+            }
+            BulkRequest request;
+            std::memcpy(&request, data, sizeof(request));
+            control.offset = request.offset;
+            control.length = request.length;
+            control.window = request.window;
+            break;
+        }
+        case BulkOp::Ack:
+        case BulkOp::Resend: {
+            if (size != sizeof(BulkAck)) {
+                return false;
+            }
+            BulkAck ack;
+            std::memcpy(&ack, data, sizeof(ack));
+            control.offset = ack.offset;
+            break;
+        }
+        case BulkOp::Abort:
+            break;
+        default:
+            return false;
+    }
+    const uint32_t position = control_write_.load(std::memory_order_relaxed);
+    if (position - control_read_.load(std::memory_order_acquire) >= control_capacity) {
+        return false;
+    }
+    controls_[position % control_capacity] = control;
+    control_write_.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool BulkSender::service()
+{
+    bool worked = false;
+    uint32_t position = control_read_.load(std::memory_order_relaxed);
+    while (position != control_write_.load(std::memory_order_acquire)) {
+        handle(controls_[position % control_capacity]);
+        control_read_.store(++position, std::memory_order_release);
+        worked = true;
+    }
+    if (error_pending_ != BulkStatus::Success) {
+        if (send_error(error_pending_)) {
+            error_pending_ = BulkStatus::Success;
+        }
+        return true;
+    }
+    if (!active_) {
+        return worked;
+    }
+    const uint32_t now_us = clock_.now_us();
+    if (acked_ >= end_) {
+        if (!done_pending_) {
+            const uint32_t elapsed_us = now_us - start_us_;
+            stats_.last_bytes_per_s =
+                elapsed_us == 0 ? 0 : static_cast<uint32_t>(uint64_t(end_ - start_) * 1000000 / elapsed_us);
+            done_pending_ = true;
+        }
+        const BulkDone done = {static_cast<uint8_t>(BulkOp::Done), end_, region_size(), stats_.last_bytes_per_s};
+        if (link_.send(reinterpret_cast<const uint8_t*>(&done), sizeof(done))) {
+            active_ = false;
+            stats_.completed++;
+        }
+        return true;
+    }
+    if (next_ != acked_ && now_us - progress_us_ > ack_timeout_us_) {
+        // Go back to the first unacknowledged byte; a chunk after it asks for an acknowledgement.
+        next_ = acked_;
+        progress_us_ = now_us;
+        stats_.timeouts++;
+        worked = true;
+    }
+    while (active_ && send_chunk()) {
+        worked = true;
+    }
+    return worked;
+}
+
+void BulkSender::handle(const Control& control)
+{
+    switch (control.op) {
+        case BulkOp::Request: {
+            stats_.requests++;
+            const uint32_t size = region_size();
+            if (control.offset > size) {
+                active_ = false;
+                error_pending_ = BulkStatus::OutOfRange;
+                return;
+            }
+            const uint32_t left = size - control.offset;
+            start_ = next_ = acked_ = sent_high_ = control.offset;
+            end_ = control.offset + (control.length < left ? control.length : left);
+            window_ = control.window == 0 ? default_window : control.window < max_window ? control.window : max_window;
+            start_us_ = progress_us_ = clock_.now_us();
+            active_ = true;
+            done_pending_ = false;
+            error_pending_ = BulkStatus::Success;
+            break;
+        }
+        case BulkOp::Ack:
+            // Cumulative: also valid for bytes sent before a go-back.
+            if (active_ && control.offset > acked_ && control.offset <= sent_high_) {
+                acked_ = control.offset;
+                if (next_ < acked_) {
+                    next_ = acked_;
+                }
+                progress_us_ = clock_.now_us();
+            }
+            break;
+        case BulkOp::Resend:
+            if (active_ && control.offset >= acked_ && control.offset < next_) {
+                acked_ = next_ = control.offset;
+                progress_us_ = clock_.now_us();
+            }
+            break;
+        case BulkOp::Abort:
+            active_ = false;
+            break;
+        default:
+            break;
+    }
+}
+
+// Sends the chunk at next_ if the window and the link allow.
+bool BulkSender::send_chunk()
+{
+    const std::size_t message_size = link_.max_message() < max_message ? link_.max_message() : max_message;
+    if (next_ >= end_ || message_size <= sizeof(BulkChunkHeader)) {
+        return false;
+    }
+    const uint32_t payload = static_cast<uint32_t>(message_size - sizeof(BulkChunkHeader));
+    if (next_ - acked_ >= window_ * payload) {
+        return false;
+    }
+    uint8_t message[max_message];
+    const uint32_t size = end_ - next_ < payload ? end_ - next_ : payload;
+    uint8_t* data = message + sizeof(BulkChunkHeader);
+    if (!source_.read(next_, data, size)) {
+        active_ = false;
+        error_pending_ = BulkStatus::SourceError;
+        return false;
+    }
+    const uint32_t after = next_ + size;
+    const uint32_t chunk_index = (after - start_ + payload - 1) / payload;
+    const uint32_t ack_interval = window_ / 2 > 0 ? window_ / 2 : 1;
+    BulkChunkHeader header;
+    header.op = static_cast<uint8_t>(BulkOp::Data);
+    header.flags = after == end_ || after - acked_ >= window_ * payload || chunk_index % ack_interval == 0
+                       ? bulk_flag_ack_requested
+                       : 0;
+    header.offset = next_;
+    header.crc = chunk_crc(next_, data, size);
+    std::memcpy(message, &header, sizeof(header));
+    if (!link_.send(message, sizeof(header) + size)) {
+        return false;
+    }
+    stats_.chunks_sent++;
+    stats_.bytes_sent += size;
+    if (next_ < sent_high_) {
+        stats_.chunks_resent++;
+    }
+    next_ = after;
+    if (next_ > sent_high_) {
+        sent_high_ = next_;
+    }
+    return true;
+}
+
+bool BulkSender::send_error(BulkStatus status)
+{
+    const BulkError error = {static_cast<uint8_t>(BulkOp::Error), static_cast<uint8_t>(status), region_size()};
+    return link_.send(reinterpret_cast<const uint8_t*>(&error), sizeof(error));
+}
+
+BulkReceiver::BulkReceiver(IBulkLink& link, uint8_t* buffer, uint32_t capacity)
+    : link_(link), buffer_(buffer), capacity_(capacity), end_(0), expected_(0), resend_requested_(no_resend),
+      window_(0), complete_(false), status_(BulkStatus::Success), region_size_(0), bytes_per_s_(0), bad_chunks_(0),
+      duplicate_chunks_(0)
+{
+}
+
+bool BulkReceiver::start(uint32_t offset, uint32_t length, uint8_t window)
+{
+    if (offset > capacity_) {
+        return false;
+    }
+    expected_ = offset;
+    end_ = offset + (length < capacity_ - offset ? length : capacity_ - offset);
+    window_ = window;
+    complete_ = false;
+    status_ = BulkStatus::Success;
+    return resume();
+}
+
+bool BulkReceiver::resume()
+{
+    if (complete_) {
+        return true;
+    }
+    resend_requested_ = no_resend;
+    const BulkRequest request = {static_cast<uint8_t>(BulkOp::Request), expected_, end_ - expected_, window_};
+    return link_.send(reinterpret_cast<const uint8_t*>(&request), sizeof(request));
+}
+
+void BulkReceiver::on_message(const uint8_t* data, std::size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    switch (static_cast<BulkOp>(data[0])) {
+        case BulkOp::Data: {
+            if (size < sizeof(BulkChunkHeader)) {
+                return;
+            }
+            BulkChunkHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            const uint8_t* payload = data + sizeof(header);
+            const uint32_t payload_size = static_cast<uint32_t>(size - sizeof(header));
+            if (header.crc != chunk_crc(header.offset, payload, payload_size)) {
+                bad_chunks_++;
+            } else if (header.offset > expected_) {
+                // Treated like a lost chunk below.
+            } else if (header.offset + payload_size <= expected_) {
+                duplicate_chunks_++;
+                if (header.flags & bulk_flag_ack_requested) {
+                    send_ack(BulkOp::Ack); // our acknowledgement was lost
+                }
+                return;
+            } else {
+                const uint32_t end = header.offset + payload_size < end_ ? header.offset + payload_size : end_;
+                if (end > expected_) {
+                    std::memcpy(buffer_ + expected_, payload + (expected_ - header.offset), end - expected_);
+                    expected_ = end;
+                }
+                resend_requested_ = no_resend;
+                if (header.flags & bulk_flag_ack_requested) {
+                    send_ack(BulkOp::Ack);
+                }
+                return;
+            }
+            if (resend_requested_ != expected_ && send_ack(BulkOp::Resend)) {
+                resend_requested_ = expected_;
+            }
+            break;
+        }
+        case BulkOp::Done: {
+            if (size != sizeof(BulkDone)) {
+                return;
+            }
+            BulkDone done;
+            std::memcpy(&done, data, sizeof(done));
+            region_size_ = done.region_size;
+            bytes_per_s_ = done.bytes_per_s;
+            complete_ = done.end == expected_;
+            break;
+        }
+        case BulkOp::Error: {
+            if (size != sizeof(BulkError)) {
+                return;
+            }
+            BulkError error;
+            std::memcpy(&error, data, sizeof(error));
+            status_ = static_cast<BulkStatus>(error.status);
+            region_size_ = error.region_size;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool BulkReceiver::send_ack(BulkOp op)
+{
+    const BulkAck ack = {static_cast<uint8_t>(op), expected_};
+    return link_.send(reinterpret_cast<const uint8_t*>(&ack), sizeof(ack));
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "i_bulk_link.hh"
+#include "i_clock.hh"
+#include "i_flash.hh"
+
+// Bulk download of a flash region over a message link (the bulk BLE characteristic).
+//
+// The host writes a Request for a byte range; the device streams it back as Data chunks of
+// the largest size the link carries, back-to-back up to a window of unacknowledged chunks.
+// The host acknowledges cumulatively (Ack: everything before `offset` arrived) when a chunk
+// asks for it, and asks for a go-back (Resend) when a chunk is missing or fails its CRC.
+// Without acknowledgement for ack_timeout_us the device goes back on its own. After a
+// disconnect the host sends a new Request from the first byte it lacks.
+
+/// @brief First byte of every bulk message.
+enum class BulkOp : uint8_t {
+    Request = 0x01,  // host → device, BulkRequest
+    Ack = 0x02,      // host → device, BulkAck
+    Resend = 0x03,   // host → device, BulkAck: send again from `offset`
+    Abort = 0x04,    // host → device, op only
+    Data = 0x10,     // device → host, BulkChunkHeader + payload
+    Done = 0x11,     // device → host, BulkDone: the range was acknowledged
+    Error = 0x12,    // device → host, BulkError
+};
+
+enum class BulkStatus : uint8_t {
+    Success = 0,
+    OutOfRange,      // the request starts past the end of the region
+    SourceError,     // reading the region failed
+    Malformed,       // unknown op or wrong size
+};
+
+struct BulkRequest {
+    uint8_t op;
+    uint32_t offset;
+    uint32_t length;         // clamped to the end of the region, 0xFFFFFFFF: everything
+    uint8_t window;          // chunks in flight, 0: the device default
+} __attribute__((packed));
+
+struct BulkAck {
+    uint8_t op;
+    uint32_t offset;
+} __attribute__((packed));
+
+constexpr uint8_t bulk_flag_ack_requested = 0x01;
+
+struct BulkChunkHeader {
+    uint8_t op;
+    uint8_t flags;           // bulk_flag_ack_requested
+    uint32_t offset;
+    uint16_t crc;            // CRC-16/CCITT of offset (little-endian) and payload
+} __attribute__((packed));
+
+struct BulkDone {
+    uint8_t op;
+    uint32_t end;            // end of the transferred range
+    uint32_t region_size;
+    uint32_t bytes_per_s;    // effective rate of this request, retransmissions included
+} __attribute__((packed));
+
+struct BulkError {
+    uint8_t op;
+    uint8_t status;          // BulkStatus
+    uint32_t region_size;
+} __attribute__((packed));
+
+/// @brief CRC-16/CCITT-FALSE, continuing from `crc`.
+uint16_t bulk_crc16(const uint8_t* data, std::size_t size, uint16_t crc = 0xFFFF);
+
+/// @brief Counters of BulkSender.
+struct BulkSenderStats {
+    uint32_t requests;
+    uint32_t completed;
+    uint32_t chunks_sent;
+    uint32_t chunks_resent;      // go-backs, on request or timeout
+    uint32_t timeouts;
+    uint32_t bytes_sent;         // payload, retransmissions included
+    uint32_t last_bytes_per_s;   // effective rate of the last completed request
+};
+
+/// @brief Device side of the bulk download.
+///
+/// on_control() is called from the link's receive callback and only queues the message;
+/// service(), from a low-priority task, runs the state machine and sends.
+class BulkSender {
+public:
+    static constexpr uint8_t default_window = 16;
+    static constexpr uint8_t max_window = 64;
+    static constexpr uint32_t default_ack_timeout_us = 250000;
+    static constexpr std::size_t max_message = 247;     // largest ATT notification payload
+    static constexpr std::size_t control_capacity = 8;  // queued host messages, power of two
+
+    BulkSender(IBulkLink& link, IFlash& source, IClock& clock, uint32_t ack_timeout_us = default_ack_timeout_us);
+
+    /// @brief Queues a host message. Never blocks.
+    /// @return false if it was malformed or the queue was full (the host times out and retries).
+    bool on_control(const uint8_t* data, std::size_t size);
+
+    /// @brief Handles queued host messages and sends while the window and the link allow.
+    /// @return true if there was anything to do.
+    bool service();
+
+    bool active() const { return active_; }
+    uint32_t region_size() const { return source_.page_size() * source_.page_count(); }
+    const BulkSenderStats& stats() const { return stats_; }
+
+private:
+    struct Control {
+        BulkOp op;
+        uint32_t offset;
+        uint32_t length;
+        uint8_t window;
+    };
+
+    void handle(const Control& control);
+    bool send_chunk();
+    bool send_error(BulkStatus status);
+
+    IBulkLink& link_;
+    IFlash& source_;
+    IClock& clock_;
+    uint32_t ack_timeout_us_;
+    std::array<Control, control_capacity> controls_;
+    std::atomic<uint32_t> control_write_;
+    std::atomic<uint32_t> control_read_;
+
+    bool active_;
+    bool done_pending_;
+    BulkStatus error_pending_;
+    uint32_t start_;
+    uint32_t end_;
+    uint32_t next_;              // first byte not sent yet
+    uint32_t acked_;             // first byte not acknowledged
+    uint32_t sent_high_;         // furthest byte ever sent in this request, to count resends
+    uint8_t window_;
+    uint32_t start_us_;
+    uint32_t progress_us_;       // last acknowledgement progress, or the start
+    BulkSenderStats stats_;
+};
+
+/// @brief Host side of the bulk download, into a caller buffer indexed by region offset.
+/// Used by the tests as the reference implementation of the protocol.
+class BulkReceiver {
+public:
+    BulkReceiver(IBulkLink& link, uint8_t* buffer, uint32_t capacity);
+
+    /// @brief Requests [offset, offset + length), e.g. the whole region with 0xFFFFFFFF.
+    bool start(uint32_t offset = 0, uint32_t length = 0xFFFFFFFF, uint8_t window = 0);
+    /// @brief After a reconnect: requests the rest of the range, from the first missing byte.
+    bool resume();
+    /// @brief Handles one device message.
+    void on_message(const uint8_t* data, std::size_t size);
+
+    bool complete() const { return complete_; }
+    BulkStatus status() const { return status_; }
+    uint32_t received() const { return expected_; }  // first missing byte
+    uint32_t region_size() const { return region_size_; }
+    uint32_t device_bytes_per_s() const { return bytes_per_s_; }
+    uint32_t bad_chunks() const { return bad_chunks_; }
+    uint32_t duplicate_chunks() const { return duplicate_chunks_; }
+
+private:
+    bool send_ack(BulkOp op);
+
+    IBulkLink& link_;
+    uint8_t* buffer_;
+    uint32_t capacity_;
+    uint32_t end_;               // requested end
+    uint32_t expected_;
+    uint32_t resend_requested_;  // one Resend per gap
+    uint8_t window_;
+    bool complete_;
+    BulkStatus status_;
+    uint32_t region_size_;
+    uint32_t bytes_per_s_;
+    uint32_t bad_chunks_;
+    uint32_t duplicate_chunks_;
+};
@@ -0,0 +1,54 @@
+#include "deadband_policy.hh"
+
+DeadbandPolicy::DeadbandPolicy(int16_t deadband, uint32_t max_silence_ms)
+    : deadband_(deadband), max_silence_ms_(max_silence_ms), sent_(0), suppressed_(0)
+{
+    reset();
+}
+
+void DeadbandPolicy::reset()
+{
+    last_value_.fill(0);
+    last_sent_ms_.fill(0);
+    has_sent_.fill(false);
+}
+
+bool DeadbandPolicy::should_send(std::size_t first_zone, std::size_t count, const int16_t* values, uint32_t now_ms)
+{
+    if (first_zone >= max_zones) {
+        return false;
+    }
+    if (count > max_zones - first_zone) {
+        count = max_zones - first_zone;
+    }
+
+    bool send = false;
+    for (std::size_t i = 0; i < count && !send; ++i) {
+        send = zone_needs_send(first_zone + i, values[i], now_ms);
+    }
+
+    if (!send) {
+        suppressed_++;
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        last_value_[first_zone + i] = values[i];
+        last_sent_ms_[first_zone + i] = now_ms;
+        has_sent_[first_zone + i] = true;
+    }
+    sent_++;
+    return true;
+}
+
+bool DeadbandPolicy::zone_needs_send(std::size_t zone, int16_t value, uint32_t now_ms) const
+{
+    if (!has_sent_[zone]) {
+        return true;
+    }
+    // Unsigned subtraction keeps the heartbeat correct across millis() wrap-around.
+    if (now_ms - last_sent_ms_[zone] >= max_silence_ms_) {
+        return true;
+    }
+    const int32_t change = static_cast<int32_t>(value) - last_value_[zone];
+    return change > deadband_ || change < -deadband_;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Change-triggered transmit policy with a dead-band and a heartbeat.
+///
+/// A group of zones (typically the zones carried by one packet, or a whole frame) is sent
+/// only when at least one zone moved by more than the dead-band since it was last sent, or
+/// when a zone has been silent for longer than the maximum silence interval. Values are in
+/// the fixed-point units produced by ZoneReducer (°C × 10).
+class DeadbandPolicy {
+public:
+    static constexpr std::size_t max_zones = 32;
+
+    /// @param deadband Largest change (fixed-point units) that is still suppressed.
+    /// @param max_silence_ms Heartbeat: a zone is re-sent at least this often, even if unchanged.
+    DeadbandPolicy(int16_t deadband, uint32_t max_silence_ms);
+
+    /// @brief Decides whether zones [first_zone, first_zone + count) must be sent now.
+    ///
+    /// When it returns true the values are recorded as the last-sent state, so callers only
+    /// ask when they are able to transmit (e.g. a central is connected).
+    bool should_send(std::size_t first_zone, std::size_t count, const int16_t* values, uint32_t now_ms);
+
+    /// @brief Forgets the last-sent state so every zone is sent on the next call, e.g. on connect.
+    void reset();
+
+    void set_deadband(int16_t deadband) { deadband_ = deadband; }
+    void set_max_silence_ms(uint32_t max_silence_ms) { max_silence_ms_ = max_silence_ms; }
+
+    uint32_t sent_count() const { return sent_; }
+    uint32_t suppressed_count() const { return suppressed_; }
+
+private:
+    bool zone_needs_send(std::size_t zone, int16_t value, uint32_t now_ms) const;
+
+    int16_t deadband_;
+    uint32_t max_silence_ms_;
+    std::array<int16_t, max_zones> last_value_;
+    std::array<uint32_t, max_zones> last_sent_ms_;
+    std::array<bool, max_zones> has_sent_;
+    uint32_t sent_;
+    uint32_t suppressed_;
+};
@@ -0,0 +1,73 @@
+#include "frame_dispatcher.hh"
+
+FrameDispatcher::FrameDispatcher(IClock* clock) : clock_(clock), sinks_(), count_(0)
+{
+}
+
+DispatchStatus FrameDispatcher::add_sink(IFrameSink& sink, const SinkPolicy& policy, uint8_t& index)
+{
+    if (count_ >= max_sinks) {
+        return DispatchStatus::TooManySinks;
+    }
+    Entry& entry = sinks_[count_];
+    entry = Entry();
+    entry.sink = &sink;
+    entry.policy = policy;
+    if (entry.policy.interval == 0) {
+        entry.policy.interval = 1;
+    }
+    index = static_cast<uint8_t>(count_++);
+    return DispatchStatus::Success;
+}
+
+void FrameDispatcher::publish(const FrameView& frame)
+{
+    for (std::size_t i = 0; i < count_; i++) {
+        Entry& entry = sinks_[i];
+        if (!(entry.policy.content & frame.content) || (entry.policy.needs_zones && frame.zone_means == nullptr)) {
+            continue;
+        }
+        const uint16_t phase = entry.phase;
+        entry.phase = static_cast<uint16_t>((phase + 1) % entry.policy.interval);
+        if (phase != 0) {
+            continue;
+        }
+        const uint32_t start_us = clock_ ? clock_->now_us() : 0;
+        if (entry.suspended) {
+            if (static_cast<int32_t>(start_us - entry.resume_us) < 0) {
+                entry.stats.dropped++;
+                continue;
+            }
+            entry.suspended = false;
+        }
+
+        switch (entry.sink->consume(frame)) {
+            case SinkResult::Sent: entry.stats.sent++; break;
+            case SinkResult::Skipped: entry.stats.skipped++; break;
+            case SinkResult::Dropped: entry.stats.dropped++; break;
+        }
+
+        if (!clock_) {
+            continue;
+        }
+        const uint32_t end_us = clock_->now_us();
+        const uint32_t elapsed_us = end_us - start_us;
+        if (elapsed_us > entry.stats.max_us) {
+            entry.stats.max_us = elapsed_us;
+        }
+        if (entry.policy.budget_us != 0 && elapsed_us > entry.policy.budget_us) {
+            entry.stats.overruns++;
+            entry.suspended = true;
+            entry.resume_us = end_us + (elapsed_us - entry.policy.budget_us);
+        }
+    }
+}
+
+bool FrameDispatcher::service()
+{
+    bool worked = false;
+    for (std::size_t i = 0; i < count_; i++) {
+        worked = sinks_[i].sink->service() || worked;
+    }
+    return worked;
+}
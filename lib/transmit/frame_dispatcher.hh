@@ -0,0 +1,121 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "frame_header.hh"
+#include "i_clock.hh"
+
+/// Frame contents, FrameView::content and SinkPolicy::content bits.
+constexpr uint8_t frame_content_temperatures = 0x01;
+constexpr uint8_t frame_content_image = 0x02;
+
+/// @brief One processed frame, published by reference: every sink reads the driver's and the
+/// reducer's own buffers, valid only during FrameDispatcher::publish().
+struct FrameView {
+    const mlx90641::FrameHeader* header;
+    const float* pixels;             // rows × columns, row-major
+    uint8_t rows;
+    uint8_t columns;
+    uint8_t content;                 // frame_content_temperatures or frame_content_image
+    // Zone results in °C × 10, nullptr when the frame was not reduced (image frames)
+    const int16_t* zone_means;
+    const int16_t* zone_mins;
+    const int16_t* zone_maxs;
+    const int16_t* zone_percentiles;
+    uint8_t zone_count;
+
+    /// @brief Points the zone results at `reducer` (a BasicZoneReducer).
+    template <typename Reducer>
+    void attach_zones(const Reducer& reducer)
+    {
+        zone_means = reducer.means();
+        zone_mins = reducer.mins();
+        zone_maxs = reducer.maxs();
+        zone_percentiles = reducer.percentiles();
+        zone_count = static_cast<uint8_t>(reducer.zone_count());
+    }
+};
+
+/// @brief What a sink did with a frame.
+enum class SinkResult : uint8_t {
+    Sent = 0,
+    Skipped,   // by the sink's own policy: unchanged values, nobody connected, ...
+    Dropped,   // the sink could not keep up (queue or buffers full)
+};
+
+/// @brief Output of published frames (serial, BLE, flash, ...), in its own format.
+///
+/// consume() runs on the acquisition task: it only formats the frame into the sink's own
+/// bounded queue (see SinkQueue) and returns Dropped when that is full. service(), from a
+/// low-priority task, does the slow part: serial writes, notifications, flash.
+class IFrameSink {
+public:
+    virtual ~IFrameSink() = default;
+    /// @brief Formats and queues `frame`. Must not block nor keep pointers into it.
+    virtual SinkResult consume(const FrameView& frame) = 0;
+    /// @brief Sends what consume() queued. Called by FrameDispatcher::service().
+    /// @return true if there was anything to do.
+    virtual bool service() { return false; }
+};
+
+/// @brief Which frames a sink gets.
+struct SinkPolicy {
+    uint8_t content;     // frame_content_* bits the sink takes
+    bool needs_zones;    // only frames with zone results
+    uint16_t interval;   // every Nth frame the sink takes, 1: all of them
+    uint32_t budget_us;  // a longer consume() suspends the sink for the excess, 0: no limit
+};
+
+/// @brief Per-sink counters, see FrameDispatcher::stats().
+struct SinkStats {
+    uint32_t sent;
+    uint32_t skipped;
+    uint32_t dropped;    // by the sink, or while suspended after an overrun
+    uint32_t overruns;   // consume() calls over budget_us
+    uint32_t max_us;     // longest consume() call
+};
+
+enum class DispatchStatus {
+    Success = 0,
+    TooManySinks,
+};
+
+/// @brief Publishes each frame to the registered sinks, in registration order.
+///
+/// Nothing is copied: sinks get a view of the buffers the frame was computed in. Each sink has
+/// its own rate and content policy. With a clock, a sink that takes longer than its budget
+/// (e.g. a BLE stack waiting for transmit buffers) misses frames for as long as it overran, so
+/// on average it cannot take more than its budget from the acquisition loop; those frames are
+/// counted as dropped, like the frames a sink drops because its queue is full.
+class FrameDispatcher {
+public:
+    static constexpr std::size_t max_sinks = 8;
+
+    explicit FrameDispatcher(IClock* clock = nullptr);
+
+    /// @param index Receives the sink's index for stats() on success.
+    DispatchStatus add_sink(IFrameSink& sink, const SinkPolicy& policy, uint8_t& index);
+
+    void publish(const FrameView& frame);
+
+    /// @brief Lets every sink send what it queued. Call from one low-priority task.
+    /// @return true if any sink had anything to do.
+    bool service();
+
+    std::size_t sink_count() const { return count_; }
+    const SinkStats& stats(uint8_t index) const { return sinks_[index].stats; }
+
+private:
+    struct Entry {
+        IFrameSink* sink;
+        SinkPolicy policy;
+        uint16_t phase;              // frames taken since the last delivery, modulo interval
+        bool suspended;
+        uint32_t resume_us;
+        SinkStats stats;
+    };
+
+    IClock* clock_;
+    std::array<Entry, max_sinks> sinks_;
+    std::size_t count_;
+};
@@ -0,0 +1,16 @@
+// Abstract class to represent one direction of a message link (BLE notifications or writes)
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Unreliable, message-oriented link: a message arrives whole or not at all.
+class IBulkLink {
+public:
+    virtual ~IBulkLink() = default;
+    /// @brief Largest message send() accepts, e.g. the ATT MTU minus 3.
+    virtual std::size_t max_message() const = 0;
+    /// @brief Queues one message without blocking.
+    /// @return false if it could not be queued now (transmit buffers full, not connected).
+    virtual bool send(const uint8_t* data, std::size_t size) = 0;
+};
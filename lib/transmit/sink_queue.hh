@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Bounded lock-free queue between a sink's consume(), on the acquisition task, and its
+/// service(), on a low-priority task: one producer, one consumer.
+///
+/// Elements are filled and read in place, so a frame-sized element is never copied twice.
+/// The producer fills slot(0) .. slot(n - 1) and publishes them with push(n); when there is no
+/// room, the sink drops the frame instead of waiting.
+template <typename T, std::size_t Capacity>
+class SinkQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr std::size_t capacity = Capacity;
+
+    SinkQueue() : slots_(), write_(0), read_(0) {}
+
+    /// @brief Producer: slots not holding queued elements.
+    std::size_t free_slots() const
+    {
+        return Capacity - (write_.load(std::memory_order_relaxed) - read_.load(std::memory_order_acquire));
+    }
+
+    /// @brief Producer: the `ahead`-th free slot, to fill before push(). Only valid below free_slots().
+    T& slot(std::size_t ahead = 0) { return slots_[(write_.load(std::memory_order_relaxed) + ahead) % Capacity]; }
+
+    /// @brief Producer: queues the first `count` free slots.
+    void push(std::size_t count = 1)
+    {
+        write_.store(write_.load(std::memory_order_relaxed) + static_cast<uint32_t>(count),
+                     std::memory_order_release);
+    }
+
+    /// @brief Consumer: the oldest queued element, nullptr if the queue is empty.
+    T* front()
+    {
+        const uint32_t position = read_.load(std::memory_order_relaxed);
+        if (position == write_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots_[position % Capacity];
+    }
+
+    /// @brief Consumer: releases the element front() returned.
+    void pop() { read_.store(read_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    std::array<T, Capacity> slots_;
+    std::atomic<uint32_t> write_;
+    std::atomic<uint32_t> read_;
+};
@@ -0,0 +1,120 @@
+#include "zone_broadcast.hh"
+#include <cstring>
+
+namespace {
+
+constexpr int16_t no_data = INT16_MIN;
+constexpr int32_t min_tenths = -400;          // -40 °C
+constexpr int32_t max_code = 0x3FE;
+constexpr std::size_t header_bytes = 4;
+constexpr unsigned zone_bits = 10;
+
+void put_bits(uint8_t* out, std::size_t bit, uint16_t value)
+{
+    for (unsigned i = 0; i < zone_bits; i++, bit++) {
+        if (value & (1u << i)) {
+            out[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+        }
+    }
+}
+
+uint16_t get_bits(const uint8_t* in, std::size_t bit)
+{
+    uint16_t value = 0;
+    for (unsigned i = 0; i < zone_bits; i++, bit++) {
+        if (in[bit / 8] & (1u << (bit % 8))) {
+            value |= static_cast<uint16_t>(1u << i);
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+bool decode_zone_broadcast(const uint8_t* data, std::size_t size, BroadcastPage& page)
+{
+    if (size < 2 + header_bytes || (data[0] | data[1] << 8) != zone_broadcast_company_id) {
+        return false;
+    }
+    const uint8_t* payload = data + 2;
+    if (payload[0] != zone_broadcast_version) {
+        return false;
+    }
+    page.sensor_id = payload[1];
+    page.sequence = payload[2];
+    page.page = payload[3] >> 6;
+    page.last = (payload[3] >> 5) & 1;
+    page.zone_count = static_cast<uint8_t>((payload[3] & 0x1F) + 1);
+    if (page.zone_count > BroadcastPage::max_zones ||
+        size < 2 + header_bytes + (page.zone_count * zone_bits + 7) / 8) {
+        return false;
+    }
+    for (std::size_t zone = 0; zone < page.zone_count; zone++) {
+        page.zones[zone] = ZoneBroadcaster::decode_zone(get_bits(payload + header_bytes, zone * zone_bits));
+    }
+    return true;
+}
+
+ZoneBroadcaster::ZoneBroadcaster(uint8_t sensor_id, uint32_t interval_ms)
+    : sensor_id_(sensor_id), interval_ms_(interval_ms), latest_(), snapshot_(), latest_count_(0), snapshot_count_(0),
+      page_(0), sequence_(0), started_(false), last_ms_(0)
+{
+}
+
+void ZoneBroadcaster::update(const int16_t* zones, std::size_t zone_count)
+{
+    latest_count_ = zone_count < max_zones ? zone_count : max_zones;
+    std::memcpy(latest_.data(), zones, latest_count_ * sizeof(int16_t));
+}
+
+bool ZoneBroadcaster::next(uint32_t now_ms, uint8_t* data)
+{
+    if (latest_count_ == 0 || (started_ && now_ms - last_ms_ < interval_ms_)) {
+        return false;
+    }
+    if (page_ == 0) {
+        snapshot_ = latest_;
+        snapshot_count_ = latest_count_;
+    }
+    const std::size_t first = page_ * zones_per_page;
+    const std::size_t left = snapshot_count_ - first;
+    const std::size_t count = left < zones_per_page ? left : zones_per_page;
+    const bool last = first + count >= snapshot_count_;
+
+    std::memset(data, 0, zone_broadcast_data_bytes);
+    data[0] = static_cast<uint8_t>(zone_broadcast_company_id);
+    data[1] = static_cast<uint8_t>(zone_broadcast_company_id >> 8);
+    uint8_t* payload = data + 2;
+    payload[0] = zone_broadcast_version;
+    payload[1] = sensor_id_;
+    payload[2] = sequence_;
+    payload[3] = static_cast<uint8_t>(page_ << 6 | (last ? 1 : 0) << 5 | (count - 1));
+    for (std::size_t zone = 0; zone < count; zone++) {
+        put_bits(payload + header_bytes, zone * zone_bits, encode_zone(snapshot_[first + zone]));
+    }
+
+    sequence_++;
+    page_ = last ? 0 : static_cast<uint8_t>(page_ + 1);
+    started_ = true;
+    last_ms_ = now_ms;
+    return true;
+}
+
+uint16_t ZoneBroadcaster::encode_zone(int16_t value)
+{
+    if (value == no_data) {
+        return no_data_code;
+    }
+    // °C × 10 to 0.25 °C steps, rounded: (value + 400) × 4 / 10
+    const int32_t code = ((value - min_tenths) * 2 + 2) / 5;
+    return static_cast<uint16_t>(code < 0 ? 0 : code > max_code ? max_code : code);
+}
+
+int16_t ZoneBroadcaster::decode_zone(uint16_t code)
+{
+    if (code >= no_data_code) {
+        return no_data;
+    }
+    // 0.25 °C steps to °C × 10, rounded: code × 10 / 4
+    return static_cast<int16_t>((code * 5 + 1) / 2 + min_tenths);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Connectionless broadcast of zone temperatures in manufacturer-specific advertising data.
+//
+// Legacy advertising carries 31 bytes: after the flags (3) and the AD structure header (2)
+// there are 26 bytes for the company identifier and zone_broadcast_payload_bytes of payload:
+//   version, sensor id, sequence, page byte (index << 6 | last page << 5 | zone count - 1),
+//   then up to 16 zones of 10 bits, little-endian bit order: 0.25 °C steps from -40 °C
+//   (-40 .. 215.5 °C), 0x3FF for a zone without data.
+// More zones than fit in one payload are sent as pages, one per rotation step.
+
+constexpr uint8_t zone_broadcast_version = 1;
+constexpr uint16_t zone_broadcast_company_id = 0xFFFF; // reserved for testing by the Bluetooth SIG
+constexpr std::size_t zone_broadcast_payload_bytes = 24;
+constexpr std::size_t zone_broadcast_data_bytes = 2 + zone_broadcast_payload_bytes; // with the company id
+
+/// @brief One decoded broadcast page.
+struct BroadcastPage {
+    static constexpr std::size_t max_zones = 16;
+
+    uint8_t sensor_id;
+    uint8_t sequence;
+    uint8_t page;
+    bool last;
+    uint8_t zone_count;
+    std::array<int16_t, max_zones> zones;   // °C × 10, INT16_MIN without data
+};
+
+/// @brief Decodes manufacturer data (company id first), e.g. on a scanner.
+/// @return false if it is not a zone broadcast of this version.
+bool decode_zone_broadcast(const uint8_t* data, std::size_t size, BroadcastPage& page);
+
+/// @brief Builds the rotating advertising data from the latest zone values.
+///
+/// Values are snapshotted when a rotation starts at page 0, so the pages of one sequence
+/// number come from the same frame. Each rotation step (a new advertising payload) gets the
+/// next sequence number: scanners drop repeats of the same payload and can count the missed
+/// ones.
+class ZoneBroadcaster {
+public:
+    static constexpr std::size_t zones_per_page = BroadcastPage::max_zones;
+    static constexpr std::size_t max_pages = 4;
+    static constexpr std::size_t max_zones = zones_per_page * max_pages;
+    static constexpr uint16_t no_data_code = 0x3FF;
+
+    /// @param interval_ms Time each payload is advertised before the next one.
+    ZoneBroadcaster(uint8_t sensor_id, uint32_t interval_ms);
+
+    /// @brief Latest zone values (°C × 10, as ZoneReducer::means()); extra zones are ignored.
+    void update(const int16_t* zones, std::size_t zone_count);
+
+    /// @brief Builds the next payload when the current one has been on air for interval_ms.
+    /// @param data Receives zone_broadcast_data_bytes of manufacturer data.
+    /// @return false if nothing is due (or no zone values yet).
+    bool next(uint32_t now_ms, uint8_t* data);
+
+    void set_interval_ms(uint32_t interval_ms) { interval_ms_ = interval_ms; }
+    void set_sensor_id(uint8_t sensor_id) { sensor_id_ = sensor_id; }
+    uint8_t sequence() const { return sequence_; }
+
+    static uint16_t encode_zone(int16_t value);
+    static int16_t decode_zone(uint16_t code);
+
+private:
+    uint8_t sensor_id_;
+    uint32_t interval_ms_;
+    std::array<int16_t, max_zones> latest_;
+    std::array<int16_t, max_zones> snapshot_;
+    std::size_t latest_count_;
+    std::size_t snapshot_count_;
+    uint8_t page_;               // next page to send
+    uint8_t sequence_;
+    bool started_;
+    uint32_t last_ms_;
+};
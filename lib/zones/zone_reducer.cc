@@ -0,0 +1,230 @@
+#include "zone_reducer.hh"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+template <typename Traits>
+std::size_t BasicPixelMask<Traits>::count() const
+{
+    std::size_t total = 0;
+    for (std::size_t pixel = 0; pixel < num_pixels; ++pixel) {
+        if (test(pixel)) {
+            total++;
+        }
+    }
+    return total;
+}
+
+template <typename Traits>
+BasicPixelMask<Traits> BasicPixelMask<Traits>::columns(std::size_t first_column, std::size_t last_column)
+{
+    BasicPixelMask mask;
+    for (std::size_t row = 0; row < num_rows; ++row) {
+        for (std::size_t col = first_column; col <= last_column && col < num_columns; ++col) {
+            mask.set(row * num_columns + col);
+        }
+    }
+    return mask;
+}
+
+template <typename Traits>
+BasicPixelMask<Traits> BasicPixelMask<Traits>::rows(std::size_t first_row, std::size_t last_row)
+{
+    BasicPixelMask mask;
+    for (std::size_t row = first_row; row <= last_row && row < num_rows; ++row) {
+        for (std::size_t col = 0; col < num_columns; ++col) {
+            mask.set(row * num_columns + col);
+        }
+    }
+    return mask;
+}
+
+template <typename Traits>
+BasicPixelMask<Traits> BasicPixelMask<Traits>::rectangle(std::size_t first_row, std::size_t last_row,
+                                                         std::size_t first_column, std::size_t last_column)
+{
+    BasicPixelMask mask;
+    for (std::size_t row = first_row; row <= last_row && row < num_rows; ++row) {
+        for (std::size_t col = first_column; col <= last_column && col < num_columns; ++col) {
+            mask.set(row * num_columns + col);
+        }
+    }
+    return mask;
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+BasicZoneReducer<Traits, MaxMemberships>::BasicZoneReducer(uint8_t percentile)
+    : percentile_(percentile > 100 ? 100 : percentile)
+{
+    clear();
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+void BasicZoneReducer<Traits, MaxMemberships>::clear()
+{
+    zone_count_ = 0;
+    membership_count_ = 0;
+    zone_begin_.fill(0);
+    zone_size_.fill(0);
+    means_.fill(0);
+    mins_.fill(0);
+    maxs_.fill(0);
+    percentiles_.fill(0);
+    rebuild_pixel_index();
+    begin_frame();
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+ZoneStatus BasicZoneReducer<Traits, MaxMemberships>::add_zone(const PixelMask& mask, uint8_t& zone_index)
+{
+    const std::size_t size = mask.count();
+    if (size == 0) {
+        return ZoneStatus::EmptyZone;
+    }
+    if (zone_count_ >= max_zones) {
+        return ZoneStatus::TooManyZones;
+    }
+    if (membership_count_ + size > max_memberships) {
+        return ZoneStatus::TooManyMemberships;
+    }
+
+    zone_index = static_cast<uint8_t>(zone_count_);
+    masks_[zone_count_] = mask;
+    zone_begin_[zone_count_] = static_cast<uint16_t>(membership_count_);
+    zone_size_[zone_count_] = static_cast<uint16_t>(size);
+    membership_count_ += size;
+    zone_count_++;
+
+    rebuild_pixel_index();
+    return ZoneStatus::Success;
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+ZoneStatus BasicZoneReducer<Traits, MaxMemberships>::add_columns(uint8_t& first_zone)
+{
+    if (zone_count_ + PixelMask::num_columns > max_zones) {
+        return ZoneStatus::TooManyZones;
+    }
+    first_zone = static_cast<uint8_t>(zone_count_);
+    for (std::size_t col = 0; col < PixelMask::num_columns; ++col) {
+        uint8_t zone;
+        const ZoneStatus status = add_zone(PixelMask::columns(col, col), zone);
+        if (status != ZoneStatus::Success) {
+            return status;
+        }
+    }
+    return ZoneStatus::Success;
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+ZoneStatus BasicZoneReducer<Traits, MaxMemberships>::add_rows(uint8_t& first_zone)
+{
+    if (zone_count_ + PixelMask::num_rows > max_zones) {
+        return ZoneStatus::TooManyZones;
+    }
+    first_zone = static_cast<uint8_t>(zone_count_);
+    for (std::size_t row = 0; row < PixelMask::num_rows; ++row) {
+        uint8_t zone;
+        const ZoneStatus status = add_zone(PixelMask::rows(row, row), zone);
+        if (status != ZoneStatus::Success) {
+            return status;
+        }
+    }
+    return ZoneStatus::Success;
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+ZoneStatus BasicZoneReducer<Traits, MaxMemberships>::add_tire_bands(uint8_t& first_zone)
+{
+    // Columns split 5/6/5 (MLX90641) or 10/12/10 (MLX90640) so the middle band is centred on the tread.
+    constexpr std::size_t outer = PixelMask::num_columns / 3;
+    constexpr std::size_t band_first_column[num_tire_bands] = {0, outer, PixelMask::num_columns - outer};
+    constexpr std::size_t band_last_column[num_tire_bands] = {
+        outer - 1, PixelMask::num_columns - outer - 1, PixelMask::num_columns - 1};
+
+    if (zone_count_ + num_tire_bands > max_zones) {
+        return ZoneStatus::TooManyZones;
+    }
+    first_zone = static_cast<uint8_t>(zone_count_);
+    for (std::size_t band = 0; band < num_tire_bands; ++band) {
+        uint8_t zone;
+        const ZoneStatus status = add_zone(PixelMask::columns(band_first_column[band], band_last_column[band]), zone);
+        if (status != ZoneStatus::Success) {
+            return status;
+        }
+    }
+    return ZoneStatus::Success;
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+void BasicZoneReducer<Traits, MaxMemberships>::begin_frame()
+{
+    for (std::size_t zone = 0; zone < zone_count_; ++zone) {
+        sum_[zone] = 0.0f;
+        min_[zone] = std::numeric_limits<float>::max();
+        max_[zone] = -std::numeric_limits<float>::max();
+        filled_[zone] = 0;
+    }
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+void BasicZoneReducer<Traits, MaxMemberships>::end_frame()
+{
+    for (std::size_t zone = 0; zone < zone_count_; ++zone) {
+        const uint16_t count = filled_[zone];
+        if (count == 0) {
+            means_[zone] = no_data;
+            mins_[zone] = no_data;
+            maxs_[zone] = no_data;
+            percentiles_[zone] = no_data;
+            continue;
+        }
+        means_[zone] = to_fixed_point(sum_[zone] / count);
+        mins_[zone] = to_fixed_point(min_[zone]);
+        maxs_[zone] = to_fixed_point(max_[zone]);
+
+        // Nearest-rank percentile: the smallest value with at least percentile_% of samples at or below it.
+        std::size_t rank = (static_cast<std::size_t>(percentile_) * count + 99) / 100;
+        if (rank == 0) {
+            rank = 1;
+        }
+        float* first = values_.data() + zone_begin_[zone];
+        std::nth_element(first, first + rank - 1, first + count);
+        percentiles_[zone] = to_fixed_point(first[rank - 1]);
+    }
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+int16_t BasicZoneReducer<Traits, MaxMemberships>::to_fixed_point(float celsius)
+{
+    const float scaled = std::round(celsius * fixed_point_scale);
+    if (!(scaled > std::numeric_limits<int16_t>::min())) {
+        return std::numeric_limits<int16_t>::min();
+    }
+    if (scaled > std::numeric_limits<int16_t>::max()) {
+        return std::numeric_limits<int16_t>::max();
+    }
+    return static_cast<int16_t>(scaled);
+}
+
+template <typename Traits, std::size_t MaxMemberships>
+void BasicZoneReducer<Traits, MaxMemberships>::rebuild_pixel_index()
+{
+    std::size_t membership = 0;
+    for (std::size_t pixel = 0; pixel < PixelMask::num_pixels; ++pixel) {
+        pixel_begin_[pixel] = static_cast<uint16_t>(membership);
+        for (std::size_t zone = 0; zone < zone_count_; ++zone) {
+            if (masks_[zone].test(pixel)) {
+                membership_zone_[membership] = static_cast<uint8_t>(zone);
+                membership++;
+            }
+        }
+    }
+    pixel_begin_[PixelMask::num_pixels] = static_cast<uint16_t>(membership);
+}
+
+template class BasicPixelMask<MLX90641Traits>;
+template class BasicPixelMask<MLX90640Traits>;
+template class BasicZoneReducer<MLX90641Traits>;
+template class BasicZoneReducer<MLX90640Traits>;
+template class BasicZoneReducer<MLX90641Traits, 2 * MLX90641Traits::num_pixels>; // LayeredZoneReducer
@@ -0,0 +1,166 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "sensor_traits.hh"
+
+/// @brief Membership mask over the pixel array of the sensor described by `Traits`.
+///
+/// Pixels are indexed row-major (pixel = row * num_columns + column), the same order
+/// the driver writes its temperature array in.
+template <typename Traits>
+class BasicPixelMask {
+public:
+    static constexpr std::size_t num_rows = Traits::num_rows;
+    static constexpr std::size_t num_columns = Traits::num_columns;
+    static constexpr std::size_t num_pixels = Traits::num_pixels;
+
+    BasicPixelMask() { words_.fill(0); }
+
+    void set(std::size_t pixel) { words_[pixel / 32] |= (1ul << (pixel % 32)); }
+    void reset(std::size_t pixel) { words_[pixel / 32] &= ~(1ul << (pixel % 32)); }
+    bool test(std::size_t pixel) const { return (words_[pixel / 32] >> (pixel % 32)) & 1u; }
+    std::size_t count() const;
+
+    /// @brief Mask covering columns [first_column, last_column] over every row.
+    static BasicPixelMask columns(std::size_t first_column, std::size_t last_column);
+
+    /// @brief Mask covering rows [first_row, last_row] over every column.
+    static BasicPixelMask rows(std::size_t first_row, std::size_t last_row);
+
+    /// @brief Mask covering rows [first_row, last_row] of columns [first_column, last_column].
+    static BasicPixelMask rectangle(std::size_t first_row, std::size_t last_row, std::size_t first_column,
+                                    std::size_t last_column);
+
+    /// @brief Mask covering every pixel.
+    static BasicPixelMask all() { return rows(0, num_rows - 1); }
+
+private:
+    std::array<uint32_t, (num_pixels + 31) / 32> words_;
+};
+
+enum class ZoneStatus {
+    Success = 0,
+    TooManyZones,
+    TooManyMemberships,
+    EmptyZone,
+};
+
+/// @brief Per-zone reduction (mean/min/max/percentile) fed one pixel at a time.
+///
+/// The reducer is meant to be driven from inside the loop that produces each pixel's
+/// temperature (see MLXSensor::calculate_temps), so the statistics are ready as soon
+/// as the last pixel is converted, without walking the temperature array a second time.
+///
+/// Results are kept as contiguous int16 arrays in °C × 10, the fixed-point format used by
+/// the BLE DataPack, so a range of zones can be copied straight into a packet.
+///
+/// `MaxMemberships` bounds the sum of the zone sizes, and with it most of the reducer's RAM
+/// (5 bytes per membership). The default fits one zone layout over the whole array (columns,
+/// rows or tire bands); layouts where pixels belong to several zones need a larger table.
+template <typename Traits, std::size_t MaxMemberships = Traits::num_pixels>
+class BasicZoneReducer {
+public:
+    using PixelMask = BasicPixelMask<Traits>;
+
+    static constexpr std::size_t max_zones = 32;
+    static constexpr std::size_t max_memberships = MaxMemberships;
+    static constexpr float fixed_point_scale = 10.0f;
+    /// Result of a zone without any pixel in the frame (e.g. outside the driver's region of interest).
+    static constexpr int16_t no_data = INT16_MIN;
+
+    /// @brief Tire bands across the tread. Band columns follow the sensor orientation:
+    /// inner is on the column 0 side.
+    enum class TireBand : uint8_t {
+        Inner = 0,
+        Middle,
+        Outer,
+    };
+    static constexpr std::size_t num_tire_bands = 3;
+
+    /// @param percentile Percentile (0-100) reported for every zone, nearest-rank method.
+    explicit BasicZoneReducer(uint8_t percentile = 90);
+
+    /// @brief Adds a zone covering the pixels set in `mask`.
+    /// @param zone_index Receives the index of the new zone on success.
+    ZoneStatus add_zone(const PixelMask& mask, uint8_t& zone_index);
+
+    /// @brief Adds one zone per column, in column order.
+    ZoneStatus add_columns(uint8_t& first_zone);
+
+    /// @brief Adds one zone per row, in row order.
+    ZoneStatus add_rows(uint8_t& first_zone);
+
+    /// @brief Adds inner/middle/outer tire bands (5/6/5 columns on the MLX90641), in TireBand order.
+    ZoneStatus add_tire_bands(uint8_t& first_zone);
+
+    /// @brief Removes every zone.
+    void clear();
+
+    std::size_t zone_count() const { return zone_count_; }
+
+    /// @brief Resets the per-frame accumulators. Call before the first accumulate() of a frame.
+    void begin_frame();
+
+    /// @brief Folds one pixel value (°C) into every zone containing that pixel.
+    void accumulate(std::size_t pixel, float value)
+    {
+        for (uint16_t m = pixel_begin_[pixel]; m < pixel_begin_[pixel + 1]; ++m) {
+            const uint8_t zone = membership_zone_[m];
+            sum_[zone] += value;
+            if (value < min_[zone]) {
+                min_[zone] = value;
+            }
+            if (value > max_[zone]) {
+                max_[zone] = value;
+            }
+            values_[zone_begin_[zone] + filled_[zone]] = value;
+            filled_[zone]++;
+        }
+    }
+
+    /// @brief Finalizes the frame and converts every zone to fixed point.
+    void end_frame();
+
+    /// @brief Zone means, min, max and percentile in °C × 10, indexed by zone, no_data for a zone
+    /// that received no pixel this frame.
+    const int16_t* means() const { return means_.data(); }
+    const int16_t* mins() const { return mins_.data(); }
+    const int16_t* maxs() const { return maxs_.data(); }
+    const int16_t* percentiles() const { return percentiles_.data(); }
+
+    /// @brief Converts a temperature in °C to the saturated °C × 10 fixed-point format.
+    static int16_t to_fixed_point(float celsius);
+
+private:
+    void rebuild_pixel_index();
+
+    uint8_t percentile_;
+    std::size_t zone_count_;
+    std::size_t membership_count_;
+    std::array<PixelMask, max_zones> masks_;
+
+    // Pixel -> zone lookup: memberships of pixel p are membership_zone_[pixel_begin_[p] .. pixel_begin_[p + 1]).
+    std::array<uint16_t, PixelMask::num_pixels + 1> pixel_begin_;
+    std::array<uint8_t, max_memberships> membership_zone_;
+
+    // Zone z owns values_[zone_begin_[z] .. zone_begin_[z] + zone_size_[z]) for the percentile selection.
+    std::array<uint16_t, max_zones> zone_begin_;
+    std::array<uint16_t, max_zones> zone_size_;
+    std::array<uint16_t, max_zones> filled_;
+    std::array<float, max_memberships> values_;
+
+    std::array<float, max_zones> sum_;
+    std::array<float, max_zones> min_;
+    std::array<float, max_zones> max_;
+
+    std::array<int16_t, max_zones> means_;
+    std::array<int16_t, max_zones> mins_;
+    std::array<int16_t, max_zones> maxs_;
+    std::array<int16_t, max_zones> percentiles_;
+};
+
+using PixelMask = BasicPixelMask<MLX90641Traits>;
+using ZoneReducer = BasicZoneReducer<MLX90641Traits>;
+/// Two overlapping layouts, e.g. columns and tire bands.
+using LayeredZoneReducer = BasicZoneReducer<MLX90641Traits, 2 * MLX90641Traits::num_pixels>;
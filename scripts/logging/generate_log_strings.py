@@ -0,0 +1,82 @@
+"""Generate the string table used to decode binary (deferred) log records.
+
+Every LOG_DEBUG/LOG_INFO/LOG_WARN/LOG_ERROR call site is keyed by the FNV-1a hash of its
+format string (see log_message_id in lib/logger/logger.hh). This script finds the format
+strings in the sources and writes a CSV table "id,level,format" for tools/log_decoder.
+
+Usage:
+    python generate_log_strings.py [project_dir] [output.csv]
+
+When listed in platformio.ini `extra_scripts`, it writes $BUILD_DIR/log_strings.csv.
+"""
+
+import csv
+import os
+import re
+import sys
+
+SOURCE_DIRS = ("src", "lib", "include")
+SOURCE_EXTENSIONS = (".c", ".cc", ".cpp", ".h", ".hh", ".hpp")
+
+CALL_RE = re.compile(
+    r"\bLOG_(DEBUG|INFO|WARN|ERROR)\s*\(\s*"   # macro name
+    r"[^,;]+?,\s*"                            # logger expression
+    r"((?:\"(?:[^\"\\]|\\.)*\"\s*)+)",        # one or more adjacent string literals
+    re.DOTALL,
+)
+LITERAL_RE = re.compile(r"\"((?:[^\"\\]|\\.)*)\"")
+
+
+def fnv1a(data):
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def unescape(literal):
+    return literal.encode("latin-1").decode("unicode_escape").encode("latin-1")
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.DOTALL)
+    return re.sub(r"//[^\n]*", " ", text)
+
+
+def collect(project_dir):
+    table = {}
+    for source_dir in SOURCE_DIRS:
+        for root, _, files in os.walk(os.path.join(project_dir, source_dir)):
+            for name in sorted(files):
+                if not name.endswith(SOURCE_EXTENSIONS):
+                    continue
+                with open(os.path.join(root, name), encoding="utf-8", errors="replace") as source:
+                    text = strip_comments(source.read())
+                for match in CALL_RE.finditer(text):
+                    data = b"".join(unescape(part) for part in LITERAL_RE.findall(match.group(2)))
+                    table[fnv1a(data)] = (match.group(1), data.decode("latin-1"))
+    return table
+
+
+def write_table(table, output_path):
+    os.makedirs(os.path.dirname(os.path.abspath(output_path)), exist_ok=True)
+    with open(output_path, "w", newline="") as output:
+        writer = csv.writer(output)
+        for message_id, (level, fmt) in sorted(table.items()):
+            writer.writerow(["0x%08X" % message_id, level, fmt])
+
+
+def main(argv):
+    project_dir = argv[1] if len(argv) > 1 else os.getcwd()
+    output_path = argv[2] if len(argv) > 2 else "log_strings.csv"
+    table = collect(project_dir)
+    write_table(table, output_path)
+    print("Wrote %d log strings to %s" % (len(table), output_path))
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO when run as an extra script
+    main(["", env.subst("$PROJECT_DIR"), env.subst("$BUILD_DIR/log_strings.csv")])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        main(sys.argv)
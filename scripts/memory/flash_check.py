@@ -0,0 +1,95 @@
+"""Fails the firmware build when the application image reaches the session recording region.
+
+The Adafruit nRF52832 linker script lets the application grow up to InternalFS (0x6D000), and
+the recording region (FLASH_LOG_ADDRESS, include/nrf_flash.hh) sits right below it: the
+recorder erasing one of its pages would then erase application code. The image ends at
+__etext plus the initialized data stored after it.
+
+Runs after each firmware build when listed in platformio.ini:
+
+    extra_scripts = post:scripts/memory/flash_check.py
+
+or standalone on an existing firmware:
+
+    python scripts/memory/flash_check.py .pio/build/adafruit_feather_nrf52832/firmware.elf
+"""
+
+import argparse
+import subprocess
+import sys
+
+INTERNAL_FS_ADDRESS = 0x6D000
+FLASH_PAGE_SIZE = 4096
+DEFAULT_LOG_PAGES = 12  # FLASH_LOG_PAGES, include/nrf_flash.hh
+
+
+def symbols(nm, elf):
+    """Address of every symbol of the firmware, by name."""
+    output = subprocess.run([nm, elf], capture_output=True, text=True, check=True).stdout
+    table = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3:
+            table[fields[2]] = int(fields[0], 16)
+    return table
+
+
+def image_end(table):
+    return table["__etext"] + table["__data_end__"] - table["__data_start__"]
+
+
+def log_address(defines):
+    """FLASH_LOG_ADDRESS as include/nrf_flash.hh computes it from the build's -D flags."""
+    if "FLASH_LOG_ADDRESS" in defines:
+        return int(defines["FLASH_LOG_ADDRESS"], 0)
+    pages = int(defines.get("FLASH_LOG_PAGES", str(DEFAULT_LOG_PAGES)), 0)
+    return INTERNAL_FS_ADDRESS - pages * FLASH_PAGE_SIZE
+
+
+def check(end, address):
+    print("Application image ends at 0x%05X, recording region starts at 0x%05X: %d B headroom"
+          % (end, address, address - end))
+    return end <= address
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("--log-address", default="", help="FLASH_LOG_ADDRESS, if overridden")
+    parser.add_argument("--log-pages", default="", help="FLASH_LOG_PAGES, if overridden")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    args = parser.parse_args(argv)
+
+    defines = {}
+    if args.log_address:
+        defines["FLASH_LOG_ADDRESS"] = args.log_address
+    if args.log_pages:
+        defines["FLASH_LOG_PAGES"] = args.log_pages
+    if not check(image_end(symbols(args.nm, args.elf)), log_address(defines)):
+        print("The application overlaps the recording region", file=sys.stderr)
+        return 1
+    return 0
+
+
+def _build_defines(env):
+    defines = {}
+    for define in env.get("CPPDEFINES", []):
+        if isinstance(define, (list, tuple)) and len(define) == 2:
+            defines[str(define[0])] = str(define[1])
+    return defines
+
+
+def _post_build(target, source, env):
+    nm = env.subst("$CC").replace("gcc", "nm")
+    elf = env.subst("$BUILD_DIR/${PROGNAME}.elf")
+    if not check(image_end(symbols(nm, elf)), log_address(_build_defines(env))):
+        sys.stderr.write("The application overlaps the recording region, see include/nrf_flash.hh\n")
+        env.Exit(1)
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run by PlatformIO
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _post_build)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main())
@@ -0,0 +1,111 @@
+"""Per-component static RAM report for the firmware build.
+
+Sums the .data and .bss symbols of every object in the build directory and groups them by
+component: one entry per file in src/, per project library in lib/, and one for the
+Arduino framework. Project components are checked against a RAM budget.
+
+Runs after each firmware build when listed in platformio.ini:
+
+    extra_scripts = post:scripts/memory/ram_report.py
+    custom_ram_budget = 20480   ; bytes for src/ + lib/, the framework is reported only
+
+or standalone on an existing build directory:
+
+    python scripts/memory/ram_report.py .pio/build/adafruit_feather_nrf52832 --budget 20480
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+from collections import defaultdict
+
+RAM_SYMBOL_TYPES = set("bBdDcCgGsSvV")  # bss, data, common, small data, weak objects
+
+
+def component_for(build_dir, path):
+    """Maps an object or archive path to (component name, is project code)."""
+    rel = os.path.relpath(path, build_dir).replace(os.sep, "/")
+    parts = rel.split("/")
+    if parts[0] == "src":
+        return "src/" + os.path.splitext(parts[-1])[0], True
+    if parts[0].startswith("lib") and len(parts) > 2:
+        # Project libraries are built in $BUILD_DIR/lib<hash>/<name>/
+        return "lib/" + parts[1], True
+    return "framework", False
+
+
+def ram_symbols(nm, path):
+    """Yields (size, name) for every RAM symbol of an object file."""
+    output = subprocess.run([nm, "-S", "-C", "-t", "d", path], capture_output=True, text=True, check=False).stdout
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in RAM_SYMBOL_TYPES:
+            yield int(fields[1]), fields[3]
+
+
+def collect(build_dir, nm):
+    components = defaultdict(lambda: {"bytes": 0, "project": False, "symbols": []})
+    for root, _, files in os.walk(build_dir):
+        for file in files:
+            # Archives are built from these objects, so they are not counted again.
+            if not file.endswith(".o"):
+                continue
+            path = os.path.join(root, file)
+            name, project = component_for(build_dir, path)
+            entry = components[name]
+            entry["project"] = project
+            for size, symbol in ram_symbols(nm, path):
+                entry["bytes"] += size
+                entry["symbols"].append((size, symbol))
+    return components
+
+
+def report(components, budget, top):
+    print("Static RAM by component (.data + .bss):")
+    project_total = 0
+    for name, entry in sorted(components.items(), key=lambda item: -item[1]["bytes"]):
+        if entry["bytes"] == 0:
+            continue
+        print("  %-32s %7d B" % (name, entry["bytes"]))
+        for size, symbol in sorted(entry["symbols"], reverse=True)[:top]:
+            print("      %-40s %7d B" % (symbol[:40], size))
+        if entry["project"]:
+            project_total += entry["bytes"]
+    print("  %-32s %7d B" % ("project total (src + lib)", project_total))
+    if budget:
+        print("  %-32s %7d B" % ("budget", budget))
+        print("  %-32s %7d B" % ("headroom", budget - project_total))
+    return project_total
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("build_dir")
+    parser.add_argument("--budget", type=int, default=0, help="RAM budget for project code in bytes")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--top", type=int, default=5, help="largest symbols listed per component")
+    args = parser.parse_args(argv)
+
+    total = report(collect(args.build_dir, args.nm), args.budget, args.top)
+    if args.budget and total > args.budget:
+        print("RAM budget exceeded by %d B" % (total - args.budget), file=sys.stderr)
+        return 1
+    return 0
+
+
+def _post_build(target, source, env):
+    budget = int(env.GetProjectOption("custom_ram_budget", "0"))
+    nm = env.subst("$CC").replace("gcc", "nm")
+    total = report(collect(env.subst("$BUILD_DIR"), nm), budget, 5)
+    if budget and total > budget:
+        sys.stderr.write("RAM budget exceeded by %d B\n" % (total - budget))
+        env.Exit(1)
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run by PlatformIO
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _post_build)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main())
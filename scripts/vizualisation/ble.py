@@ -1,9 +1,11 @@
 import asyncio
 from bleak import BleakScanner, BleakClient
 import struct
+import time
 import matplotlib.pyplot as plt
 import numpy as np
 import sys
+from frame_stats import FrameStats
 
 # BLE device and characteristic
 DEVICE_NAME = "MLX90641"
@@ -12,6 +14,14 @@ CHAR_UUID = "00000001-0000-1000-8000-00805f9b34fb"
 FULL_COLUMNS = 16
 full_buffer = [0.0] * FULL_COLUMNS  # 16-column averaged temperatures
 
+# Protocol 2 (include/data_pack.hh): a FrameHeaderPack, then the changed DataPacks of the frame
+PROTOCOL = 2
+HEADER_PACKET_ID = 0xFF
+DATA_PACK = struct.Struct("<BBB8h")
+HEADER_PACK = struct.Struct("<BBIIIhHB")
+NO_DATA = -32768  # column outside the region of interest
+stats = FrameStats()
+
 # Global flag for window status
 window_closed = asyncio.Event()
 
@@ -29,12 +39,17 @@ def notification_handler(_, data):
     """Handle incoming BLE notifications."""
     global full_buffer
 
-    if len(data) != 19:
-        print(f"Unexpected packet length: {len(data)}")
+    if len(data) != DATA_PACK.size or data[0] != PROTOCOL:
+        print(f"Unexpected packet: length {len(data)}, protocol {data[0] if data else None}")
+        return
+
+    if data[1] == HEADER_PACKET_ID:
+        _, _, sequence, timestamp_us, sent_us, ta, vdd, sub_page = HEADER_PACK.unpack(data)
+        stats.add(sequence, timestamp_us, sent_us, time.monotonic())
         return
 
-    protocol, packet_id, reserved, *temps = struct.unpack("<BBB8h", data)
-    temps = [t / 10.0 for t in temps]
+    protocol, packet_id, sequence, *temps = DATA_PACK.unpack(data)
+    temps = [float("nan") if t == NO_DATA else t / 10.0 for t in temps]
 
     start_idx = packet_id * 8
     for i, t in enumerate(temps):
@@ -72,6 +87,7 @@ async def main():
         print("Stopping BLE notifications and closing...")
         await client.stop_notify(CHAR_UUID)
         plt.close(fig)
+        print(stats.summary())
         sys.exit(0)
 
 if __name__ == "__main__":
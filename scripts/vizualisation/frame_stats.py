@@ -0,0 +1,71 @@
+"""Drop rate and latency statistics from the frame headers sent by the firmware.
+
+Both outputs carry, per frame, a sequence number (gaps are frames that were not
+delivered), the device time the sensor data became ready and the device time the
+frame was sent. The device and host clocks are not synchronized, so the host-side
+latency is measured relative to the fastest frame seen: the smallest
+(arrival - data-ready) difference is taken as the clock offset.
+"""
+
+DEVICE_CLOCK_WRAP = 1 << 32  # microseconds, ~71 minutes
+
+
+class FrameStats:
+    def __init__(self, bin_ms=5, bins=20):
+        self.bin_ms = bin_ms
+        self.bins = bins
+        self.reset()
+
+    def reset(self):
+        self.received = 0
+        self.dropped = 0
+        self.last_sequence = None
+        self.device_latency_us = []  # sent - data-ready, device clock
+        self.transit_us = []         # host arrival - data-ready, unknown offset
+        self._device_base = 0
+        self._last_timestamp = None
+
+    def add(self, sequence, timestamp_us, sent_us, host_time_s):
+        """Records one frame; host_time_s is its arrival time (time.monotonic())."""
+        if self.last_sequence is not None:
+            gap = (sequence - self.last_sequence) % DEVICE_CLOCK_WRAP
+            if gap == 0 or gap > DEVICE_CLOCK_WRAP // 2:
+                self.reset()  # device restarted
+            else:
+                self.dropped += gap - 1
+        self.last_sequence = sequence
+        self.received += 1
+
+        if self._last_timestamp is not None and timestamp_us < self._last_timestamp:
+            self._device_base += DEVICE_CLOCK_WRAP
+        self._last_timestamp = timestamp_us
+        self.device_latency_us.append((sent_us - timestamp_us) % DEVICE_CLOCK_WRAP)
+        self.transit_us.append(host_time_s * 1e6 - (self._device_base + timestamp_us))
+
+    def drop_rate(self):
+        total = self.received + self.dropped
+        return self.dropped / total if total else 0.0
+
+    def latency_histogram(self):
+        """Counts per bin_ms bin of the end-to-end latency above the fastest frame."""
+        counts = [0] * (self.bins + 1)  # last bin: everything slower
+        if not self.transit_us:
+            return counts
+        offset = min(self.transit_us)
+        for transit in self.transit_us:
+            index = int((transit - offset) / 1000 / self.bin_ms)
+            counts[min(index, self.bins)] += 1
+        return counts
+
+    def summary(self):
+        lines = [f"frames {self.received}, dropped {self.dropped} ({100 * self.drop_rate():.1f} %)"]
+        if self.device_latency_us:
+            device = sorted(self.device_latency_us)
+            lines.append(f"on-device latency median {device[len(device) // 2] / 1000:.1f} ms, "
+                         f"max {device[-1] / 1000:.1f} ms")
+        lines.append(f"end-to-end latency above the fastest frame ({self.bin_ms} ms bins):")
+        for index, count in enumerate(self.latency_histogram()):
+            if count:
+                label = f">= {index * self.bin_ms}" if index == self.bins else f"{index * self.bin_ms}"
+                lines.append(f"  {label:>6} ms  {count}")
+        return "\n".join(lines)
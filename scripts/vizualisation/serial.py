@@ -1,20 +1,27 @@
+import struct
 import time
 import numpy as np
 import matplotlib.pyplot as plt
 import serial
+from frame_stats import FrameStats
 
 # -------- CONFIG ----------
 COM_PORT = "/dev/cu.usbserial-0247185B"
 BAUDRATE = 115200
 ROWS, COLS = 12, 16
-BYTES_PER_FRAME = ROWS * COLS * 4  # 192 floats * 4 bytes
-MIN_TEMP = -40.0   # validation range
-MAX_TEMP = 150.0
 VMIN, VMAX = 20, 50  # initial color scale
+CAPTURE_PATH = None  # e.g. "session.bin": raw serial bytes, for tools/capture_convert
 # --------------------------
 
+# SerialFrameHeader (include/data_pack.hh), followed by payload_bytes bytes
+HEADER = struct.Struct("<IIIIffBBBBH")
+MAGIC = struct.pack("<I", 0x4D524654)
+MAX_FRAME = HEADER.size + 4096
+stats = FrameStats()
+
 ser = serial.Serial(COM_PORT, BAUDRATE, timeout=0.05)
 buf = bytearray()
+capture = open(CAPTURE_PATH, "wb") if CAPTURE_PATH else None
 
 running = True
 
@@ -63,64 +70,82 @@ try:
         if n:
             chunk = ser.read(n)
             buf.extend(chunk)
+            if capture:
+                capture.write(chunk)
         else:
             time.sleep(0.001)
 
-        # try to find one or more aligned valid frames in buffer
+        # frames start with the header magic, anything else (log text) is skipped
         offset = 0
-        buf_len = len(buf)
-        while buf_len - offset >= BYTES_PER_FRAME:
-            candidate = buf[offset: offset + BYTES_PER_FRAME]
-            arr = np.frombuffer(bytes(candidate), dtype='<f4')
-            if arr.size != ROWS * COLS:
+        while True:
+            offset = buf.find(MAGIC, offset)
+            if offset < 0:
+                offset = max(0, len(buf) - len(MAGIC) + 1)
+                break
+            if len(buf) - offset < HEADER.size:
+                break
+            (_, sequence, timestamp_us, sent_us, ta, vdd,
+             sub_page, rows, cols, payload, payload_bytes) = HEADER.unpack_from(buf, offset)
+            frame_bytes = HEADER.size + payload_bytes
+            if rows * cols == 0 or frame_bytes > MAX_FRAME:
                 offset += 1
                 continue
+            if len(buf) - offset < frame_bytes:
+                break
 
-            if np.all(np.isfinite(arr)) and arr.min() >= MIN_TEMP and arr.max() <= MAX_TEMP:
-                # reshape full matrix
-                matrix = arr.reshape((ROWS, COLS))
-
-                # --- Full heatmap update ---
-                im1.set_clim(vmin=np.min(matrix), vmax=np.max(matrix))
-                im1.set_data(matrix)
-
-                # --- Column-average heatmap ---
-                col_avg = np.mean(matrix, axis=0)  # 16 values
-                col_matrix = np.tile(col_avg, (ROWS, 1))  # replicate for display
-                im2.set_clim(vmin=np.min(col_matrix), vmax=np.max(col_matrix))
-                im2.set_data(col_matrix)
-
-                # Update titles
-                ax1.set_title(f"Full Heatmap min:{matrix.min():.2f} max:{matrix.max():.2f}")
-                ax2.set_title(f"Column Avg min:{col_avg.min():.2f} max:{col_avg.max():.2f}")
-
-                # Update FPS
-                frame_count += 1
-                elapsed = time.time() - t0
-                if elapsed >= 1.0:
-                    fps = frame_count / elapsed
-                    frame_count = 0
-                    t0 = time.time()
-                    ax1.set_title(f"Full Heatmap min:{matrix.min():.2f} max:{matrix.max():.2f} fps:{fps:.1f}")
-
-                fig.canvas.draw_idle()
-                plt.pause(0.001)
-
-                offset += BYTES_PER_FRAME
-            else:
-                offset += 1
+            # raw words of a HOST_OFFLOAD firmware: decode with tools/offload_decoder
+            if payload > 1 or (rows, cols) != (ROWS, COLS):
+                offset += frame_bytes  # or another sensor model, set ROWS, COLS to display it
+                continue
+
+            arr = np.frombuffer(bytes(buf[offset + HEADER.size: offset + frame_bytes]), dtype='<f4')
+            stats.add(sequence, timestamp_us, sent_us, time.monotonic())
+            matrix = arr.reshape((ROWS, COLS))
+
+            # --- Full heatmap update ---
+            im1.set_clim(vmin=np.nanmin(matrix), vmax=np.nanmax(matrix))
+            im1.set_data(matrix)
+
+            # --- Column-average heatmap ---
+            col_avg = np.nanmean(matrix, axis=0)  # NaN outside the region of interest
+            col_matrix = np.tile(col_avg, (ROWS, 1))  # replicate for display
+            im2.set_clim(vmin=np.nanmin(col_matrix), vmax=np.nanmax(col_matrix))
+            im2.set_data(col_matrix)
+
+            # Update titles (image frames are not °C, only their ordering is meaningful)
+            kind = "IR image" if payload == 1 else "Full Heatmap"
+            ax1.set_title(f"{kind} min:{np.nanmin(matrix):.2f} max:{np.nanmax(matrix):.2f}")
+            ax2.set_title(f"Column Avg min:{np.nanmin(col_avg):.2f} max:{np.nanmax(col_avg):.2f}")
+
+            # Update FPS
+            frame_count += 1
+            elapsed = time.time() - t0
+            if elapsed >= 1.0:
+                fps = frame_count / elapsed
+                frame_count = 0
+                t0 = time.time()
+                ax1.set_title(f"{kind} min:{np.nanmin(matrix):.2f} max:{np.nanmax(matrix):.2f} fps:{fps:.1f} "
+                              f"Ta:{ta:.1f} Vdd:{vdd:.2f}")
+
+            fig.canvas.draw_idle()
+            plt.pause(0.001)
+
+            offset += frame_bytes
 
         # drop consumed bytes from buffer
         if offset:
             buf = buf[offset:]
 
         # avoid unbounded buffer growth
-        if len(buf) > 10 * BYTES_PER_FRAME:
-            buf = buf[-10 * BYTES_PER_FRAME :]
+        if len(buf) > 10 * MAX_FRAME:
+            buf = buf[-10 * MAX_FRAME :]
 
 except KeyboardInterrupt:
     print("\nInterrupted by user")
 finally:
+    print(stats.summary())
+    if capture:
+        capture.close()
     if ser.is_open:
         ser.close()
         print("Serial port closed.")
@@ -6,6 +6,10 @@ void Wire::begin() {
     ::Wire.begin();
 }
 
+void Wire::end() {
+    ::Wire.end();
+}
+
 void Wire::setClock(uint32_t freq) {
     ::Wire.setClock(freq);
 }
@@ -48,4 +52,31 @@ void Wire::flush() {
 
 void Wire::delayMicroseconds(int us) {
     ::delayMicroseconds(us);
+}
+
+uint32_t Wire::micros() {
+    return ::micros();
+}
+
+// Open drain: released lines are pulled high by the bus pull-ups.
+void Wire::drive_scl(bool high) {
+    if (high) {
+        pinMode(PIN_WIRE_SCL, INPUT);
+    } else {
+        digitalWrite(PIN_WIRE_SCL, LOW);
+        pinMode(PIN_WIRE_SCL, OUTPUT);
+    }
+}
+
+void Wire::drive_sda(bool high) {
+    if (high) {
+        pinMode(PIN_WIRE_SDA, INPUT);
+    } else {
+        digitalWrite(PIN_WIRE_SDA, LOW);
+        pinMode(PIN_WIRE_SDA, OUTPUT);
+    }
+}
+
+bool Wire::read_sda() {
+    return digitalRead(PIN_WIRE_SDA) == HIGH;
 }
\ No newline at end of file
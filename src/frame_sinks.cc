@@ -0,0 +1,137 @@
+#include "frame_sinks.hh"
+#include <Arduino.h> // for Serial, micros, millis
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+SerialFrameHeader makeSerialHeader(SerialPayload payload, const mlx90641::FrameHeader& header, uint8_t rows,
+                                   uint8_t columns, size_t payload_bytes) {
+    SerialFrameHeader serial_header;
+    serial_header.magic = serial_frame_magic;
+    serial_header.sequence = header.sequence;
+    serial_header.timestamp_us = header.timestamp_us;
+    serial_header.sent_us = 0;
+    serial_header.ta = header.ta;
+    serial_header.vdd = header.vdd;
+    serial_header.sub_page = header.sub_page;
+    serial_header.rows = rows;
+    serial_header.columns = columns;
+    serial_header.payload = static_cast<uint8_t>(payload);
+    serial_header.payload_bytes = static_cast<uint16_t>(payload_bytes);
+    return serial_header;
+}
+
+SinkResult DebugPrintSink::consume(const FrameView& frame) {
+    if (queue_.free_slots() == 0) {
+        return SinkResult::Dropped;
+    }
+    std::memcpy(queue_.slot().values, frame.pixels, sizeof(Pixels::values));
+    queue_.push();
+    return SinkResult::Sent;
+}
+
+bool DebugPrintSink::service() {
+    const Pixels* pixels = queue_.front();
+    if (!pixels) {
+        return false;
+    }
+    for (size_t i = 0; i < 10; i++) {
+        Serial.printf("%.2f, ", pixels->values[i]);
+    }
+    queue_.pop();
+    return true;
+}
+
+SinkResult BleZoneSink::consume(const FrameView& frame) {
+    if (!Bluefruit.connected()) {
+        return SinkResult::Skipped;
+    }
+    if (queue_.free_slots() < 1u + packet_count_) {
+        return SinkResult::Dropped; // before the policy takes these columns as sent
+    }
+    const int16_t* columns = frame.zone_means + first_zone_;
+    size_t queued = 0;
+    for (uint8_t packetId = 0; packetId < packet_count_; packetId++) {
+        if (!policy_.should_send(packetId * 8, 8, columns + packetId * 8, millis())) {
+            continue; // unchanged within the dead-band
+        }
+        if (queued == 0) {
+            queue_header(queue_.slot(queued++), *frame.header);
+        }
+        DataPack datapack;
+        datapack.protocol = ble_protocol_version;
+        datapack.packet_id = packetId;
+        datapack.sequence = static_cast<uint8_t>(frame.header->sequence);
+
+        // Fill the 8 temps of this packet
+        std::memcpy(datapack.temps, columns + packetId * 8, sizeof(datapack.temps));
+
+        Packet& packet = queue_.slot(queued++);
+        packet.size = sizeof(datapack);
+        std::memcpy(packet.data, &datapack, sizeof(datapack));
+    }
+    queue_.push(queued);
+    return queued > 0 ? SinkResult::Sent : SinkResult::Skipped;
+}
+
+// Frame metadata first, so the app can tell drops (sequence gaps) and latency (sent_us - timestamp_us)
+void BleZoneSink::queue_header(Packet& packet, const mlx90641::FrameHeader& header) {
+    FrameHeaderPack header_pack;
+    header_pack.protocol = ble_protocol_version;
+    header_pack.packet_id = frame_header_packet_id;
+    header_pack.sequence = header.sequence;
+    header_pack.timestamp_us = header.timestamp_us;
+    header_pack.sent_us = 0; // set by service()
+    header_pack.ta = static_cast<int16_t>(lroundf(header.ta * 100.0f));
+    header_pack.vdd = static_cast<uint16_t>(lroundf(header.vdd * 1000.0f));
+    header_pack.sub_page = header.sub_page;
+    packet.size = sizeof(header_pack);
+    std::memcpy(packet.data, &header_pack, sizeof(header_pack));
+}
+
+bool BleZoneSink::service() {
+    Packet* packet = queue_.front();
+    if (!packet) {
+        return false;
+    }
+    if (packet->data[offsetof(FrameHeaderPack, packet_id)] == frame_header_packet_id) {
+        const uint32_t sent_us = micros();
+        std::memcpy(packet->data + offsetof(FrameHeaderPack, sent_us), &sent_us, sizeof(sent_us));
+    }
+    // Waits for a transmit buffer; fails once the central is gone, the packet is dropped then.
+    characteristic_.notify(packet->data, packet->size);
+    queue_.pop();
+    return true;
+}
+
+SinkResult BroadcastSink::consume(const FrameView& frame) {
+    broadcaster_.update(frame.zone_means + first_zone_, zone_count_);
+    if (queue_.free_slots() == 0) {
+        return SinkResult::Dropped; // the last payload was not advertised yet
+    }
+    if (!broadcaster_.next(millis(), queue_.slot().data)) {
+        return SinkResult::Skipped; // the current payload is still on air
+    }
+    queue_.push();
+    return SinkResult::Sent;
+}
+
+bool BroadcastSink::service() {
+    Payload* payload = queue_.front();
+    if (!payload) {
+        return false;
+    }
+    advertise_(payload->data, sizeof(payload->data));
+    queue_.pop();
+    return true;
+}
+
+SinkResult RecorderSink::consume(const FrameView& frame) {
+    if (Bluefruit.connected()) {
+        return SinkResult::Skipped;
+    }
+    const mlx90641::FrameHeader& header = *frame.header;
+    return recorder_.record(header.sequence, header.timestamp_us, header.ta, frame.zone_means, frame.zone_count)
+               ? SinkResult::Sent
+               : SinkResult::Dropped;
+}
@@ -4,131 +4,319 @@
 #include "BLE_gatt.h"
 #include <bluefruit.h>
 #include "data_pack.hh"
-#include "arduino_logger.hh"
+#include "queued_logger.hh"
+#include "zone_reducer.hh"
+#include "session_stats.hh"
+#include "session_stats_control.hh"
+#include "deadband_policy.hh"
+#include "acquisition_scheduler.hh"
+#include "arduino_clock.hh"
+#include "nrf_flash.hh"
+#include "session_recorder.hh"
+#include "bulk_transfer.hh"
+#include "ble_bulk_link.hh"
+#include "frame_dispatcher.hh"
+#include "frame_sinks.hh"
+#ifdef DEFERRED_LOGGING
+#include "deferred_logger.hh"
+#endif
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#ifdef TIRE_SENSOR_MLX90640
+using TireSensor = mlx90641::MLX90640Sensor; // 32 columns, 4 BLE packets per frame
+#else
+using TireSensor = mlx90641::MLX90641Sensor;
+#endif
 
 // Replace #define with constexpr
-constexpr uint8_t mlx90641_i2c_addr = 0x33; // MLX90641 I2C address
-constexpr size_t ee_data_size = 832u;
-constexpr size_t frame_data_size = 834u;
-constexpr size_t num_pixels = 192u;  // 16x12
+constexpr uint8_t mlx90641_i2c_addr = 0x33; // MLX90641/MLX90640 I2C address
 
 constexpr float temp_scaling = 1.00f; // Default = 1.00
 constexpr int temp_offset = 0;       // Default = 0 (in tenths of degrees Celsius)
+constexpr int16_t ble_deadband = 2;              // °C × 10, smaller changes are not notified
+constexpr uint32_t ble_max_silence_ms = 1000;    // heartbeat: notify at least this often
+// A serial record is 10 bits per byte at this rate: ~70 ms for an MLX90641 frame, ~270 ms for an
+// MLX90640 one, longer than a subpage. See serialFrameInterval().
+constexpr uint32_t serial_baud = 115200;
+#ifdef BLE_BROADCAST
+// Each advertising payload is on air this long (about 5 advertising events) before the next one.
+constexpr uint32_t broadcast_interval_ms = 500;
+// Nothing connects to a broadcasting sensor, so its output counters are logged every N frames.
+constexpr uint32_t broadcast_report_frames = 1024;
+#endif
+// While no central is connected, every Nth temperature frame's zones are recorded to flash
+// (about 23 bytes each: one per second at 32 Hz fills the 48 KB region in ~35 min, then the
+// oldest records are overwritten).
+constexpr uint32_t recording_interval_frames = 32;
+// Every Nth frame is converted to °C; the others only to the compensated IR image (a fraction of
+// the CPU time, see test_raw_image), which goes to serial only. 1 = temperatures only.
+constexpr uint32_t temperature_frame_interval = 1;
 
 uint8_t macaddr[6]; 
-uint16_t eeData[ee_data_size];
-uint16_t frameData[frame_data_size];
-float tempData[num_pixels];
-char rowBuf[512];
 Wire wire; 
 I2CAdapter i2c_adapter(wire);
-ArduinoLogger logger(Logger::Level::INFO); // Change to DEBUG for more verbosity
-mlx90641::MLX90641Sensor mlx_sensor(i2c_adapter, mlx90641_i2c_addr, &logger);
-DataPack datapack;
+ArduinoClock sleep_clock;
+#ifdef DEFERRED_LOGGING
+DeferredLogger logger(sleep_clock, Logger::Level::INFO); // decode with tools/log_decoder
+#else
+QueuedLogger logger(Logger::Level::INFO); // Change to DEBUG for more verbosity, written by serviceOutputs()
+#endif
+TireSensor mlx_sensor(i2c_adapter, mlx90641_i2c_addr, &logger, &sleep_clock); // stamps frames with sleep_clock
+TireSensor::Reducer zone_reducer;
+uint8_t column_zones; // index of the first of the column zones
+using TireSessionStats = BasicZoneSessionStats<TireSensor::SensorTraits>; // per zone only, per pixel costs ~3.8 KB
+TireSessionStats session_stats;
+SessionStatsControl<TireSessionStats::capacity> stats_control(session_stats); // fetched over the bulk characteristic
+DeadbandPolicy ble_policy(ble_deadband, ble_max_silence_ms);
+bool ble_was_connected = false;
+uint32_t frames_since_temperature = 0;
+NrfFlash log_flash;
+SessionRecorder recorder(log_flash, &sleep_clock);
+BleBulkLink bulk_link(GATTbulk);
+BulkSender bulk_sender(bulk_link, log_flash, sleep_clock); // serves the recording region
+// Every output gets each frame by reference, with its own content, rate and time budget.
+FrameDispatcher dispatcher(&sleep_clock);
+std::atomic<bool> sinks_ready(false); // the sink table is complete, serviceOutputs() may use it
+#ifdef HOST_OFFLOAD
+HostOffloadSink<TireSensor> offload_sink(mlx_sensor); // raw frames, the host computes the temperatures
+#else
+SerialFrameSink<TireSensor::SensorTraits> serial_sink;
+#endif
+RecorderSink recorder_sink(recorder);
+#ifdef BLE_BROADCAST
+// The advertising is non-connectable: no notifications, and the recording can't be downloaded.
+ZoneBroadcaster broadcaster(0, broadcast_interval_ms); // sensor id set in setup()
+BroadcastSink broadcast_sink(broadcaster, startBroadcast);
+uint8_t broadcast_sink_index;
+uint32_t frames_since_report = 0;
+#else
+BleZoneSink ble_sink(GATTone, ble_policy);
+uint8_t ble_sink_index;
+#endif
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+DebugPrintSink debug_sink;
+#endif
+AcquisitionScheduler scheduler(sleep_clock,
+    AcquisitionScheduler::subpage_period_us(TireSensor::default_refresh_rate));
+
 
+// Low-priority task sending what the sinks queued (serial records, notifications, advertising
+// data), so the acquisition loop never waits for the UART or the BLE stack. It is the only
+// task writing to the serial port: log lines go out between two records, never inside one.
+void serviceOutputs() {
+    bool busy = sinks_ready.load(std::memory_order_acquire) && dispatcher.service();
+#ifdef DEFERRED_LOGGING
+    uint8_t buffer[64];
+#else
+    uint8_t buffer[QueuedLogger::max_line];
+#endif
+    size_t length = logger.drain(buffer, sizeof(buffer));
+    if (length > 0) {
+        Serial.write(buffer, length);
+        busy = true;
+    }
+    if (!busy) {
+        delay(2);
+    }
+}
+
+// Every Nth frame fits the serial link: a faster output would only fill the sink's queue, whose
+// extra frames are counted as dropped.
+uint16_t serialFrameInterval() {
+    const uint32_t record_us = static_cast<uint32_t>(
+        (sizeof(SerialFrameHeader) + TireSensor::SensorTraits::num_pixels * sizeof(float)) * 10 * 1000000ull /
+        serial_baud);
+    const uint32_t subpage_us = AcquisitionScheduler::subpage_period_us(TireSensor::default_refresh_rate);
+    return static_cast<uint16_t>(record_us / subpage_us + 1);
+}
+
+// Low-priority task writing recorded frames to flash and streaming bulk downloads: an erase
+// halts the CPU for ~85 ms and notify() waits for transmit buffers, neither of which the
+// acquisition loop must wait for.
+void serviceStorage() {
+    const bool recorded = recorder.service();
+    const bool sent = bulk_sender.service();
+    const bool replied = stats_control.service(bulk_link);
+    if (!recorded && !sent && !replied) {
+        delay(bulk_sender.active() ? 2 : 50);
+    }
+}
+
+// BLE task: only queues the message for loop() (statistics commands) or serviceStorage()
+void bulkWrite(uint16_t conn_hdl, BLECharacteristic* chr, uint8_t* data, uint16_t len) {
+    if (!stats_control.on_control(data, len)) {
+        bulk_sender.on_control(data, len);
+    }
+}
 
 void setup() {
-    Serial.begin(115200);
-    Serial.println("DEBUG: Starting setup...");
+    Serial.begin(serial_baud);
+    Scheduler.startLoop(serviceOutputs, 1024, TASK_PRIO_LOW); // writes the log from here on
+    LOG_DEBUG(&logger, "Starting setup...");
     
-    Serial.println("DEBUG: Initializing MLX90641 sensor...");
+    LOG_DEBUG(&logger, "Initializing thermal sensor...");
     bool result = mlx_sensor.init();
     if (!result) {
-        Serial.println("ERROR: Failed to initialize MLX90641!");
+        LOG_ERROR(&logger, "Failed to initialize thermal sensor!");
         while (1) delay(1000);
     }
-    Serial.println("DEBUG: MLX90641 initialized successfully");
+    LOG_DEBUG(&logger, "Thermal sensor initialized successfully");
+    // Sensor mounted off-axis: only convert the pixels the tire covers, e.g.
+    // mlx_sensor.set_roi(TireSensor::PixelMask::rectangle(2, 9, 0, 15));
+
+    if (zone_reducer.add_columns(column_zones) != ZoneStatus::Success) {
+        LOG_ERROR(&logger, "Failed to configure column zones!");
+        while (1) delay(1000);
+    }
+    stats_control.set_entries(zone_reducer.zone_count());
+    LOG_DEBUG(&logger, "Session stats use %u bytes", (unsigned)TireSessionStats::memory_bytes());
+
+    uint8_t sink_index;
+#ifdef HOST_OFFLOAD
+    dispatcher.add_sink(offload_sink, {frame_content_temperatures | frame_content_image, false, 1, 0}, sink_index);
+#else
+    constexpr uint8_t all_frames = frame_content_temperatures | frame_content_image;
+    dispatcher.add_sink(serial_sink, {all_frames, false, serialFrameInterval(), 0}, sink_index);
+#endif
+#ifdef BLE_BROADCAST
+    broadcast_sink.set_zones(column_zones, TireSensor::SensorTraits::num_columns);
+    dispatcher.add_sink(broadcast_sink, {frame_content_temperatures, true, 1, 0}, broadcast_sink_index);
+#else
+    ble_sink.set_columns(column_zones, TireSensor::SensorTraits::num_columns);
+    dispatcher.add_sink(ble_sink, {frame_content_temperatures, true, 1, 0}, ble_sink_index);
+#endif
+    dispatcher.add_sink(recorder_sink, {frame_content_temperatures, true, recording_interval_frames, 0}, sink_index);
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+    if (logger.enabled(Logger::Level::DEBUG)) {
+        dispatcher.add_sink(debug_sink, {frame_content_temperatures | frame_content_image, false, 1, 0}, sink_index);
+    }
+#endif
+    sinks_ready.store(true, std::memory_order_release);
 
     delay(5000);
     // START UP BLUETOOTH
-    Serial.println("DEBUG: Starting Bluetooth...");
-    Serial.print("Starting bluetooth with MAC address ");
+    LOG_DEBUG(&logger, "Starting Bluetooth...");
+    Bluefruit.configPrphBandwidth(BANDWIDTH_MAX); // 247-byte MTU for bulk downloads
     Bluefruit.begin();
     Bluefruit.getAddr(macaddr);
-    Serial.printBufferReverse(macaddr, 6, ':');
-    Serial.println();
-    Bluefruit.setName("MLX90641");
-    Serial.println("DEBUG: Bluetooth initialized");
+    LOG_INFO(&logger, "Bluetooth MAC address %02X:%02X:%02X:%02X:%02X:%02X", macaddr[5], macaddr[4], macaddr[3],
+             macaddr[2], macaddr[1], macaddr[0]);
+    Bluefruit.setName(TireSensor::SensorTraits::name);
+    LOG_DEBUG(&logger, "Bluetooth initialized");
 
     // RUN BLUETOOTH GATT
-    Serial.println("DEBUG: Setting up GATT services...");
-    setupMainService();
+    LOG_DEBUG(&logger, "Setting up GATT services...");
+    setupMainService(bulkWrite);
+#ifdef BLE_BROADCAST
+    // No connection: the zones go out in advertising data, see startBroadcast()
+#ifdef BROADCAST_SENSOR_ID
+    broadcaster.set_sensor_id(BROADCAST_SENSOR_ID);
+#else
+    broadcaster.set_sensor_id(macaddr[0]);
+#endif
+#else
     startAdvertising(); 
-    Serial.println("DEBUG: Setup complete - Running!");
-}
-
+#endif
 
+    // The SoftDevice flash API needs Bluefruit running.
+    recorder.mount();
+    Scheduler.startLoop(serviceStorage, 1024, TASK_PRIO_LOW);
+    LOG_INFO(&logger, "Recording: %lu bytes free, recorder uses %u bytes", (unsigned long)recorder.remaining_bytes(),
+             (unsigned)SessionRecorder::memory_bytes());
+    LOG_DEBUG(&logger, "Setup complete - Running!");
+}
 
-void sendColumnAveragesBLE(float* avgColumns16) {
-    if (!Bluefruit.connected()) return;
 
-    for (uint8_t packetId = 0; packetId < 2; packetId++) {
-        datapack.protocol = 1;
-        datapack.packet_id = packetId;
-        datapack.reserved = 0;
 
-        // Fill 8 temps for this half
-        for (uint8_t i = 0; i < 8; i++) {
-            uint8_t col = i + packetId * 8;
-            datapack.temps[i] = static_cast<int16_t>(avgColumns16[col] * 10.0f);
-        }
+// A new central gets every packet once, and the recording is complete in flash for a download.
+void checkConnection() {
+    const bool connected = Bluefruit.connected();
+    if (connected && !ble_was_connected) {
+        ble_policy.reset();
+        recorder.request_flush();
+        const RecorderStats stats = recorder.stats();
+        LOG_INFO(&logger, "Recorded %lu frames (%lu dropped, %lu flash errors), %lu bytes free",
+                 (unsigned long)stats.records, (unsigned long)stats.dropped, (unsigned long)stats.flash_errors,
+                 (unsigned long)recorder.remaining_bytes());
+#ifndef BLE_BROADCAST
+        const SinkStats& ble = dispatcher.stats(ble_sink_index);
+        LOG_INFO(&logger, "BLE output: %lu sent, %lu dropped, longest %lu us", (unsigned long)ble.sent,
+                 (unsigned long)ble.dropped, (unsigned long)ble.max_us);
+#endif
+    }
+    ble_was_connected = connected;
+}
 
-        GATTone.notify((uint8_t*)&datapack, sizeof(datapack));
-        delay(5); // small delay to avoid BLE congestion
+#ifdef BLE_BROADCAST
+void reportBroadcast() {
+    frames_since_report = (frames_since_report + 1) % broadcast_report_frames;
+    if (frames_since_report != 0) {
+        return;
     }
+    const SinkStats& broadcast = dispatcher.stats(broadcast_sink_index);
+    LOG_INFO(&logger, "Broadcast output: %lu payloads, %lu dropped", (unsigned long)broadcast.sent,
+             (unsigned long)broadcast.dropped);
 }
+#endif
+
 
 void loop() {
-    Serial.println("DEBUG: Starting new loop iteration");
-    
-    const int maxRetries = 5;   
-    int retries = 0;
-    bool frameSuccess = false;
-
-    Serial.println("DEBUG: Attempting to read frame...");
-    while (!frameSuccess && retries < maxRetries) {
-        frameSuccess = mlx_sensor.read_frame();
-        if (!frameSuccess) {
-            retries++;
-            Serial.print("DEBUG: Frame read failed, retry ");
-            Serial.print(retries);
-            Serial.print("/");
-            Serial.println(maxRetries);
-            delay(1); // short delay before retry
-        }
-    }
+    LOG_DEBUG(&logger, "Starting new loop iteration");
 
-    // If still failed after max retries, skip this iteration entirely
-    if (!frameSuccess) {
-        Serial.println("ERROR: Missed frame, all retries failed. Skipping notification.");
-        return;
+    // Sleep until just before the next subpage, then poll the few remaining cycles.
+    uint32_t missed = scheduler.wait_for_next_frame();
+    if (missed > 0) {
+        LOG_DEBUG(&logger, "Missed frames: %lu", (unsigned long)missed);
     }
+    bool dataReady = false;
+    while (!dataReady && mlx_sensor.poll_data_ready(dataReady) == 0) {
+    }
+    scheduler.data_ready_at(sleep_clock.now_us());
     
-    Serial.println("DEBUG: Frame read successful, calculating temperatures...");
-    mlx_sensor.calculate_temps();
-    Serial.println("DEBUG: Temperature calculation complete");
-    
-    auto tempData = mlx_sensor.get_temps();
-    Serial.println("DEBUG: Retrieved temperature array");
-    for (size_t i = 0; i < 10; i++) {
-        Serial.printf("%.2f, ", tempData[i]);
+    // Failed transactions are retried per block inside the I2C adapter, within the frame
+    // latency budget, so a failed frame is skipped rather than read again.
+    LOG_DEBUG(&logger, "Attempting to read frame...");
+    if (!mlx_sensor.read_frame()) {
+        const I2CStats& stats = i2c_adapter.stats();
+        LOG_ERROR(&logger, "Missed frame, I2C status %d (retries %lu, bus clears %lu). Skipping notification.",
+                  static_cast<int>(i2c_adapter.last_status()), (unsigned long)stats.retries,
+                  (unsigned long)stats.bus_clears);
+        scheduler.frame_done();
+        return;
     }
 
-    Serial.write((uint8_t*)tempData.data(), tempData.size() * sizeof(float));
     
-    Serial.println("DEBUG: Calculating column averages...");
-    // Row 0, pixels [0 .. 15]
-    float colAvg[16];
-    for (int col = 0; col < 16; col++) {
-        float sum = 0.0f;
-        for (int row = 0; row < 12; row++) {
-            sum += tempData[row * 16 + col];  // row-major order
-        }
-        colAvg[col] = sum / 12.0f;  // average of this column
-    }    
-
-    Serial.println("DEBUG: Sending BLE data...");
-    sendColumnAveragesBLE(colAvg);
-    Serial.println("DEBUG: Loop iteration complete");
+    const bool temperature_frame = frames_since_temperature == 0;
+    frames_since_temperature = (frames_since_temperature + 1) % temperature_frame_interval;
+    if (temperature_frame) {
+        LOG_DEBUG(&logger, "Frame read successful, calculating temperatures...");
+        mlx_sensor.calculate_temps(&zone_reducer); // column averages are reduced in the same pass
+        LOG_DEBUG(&logger, "Temperature calculation complete");
+        session_stats.update(zone_reducer);
+        stats_control.on_frame(); // a fetch or reset asked for since the last frame
+    } else {
+        mlx_sensor.calculate_image();
+    }
+    
+    // One view of the driver's and the reducer's buffers for every output, no copy
+    FrameView frame = {&mlx_sensor.frame_header(), mlx_sensor.get_temps().data(), TireSensor::SensorTraits::num_rows,
+                       TireSensor::SensorTraits::num_columns,
+                       mlx_sensor.output() == TireSensor::Output::Image ? frame_content_image
+                                                                        : frame_content_temperatures,
+                       nullptr, nullptr, nullptr, nullptr, 0};
+    if (temperature_frame) {
+        frame.attach_zones(zone_reducer);
+    }
+    checkConnection();
+#ifdef BLE_BROADCAST
+    reportBroadcast();
+#endif
+    dispatcher.publish(frame);
+    scheduler.frame_done();
+    LOG_DEBUG(&logger, "Active %lu us per frame, duty cycle %.2f",
+              (unsigned long)scheduler.average_active_us(), scheduler.duty_cycle());
+    LOG_DEBUG(&logger, "Loop iteration complete");
     
 }
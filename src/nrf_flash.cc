@@ -0,0 +1,71 @@
+#include "nrf_flash.hh"
+#include <Arduino.h> // for delay, millis
+#include <nrf_soc.h>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t operation_timeout_ms = 500;
+constexpr uint32_t chunk_words = 64; // sd_flash_write needs a word-aligned source
+
+uint32_t* address(uint32_t offset) {
+    return reinterpret_cast<uint32_t*>(FLASH_LOG_ADDRESS + offset);
+}
+
+// Issues `start` until the SoftDevice accepts it (busy with another flash operation), then
+// waits for `done`.
+template <typename Start, typename Done>
+bool run(Start start, Done done) {
+    const uint32_t begin_ms = millis();
+    uint32_t result;
+    while ((result = start()) == NRF_ERROR_BUSY) {
+        if (millis() - begin_ms > operation_timeout_ms) return false;
+        delay(1);
+    }
+    if (result != NRF_SUCCESS) return false;
+    while (!done()) {
+        if (millis() - begin_ms > operation_timeout_ms) return false;
+        delay(1);
+    }
+    return true;
+}
+
+} // namespace
+
+bool NrfFlash::erase_page(uint32_t page) {
+    if (page >= page_count()) return false;
+    const uint32_t first = page * flash_page_size;
+    return run([&]() { return sd_flash_page_erase((FLASH_LOG_ADDRESS + first) / flash_page_size); },
+               [&]() {
+                   for (uint32_t word = 0; word < flash_page_size / 4; word++) {
+                       if (address(first)[word] != 0xFFFFFFFF) return false;
+                   }
+                   return true;
+               });
+}
+
+bool NrfFlash::write(uint32_t offset, const void* data, std::size_t size) {
+    if (offset % 4 != 0 || size % 4 != 0 || offset + size > flash_page_size * page_count()) return false;
+    uint32_t words[chunk_words];
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        const uint32_t count = size / 4 < chunk_words ? size / 4 : chunk_words;
+        std::memcpy(words, bytes, count * 4);
+        if (!write_words(offset, words, count)) return false;
+        offset += count * 4;
+        bytes += count * 4;
+        size -= count * 4;
+    }
+    return true;
+}
+
+bool NrfFlash::read(uint32_t offset, void* data, std::size_t size) {
+    if (offset + size > flash_page_size * page_count()) return false;
+    std::memcpy(data, address(offset), size); // memory-mapped
+    return true;
+}
+
+bool NrfFlash::write_words(uint32_t offset, const uint32_t* words, uint32_t count) {
+    return run([&]() { return sd_flash_write(address(offset), words, count); },
+               [&]() { return std::memcmp(address(offset), words, count * 4) == 0; });
+}
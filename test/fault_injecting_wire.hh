@@ -0,0 +1,141 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include "i_wire.hh"
+#include "virtual_clock.hh"
+
+// IWire decorator injecting bus faults in front of another IWire (usually a device mock).
+// Transactions are numbered from 0 in beginTransmission() order; a fault scheduled for a
+// transaction replaces its outcome. Speed-dependent faults hit one in `period` transactions
+// while the clock is at or above a frequency. A stuck SDA is released after a number of SCL pulses;
+// a transaction started while SDA is stuck "hangs" for hang_us and is counted.
+class FaultInjectingWire : public IWire {
+public:
+    enum class Fault {
+        None,
+        AddressNack,
+        DataNack,
+        Timeout,    // endTransmission() returns 5 after timeout_us
+        BusError,   // endTransmission() returns 4 (arbitration lost, ...)
+        ShortRead,  // requestFrom() delivers 2 bytes less than requested
+        Slow,       // the transaction succeeds but takes timeout_us longer
+        Corrupt,    // bit 0 of every byte read is flipped
+    };
+
+    FaultInjectingWire(IWire& inner, VirtualClock& clock) : inner_(inner), clock_(clock) {}
+
+    void fail(uint32_t transaction, Fault fault) { faults_[transaction] = fault; }
+    // Every transaction from now on fails with `fault` (None to stop).
+    void fail_all(Fault fault) { fail_all_ = fault; }
+    void fail_at_speed(uint32_t frequency, Fault fault, uint32_t period = 1)
+    {
+        speed_frequency_ = frequency;
+        speed_fault_ = fault;
+        speed_period_ = period;
+        speed_count_ = 0;
+    }
+    // SDA reads low until `pulses` SCL pulses were clocked (255: never released).
+    void stick_sda(uint8_t pulses) { stuck_pulses_ = pulses; scl_pulses = 0; }
+
+    uint32_t transactions() const { return transaction_; }
+
+    uint32_t timeout_us = 5000;
+    uint32_t hang_us = 1000000;
+    uint32_t scl_pulses = 0;
+    uint32_t hung_transactions = 0;
+    uint32_t restarts = 0;       // begin() calls
+    uint32_t frequency = 0;
+
+    void begin() override { restarts++; inner_.begin(); }
+    void end() override { inner_.end(); }
+    void setClock(uint32_t freq) override { frequency = freq; inner_.setClock(freq); }
+
+    void beginTransmission(uint8_t address) override
+    {
+        current_ = next_fault();
+        transaction_++;
+        if (sda_stuck()) {
+            hung_transactions++;
+            clock_.advance(hang_us);
+        }
+        inner_.beginTransmission(address);
+    }
+
+    int endTransmission(bool stop = true) override
+    {
+        const int result = inner_.endTransmission(stop);
+        const Fault fault = current_;
+        if (fault != Fault::ShortRead && fault != Fault::Corrupt) {
+            current_ = Fault::None; // applied once, not to the next stray endTransmission()
+        }
+        switch (fault) {
+            case Fault::AddressNack: return 2;
+            case Fault::DataNack: return 3;
+            case Fault::BusError: return 4;
+            case Fault::Timeout:
+                clock_.advance(timeout_us);
+                return 5;
+            case Fault::Slow:
+                clock_.advance(timeout_us);
+                return result;
+            default: return result;
+        }
+    }
+
+    uint8_t requestFrom(uint8_t address, std::size_t quantity) override
+    {
+        const uint8_t received = inner_.requestFrom(address, quantity);
+        return current_ == Fault::ShortRead && received >= 2 ? static_cast<uint8_t>(received - 2) : received;
+    }
+
+    std::size_t write(uint8_t data) override { return inner_.write(data); }
+    std::size_t write(const char* data, std::size_t quantity) override { return inner_.write(data, quantity); }
+    int available() override { return inner_.available(); }
+    int read() override
+    {
+        const int value = inner_.read();
+        return current_ == Fault::Corrupt && value >= 0 ? value ^ 0x01 : value;
+    }
+    int peek() override { return inner_.peek(); }
+    void flush() override { inner_.flush(); }
+    void delayMicroseconds(int us) override { inner_.delayMicroseconds(us); }
+    uint32_t micros() override { return inner_.micros(); }
+
+    void drive_scl(bool high) override
+    {
+        if (high && !scl_high_) {
+            scl_pulses++;
+        }
+        scl_high_ = high;
+    }
+    void drive_sda(bool) override {}
+    bool read_sda() override { return !sda_stuck(); }
+
+private:
+    Fault next_fault()
+    {
+        std::map<uint32_t, Fault>::iterator it = faults_.find(transaction_);
+        if (it != faults_.end()) {
+            return it->second;
+        }
+        if (speed_fault_ != Fault::None && frequency >= speed_frequency_ && speed_count_++ % speed_period_ == 0) {
+            return speed_fault_;
+        }
+        return fail_all_;
+    }
+
+    bool sda_stuck() const { return stuck_pulses_ == 255 || scl_pulses < stuck_pulses_; }
+
+    IWire& inner_;
+    VirtualClock& clock_;
+    std::map<uint32_t, Fault> faults_;
+    Fault fail_all_ = Fault::None;
+    Fault speed_fault_ = Fault::None;
+    uint32_t speed_frequency_ = 0;
+    uint32_t speed_period_ = 1;
+    uint32_t speed_count_ = 0;
+    Fault current_ = Fault::None;
+    uint32_t transaction_ = 0;
+    uint8_t stuck_pulses_ = 0;
+    bool scl_high_ = true;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "i_flash.hh"
+#include "virtual_clock.hh"
+
+// File-backed stand-in for the nRF52 internal flash: NOR rules (erase sets 0xFF, writes only
+// clear bits, word-aligned), per-page erase counts for wear checks, and the nRF52832 erase
+// and write times charged to an optional VirtualClock. The file outlives the object, so a
+// "reboot" is a new FileFlash on the same path.
+class FileFlash : public IFlash {
+public:
+    static constexpr uint32_t erase_us = 85000;
+    static constexpr uint32_t write_us_per_word = 41;
+
+    FileFlash(const std::string& path, uint32_t page_size, uint32_t page_count, VirtualClock* clock = nullptr)
+        : page_size_(page_size), page_count_(page_count), clock_(clock)
+    {
+        erase_counts.assign(page_count, 0);
+        file_ = std::fopen(path.c_str(), "r+b");
+        if (!file_) {
+            file_ = std::fopen(path.c_str(), "w+b");
+            const std::vector<uint8_t> blank(page_size * page_count, 0xFF); // factory-erased
+            std::fwrite(blank.data(), 1, blank.size(), file_);
+            std::fflush(file_);
+        }
+    }
+    ~FileFlash() override { std::fclose(file_); }
+
+    uint32_t page_size() const override { return page_size_; }
+    uint32_t page_count() const override { return page_count_; }
+
+    bool erase_page(uint32_t page) override
+    {
+        if (page >= page_count_ || fail_erases) {
+            return false;
+        }
+        const std::vector<uint8_t> blank(page_size_, 0xFF);
+        erase_counts[page]++;
+        advance(erase_us);
+        return store(page * page_size_, blank.data(), blank.size());
+    }
+
+    bool write(uint32_t offset, const void* data, std::size_t size) override
+    {
+        if (offset % 4 != 0 || size % 4 != 0 || offset + size > page_size_ * page_count_) {
+            misuse++;
+            return false;
+        }
+        std::vector<uint8_t> current(size);
+        read(offset, current.data(), size);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (std::size_t i = 0; i < size; i++) {
+            if ((bytes[i] & ~current[i]) != 0) {
+                misuse++; // setting a bit needs an erase
+            }
+            current[i] &= bytes[i];
+        }
+        writes++;
+        advance(write_us_per_word * static_cast<uint32_t>(size / 4));
+        return store(offset, current.data(), size);
+    }
+
+    bool read(uint32_t offset, void* data, std::size_t size) override
+    {
+        std::fseek(file_, offset, SEEK_SET);
+        return std::fread(data, 1, size, file_) == size;
+    }
+
+    bool fail_erases = false;
+    uint32_t misuse = 0;      // unaligned writes and writes over unerased bits
+    uint32_t writes = 0;
+    std::vector<uint32_t> erase_counts;
+
+private:
+    bool store(uint32_t offset, const uint8_t* data, std::size_t size)
+    {
+        std::fseek(file_, offset, SEEK_SET);
+        const bool ok = std::fwrite(data, 1, size, file_) == size;
+        std::fflush(file_);
+        return ok;
+    }
+
+    void advance(uint32_t us)
+    {
+        if (clock_) {
+            clock_->advance(us);
+        }
+    }
+
+    uint32_t page_size_;
+    uint32_t page_count_;
+    VirtualClock* clock_;
+    std::FILE* file_;
+};
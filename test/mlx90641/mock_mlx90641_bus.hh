@@ -0,0 +1,239 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "i_wire.hh"
+#include "virtual_clock.hh"
+
+namespace mlx90641 {
+
+// Adds the parity bits (11-15) the sensor stores with each 11-bit EEPROM value, so the
+// driver's hamming_decode() accepts the word.
+inline uint16_t hamming_encode(uint16_t value)
+{
+    int d[16];
+    for (int i = 0; i < 11; i++) {
+        d[i] = (value >> i) & 1;
+    }
+    d[11] = d[0] ^ d[1] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[10];
+    d[12] = d[0] ^ d[2] ^ d[3] ^ d[5] ^ d[6] ^ d[9] ^ d[10];
+    d[13] = d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9] ^ d[10];
+    d[14] = d[4] ^ d[5] ^ d[6] ^ d[7] ^ d[8] ^ d[9] ^ d[10];
+    d[15] = 0;
+    for (int i = 0; i < 15; i++) {
+        d[15] ^= d[i];
+    }
+    uint16_t word = 0;
+    for (int i = 0; i < 16; i++) {
+        word |= static_cast<uint16_t>(d[i] << i);
+    }
+    return word;
+}
+
+// IWire double emulating MLX90641 devices on one I2C bus.
+//
+// Each device has EEPROM, RAM and the status/control registers. It produces a subpage
+// every refresh period of the VirtualClock (alternating 0/1), setting data-ready and
+// counting an overwrite if the previous subpage was never cleared. Transfers advance the
+// clock by their duration at the configured bus speed.
+class MockMLX90641Bus : public IWire {
+public:
+    struct Device {
+        uint8_t address;
+        std::vector<uint16_t> memory;   // word addressed, whole 16-bit space
+        uint32_t next_frame_us;
+        uint32_t period_scale_ppm;      // sensor clock error, 1000000 = exact
+        uint32_t frames_produced;
+        uint32_t overwritten;           // subpages replaced before data-ready was cleared
+        uint32_t stale_reads;           // pixel reads from the subpage that is not the latest
+        uint8_t sub_page;
+        uint16_t pixel_value;
+        bool write_pixels;              // false: pixel RAM keeps what the test stored
+
+        uint16_t& status() { return memory[0x8000]; }
+        uint16_t& control() { return memory[0x800D]; }
+    };
+
+    explicit MockMLX90641Bus(VirtualClock& clock) : clock_(clock) {}
+
+    // `eeprom` holds the 832 decoded words (as in test_data_mlx90641_eeprom).
+    Device& add_device(uint8_t address, uint32_t first_frame_us, const uint16_t* eeprom, uint8_t refresh_rate = 0x06)
+    {
+        devices_.push_back(Device());
+        Device& device = devices_.back();
+        device.address = address;
+        device.memory.assign(0x10000, 0);
+        device.next_frame_us = first_frame_us;
+        device.period_scale_ppm = 1000000;
+        device.frames_produced = 0;
+        device.overwritten = 0;
+        device.stale_reads = 0;
+        device.sub_page = 1;
+        device.pixel_value = 0x0100;
+        device.write_pixels = true;
+        for (int i = 0; i < 832; i++) {
+            device.memory[0x2400 + i] = i < 16 ? eeprom[i] : hamming_encode(eeprom[i]);
+        }
+        device.control() = static_cast<uint16_t>(0x0901 & ~0x0380) | static_cast<uint16_t>((refresh_rate & 0x07) << 7);
+        device.status() = 0x0010;
+        return device;
+    }
+
+    Device* device(uint8_t address)
+    {
+        for (Device& device : devices_) {
+            if (device.address == address) {
+                return &device;
+            }
+        }
+        return nullptr;
+    }
+
+    uint32_t frequency() const { return frequency_; }
+    uint32_t transactions() const { return transactions_; }
+
+    void begin() override {}
+    void end() override {}
+    void setClock(uint32_t freq) override { frequency_ = freq; }
+
+    void beginTransmission(uint8_t address) override
+    {
+        tx_address_ = address;
+        tx_.clear();
+        pending_ = true;
+    }
+
+    std::size_t write(uint8_t data) override
+    {
+        tx_.push_back(data);
+        return 1;
+    }
+
+    std::size_t write(const char* data, std::size_t quantity) override
+    {
+        for (std::size_t i = 0; i < quantity; i++) {
+            tx_.push_back(static_cast<uint8_t>(data[i]));
+        }
+        return quantity;
+    }
+
+    int endTransmission(bool stop = true) override
+    {
+        (void)stop;
+        if (!pending_) {
+            return 0;
+        }
+        pending_ = false;
+        transfer(tx_.size());
+        Device* device = this->device(tx_address_);
+        if (!device) {
+            return 2; // address NACK
+        }
+        update(*device);
+        if (tx_.size() >= 2) {
+            pointer_ = static_cast<uint16_t>(tx_[0] << 8 | tx_[1]);
+        }
+        if (tx_.size() >= 4) {
+            register_write(*device, pointer_, static_cast<uint16_t>(tx_[2] << 8 | tx_[3]));
+        }
+        return 0;
+    }
+
+    uint8_t requestFrom(uint8_t address, std::size_t quantity) override
+    {
+        transfer(quantity);
+        rx_.clear();
+        rx_pos_ = 0;
+        Device* device = this->device(address);
+        if (!device) {
+            return 0;
+        }
+        update(*device);
+        for (std::size_t i = 0; i < quantity / 2; i++) {
+            const uint16_t address_word = static_cast<uint16_t>(pointer_ + i);
+            check_stale(*device, address_word);
+            const uint16_t word = device->memory[address_word];
+            rx_.push_back(static_cast<uint8_t>(word >> 8));
+            rx_.push_back(static_cast<uint8_t>(word & 0xFF));
+        }
+        return static_cast<uint8_t>(rx_.size());
+    }
+
+    int available() override { return static_cast<int>(rx_.size() - rx_pos_); }
+    int read() override { return rx_pos_ < rx_.size() ? rx_[rx_pos_++] : -1; }
+    int peek() override { return rx_pos_ < rx_.size() ? rx_[rx_pos_] : -1; }
+    void flush() override {}
+    void delayMicroseconds(int us) override { clock_.advance(static_cast<uint32_t>(us)); }
+    uint32_t micros() override { return clock_.now_us(); }
+    void drive_scl(bool) override {}
+    void drive_sda(bool) override {}
+    bool read_sda() override { return true; }
+
+private:
+    // Address byte + payload, 9 bits per byte, plus start/stop.
+    void transfer(std::size_t bytes)
+    {
+        transactions_++;
+        const uint64_t bits = (bytes + 1) * 9 + 2;
+        nanoseconds_ += bits * 1000000000ull / frequency_;
+        clock_.advance(static_cast<uint32_t>(nanoseconds_ / 1000));
+        nanoseconds_ %= 1000;
+    }
+
+    void update(Device& device)
+    {
+        while (static_cast<int32_t>(clock_.now_us() - device.next_frame_us) >= 0) {
+            if (device.status() & 0x0008) {
+                device.overwritten++;
+            }
+            device.sub_page ^= 1;
+            // Pixel RAM is 12 groups of 32 words (two rows each), even groups hold subpage 0.
+            for (int group = device.sub_page; device.write_pixels && group < 12; group += 2) {
+                for (int word = 0; word < 32; word++) {
+                    device.memory[0x0400 + group * 32 + word] = device.pixel_value;
+                }
+            }
+            device.status() = static_cast<uint16_t>((device.status() & 0x0010) | 0x0008 | device.sub_page);
+            device.frames_produced++;
+            const uint8_t refresh_rate = (device.control() >> 7) & 0x07;
+            const uint64_t period_us = 2000000u >> refresh_rate;
+            device.next_frame_us += static_cast<uint32_t>(period_us * device.period_scale_ppm / 1000000u);
+        }
+    }
+
+    void register_write(Device& device, uint16_t address, uint16_t value)
+    {
+        if (address == 0x8000) {
+            // Data-ready clears when written 0, the start bit (5) is not stored.
+            const uint16_t status = device.status();
+            device.status() = static_cast<uint16_t>((status & 0x0001) | (value & 0x0010) | (status & value & 0x0008));
+        } else {
+            device.memory[address] = value;
+        }
+    }
+
+    void check_stale(Device& device, uint16_t address)
+    {
+        if (address < 0x0400 || address >= 0x0580) {
+            return;
+        }
+        const int group = (address - 0x0400) / 32;
+        if ((address - 0x0400) % 32 == 0 && (group & 1) != device.sub_page) {
+            device.stale_reads++;
+        }
+    }
+
+    VirtualClock& clock_;
+    std::deque<Device> devices_;
+    uint32_t frequency_ = 100000;
+    uint64_t nanoseconds_ = 0;
+    uint32_t transactions_ = 0;
+    uint8_t tx_address_ = 0;
+    std::vector<uint8_t> tx_;
+    bool pending_ = false;
+    uint16_t pointer_ = 0;
+    std::vector<uint8_t> rx_;
+    std::size_t rx_pos_ = 0;
+};
+
+} // namespace mlx90641
@@ -0,0 +1,156 @@
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "batch_processor.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Output = MLX90641Sensor::Output;
+
+namespace {
+
+constexpr std::size_t pixels = MLX90641Sensor::num_pixels;
+constexpr std::size_t frame_bytes = MLX90641Sensor::frame_data_size * sizeof(uint16_t);
+constexpr std::size_t record_bytes = 20 + frame_bytes; // as in a capture file: record header, then the frame
+
+// A session of raw frames as the device sends them: one real frame from the mock sensor,
+// its pixels and PTAT varied from frame to frame, both subpages.
+struct Session {
+    std::array<uint16_t, MLX90641Sensor::ee_data_size> eeprom;
+    std::vector<uint8_t> records;
+    std::size_t count;
+
+    explicit Session(std::size_t frames) : records(frames * record_bytes), count(frames)
+    {
+        VirtualClock clock;
+        MockMLX90641Bus wire(clock);
+        I2CAdapter i2c(wire);
+        MockMLX90641Bus::Device& device = wire.add_device(0x33, 100000, test_eeprom_data.data());
+        MLX90641Sensor sensor(i2c, 0x33);
+        TEST_ASSERT_TRUE(sensor.init());
+        TEST_ASSERT_EQUAL(0, sensor.read_eeprom(0, eeprom.size(), eeprom.data()));
+        clock.sleep_until_us(device.next_frame_us);
+        TEST_ASSERT_TRUE(sensor.read_frame());
+        for (std::size_t n = 0; n < frames; n++) {
+            std::array<uint16_t, MLX90641Sensor::frame_data_size> words = sensor.frame_words();
+            for (std::size_t pixel = 0; pixel < pixels; pixel++) {
+                words[pixel] = static_cast<uint16_t>(words[pixel] + (n * 13 + pixel * 5) % 400);
+            }
+            words[MLX90641Traits::frame_ptat] = static_cast<uint16_t>(words[MLX90641Traits::frame_ptat] + n % 7);
+            words[MLX90641Traits::frame_sub_page] = static_cast<uint16_t>(n % 2);
+            std::memcpy(records.data() + n * record_bytes + 20, words.data(), frame_bytes);
+        }
+    }
+
+    RawFrameSpan span() const { return {records.data() + 20, count, record_bytes}; }
+
+    // What one engine fed the frames in order computes.
+    void replay(std::vector<float>& temps, std::vector<float>& ambients, Output output = Output::Temperature) const
+    {
+        OffloadEngine engine;
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.load_eeprom(eeprom.data(), eeprom.size()));
+        temps.resize(count * pixels);
+        ambients.resize(count);
+        for (std::size_t n = 0; n < count; n++) {
+            const uint16_t* words = reinterpret_cast<const uint16_t*>(records.data() + n * record_bytes + 20);
+            TEST_ASSERT_EQUAL(OffloadStatus::Success,
+                              engine.process_frame(words, MLX90641Sensor::frame_data_size, output));
+            std::memcpy(&temps[n * pixels], engine.temps().data(), pixels * sizeof(float));
+            ambients[n] = engine.ambient();
+        }
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_batch_matches_an_in_order_replay() {
+    const Session session(300);
+    std::vector<float> expected, expected_ambients;
+    session.replay(expected, expected_ambients);
+
+    const unsigned thread_counts[] = {1, 2, 3, 8};
+    const std::size_t chunk_sizes[] = {1, 7, 64, 1000};
+    for (unsigned threads : thread_counts) {
+        for (std::size_t chunk_frames : chunk_sizes) {
+            BatchProcessor batch({threads, chunk_frames});
+            TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.load_eeprom(session.eeprom.data(), session.eeprom.size()));
+            std::vector<float> temps(session.count * pixels), ambients(session.count);
+            TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.process(session.span(), temps.data(), ambients.data()));
+            TEST_ASSERT_EQUAL_MEMORY(expected.data(), temps.data(), temps.size() * sizeof(float));
+            TEST_ASSERT_EQUAL_MEMORY(expected_ambients.data(), ambients.data(), ambients.size() * sizeof(float));
+            TEST_ASSERT_EQUAL(session.count, batch.stats().frames);
+            TEST_ASSERT_EQUAL((session.count + chunk_frames - 1) / chunk_frames, batch.stats().chunks);
+            TEST_ASSERT_EQUAL(0, batch.stats().warmup_frames); // every subpage covers the whole array
+            TEST_ASSERT_LESS_OR_EQUAL(threads, batch.stats().threads);
+        }
+    }
+}
+
+void test_batch_computes_images() {
+    const Session session(50);
+    std::vector<float> expected, ambients;
+    session.replay(expected, ambients, Output::Image);
+    BatchProcessor batch({4, 8});
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.load_eeprom(session.eeprom.data(), session.eeprom.size()));
+    std::vector<float> image(session.count * pixels);
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.process(session.span(), image.data(), nullptr, Output::Image));
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), image.data(), image.size() * sizeof(float));
+}
+
+void test_bad_input_is_reported() {
+    Session session(4);
+    BatchProcessor batch;
+    std::vector<float> temps(session.count * pixels);
+    TEST_ASSERT_EQUAL(OffloadStatus::NotCalibrated, batch.process(session.span(), temps.data()));
+    session.eeprom[16] ^= 0x0003; // two bit errors, beyond the Hamming correction
+    TEST_ASSERT_EQUAL(OffloadStatus::InvalidEeprom, batch.load_eeprom(session.eeprom.data(), session.eeprom.size()));
+    TEST_ASSERT_FALSE(batch.calibrated());
+    session.eeprom[16] ^= 0x0003;
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.load_eeprom(session.eeprom.data(), session.eeprom.size()));
+    const RawFrameSpan overlapping = {session.records.data(), session.count, frame_bytes - 2};
+    TEST_ASSERT_EQUAL(OffloadStatus::WrongSize, batch.process(overlapping, temps.data()));
+    const RawFrameSpan empty = {session.records.data(), 0, record_bytes};
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.process(empty, temps.data()));
+    TEST_ASSERT_EQUAL(0, batch.stats().frames);
+}
+
+// Not a pass/fail criterion (shared CI machines), the numbers are for the log.
+void test_throughput_from_one_to_all_cores() {
+    const Session session(4000);
+    std::vector<float> temps(session.count * pixels);
+    const unsigned cores = std::max(std::thread::hardware_concurrency(), 4u);
+    double one_thread_fps = 0.0;
+    for (unsigned threads = 1; threads <= cores; threads *= 2) {
+        BatchProcessor batch({threads, BatchProcessor::default_options().chunk_frames});
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.load_eeprom(session.eeprom.data(), session.eeprom.size()));
+        const auto start = std::chrono::steady_clock::now();
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.process(session.span(), temps.data()));
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double fps = session.count / seconds;
+        if (threads == 1) {
+            one_thread_fps = fps;
+        }
+        printf("%2u threads: %8.0f frames/s, x%.2f\n", threads, fps, fps / one_thread_fps);
+        TEST_ASSERT_EQUAL(session.count, batch.stats().frames);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_batch_matches_an_in_order_replay);
+    RUN_TEST(test_batch_computes_images);
+    RUN_TEST(test_bad_input_is_reported);
+    RUN_TEST(test_throughput_from_one_to_all_cores);
+    return UNITY_END();
+}
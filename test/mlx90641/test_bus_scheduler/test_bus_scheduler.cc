@@ -0,0 +1,218 @@
+#include <unity.h>
+#include <memory>
+#include <vector>
+#include "acquisition_scheduler.hh"
+#include "bus_scheduler.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+
+namespace {
+
+const uint32_t period_us = AcquisitionScheduler::subpage_period_us(MLX90641Sensor::default_refresh_rate);
+
+// N sensors with their own address and data-ready phase on one emulated bus.
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    std::vector<std::unique_ptr<MLX90641Sensor>> sensors;
+    BusScheduler scheduler;
+
+    Rig() : wire(clock), i2c(wire), scheduler(i2c, clock) {}
+
+    void add(uint8_t address, uint32_t phase_us)
+    {
+        wire.add_device(address, phase_us, test_eeprom_data.data());
+        sensors.emplace_back(new MLX90641Sensor(i2c, address));
+        TEST_ASSERT_TRUE(sensors.back()->init());
+    }
+
+    void start()
+    {
+        for (auto& sensor : sensors) {
+            uint8_t index;
+            TEST_ASSERT_TRUE(scheduler.add_sensor(*sensor, period_us, index) == BusStatus::Success);
+        }
+    }
+
+    // Runs the scheduler for `duration_us`, returns completed frames per sensor.
+    std::vector<uint32_t> run(uint32_t duration_us)
+    {
+        std::vector<uint32_t> completed(sensors.size(), 0);
+        const uint32_t end_us = clock.now_us() + duration_us;
+        while (static_cast<int32_t>(clock.now_us() - end_us) < 0) {
+            const uint8_t index = scheduler.step();
+            if (index != BusScheduler::no_sensor) {
+                completed[index]++;
+            }
+        }
+        return completed;
+    }
+
+    uint32_t overwritten(uint8_t address) { return wire.device(address)->overwritten; }
+};
+
+} // namespace
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_two_sensors_share_the_bus_without_missing_subpages() {
+    Rig rig;
+    rig.add(0x33, 50000);
+    rig.add(0x34, 58000); // data-ready while the first sensor is being read
+    rig.start();
+    rig.run(period_us); // settle, frames produced during init were never read
+    const uint32_t overwritten[] = {rig.overwritten(0x33), rig.overwritten(0x34)};
+    const uint32_t stale_reads[] = {rig.wire.device(0x33)->stale_reads, rig.wire.device(0x34)->stale_reads};
+
+    const std::vector<uint32_t> completed = rig.run(64 * period_us);
+    for (uint8_t i = 0; i < 2; i++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(63, completed[i]);
+        TEST_ASSERT_LESS_OR_EQUAL(65, completed[i]);
+        TEST_ASSERT_EQUAL(0, rig.scheduler.stats(i).errors);
+    }
+    TEST_ASSERT_EQUAL(overwritten[0], rig.overwritten(0x33));
+    TEST_ASSERT_EQUAL(overwritten[1], rig.overwritten(0x34));
+    TEST_ASSERT_EQUAL(stale_reads[0], rig.wire.device(0x33)->stale_reads);
+    TEST_ASSERT_EQUAL(stale_reads[1], rig.wire.device(0x34)->stale_reads);
+}
+
+void test_bus_utilization_is_reported_per_sensor() {
+    Rig rig;
+    rig.add(0x33, 50000);
+    rig.add(0x34, 66000);
+    rig.start();
+    rig.run(32 * period_us);
+
+    const float total = rig.scheduler.utilization();
+    TEST_ASSERT_TRUE(rig.scheduler.utilization(0) > 0.3f && rig.scheduler.utilization(0) < 0.5f);
+    TEST_ASSERT_TRUE(rig.scheduler.utilization(1) > 0.3f && rig.scheduler.utilization(1) < 0.5f);
+    TEST_ASSERT_TRUE(total < 1.0f);
+    TEST_ASSERT_TRUE(rig.scheduler.stats(0).bus_us > 0);
+}
+
+void test_overloaded_bus_reports_missed_frames() {
+    // Three full subpage reads at 400 kHz take longer than one subpage period.
+    Rig rig;
+    rig.add(0x33, 50000);
+    rig.add(0x34, 60000);
+    rig.add(0x35, 70000);
+    rig.start();
+    rig.run(period_us);
+    uint32_t overwritten_before = 0;
+    for (uint8_t address = 0x33; address <= 0x35; address++) {
+        overwritten_before += rig.overwritten(address);
+    }
+
+    rig.run(64 * period_us);
+    uint32_t missed = 0;
+    uint32_t overwritten = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        missed += rig.scheduler.stats(i).missed_frames;
+        overwritten += rig.overwritten(0x33 + i);
+    }
+    overwritten -= overwritten_before;
+    TEST_ASSERT_GREATER_THAN(0, overwritten);
+    TEST_ASSERT_GREATER_OR_EQUAL(overwritten * 8 / 10, missed);
+    TEST_ASSERT_TRUE(rig.scheduler.utilization() > 0.9f);
+}
+
+void test_prediction_tracks_sensor_clock_error() {
+    Rig rig;
+    rig.add(0x33, 50000);
+    rig.wire.device(0x33)->period_scale_ppm = 990000; // sensor runs 1% fast
+    rig.start();
+    rig.run(period_us);
+    const uint32_t overwritten = rig.overwritten(0x33);
+    const uint32_t polls = rig.scheduler.stats(0).polls;
+    const uint32_t frames = rig.scheduler.stats(0).frames;
+
+    rig.run(128 * period_us);
+    const uint32_t served = rig.scheduler.stats(0).frames - frames;
+    TEST_ASSERT_GREATER_OR_EQUAL(128, served);
+    TEST_ASSERT_EQUAL(overwritten, rig.overwritten(0x33));
+    TEST_ASSERT_EQUAL(0, rig.scheduler.stats(0).missed_frames);
+    // Polling starts shortly before data-ready, not continuously
+    TEST_ASSERT_LESS_OR_EQUAL(4 * served, rig.scheduler.stats(0).polls - polls);
+}
+
+void test_rejects_foreign_bus_and_too_many_sensors() {
+    Rig rig;
+    MockMLX90641Bus other_wire(rig.clock);
+    I2CAdapter other_i2c(other_wire);
+    MLX90641Sensor foreign(other_i2c, 0x33);
+    uint8_t index;
+    TEST_ASSERT_TRUE(rig.scheduler.add_sensor(foreign, period_us, index) == BusStatus::WrongBus);
+
+    std::vector<std::unique_ptr<MLX90641Sensor>> sensors;
+    for (std::size_t i = 0; i < BusScheduler::max_sensors; i++) {
+        sensors.emplace_back(new MLX90641Sensor(rig.i2c, static_cast<uint8_t>(0x33 + i)));
+        TEST_ASSERT_TRUE(rig.scheduler.add_sensor(*sensors.back(), period_us, index) == BusStatus::Success);
+        TEST_ASSERT_EQUAL(i, index);
+    }
+    MLX90641Sensor extra(rig.i2c, 0x40);
+    TEST_ASSERT_TRUE(rig.scheduler.add_sensor(extra, period_us, index) == BusStatus::TooManySensors);
+}
+
+void test_absent_sensor_counts_errors_without_blocking_others() {
+    Rig rig;
+    rig.add(0x33, 50000);
+    rig.sensors.emplace_back(new MLX90641Sensor(rig.i2c, 0x36)); // nothing answers at 0x36
+    rig.start();
+
+    const std::vector<uint32_t> completed = rig.run(16 * period_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(15, completed[0]);
+    TEST_ASSERT_EQUAL(0, completed[1]);
+    TEST_ASSERT_GREATER_THAN(0, rig.scheduler.stats(1).errors);
+}
+
+void test_mixed_sensor_types_share_the_bus() {
+    // Raw frame reads only: neither sensor needs its calibration for the scheduler.
+    VirtualClock clock;
+    MockMLX90641Bus wire(clock);
+    I2CAdapter i2c(wire);
+    i2c.set_frequency(400);
+    BusScheduler scheduler(i2c, clock);
+    const uint8_t refresh_rate = 0x04; // 8 Hz, room for a whole MLX90640 subpage next to the MLX90641
+    const uint32_t slow_period_us = AcquisitionScheduler::subpage_period_us(refresh_rate);
+    wire.add_device(0x33, 50000, test_eeprom_data.data(), refresh_rate);
+    wire.add_device(0x34, 90000, test_eeprom_data.data(), refresh_rate);
+    MLX90641Sensor small(i2c, 0x33);
+    MLX90640Sensor large(i2c, 0x34);
+    uint8_t index;
+    TEST_ASSERT_TRUE(scheduler.add_sensor(small, slow_period_us, index) == BusStatus::Success);
+    TEST_ASSERT_TRUE(scheduler.add_sensor(large, slow_period_us, index) == BusStatus::Success);
+    TEST_ASSERT_EQUAL(1, index);
+
+    std::vector<uint32_t> completed(2, 0);
+    const uint32_t end_us = clock.now_us() + 16 * slow_period_us;
+    while (static_cast<int32_t>(clock.now_us() - end_us) < 0) {
+        const uint8_t done = scheduler.step();
+        if (done != BusScheduler::no_sensor) {
+            completed[done]++;
+        }
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(15, completed[i]);
+        TEST_ASSERT_EQUAL(0, scheduler.stats(i).errors);
+    }
+    // Each sensor is read with its own block layout: the MLX90640 has four times the pixels.
+    TEST_ASSERT_TRUE(scheduler.stats(1).bus_us > 2 * scheduler.stats(0).bus_us);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_two_sensors_share_the_bus_without_missing_subpages);
+    RUN_TEST(test_bus_utilization_is_reported_per_sensor);
+    RUN_TEST(test_overloaded_bus_reports_missed_frames);
+    RUN_TEST(test_prediction_tracks_sensor_clock_error);
+    RUN_TEST(test_rejects_foreign_bus_and_too_many_sensors);
+    RUN_TEST(test_absent_sensor_counts_errors_without_blocking_others);
+    RUN_TEST(test_mixed_sensor_types_share_the_bus);
+    return UNITY_END();
+}
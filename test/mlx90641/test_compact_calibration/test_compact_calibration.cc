@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <cmath>
+#include <cstring>
+#include "acquisition_scheduler.hh"
+#include "mlx90641_driver.hh"
+#include "mlx90641_eeprom_parser.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+
+namespace {
+
+bool same_bits(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+uint32_t fnv1a(const void* data, std::size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+ParamsMLX90641 expanded;
+CompactParamsMLX90641 compact;
+
+} // namespace
+
+void setUp(void) {
+    MLX90641EEpromParser parser(test_eeprom_data);
+    parser.extract_all(expanded);
+    parser.extract_all(compact);
+}
+
+void tearDown(void) {}
+
+void test_compact_coefficients_decode_bit_identical() {
+    for (std::size_t p = 0; p < 192; p++) {
+        TEST_ASSERT_TRUE(same_bits(expanded.alpha[p], compact.alpha[p]));
+        TEST_ASSERT_TRUE(same_bits(expanded.kta[p], compact.kta[p]));
+        TEST_ASSERT_TRUE(same_bits(expanded.kv[p], compact.kv[p]));
+    }
+}
+
+void test_compact_keeps_eeprom_bit_widths() {
+    for (std::size_t p = 0; p < 192; p++) {
+        TEST_ASSERT_LESS_THAN(2048, compact.alpha.raw[p]);
+        TEST_ASSERT_TRUE(compact.kta.raw[p] >= -32 && compact.kta.raw[p] < 32);
+        TEST_ASSERT_TRUE(compact.kv.raw[p] >= -16 && compact.kv.raw[p] < 16);
+    }
+}
+
+void test_shared_parameters_match() {
+    TEST_ASSERT_TRUE(expanded.offset == compact.offset);
+    TEST_ASSERT_TRUE(expanded.ksTo == compact.ksTo);
+    TEST_ASSERT_TRUE(expanded.brokenPixels == compact.brokenPixels);
+    TEST_ASSERT_EQUAL(expanded.gainEE, compact.gainEE);
+    TEST_ASSERT_TRUE(same_bits(expanded.cpAlpha, compact.cpAlpha));
+}
+
+void test_compact_storage_saves_ram() {
+    TEST_ASSERT_GREATER_OR_EQUAL(1400, sizeof(ParamsMLX90641) - sizeof(CompactParamsMLX90641));
+}
+
+// Same frame through the driver: the temperatures must not depend on the calibration storage
+// (run in both the native and native_compact environments).
+void test_temperatures_are_identical_for_both_storage_options() {
+    VirtualClock clock;
+    MockMLX90641Bus wire(clock);
+    I2CAdapter i2c(wire);
+    MockMLX90641Bus::Device& device = wire.add_device(0x33, 100000, test_eeprom_data.data());
+    device.pixel_value = 0x0200;
+    device.memory[0x0580 + (192 - 192)] = 19947;              // PTAT art
+    device.memory[0x0580 + (200 - 192)] = 0xFFC0;             // compensation pixel
+    device.memory[0x0580 + (202 - 192)] = 7685;               // gain
+    device.memory[0x0580 + (224 - 192)] = 1600;               // PTAT
+    device.memory[0x0580 + (234 - 192)] = 0x9E40;             // Vdd ~3.3 V at 18-bit resolution
+
+    MLX90641Sensor sensor(i2c, 0x33);
+    TEST_ASSERT_TRUE(sensor.init());
+    // The reference frame is subpage 0 (offsets differ per subpage), whatever init() took.
+    uint32_t wake_us = device.next_frame_us;
+    if (device.sub_page == 0) {
+        wake_us += AcquisitionScheduler::subpage_period_us(MLX90641Sensor::default_refresh_rate);
+    }
+    clock.sleep_until_us(wake_us);
+    TEST_ASSERT_TRUE(sensor.read_frame());
+    sensor.calculate_temps();
+
+    const auto& temps = sensor.get_temps();
+    for (std::size_t p = 0; p < temps.size(); p++) {
+        TEST_ASSERT_TRUE(std::isfinite(temps[p]));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, sensor.get_ambient());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 64.93f, temps[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x8DBCA2BBu, fnv1a(temps.data(), sizeof(float) * temps.size()));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_compact_coefficients_decode_bit_identical);
+    RUN_TEST(test_compact_keeps_eeprom_bit_widths);
+    RUN_TEST(test_shared_parameters_match);
+    RUN_TEST(test_compact_storage_saves_ram);
+    RUN_TEST(test_temperatures_are_identical_for_both_storage_options);
+    return UNITY_END();
+}
@@ -0,0 +1,407 @@
+#include "test_data_mlx90641_golden.hh"
+
+namespace mlx90641 {
+const std::array<GoldenFrame, 8> golden_frames = {{
+{"recorded, subpage 0",
+ {{
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x4DEB, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFFC0, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x9E40, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0000,
+ }},
+ {{
+  65.72447f, 60.79444f, 56.95981f, 53.35053f, 52.44099f, 51.26024f, 50.08715f, 49.05481f,
+  49.87938f, 50.89552f, 52.26480f, 54.11788f, 58.09180f, 61.71445f, 68.23736f, 88.08441f,
+  60.63784f, 56.72753f, 53.14359f, 51.13267f, 49.10176f, 47.17987f, 46.65114f, 46.50701f,
+  46.52529f, 47.50929f, 48.94024f, 50.62471f, 52.79445f, 56.72812f, 62.34324f, 72.38996f,
+  59.74596f, 55.66455f, 52.35275f, 49.08368f, 47.54048f, 46.49367f, 45.82738f, 44.85799f,
+  45.54409f, 46.01854f, 47.41262f, 48.86839f, 51.20334f, 55.03142f, 60.04619f, 66.88523f,
+  57.29345f, 53.31562f, 50.08444f, 47.68394f, 45.77271f, 44.76299f, 43.89570f, 44.26181f,
+  43.96226f, 44.17391f, 45.39558f, 46.81695f, 48.72419f, 52.20178f, 56.80356f, 63.43821f,
+  58.50844f, 53.95887f, 50.40701f, 46.73457f, 45.58160f, 44.59442f, 44.12892f, 43.15042f,
+  43.37932f, 44.00668f, 45.26624f, 46.28199f, 48.64751f, 51.84536f, 56.30826f, 61.29265f,
+  57.46471f, 53.57115f, 49.94493f, 47.46243f, 45.39913f, 43.88689f, 43.25423f, 43.51442f,
+  42.96444f, 43.28198f, 44.24165f, 45.78465f, 47.34180f, 50.42990f, 54.57771f, 59.90723f,
+  60.07078f, 54.54255f, 51.52961f, 48.14906f, 46.10649f, 45.45342f, 44.37503f, 43.47271f,
+  43.29853f, 44.24469f, 44.81650f, 45.87838f, 48.11203f, 51.10909f, 54.94381f, 59.99246f,
+  61.05110f, 55.81953f, 52.12465f, 49.10982f, 46.81970f, 45.16698f, 44.19481f, 44.21117f,
+  43.85064f, 43.92638f, 45.23885f, 46.37161f, 48.37515f, 51.26223f, 55.33797f, 59.93052f,
+  65.67608f, 59.71562f, 55.31505f, 51.17332f, 48.61231f, 47.10180f, 46.62789f, 44.87869f,
+  45.28224f, 45.43720f, 46.98131f, 47.60748f, 49.69080f, 52.86482f, 56.96984f, 60.67059f,
+  69.24495f, 62.54632f, 58.01540f, 54.21427f, 51.17454f, 49.31028f, 48.46638f, 47.00052f,
+  46.82191f, 46.91059f, 47.93737f, 49.29840f, 51.30013f, 54.38004f, 57.87866f, 63.48705f,
+  76.89185f, 68.42030f, 63.51941f, 58.73120f, 54.89338f, 53.02711f, 51.93101f, 50.36477f,
+  49.74011f, 50.42701f, 51.73948f, 52.30538f, 54.07847f, 58.03145f, 62.27572f, 70.20176f,
+  85.89589f, 76.73182f, 69.97913f, 65.07862f, 60.93833f, 58.08037f, 56.31400f, 55.89665f,
+  54.32294f, 54.37611f, 55.61785f, 56.45819f, 57.59431f, 61.06773f, 66.37327f, 94.20924f,
+ }}},
+{"recorded, subpage 1",
+ {{
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200, 0x0200,
+  0x4DEB, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFFC0, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x9E40, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0001,
+ }},
+ {{
+  65.60493f, 60.90713f, 56.95981f, 53.35053f, 52.35140f, 51.34680f, 50.08715f, 49.05481f,
+  49.87938f, 50.98068f, 52.35343f, 54.11788f, 58.09180f, 61.71445f, 68.35441f, 88.08441f,
+  60.63784f, 56.83595f, 53.24227f, 51.04265f, 49.01722f, 47.26031f, 46.65114f, 46.43152f,
+  46.44809f, 47.58829f, 48.94024f, 50.62471f, 52.70277f, 56.83032f, 62.46055f, 72.38996f,
+  59.63872f, 55.76214f, 52.35275f, 49.08368f, 47.54048f, 46.56717f, 45.82738f, 44.85799f,
+  45.54409f, 46.01854f, 47.48834f, 48.86839f, 51.11941f, 55.12354f, 60.15053f, 67.00567f,
+  57.29345f, 53.41183f, 50.08444f, 47.60458f, 45.69889f, 44.83449f, 43.89570f, 44.19317f,
+  43.96226f, 44.17391f, 45.39558f, 46.81695f, 48.72419f, 52.29286f, 56.90767f, 63.55381f,
+  58.40737f, 54.05066f, 50.40701f, 46.65922f, 45.44235f, 44.66100f, 44.12892f, 43.15042f,
+  43.31799f, 44.07258f, 45.19721f, 46.20687f, 48.57088f, 52.01718f, 56.30826f, 61.17987f,
+  57.35559f, 53.57115f, 49.94493f, 47.38779f, 45.32899f, 43.95299f, 43.32074f, 43.45003f,
+  42.90112f, 43.34701f, 44.17107f, 45.71319f, 47.26408f, 50.51764f, 54.47879f, 59.90723f,
+  60.07078f, 54.62966f, 51.52961f, 48.14906f, 46.10649f, 45.45342f, 44.43761f, 43.47271f,
+  43.23821f, 44.24469f, 44.88272f, 45.80665f, 48.03625f, 51.27609f, 55.03757f, 59.99246f,
+  61.05110f, 56.00337f, 52.20837f, 49.10982f, 46.75005f, 45.23395f, 44.26111f, 44.21117f,
+  43.78732f, 43.99131f, 45.23885f, 46.37161f, 48.29617f, 51.43916f, 55.33797f, 60.04379f,
+  65.67608f, 59.80619f, 55.39791f, 51.17332f, 48.54202f, 47.23098f, 46.69251f, 44.87869f,
+  45.21866f, 45.56545f, 46.98131f, 47.68203f, 49.69080f, 53.03655f, 57.06807f, 60.78706f,
+  69.13247f, 62.64322f, 58.01540f, 54.21427f, 51.17454f, 49.38210f, 48.46638f, 47.00052f,
+  46.75467f, 47.05050f, 47.93737f, 49.22022f, 51.30013f, 54.47637f, 57.87866f, 63.48705f,
+  76.78101f, 68.51799f, 63.51941f, 58.64666f, 54.89338f, 53.09960f, 51.93101f, 50.36477f,
+  49.67055f, 50.49721f, 51.66140f, 52.22369f, 53.90286f, 58.03145f, 62.16845f, 70.06069f,
+  85.89589f, 76.83571f, 69.97913f, 64.99262f, 60.85825f, 58.15788f, 56.31400f, 55.89665f,
+  54.25001f, 54.37611f, 55.44920f, 56.28896f, 57.40362f, 61.17358f, 66.24986f, 94.02396f,
+ }}},
+{"sweep Ta -40, subpage 0",
+ {{
+  0xFF06, 0xFF1C, 0xFF30, 0xFF48, 0xFF57, 0xFF71, 0xFF8C, 0xFFA9, 0xFFB6, 0xFFCE, 0xFFD9, 0xFFE0,
+  0xFFDA, 0xFFD3, 0xFFBD, 0xFF8C, 0x0025, 0x0050, 0x0092, 0x00CF, 0x0114, 0x0154, 0x0189, 0x01B7,
+  0x01D0, 0x01ED, 0x01D7, 0x01C4, 0x01AC, 0x017F, 0x0136, 0x00E2, 0x0195, 0x0223, 0x02A6, 0x0338,
+  0x03B6, 0x042C, 0x0492, 0x04CE, 0x04EC, 0x04F5, 0x04C6, 0x04A0, 0x0450, 0x03E3, 0x0354, 0x02D2,
+  0x03F3, 0x04D1, 0x05BA, 0x0687, 0x0777, 0x0831, 0x08C2, 0x0907, 0x0988, 0x099B, 0x0919, 0x0897,
+  0x0813, 0x074C, 0x0646, 0x0554, 0x06CF, 0x082D, 0x098C, 0x0B0D, 0x0C76, 0x0DDF, 0x0E96, 0x0F51,
+  0x0FC2, 0x0F5C, 0x0ECC, 0x0DF6, 0x0D3B, 0x0BF9, 0x0A55, 0x08D6, 0x0ABF, 0x0CFB, 0x0EAB, 0x1121,
+  0x1312, 0x14BB, 0x157E, 0x164F, 0x16FC, 0x1714, 0x157E, 0x14B4, 0x1316, 0x1125, 0x0F0C, 0x0CCA,
+  0x0F06, 0x1261, 0x150E, 0x1815, 0x1A44, 0x1C76, 0x1E01, 0x1F26, 0x1F48, 0x1F7A, 0x1D76, 0x1BCB,
+  0x1966, 0x1763, 0x1461, 0x116F, 0x1411, 0x17E5, 0x1B57, 0x1E3E, 0x21FF, 0x2487, 0x25E2, 0x27B9,
+  0x2801, 0x2826, 0x2539, 0x2301, 0x20A7, 0x1D8F, 0x19BB, 0x15E0, 0x18F4, 0x1DE5, 0x222B, 0x25F3,
+  0x2A01, 0x2E66, 0x2F4F, 0x3138, 0x30CB, 0x30FA, 0x2DA4, 0x2B15, 0x27A5, 0x2490, 0x1F9F, 0x1ADC,
+  0x1E17, 0x2362, 0x27AD, 0x2CBB, 0x3105, 0x3591, 0x3780, 0x390C, 0x39C5, 0x38FB, 0x3549, 0x31CA,
+  0x2ECD, 0x29D0, 0x23CF, 0x1EA7, 0x21CE, 0x284D, 0x2C42, 0x32E4, 0x3771, 0x3CBE, 0x3E63, 0x4057,
+  0x4007, 0x40BE, 0x3B1C, 0x38E7, 0x33F8, 0x2FA0, 0x28FD, 0x1EA1, 0x2481, 0x2C21, 0x30B8, 0x3721,
+  0x3C70, 0x40C4, 0x43AD, 0x45A3, 0x4693, 0x4450, 0x4073, 0x3E9C, 0x3867, 0x3325, 0x2AEB, 0x166B,
+  0x7467, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFE7F, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF20, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0000,
+ }},
+ {{
+  -40.03483f, -38.19657f, -36.41587f, -34.65275f, -32.86436f, -31.11216f, -29.34782f, -27.52171f,
+  -25.77103f, -24.00033f, -22.18680f, -20.41314f, -18.62424f, -16.83155f, -15.04467f, -13.26472f,
+  -11.52098f, -9.73503f, -7.94745f, -6.19408f, -4.40395f, -2.63127f, -0.81473f, 0.95764f,
+  2.72668f, 4.49483f, 6.26854f, 8.04097f, 9.82831f, 11.62430f, 13.37723f, 15.14478f,
+  16.94515f, 18.76254f, 20.52303f, 22.28961f, 24.08240f, 25.85913f, 27.65915f, 29.42618f,
+  31.20208f, 32.97977f, 34.76224f, 36.56068f, 38.33536f, 40.11092f, 41.89834f, 43.65637f,
+  45.43837f, 47.23318f, 48.99074f, 50.79072f, 52.56737f, 54.34352f, 56.12160f, 57.91579f,
+  59.67530f, 61.47510f, 63.25686f, 65.02497f, 66.79887f, 68.58160f, 70.35218f, 72.16205f,
+  73.91344f, 75.69265f, 77.48958f, 79.26890f, 81.04795f, 82.82408f, 84.59800f, 86.38038f,
+  88.17044f, 89.95540f, 91.72390f, 93.49814f, 95.29629f, 97.05702f, 98.83679f, 100.61469f,
+  102.40266f, 104.17849f, 105.97057f, 107.75235f, 109.53161f, 111.31331f, 113.08960f, 114.87498f,
+  116.64490f, 118.42725f, 120.21543f, 121.99404f, 123.76976f, 125.55459f, 127.32281f, 129.11688f,
+  130.88928f, 132.67700f, 134.45024f, 136.22770f, 138.01619f, 139.78830f, 141.57379f, 143.35272f,
+  145.13551f, 146.91308f, 148.69341f, 150.47762f, 152.25295f, 154.02482f, 155.81928f, 157.59833f,
+  159.38046f, 161.15763f, 162.92857f, 164.71098f, 166.49010f, 168.27223f, 170.05371f, 171.83321f,
+  173.61542f, 175.39546f, 177.16800f, 178.95875f, 180.73920f, 182.51545f, 184.28512f, 186.07984f,
+  187.84652f, 189.63817f, 191.40802f, 193.18773f, 194.96984f, 196.75444f, 198.53546f, 200.31798f,
+  202.09016f, 203.87393f, 205.65156f, 207.43162f, 209.21311f, 210.99703f, 212.78058f, 214.55378f,
+  216.32798f, 218.11427f, 219.89409f, 221.67879f, 223.45346f, 225.23683f, 227.01235f, 228.79720f,
+  230.57387f, 232.35512f, 234.13642f, 235.91285f, 237.70109f, 239.48196f, 241.25290f, 243.04156f,
+  244.82001f, 246.59297f, 248.38075f, 250.15264f, 251.93254f, 253.71643f, 255.49556f, 257.28054f,
+  259.05391f, 260.83714f, 262.61596f, 264.39674f, 266.17767f, 267.95811f, 269.73590f, 271.51354f,
+  273.29360f, 275.07711f, 276.85351f, 278.63914f, 280.42235f, 282.19687f, 283.97721f, 285.75912f,
+  287.53975f, 289.31861f, 291.10092f, 292.88307f, 294.66497f, 296.43521f, 298.21631f, 299.99886f,
+ }}},
+{"sweep Ta -40, subpage 1",
+ {{
+  0xFF07, 0xFF1B, 0xFF30, 0xFF48, 0xFF58, 0xFF70, 0xFF8C, 0xFFA9, 0xFFB6, 0xFFCE, 0xFFD8, 0xFFE0,
+  0xFFDA, 0xFFD3, 0xFFBC, 0xFF8C, 0x0025, 0x004F, 0x0091, 0x00D0, 0x0115, 0x0153, 0x0189, 0x01B7,
+  0x01D1, 0x01EC, 0x01D7, 0x01C4, 0x01AD, 0x017E, 0x0136, 0x00E2, 0x0196, 0x0222, 0x02A6, 0x0338,
+  0x03B6, 0x042B, 0x0492, 0x04CE, 0x04EC, 0x04F5, 0x04C5, 0x04A0, 0x0450, 0x03E2, 0x0353, 0x02D1,
+  0x03F3, 0x04D0, 0x05BA, 0x0688, 0x0778, 0x0830, 0x08C2, 0x0907, 0x0988, 0x099B, 0x0919, 0x0897,
+  0x0813, 0x074B, 0x0646, 0x0553, 0x06D0, 0x082D, 0x098C, 0x0B0E, 0x0C78, 0x0DDE, 0x0E96, 0x0F51,
+  0x0FC3, 0x0F5B, 0x0ECD, 0x0DF7, 0x0D3B, 0x0BF8, 0x0A55, 0x08D7, 0x0AC0, 0x0CFB, 0x0EAB, 0x1122,
+  0x1313, 0x14BA, 0x157D, 0x164F, 0x16FD, 0x1713, 0x157E, 0x14B5, 0x1317, 0x1124, 0x0F0D, 0x0CCA,
+  0x0F06, 0x1260, 0x150E, 0x1815, 0x1A44, 0x1C76, 0x1E00, 0x1F26, 0x1F48, 0x1F7A, 0x1D75, 0x1BCB,
+  0x1967, 0x1762, 0x1460, 0x116F, 0x1411, 0x17E3, 0x1B56, 0x1E3E, 0x2200, 0x2486, 0x25E1, 0x27B9,
+  0x2802, 0x2825, 0x2539, 0x2301, 0x20A7, 0x1D8D, 0x19BB, 0x15DF, 0x18F4, 0x1DE4, 0x222B, 0x25F3,
+  0x2A02, 0x2E64, 0x2F4E, 0x3138, 0x30CC, 0x30F9, 0x2DA4, 0x2B15, 0x27A5, 0x248E, 0x1F9E, 0x1ADB,
+  0x1E18, 0x2361, 0x27AD, 0x2CBB, 0x3105, 0x3590, 0x3780, 0x390C, 0x39C6, 0x38FA, 0x3549, 0x31CB,
+  0x2ECD, 0x29CF, 0x23CF, 0x1EA7, 0x21CF, 0x284D, 0x2C42, 0x32E5, 0x3771, 0x3CBD, 0x3E63, 0x4057,
+  0x4008, 0x40BD, 0x3B1D, 0x38E8, 0x33FA, 0x2FA0, 0x28FE, 0x1EA2, 0x2481, 0x2C20, 0x30B8, 0x3722,
+  0x3C70, 0x40C3, 0x43AD, 0x45A3, 0x4694, 0x4450, 0x4074, 0x3E9D, 0x3868, 0x3325, 0x2AEC, 0x166C,
+  0x7467, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFE7F, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF20, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0001,
+ }},
+ {{
+  -40.00150f, -38.22398f, -36.41587f, -34.65275f, -32.84577f, -31.12918f, -29.34782f, -27.52171f,
+  -25.77103f, -23.94194f, -22.20480f, -20.41314f, -18.62424f, -16.83155f, -15.06991f, -13.26472f,
+  -11.52098f, -9.75215f, -7.96196f, -6.18066f, -4.39182f, -2.64245f, -0.81473f, 0.91949f,
+  2.73718f, 4.48465f, 6.26854f, 8.04097f, 9.84142f, 11.60997f, 13.43480f, 15.14478f,
+  16.96023f, 18.75018f, 20.52303f, 22.28961f, 24.08240f, 25.85101f, 27.65915f, 29.42618f,
+  31.20208f, 32.97977f, 34.75434f, 36.56068f, 38.30464f, 40.10052f, 41.88651f, 43.64199f,
+  45.43837f, 47.22451f, 48.99074f, 50.79764f, 52.57359f, 54.33781f, 56.12160f, 57.89625f,
+  59.67530f, 61.47510f, 63.25686f, 65.02497f, 66.79887f, 68.57431f, 70.38112f, 72.15194f,
+  73.92146f, 75.71628f, 77.48958f, 79.27437f, 81.05756f, 82.81951f, 84.59800f, 86.38038f,
+  88.17454f, 89.95100f, 91.72841f, 93.50305f, 95.27928f, 97.07002f, 98.83679f, 100.62283f,
+  102.40882f, 104.17849f, 105.97057f, 107.75648f, 109.53538f, 111.30980f, 113.08621f, 114.86341f,
+  116.64818f, 118.42407f, 120.20323f, 121.99780f, 123.77393f, 125.54985f, 127.32812f, 129.11688f,
+  130.88928f, 132.67246f, 134.45024f, 136.22770f, 138.01619f, 139.78830f, 141.57085f, 143.35272f,
+  145.12610f, 146.91308f, 148.69028f, 150.46681f, 152.25665f, 154.03378f, 155.81474f, 157.59833f,
+  159.38046f, 161.14984f, 162.92515f, 164.71098f, 166.49300f, 168.26948f, 170.05106f, 171.83321f,
+  173.61794f, 175.39301f, 177.16800f, 178.95875f, 180.72883f, 182.50856f, 184.28512f, 186.07513f,
+  187.84652f, 189.63455f, 191.41811f, 193.18773f, 194.97257f, 196.74942f, 198.53307f, 200.31798f,
+  202.09257f, 203.87886f, 205.65156f, 207.44008f, 209.21311f, 210.99084f, 212.77706f, 214.54944f,
+  216.33183f, 218.11093f, 219.89409f, 221.67879f, 223.45346f, 225.23452f, 227.01235f, 228.79720f,
+  230.57603f, 232.35979f, 234.13642f, 235.91528f, 237.70109f, 239.47912f, 241.25290f, 243.04156f,
+  244.82393f, 246.60280f, 248.38075f, 250.15531f, 251.93254f, 253.71415f, 255.49556f, 257.28054f,
+  259.05615f, 260.83499f, 262.61827f, 264.39909f, 266.18304f, 267.95811f, 269.73913f, 271.51797f,
+  273.29360f, 275.07363f, 276.85351f, 278.64202f, 280.41488f, 282.19439f, 283.97721f, 285.75912f,
+  287.54205f, 289.31861f, 291.09587f, 292.87757f, 294.65911f, 296.44482f, 298.21954f, 300.00495f,
+ }}},
+{"sweep Ta +25, subpage 0",
+ {{
+  0xFC5A, 0xFC22, 0xFBED, 0xFBA7, 0xFB64, 0xFB46, 0xFB39, 0xFB53, 0xFB6C, 0xFB9F, 0xFBE7, 0xFC33,
+  0xFC74, 0xFCA6, 0xFCFD, 0xFDB2, 0xFD33, 0xFCFE, 0xFCD6, 0xFCB2, 0xFCA2, 0xFCA8, 0xFCBB, 0xFCBF,
+  0xFCF3, 0xFD15, 0xFD63, 0xFD8B, 0xFDC0, 0xFDF8, 0xFE32, 0xFE47, 0xFE4C, 0xFE59, 0xFE71, 0xFE98,
+  0xFEB6, 0xFEDF, 0xFF09, 0xFF49, 0xFF6E, 0xFF9C, 0xFFBD, 0xFFE2, 0xFFE4, 0xFFE5, 0xFFDB, 0xFFCE,
+  0x005C, 0x00B0, 0x011D, 0x017E, 0x01F8, 0x0266, 0x02C7, 0x0303, 0x035E, 0x038D, 0x0379, 0x0355,
+  0x0331, 0x02EA, 0x027C, 0x0209, 0x02E0, 0x03B6, 0x0490, 0x0584, 0x0698, 0x0757, 0x07E4, 0x0879,
+  0x08D3, 0x08BB, 0x0881, 0x081E, 0x07B8, 0x0705, 0x0608, 0x0525, 0x0684, 0x080B, 0x0944, 0x0AFB,
+  0x0C69, 0x0DA8, 0x0E51, 0x0EFA, 0x0F90, 0x0FC1, 0x0EC0, 0x0E42, 0x0D33, 0x0BE2, 0x0A6F, 0x08D4,
+  0x0A75, 0x0D04, 0x0F14, 0x116F, 0x1327, 0x14E3, 0x1629, 0x1724, 0x1753, 0x1796, 0x1624, 0x14F4,
+  0x132C, 0x11AF, 0x0F67, 0x0D2B, 0x0F45, 0x1254, 0x1520, 0x177D, 0x1A8B, 0x1CA7, 0x1DD6, 0x1F61,
+  0x1FB3, 0x1FEC, 0x1DA8, 0x1BEB, 0x1A15, 0x17A3, 0x1495, 0x1177, 0x13EB, 0x1808, 0x1B9F, 0x1ED0,
+  0x223A, 0x25EC, 0x26C5, 0x2873, 0x282B, 0x2866, 0x25B4, 0x23A4, 0x20CE, 0x1E47, 0x1A2E, 0x163C,
+  0x18EA, 0x1D6B, 0x211D, 0x2570, 0x2926, 0x2D16, 0x2ED0, 0x3030, 0x30E0, 0x3047, 0x2D33, 0x2A42,
+  0x27BF, 0x2388, 0x1E6B, 0x1A03, 0x1C95, 0x223B, 0x25B6, 0x2B80, 0x2F7B, 0x3420, 0x359C, 0x3760,
+  0x3729, 0x37D7, 0x3306, 0x312A, 0x2CE7, 0x2926, 0x2366, 0x1A68, 0x1F5D, 0x2610, 0x2A20, 0x2FC5,
+  0x3478, 0x3857, 0x3AF5, 0x3CBA, 0x3D9A, 0x3BB2, 0x385C, 0x36C9, 0x315D, 0x2CC7, 0x2590, 0x1374,
+  0x4DEB, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFE20, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF20, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0000,
+ }},
+ {{
+  -40.04911f, -38.25345f, -36.38416f, -34.70137f, -32.89923f, -31.10587f, -29.30205f, -27.50399f,
+  -25.76939f, -24.01526f, -22.16522f, -20.38177f, -18.60658f, -16.87943f, -15.05812f, -13.20875f,
+  -11.50821f, -9.72551f, -7.96412f, -6.19592f, -4.40495f, -2.59388f, -0.83744f, 0.91912f,
+  2.70798f, 4.47886f, 6.30859f, 8.07394f, 9.84520f, 11.59940f, 13.38278f, 15.20342f,
+  16.93565f, 18.72510f, 20.49806f, 22.32614f, 24.08586f, 25.85495f, 27.62577f, 29.43917f,
+  31.21449f, 33.00210f, 34.78033f, 36.55026f, 38.31148f, 40.08456f, 41.85990f, 43.69218f,
+  45.46838f, 47.24425f, 49.02195f, 50.77810f, 52.55320f, 54.33471f, 56.11483f, 57.91559f,
+  59.67588f, 61.46420f, 63.23465f, 65.01988f, 66.79744f, 68.59706f, 70.35351f, 72.16069f,
+  73.91680f, 75.69308f, 77.49285f, 79.26130f, 81.04144f, 82.82553f, 84.60834f, 86.39476f,
+  88.16991f, 89.94622f, 91.72728f, 93.50293f, 95.27985f, 97.07510f, 98.86234f, 100.62154f,
+  102.39972f, 104.18585f, 105.97749f, 107.74260f, 109.52249f, 111.30060f, 113.08842f, 114.86444f,
+  116.65348f, 118.42963f, 120.20331f, 121.98359f, 123.77057f, 125.54676f, 127.32509f, 129.11365f,
+  130.88673f, 132.66935f, 134.45205f, 136.23675f, 138.01207f, 139.78794f, 141.57482f, 143.34551f,
+  145.13407f, 146.91719f, 148.68423f, 150.46387f, 152.25115f, 154.03715f, 155.80196f, 157.58201f,
+  159.37327f, 161.14592f, 162.93570f, 164.71874f, 166.49283f, 168.26975f, 170.04661f, 171.83220f,
+  173.60829f, 175.39744f, 177.16965f, 178.95081f, 180.73529f, 182.51723f, 184.28683f, 186.07350f,
+  187.85911f, 189.62800f, 191.42054f, 193.18793f, 194.97204f, 196.75687f, 198.53304f, 200.31514f,
+  202.09494f, 203.87517f, 205.65656f, 207.42995f, 209.21206f, 210.99606f, 212.77121f, 214.56227f,
+  216.32790f, 218.10974f, 219.88963f, 221.67710f, 223.45038f, 225.23804f, 227.01390f, 228.79454f,
+  230.58031f, 232.35256f, 234.13842f, 235.91767f, 237.69393f, 239.47343f, 241.25838f, 243.04460f,
+  244.81868f, 246.59346f, 248.38178f, 250.16061f, 251.93778f, 253.71743f, 255.49580f, 257.28187f,
+  259.05330f, 260.83622f, 262.61639f, 264.39328f, 266.18008f, 267.95839f, 269.74355f, 271.51117f,
+  273.29552f, 275.08554f, 276.85594f, 278.63471f, 280.41350f, 282.19620f, 283.97798f, 285.76383f,
+  287.54103f, 289.32301f, 291.09508f, 292.88163f, 294.65615f, 296.44241f, 298.21306f, 300.00986f,
+ }}},
+{"sweep Ta +25, subpage 1",
+ {{
+  0xFC5B, 0xFC21, 0xFBED, 0xFBA7, 0xFB65, 0xFB45, 0xFB39, 0xFB53, 0xFB6C, 0xFB9E, 0xFBE6, 0xFC33,
+  0xFC74, 0xFCA6, 0xFCFC, 0xFDB2, 0xFD33, 0xFCFD, 0xFCD5, 0xFCB3, 0xFCA3, 0xFCA7, 0xFCBB, 0xFCC0,
+  0xFCF4, 0xFD14, 0xFD63, 0xFD8B, 0xFDC1, 0xFDF7, 0xFE31, 0xFE47, 0xFE4D, 0xFE58, 0xFE71, 0xFE98,
+  0xFEB6, 0xFEDE, 0xFF09, 0xFF49, 0xFF6E, 0xFF9C, 0xFFBC, 0xFFE2, 0xFFE5, 0xFFE4, 0xFFDA, 0xFFCD,
+  0x005C, 0x00AF, 0x011D, 0x017F, 0x01F9, 0x0265, 0x02C7, 0x0304, 0x035E, 0x038D, 0x0379, 0x0355,
+  0x0331, 0x02E9, 0x027B, 0x0208, 0x02E1, 0x03B5, 0x0490, 0x0585, 0x069A, 0x0756, 0x07E4, 0x0879,
+  0x08D4, 0x08BA, 0x0882, 0x081F, 0x07B9, 0x0703, 0x0608, 0x0526, 0x0685, 0x080B, 0x0944, 0x0AFC,
+  0x0C6A, 0x0DA7, 0x0E50, 0x0EFB, 0x0F91, 0x0FC0, 0x0EC1, 0x0E43, 0x0D34, 0x0BE1, 0x0A70, 0x08D4,
+  0x0A75, 0x0D03, 0x0F14, 0x116F, 0x1327, 0x14E3, 0x1628, 0x1724, 0x1754, 0x1796, 0x1623, 0x14F5,
+  0x132D, 0x11AD, 0x0F66, 0x0D2B, 0x0F45, 0x1252, 0x151F, 0x177D, 0x1A8C, 0x1CA6, 0x1DD5, 0x1F61,
+  0x1FB4, 0x1FEB, 0x1DA8, 0x1BEB, 0x1A16, 0x17A1, 0x1495, 0x1176, 0x13EB, 0x1807, 0x1B9E, 0x1ED0,
+  0x223B, 0x25EA, 0x26C4, 0x2873, 0x282C, 0x2864, 0x25B4, 0x23A3, 0x20CE, 0x1E45, 0x1A2D, 0x163B,
+  0x18EB, 0x1D6A, 0x211D, 0x2570, 0x2926, 0x2D15, 0x2ED0, 0x3030, 0x30E1, 0x3045, 0x2D33, 0x2A43,
+  0x27BF, 0x2387, 0x1E6B, 0x1A03, 0x1C96, 0x223A, 0x25B6, 0x2B81, 0x2F7B, 0x341F, 0x359C, 0x3760,
+  0x372A, 0x37D6, 0x3307, 0x312B, 0x2CE9, 0x2926, 0x2367, 0x1A69, 0x1F5D, 0x260F, 0x2A20, 0x2FC6,
+  0x3479, 0x3856, 0x3AF5, 0x3CBA, 0x3D9B, 0x3BB2, 0x385E, 0x36CB, 0x315F, 0x2CC6, 0x2591, 0x1375,
+  0x4DEB, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFE20, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF20, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0001,
+ }},
+ {{
+  -40.04911f, -38.25345f, -36.38416f, -34.70137f, -32.89923f, -31.10587f, -29.30205f, -27.50399f,
+  -25.76939f, -24.01526f, -22.16522f, -20.38177f, -18.60658f, -16.87943f, -15.05812f, -13.20875f,
+  -11.50821f, -9.72551f, -7.96412f, -6.19592f, -4.40495f, -2.59388f, -0.83744f, 0.91912f,
+  2.70798f, 4.47886f, 6.30859f, 8.07394f, 9.84520f, 11.59940f, 13.38278f, 15.20342f,
+  16.93565f, 18.72510f, 20.49806f, 22.32614f, 24.08586f, 25.85495f, 27.62577f, 29.43917f,
+  31.21449f, 33.00210f, 34.78033f, 36.55026f, 38.31148f, 40.08456f, 41.85990f, 43.69218f,
+  45.46838f, 47.24425f, 49.02195f, 50.77810f, 52.55320f, 54.33471f, 56.11483f, 57.91559f,
+  59.67588f, 61.46420f, 63.23465f, 65.01988f, 66.79744f, 68.59706f, 70.35351f, 72.16069f,
+  73.91680f, 75.69308f, 77.49285f, 79.26130f, 81.04144f, 82.82553f, 84.60834f, 86.39476f,
+  88.16991f, 89.94622f, 91.72728f, 93.50293f, 95.27985f, 97.07510f, 98.86234f, 100.62154f,
+  102.39972f, 104.18585f, 105.97749f, 107.74260f, 109.52249f, 111.30060f, 113.08842f, 114.86444f,
+  116.65348f, 118.42963f, 120.20331f, 121.98359f, 123.77057f, 125.54676f, 127.32509f, 129.11365f,
+  130.88673f, 132.66935f, 134.45205f, 136.23675f, 138.01207f, 139.78794f, 141.57482f, 143.34551f,
+  145.13407f, 146.91719f, 148.68423f, 150.46387f, 152.25115f, 154.03715f, 155.80196f, 157.58201f,
+  159.37327f, 161.14592f, 162.93570f, 164.71874f, 166.49283f, 168.26975f, 170.04661f, 171.83220f,
+  173.60829f, 175.39744f, 177.16965f, 178.95081f, 180.73529f, 182.51723f, 184.28683f, 186.07350f,
+  187.85911f, 189.62800f, 191.42054f, 193.18793f, 194.97204f, 196.75687f, 198.53304f, 200.31514f,
+  202.09494f, 203.87517f, 205.65656f, 207.42995f, 209.21206f, 210.99606f, 212.77121f, 214.56227f,
+  216.32790f, 218.10974f, 219.88963f, 221.67710f, 223.45038f, 225.23804f, 227.01390f, 228.79454f,
+  230.58031f, 232.35256f, 234.13842f, 235.91767f, 237.69393f, 239.47343f, 241.25838f, 243.04460f,
+  244.81868f, 246.59346f, 248.38178f, 250.16061f, 251.93778f, 253.71743f, 255.49580f, 257.28187f,
+  259.05330f, 260.83622f, 262.61639f, 264.39328f, 266.18008f, 267.95839f, 269.74355f, 271.51117f,
+  273.29552f, 275.08554f, 276.85594f, 278.63471f, 280.41350f, 282.19620f, 283.97798f, 285.76383f,
+  287.54103f, 289.32301f, 291.09508f, 292.88163f, 294.65615f, 296.44241f, 298.21306f, 300.00986f,
+ }}},
+{"sweep Ta +125, subpage 0",
+ {{
+  0xF4D7, 0xF3B1, 0xF2A3, 0xF14A, 0xF017, 0xEF53, 0xEED3, 0xEEE9, 0xEF2B, 0xEFB2, 0xF0B0, 0xF1C7,
+  0xF2E4, 0xF3C3, 0xF55C, 0xF8B7, 0xF4E7, 0xF39D, 0xF241, 0xF109, 0xF004, 0xEF5F, 0xEF14, 0xEEAB,
+  0xEF2D, 0xEF60, 0xF0CF, 0xF1AE, 0xF2C8, 0xF427, 0xF5DD, 0xF72D, 0xF53A, 0xF3D5, 0xF2BB, 0xF1AC,
+  0xF0C0, 0xF012, 0xEF9B, 0xEFE1, 0xF024, 0xF0BF, 0xF1C7, 0xF2C9, 0xF3C1, 0xF4FE, 0xF66F, 0xF7B0,
+  0xF68B, 0xF564, 0xF475, 0xF3B3, 0xF2E9, 0xF285, 0xF267, 0xF290, 0xF288, 0xF30C, 0xF430, 0xF519,
+  0xF605, 0xF722, 0xF85F, 0xF952, 0xF86A, 0xF7CD, 0xF73F, 0xF6A3, 0xF609, 0xF5E1, 0xF600, 0xF633,
+  0xF65F, 0xF723, 0xF7D7, 0xF8B0, 0xF93C, 0xFA0C, 0xFAD6, 0xFB9C, 0xFB83, 0xFB2E, 0xFB32, 0xFAFC,
+  0xFB16, 0xFB46, 0xFBAE, 0xFBFA, 0xFC5D, 0xFCD7, 0xFD67, 0xFDBE, 0xFE29, 0xFE81, 0xFEC2, 0xFEE1,
+  0xFF02, 0xFF86, 0x0008, 0x00AF, 0x0144, 0x01DE, 0x027C, 0x0318, 0x0376, 0x03EB, 0x03F6, 0x0406,
+  0x03D0, 0x03AA, 0x033E, 0x02CD, 0x039B, 0x04C9, 0x05FC, 0x070F, 0x086E, 0x098B, 0x0A57, 0x0B34,
+  0x0BAB, 0x0C1A, 0x0B7B, 0x0AF8, 0x0A6A, 0x0990, 0x0865, 0x0718, 0x0821, 0x0A4B, 0x0C42, 0x0E15,
+  0x1003, 0x1219, 0x12D6, 0x1402, 0x141C, 0x147F, 0x1355, 0x1278, 0x1116, 0x0FE0, 0x0DC5, 0x0BB9,
+  0x0D34, 0x0FEB, 0x1243, 0x14F2, 0x175E, 0x19F0, 0x1B3A, 0x1C43, 0x1CE7, 0x1CC9, 0x1B20, 0x1979,
+  0x1814, 0x15A0, 0x1286, 0x0FD2, 0x1136, 0x14FF, 0x176E, 0x1B5F, 0x1E22, 0x215F, 0x228B, 0x23EE,
+  0x23F8, 0x249C, 0x2198, 0x2081, 0x1DB7, 0x1B48, 0x177B, 0x1175, 0x148D, 0x1948, 0x1C3D, 0x2048,
+  0x23B7, 0x26A0, 0x28A5, 0x2A0A, 0x2AD2, 0x29AE, 0x277D, 0x267E, 0x22C1, 0x1F94, 0x1A80, 0x0D67,
+  0x2AB0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFD8E, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF20, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0000,
+ }},
+ {{
+  -40.00744f, -38.29592f, -36.46246f, -34.62433f, -32.92356f, -31.14238f, -29.31053f, -27.50662f,
+  -25.80434f, -24.00795f, -22.20663f, -20.44573f, -18.64594f, -16.91622f, -15.04592f, -13.31751f,
+  -11.49174f, -9.71329f, -7.92406f, -6.20691f, -4.39069f, -2.63298f, -0.82583f, 0.95938f,
+  2.72832f, 4.48397f, 6.30694f, 8.03229f, 9.87292f, 11.59447f, 13.42252f, 15.17677f,
+  16.99233f, 18.76927f, 20.54713f, 22.31170f, 24.10416f, 25.84638f, 27.63187f, 29.44147f,
+  31.19355f, 32.98415f, 34.76018f, 36.56226f, 38.32604f, 40.09760f, 41.86638f, 43.68216f,
+  45.43822f, 47.24329f, 49.00113f, 50.76946f, 52.58056f, 54.34803f, 56.12726f, 57.90302f,
+  59.68360f, 61.47122f, 63.24337f, 65.03310f, 66.78963f, 68.57437f, 70.37622f, 72.12135f,
+  73.91381f, 75.69208f, 77.47130f, 78.65287f, 81.03550f, 82.82725f, 84.60535f, 86.39075f,
+  88.16437f, 89.93923f, 91.72486f, 93.51094f, 95.27551f, 97.06201f, 98.84290f, 100.61545f,
+  102.41164f, 104.18948f, 105.97343f, 107.75517f, 109.53600f, 111.31210f, 113.08670f, 114.86247f,
+  116.65386f, 118.43151f, 120.21117f, 121.99592f, 123.76275f, 125.54229f, 127.34183f, 129.12258f,
+  130.87991f, 132.66859f, 134.44390f, 136.22457f, 138.01260f, 139.79718f, 141.57314f, 143.35279f,
+  145.12850f, 146.91313f, 148.68859f, 150.46902f, 152.24247f, 154.03739f, 155.80939f, 157.58705f,
+  159.37917f, 161.15533f, 162.92650f, 164.71879f, 166.49185f, 168.27779f, 170.05016f, 171.82767f,
+  173.61663f, 175.39145f, 177.16873f, 178.95608f, 180.73567f, 182.51667f, 184.29906f, 186.07262f,
+  187.84517f, 189.63547f, 191.42053f, 193.18985f, 194.97216f, 196.75312f, 198.53975f, 200.31117f,
+  202.09162f, 203.87316f, 205.65923f, 207.42985f, 209.22135f, 210.99254f, 212.78239f, 214.55087f,
+  216.34388f, 218.10801f, 219.88984f, 221.67015f, 223.45914f, 225.23179f, 227.01980f, 228.79621f,
+  230.57621f, 232.35407f, 234.13301f, 235.91178f, 237.69134f, 239.48197f, 241.25326f, 243.03945f,
+  244.80998f, 246.60198f, 248.37485f, 250.15233f, 251.93210f, 253.72008f, 255.50032f, 257.28186f,
+  259.05304f, 260.84027f, 262.61814f, 264.39543f, 266.17272f, 267.96121f, 269.73957f, 271.52018f,
+  273.28898f, 275.08320f, 276.85349f, 278.63343f, 280.41677f, 282.19744f, 283.98052f, 285.76152f,
+  287.53980f, 289.32300f, 291.10383f, 292.88133f, 294.66485f, 296.43274f, 298.21422f, 300.00830f,
+ }}},
+{"sweep Ta +125, subpage 1",
+ {{
+  0xF4D8, 0xF3B0, 0xF2A3, 0xF14A, 0xF019, 0xEF52, 0xEED3, 0xEEE9, 0xEF2B, 0xEFB1, 0xF0AF, 0xF1C7,
+  0xF2E4, 0xF3C3, 0xF55A, 0xF8B7, 0xF4E7, 0xF39B, 0xF23F, 0xF10B, 0xF005, 0xEF5E, 0xEF14, 0xEEAC,
+  0xEF2E, 0xEF5F, 0xF0CF, 0xF1AE, 0xF2C9, 0xF426, 0xF5DB, 0xF72D, 0xF53B, 0xF3D3, 0xF2BB, 0xF1AC,
+  0xF0C0, 0xF011, 0xEF9B, 0xEFE1, 0xF024, 0xF0BF, 0xF1C6, 0xF2C9, 0xF3C2, 0xF4FD, 0xF66E, 0xF7AE,
+  0xF68B, 0xF562, 0xF475, 0xF3B5, 0xF2EA, 0xF284, 0xF267, 0xF291, 0xF288, 0xF30C, 0xF430, 0xF519,
+  0xF605, 0xF721, 0xF85D, 0xF951, 0xF86C, 0xF7CC, 0xF73F, 0xF6A4, 0xF60C, 0xF5E0, 0xF600, 0xF633,
+  0xF661, 0xF722, 0xF7D8, 0xF8B1, 0xF93E, 0xFA09, 0xFAD6, 0xFB9E, 0xFB84, 0xFB2E, 0xFB32, 0xFAFD,
+  0xFB17, 0xFB44, 0xFBAD, 0xFBFC, 0xFC5E, 0xFCD6, 0xFD68, 0xFDBF, 0xFE2B, 0xFE80, 0xFEC3, 0xFEE1,
+  0xFF02, 0xFF85, 0x0008, 0x00AF, 0x0144, 0x01DE, 0x027A, 0x0318, 0x0378, 0x03EB, 0x03F5, 0x0408,
+  0x03D2, 0x03A7, 0x033D, 0x02CD, 0x039B, 0x04C6, 0x05FB, 0x070F, 0x086F, 0x0989, 0x0A56, 0x0B34,
+  0x0BAC, 0x0C19, 0x0B7B, 0x0AF8, 0x0A6B, 0x098D, 0x0865, 0x0717, 0x0821, 0x0A4A, 0x0C40, 0x0E15,
+  0x1005, 0x1216, 0x12D4, 0x1402, 0x141E, 0x147C, 0x1355, 0x1277, 0x1116, 0x0FDD, 0x0DC3, 0x0BB8,
+  0x0D35, 0x0FEA, 0x1243, 0x14F2, 0x175E, 0x19EF, 0x1B3A, 0x1C43, 0x1CE8, 0x1CC6, 0x1B20, 0x197B,
+  0x1814, 0x159E, 0x1286, 0x0FD2, 0x1138, 0x14FD, 0x176E, 0x1B61, 0x1E22, 0x215D, 0x228B, 0x23EE,
+  0x23FA, 0x249A, 0x2199, 0x2083, 0x1DBA, 0x1B48, 0x177C, 0x1176, 0x148D, 0x1946, 0x1C3D, 0x204A,
+  0x23B9, 0x269F, 0x28A5, 0x2A0A, 0x2AD3, 0x29AE, 0x277F, 0x2681, 0x22C3, 0x1F93, 0x1A82, 0x0D68,
+  0x2AB0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFD8E, 0x0000, 0x1E05, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0640, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF20, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0901, 0x0001,
+ }},
+ {{
+  -40.06984f, -38.24457f, -36.46246f, -34.62433f, -32.85101f, -31.11053f, -29.31053f, -27.50662f,
+  -25.80434f, -23.97628f, -22.17295f, -20.44573f, -18.64594f, -16.91622f, -15.13188f, -13.31751f,
+  -11.49174f, -9.78098f, -7.98311f, -6.15531f, -4.41340f, -2.61206f, -0.82583f, 0.94120f,
+  2.71021f, 4.50155f, 6.30694f, 8.03229f, 9.85016f, 11.61940f, 13.36760f, 15.17677f,
+  16.96598f, 18.72779f, 20.54713f, 22.31170f, 24.10416f, 25.86067f, 27.63187f, 29.44147f,
+  31.19355f, 32.98415f, 34.77415f, 36.56226f, 38.30917f, 40.11605f, 41.88739f, 43.63977f,
+  45.43822f, 47.21244f, 49.00113f, 50.79379f, 52.56944f, 54.35822f, 56.12726f, 57.89335f,
+  59.68360f, 61.47122f, 63.24337f, 65.03310f, 66.78963f, 68.58746f, 70.34779f, 72.13953f,
+  73.94077f, 75.70442f, 77.47130f, 78.64295f, 81.04298f, 82.83529f, 84.60535f, 86.39075f,
+  88.17788f, 89.94700f, 91.71687f, 93.50225f, 95.29193f, 97.05416f, 98.84290f, 100.63912f,
+  102.40069f, 104.18948f, 105.97343f, 107.74780f, 109.52929f, 111.30025f, 113.09275f, 114.87390f,
+  116.64800f, 118.43719f, 120.20492f, 121.98940f, 123.77628f, 125.55053f, 127.33260f, 129.12258f,
+  130.87991f, 132.67652f, 134.44390f, 136.22457f, 138.01260f, 139.79718f, 141.56376f, 143.35279f,
+  145.13739f, 146.91313f, 148.69410f, 150.47928f, 152.25384f, 154.03208f, 155.81740f, 157.58705f,
+  159.37917f, 161.14951f, 162.93254f, 164.71879f, 166.48671f, 168.26928f, 170.05485f, 171.82767f,
+  173.61216f, 175.39582f, 177.16873f, 178.95608f, 180.73013f, 182.51164f, 184.29906f, 186.08102f,
+  187.84517f, 189.64193f, 191.41080f, 193.18985f, 194.98007f, 196.75044f, 198.53253f, 200.31117f,
+  202.09861f, 203.87043f, 205.65923f, 207.43466f, 209.22135f, 210.98825f, 212.77086f, 214.55869f,
+  216.33694f, 218.11402f, 219.88984f, 221.67015f, 223.45914f, 225.23596f, 227.01980f, 228.79621f,
+  230.57232f, 232.35137f, 234.13301f, 235.91967f, 237.69134f, 239.47237f, 241.25326f, 243.03945f,
+  244.82116f, 246.59251f, 248.37485f, 250.15996f, 251.93210f, 253.71363f, 255.50032f, 257.28186f,
+  259.05920f, 260.83403f, 262.61394f, 264.40309f, 266.17585f, 267.96121f, 269.73376f, 271.51219f,
+  273.28898f, 275.07356f, 276.85349f, 278.64120f, 280.42383f, 282.20192f, 283.98052f, 285.76152f,
+  287.53566f, 289.32300f, 291.09523f, 292.88486f, 294.65502f, 296.43796f, 298.22591f, 299.99728f,
+ }}},
+}};
+
+} // namespace mlx90641
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace mlx90641 {
+
+/// @brief One frame of the To accuracy corpus (see test_to_accuracy) for test_eeprom_data,
+/// with the temperatures of the double-precision model.
+struct GoldenFrame {
+    const char* name;
+    std::array<uint16_t, 242> words;  // MLXSensor::frame_words() layout
+    std::array<float, 192> to;        // °C, before bad-pixel correction
+};
+
+// Generated by test_to_accuracy with MLX90641_GOLDEN_OUT set, do not edit.
+extern const std::array<GoldenFrame, 8> golden_frames;
+
+} // namespace mlx90641
@@ -140,9 +140,7 @@ void test_offset() {
 
 void test_broken_pixels() {
     const auto broken_pixels = eeprom->get_broken_pixels();
-    for (size_t i = 0; i < broken_pixels.size(); ++i) {
-        TEST_ASSERT_EQUAL(expected_params.brokenPixels[i], broken_pixels[i]);
-    }
+    TEST_ASSERT_TRUE(expected_params.brokenPixels == broken_pixels);
 }
 
 int main(int argc, char **argv) {
@@ -0,0 +1,136 @@
+#include <unity.h>
+#include "fault_injecting_wire.hh"
+#include "i2c_adapter.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Fault = FaultInjectingWire::Fault;
+
+namespace {
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus bus;
+    FaultInjectingWire wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+    MLX90641Sensor sensor;
+
+    explicit Rig(const I2CRecoveryConfig& recovery = I2CAdapter::default_recovery())
+        : bus(clock), wire(bus, clock), i2c(wire, recovery),
+          device(bus.add_device(0x33, 100000, test_eeprom_data.data())), sensor(i2c, 0x33, nullptr, &clock)
+    {
+        device.memory[0x0580 + (192 - 192)] = 19947;  // PTAT art
+        device.memory[0x0580 + (224 - 192)] = 1600;   // PTAT
+        device.memory[0x0580 + (234 - 192)] = 0x9E40; // Vdd ~3.3 V
+        TEST_ASSERT_TRUE(sensor.init());
+        // Frames produced during init were never read: start on a fresh data-ready.
+        bool ready = false;
+        TEST_ASSERT_EQUAL(0, sensor.poll_data_ready(ready));
+        if (ready) {
+            TEST_ASSERT_TRUE(sensor.read_frame());
+        }
+    }
+
+    // Polls the next subpage like main.cpp, returns the time it became ready.
+    uint32_t wait_for_data_ready()
+    {
+        const uint32_t ready_us = device.next_frame_us;
+        clock.sleep_until_us(ready_us);
+        bool ready = false;
+        while (!ready) {
+            TEST_ASSERT_EQUAL(0, sensor.poll_data_ready(ready));
+        }
+        return ready_us;
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_frames_are_numbered_and_stamped_at_data_ready() {
+    Rig rig;
+    const uint32_t first = rig.sensor.frame_header().sequence;
+    for (uint32_t frame = 1; frame <= 4; frame++) {
+        const uint32_t ready_us = rig.wait_for_data_ready();
+        TEST_ASSERT_TRUE(rig.sensor.read_frame());
+        const FrameHeader& header = rig.sensor.frame_header();
+        TEST_ASSERT_EQUAL(first + frame, header.sequence);
+        TEST_ASSERT_UINT32_WITHIN(500, ready_us + 250, header.timestamp_us); // one status poll later
+        TEST_ASSERT_EQUAL(rig.device.sub_page, header.sub_page);
+        TEST_ASSERT_EQUAL_FLOAT(rig.sensor.get_ambient(), header.ta);
+        TEST_ASSERT_FLOAT_WITHIN(0.2f, 3.3f, header.vdd);
+    }
+}
+
+void test_stamp_does_not_include_the_read() {
+    Rig rig;
+    const uint32_t ready_us = rig.wait_for_data_ready();
+    rig.clock.advance(3000); // the application was busy before reading
+    TEST_ASSERT_TRUE(rig.sensor.read_frame());
+    TEST_ASSERT_LESS_THAN(ready_us + 1000, rig.sensor.frame_header().timestamp_us);
+}
+
+void test_failed_read_leaves_a_sequence_gap() {
+    const I2CRecoveryConfig no_retries = {0, 5000, 20000, 0, 256};
+    Rig rig(no_retries);
+    const uint32_t first = rig.sensor.frame_header().sequence;
+    rig.wait_for_data_ready();
+    rig.wire.fail(rig.wire.transactions() + 4, Fault::AddressNack); // a pixel RAM block
+    TEST_ASSERT_FALSE(rig.sensor.read_frame());
+    TEST_ASSERT_EQUAL(first, rig.sensor.frame_header().sequence); // unchanged by the failure
+
+    rig.wait_for_data_ready();
+    TEST_ASSERT_TRUE(rig.sensor.read_frame());
+    TEST_ASSERT_EQUAL(first + 2, rig.sensor.frame_header().sequence);
+}
+
+void test_subpage_replaced_during_a_stepped_read_is_renumbered() {
+    Rig rig;
+    const uint32_t first = rig.sensor.frame_header().sequence;
+    rig.wait_for_data_ready();
+    TEST_ASSERT_EQUAL(0, rig.sensor.read_frame_step(0));
+    const uint32_t replaced_us = rig.device.next_frame_us;
+    rig.clock.sleep_until_us(replaced_us); // the sensor writes the next subpage mid-read
+    int error = 0;
+    for (uint8_t step = 1; step < MLX90641Sensor::frame_read_steps; step++) {
+        error = rig.sensor.read_frame_step(step);
+    }
+    TEST_ASSERT_EQUAL(-8, error);
+    for (uint8_t step = 0; step < MLX90641Sensor::frame_read_steps; step++) {
+        TEST_ASSERT_EQUAL(0, rig.sensor.read_frame_step(step));
+    }
+    const FrameHeader& header = rig.sensor.frame_header();
+    TEST_ASSERT_EQUAL(first + 2, header.sequence);
+    TEST_ASSERT_GREATER_OR_EQUAL(replaced_us, header.timestamp_us);
+    TEST_ASSERT_EQUAL(rig.device.sub_page, header.sub_page);
+}
+
+void test_no_clock_leaves_timestamps_at_zero() {
+    VirtualClock clock;
+    MockMLX90641Bus bus(clock);
+    I2CAdapter i2c(bus);
+    bus.add_device(0x33, 100000, test_eeprom_data.data());
+    MLX90641Sensor sensor(i2c, 0x33);
+    TEST_ASSERT_TRUE(sensor.init());
+    TEST_ASSERT_TRUE(sensor.read_frame());
+    TEST_ASSERT_TRUE(sensor.read_frame());
+    TEST_ASSERT_EQUAL(0, sensor.frame_header().timestamp_us);
+    TEST_ASSERT_EQUAL(1, sensor.frame_header().sequence);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_frames_are_numbered_and_stamped_at_data_ready);
+    RUN_TEST(test_stamp_does_not_include_the_read);
+    RUN_TEST(test_failed_read_leaves_a_sequence_gap);
+    RUN_TEST(test_subpage_replaced_during_a_stepped_read_is_renumbered);
+    RUN_TEST(test_no_clock_leaves_timestamps_at_zero);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+#include <unity.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Snapshot = MLX90641Sensor::Snapshot;
+using Output = MLX90641Sensor::Output;
+
+namespace {
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+    MLX90641Sensor sensor;
+
+    Rig() : wire(clock), i2c(wire), device(wire.add_device(0x33, 100000, test_eeprom_data.data())), sensor(i2c, 0x33, nullptr, &clock)
+    {
+        TEST_ASSERT_TRUE(sensor.init());
+    }
+
+    void read_frame()
+    {
+        clock.sleep_until_us(device.next_frame_us);
+        TEST_ASSERT_TRUE(sensor.read_frame());
+    }
+};
+
+// What a reader thread saw.
+struct ReaderResult {
+    uint32_t reads = 0;
+    uint32_t retries = 0;
+    uint32_t torn = 0;          // pixels or output not from the frame of the header
+    uint32_t backwards = 0;     // older than a frame already seen
+};
+
+// Frame n: every pixel holds n, the output alternates, as the driver writes it (piecewise).
+void publish_frame(MLX90641Sensor::Publisher& publisher, uint32_t n, std::array<float, 192>& temps)
+{
+    FrameHeader header = {};
+    header.sequence = n;
+    header.timestamp_us = n * 31250;
+    const Output output = n % 2 ? Output::Image : Output::Temperature;
+    temps.fill(static_cast<float>(n));
+    publisher.begin_write();
+    publisher.store(offsetof(Snapshot, header), &header, sizeof(header));
+    publisher.store(offsetof(Snapshot, output), &output, sizeof(output));
+    publisher.store(offsetof(Snapshot, temps), temps.data(), sizeof(temps));
+    publisher.end_write();
+}
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_processed_frames_are_published() {
+    Rig rig;
+    MLX90641Sensor::Publisher publisher;
+    Snapshot snapshot;
+    TEST_ASSERT_FALSE(publisher.try_read(snapshot)); // nothing yet
+    rig.sensor.set_publisher(&publisher);
+
+    rig.read_frame();
+    rig.sensor.calculate_temps();
+    TEST_ASSERT_EQUAL(1, publisher.published());
+    TEST_ASSERT_TRUE(publisher.try_read(snapshot));
+    TEST_ASSERT_EQUAL(rig.sensor.frame_header().sequence, snapshot.header.sequence);
+    TEST_ASSERT_EQUAL(rig.sensor.frame_header().timestamp_us, snapshot.header.timestamp_us);
+    TEST_ASSERT_TRUE(snapshot.output == Output::Temperature);
+    TEST_ASSERT_EQUAL_MEMORY(rig.sensor.get_temps().data(), snapshot.temps.data(), sizeof(snapshot.temps));
+
+    rig.read_frame();
+    rig.sensor.calculate_image();
+    TEST_ASSERT_TRUE(publisher.read(snapshot));
+    TEST_ASSERT_EQUAL(2, publisher.published());
+    TEST_ASSERT_TRUE(snapshot.output == Output::Image);
+    TEST_ASSERT_EQUAL(rig.sensor.frame_header().sequence, snapshot.header.sequence);
+    TEST_ASSERT_EQUAL_MEMORY(rig.sensor.get_temps().data(), snapshot.temps.data(), sizeof(snapshot.temps));
+}
+
+void test_unpublished_sensor_keeps_working() {
+    Rig rig;
+    rig.read_frame();
+    rig.sensor.calculate_temps(); // no publisher: nothing to do
+    TEST_ASSERT_EQUAL(0, rig.sensor.frame_header().sequence);
+}
+
+void test_concurrent_readers_never_see_torn_frames() {
+    constexpr uint32_t frames = 200000;
+    constexpr int reader_count = 3;
+    static MLX90641Sensor::Publisher publisher;
+    std::atomic<bool> done(false);
+    std::vector<ReaderResult> results(reader_count);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < reader_count; r++) {
+        readers.emplace_back([&done, &results, r]() {
+            ReaderResult& result = results[r];
+            Snapshot snapshot;
+            uint32_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                uint32_t retries = 0;
+                if (!publisher.read(snapshot, &retries)) {
+                    continue;
+                }
+                result.reads++;
+                result.retries += retries;
+                const uint32_t n = snapshot.header.sequence;
+                bool consistent = snapshot.header.timestamp_us == n * 31250 &&
+                                  snapshot.output == (n % 2 ? Output::Image : Output::Temperature);
+                for (float value : snapshot.temps) {
+                    consistent = consistent && value == static_cast<float>(n);
+                }
+                result.torn += consistent ? 0 : 1;
+                result.backwards += n < last ? 1 : 0;
+                last = n;
+            }
+        });
+    }
+
+    // The writer never waits for the readers.
+    std::array<float, 192> temps;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 1; n <= frames; n++) {
+        publish_frame(publisher, n, temps);
+    }
+    const double write_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+    done.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    uint32_t reads = 0;
+    uint32_t retries = 0;
+    for (const ReaderResult& result : results) {
+        TEST_ASSERT_EQUAL(0, result.torn);
+        TEST_ASSERT_EQUAL(0, result.backwards);
+        reads += result.reads;
+        retries += result.retries;
+    }
+    printf("%u frames published (%.2f us each), %u consistent reads by %d readers, %u retries\n", (unsigned)frames,
+           write_us, (unsigned)reads, reader_count, (unsigned)retries);
+    TEST_ASSERT_EQUAL(frames, publisher.published());
+    TEST_ASSERT_GREATER_THAN(0, reads);
+    Snapshot last;
+    TEST_ASSERT_TRUE(publisher.try_read(last)); // no writer: the first attempt succeeds
+    TEST_ASSERT_EQUAL(frames, last.header.sequence);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_processed_frames_are_published);
+    RUN_TEST(test_unpublished_sensor_keeps_working);
+    RUN_TEST(test_concurrent_readers_never_see_torn_frames);
+    return UNITY_END();
+}
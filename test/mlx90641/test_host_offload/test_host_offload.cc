@@ -0,0 +1,151 @@
+#include <unity.h>
+#include <cstring>
+#include <vector>
+#include "data_pack.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "offload_engine.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Output = MLX90641Sensor::Output;
+
+namespace {
+
+// The device side of HOST_OFFLOAD: a sensor on the mock bus, which also computes the
+// temperatures the host must reproduce.
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+    MLX90641Sensor sensor;
+    std::array<uint16_t, MLX90641Sensor::ee_data_size> eeprom;
+
+    Rig() : wire(clock), i2c(wire), device(wire.add_device(0x33, 100000, test_eeprom_data.data())), sensor(i2c, 0x33)
+    {
+        device.write_pixels = false;
+        for (uint16_t pixel = 0; pixel < 192; pixel++) {
+            device.memory[0x0400 + pixel] = static_cast<uint16_t>(0x0100 + 40 * (pixel % 16) + 7 * (pixel / 16));
+        }
+        device.memory[0x0580 + (192 - 192)] = 19947;  // PTAT art
+        device.memory[0x0580 + (200 - 192)] = 0xFFC0; // compensation pixel
+        device.memory[0x0580 + (202 - 192)] = 7685;   // gain
+        device.memory[0x0580 + (224 - 192)] = 1600;   // PTAT
+        device.memory[0x0580 + (234 - 192)] = 0x9E40; // Vdd ~3.3 V
+        TEST_ASSERT_TRUE(sensor.init());
+        // What the firmware sends, in the chunks it uses
+        for (std::size_t word = 0; word < eeprom.size(); word += 32) {
+            TEST_ASSERT_EQUAL(0, sensor.read_eeprom(word, 32, eeprom.data() + word));
+        }
+    }
+
+    bool read_next_frame()
+    {
+        clock.sleep_until_us(device.next_frame_us);
+        return sensor.read_frame();
+    }
+};
+
+// Appends a serial record as main.cpp writes it.
+void append_record(std::vector<uint8_t>& stream, SerialPayload payload, const void* data, std::size_t size)
+{
+    SerialFrameHeader header = {};
+    header.magic = serial_frame_magic;
+    header.rows = 12;
+    header.columns = 16;
+    header.payload = static_cast<uint8_t>(payload);
+    header.payload_bytes = static_cast<uint16_t>(size);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&header);
+    stream.insert(stream.end(), bytes, bytes + sizeof(header));
+    bytes = static_cast<const uint8_t*>(data);
+    stream.insert(stream.end(), bytes, bytes + size);
+}
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_eeprom_is_sent_as_stored_on_the_sensor() {
+    Rig rig;
+    TEST_ASSERT_EQUAL_MEMORY(&rig.device.memory[0x2400], rig.eeprom.data(), sizeof(rig.eeprom)); // Hamming coded
+}
+
+void test_host_temperatures_match_the_device_bit_for_bit() {
+    Rig rig;
+    OffloadEngine engine;
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.load_eeprom(rig.eeprom.data(), rig.eeprom.size()));
+    for (int frame = 0; frame < 4; frame++) { // both subpages, twice
+        TEST_ASSERT_TRUE(rig.read_next_frame());
+        rig.sensor.calculate_temps();
+        const std::array<uint16_t, MLX90641Sensor::frame_data_size>& words = rig.sensor.frame_words();
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.process_frame(words.data(), words.size()));
+        TEST_ASSERT_FLOAT_WITHIN(80.0f, 50.0f, engine.temps()[100]);
+        TEST_ASSERT_EQUAL_MEMORY(rig.sensor.get_temps().data(), engine.temps().data(), sizeof(float) * 192);
+        TEST_ASSERT_EQUAL_FLOAT(rig.sensor.get_ambient(), engine.ambient());
+        TEST_ASSERT_EQUAL(rig.sensor.frame_header().sub_page, engine.sensor().frame_header().sub_page);
+    }
+}
+
+void test_host_image_matches_the_device() {
+    Rig rig;
+    OffloadEngine engine;
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.load_eeprom(rig.eeprom.data(), rig.eeprom.size()));
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    rig.sensor.calculate(Output::Image);
+    const std::array<uint16_t, MLX90641Sensor::frame_data_size>& words = rig.sensor.frame_words();
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.process_frame(words.data(), words.size(), Output::Image));
+    TEST_ASSERT_EQUAL_MEMORY(rig.sensor.get_temps().data(), engine.temps().data(), sizeof(float) * 192);
+}
+
+void test_bad_input_is_reported() {
+    Rig rig;
+    OffloadEngine engine;
+    const std::array<uint16_t, MLX90641Sensor::frame_data_size>& words = rig.sensor.frame_words();
+    TEST_ASSERT_EQUAL(OffloadStatus::NotCalibrated, engine.process_frame(words.data(), words.size()));
+    TEST_ASSERT_EQUAL(OffloadStatus::WrongSize, engine.load_eeprom(rig.eeprom.data(), 100));
+    rig.eeprom[16] ^= 0x0003; // two bit errors, beyond the Hamming correction
+    TEST_ASSERT_EQUAL(OffloadStatus::InvalidEeprom, engine.load_eeprom(rig.eeprom.data(), rig.eeprom.size()));
+    TEST_ASSERT_FALSE(engine.calibrated());
+    rig.eeprom[16] ^= 0x0003;
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.load_eeprom(rig.eeprom.data(), rig.eeprom.size()));
+    TEST_ASSERT_EQUAL(OffloadStatus::WrongSize, engine.process_frame(words.data(), words.size() - 1));
+}
+
+void test_parser_splits_a_serial_capture() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    const std::array<uint16_t, MLX90641Sensor::frame_data_size>& words = rig.sensor.frame_words();
+    std::vector<uint8_t> stream;
+    const char log_line[] = "I: sensor ready\r\n";
+    stream.insert(stream.end(), log_line, log_line + sizeof(log_line) - 1);
+    append_record(stream, SerialPayload::EepromWords, rig.eeprom.data(), sizeof(rig.eeprom));
+    append_record(stream, SerialPayload::FrameWords, words.data(), sizeof(words));
+
+    SerialRecordParser parser;
+    SerialFrameHeader header;
+    std::vector<uint8_t> payload;
+    parser.feed(stream.data(), 100); // records arrive in pieces
+    TEST_ASSERT_FALSE(parser.next(header, payload));
+    parser.feed(stream.data() + 100, stream.size() - 100);
+    TEST_ASSERT_TRUE(parser.next(header, payload));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SerialPayload::EepromWords), header.payload);
+    TEST_ASSERT_EQUAL_MEMORY(rig.eeprom.data(), payload.data(), sizeof(rig.eeprom));
+    TEST_ASSERT_TRUE(parser.next(header, payload));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SerialPayload::FrameWords), header.payload);
+    TEST_ASSERT_EQUAL(sizeof(words), payload.size());
+    TEST_ASSERT_FALSE(parser.next(header, payload));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_eeprom_is_sent_as_stored_on_the_sensor);
+    RUN_TEST(test_host_temperatures_match_the_device_bit_for_bit);
+    RUN_TEST(test_host_image_matches_the_device);
+    RUN_TEST(test_bad_input_is_reported);
+    RUN_TEST(test_parser_splits_a_serial_capture);
+    return UNITY_END();
+}
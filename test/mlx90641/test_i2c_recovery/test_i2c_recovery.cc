@@ -0,0 +1,174 @@
+#include <unity.h>
+#include "fault_injecting_wire.hh"
+#include "i2c_adapter.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Fault = FaultInjectingWire::Fault;
+
+namespace {
+
+// Status poll, data-ready clear (write + readback), 15 RAM chunks, status, control.
+constexpr uint32_t frame_transactions = 20;
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus bus;
+    FaultInjectingWire wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+    MLX90641Sensor sensor;
+
+    explicit Rig(const I2CRecoveryConfig& recovery = I2CAdapter::default_recovery())
+        : bus(clock), wire(bus, clock), i2c(wire, recovery),
+          device(bus.add_device(0x33, 100000, test_eeprom_data.data())), sensor(i2c, 0x33)
+    {
+    }
+
+    bool init()
+    {
+        const bool ok = sensor.init();
+        i2c.reset_stats();
+        return ok;
+    }
+
+    // Reads the next subpage, the first transaction is numbered wire.transactions().
+    bool read_next_frame()
+    {
+        clock.sleep_until_us(device.next_frame_us);
+        return sensor.read_frame();
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_clean_frame_needs_no_recovery() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    const uint32_t first = rig.wire.transactions();
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    TEST_ASSERT_EQUAL(frame_transactions, rig.wire.transactions() - first);
+    TEST_ASSERT_EQUAL(0, rig.i2c.stats().retries);
+    TEST_ASSERT_EQUAL(0, rig.i2c.stats().bus_clears);
+}
+
+void test_nack_retries_only_the_failed_block() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    rig.wire.fail(rig.wire.transactions() + 6, Fault::AddressNack); // a pixel RAM chunk
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().retries);
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().nacks);
+    TEST_ASSERT_EQUAL(0, rig.i2c.stats().bus_clears);
+    TEST_ASSERT_EQUAL(frame_transactions + 1, rig.i2c.stats().transactions);
+    TEST_ASSERT_EQUAL(I2CStatus::Success, rig.i2c.last_status());
+}
+
+void test_timeout_clears_the_bus_before_the_retry() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    rig.wire.fail(rig.wire.transactions() + 4, Fault::Slow);
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().timeouts);
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().bus_clears);
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().retries);
+    TEST_ASSERT_EQUAL(400000, rig.wire.frequency); // restarted at the configured speed
+}
+
+void test_stuck_sda_is_released_with_clock_pulses() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    const uint32_t restarts = rig.wire.restarts;
+    rig.wire.stick_sda(4);
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    TEST_ASSERT_EQUAL(4 + 1, rig.wire.scl_pulses); // released after 4 pulses, then the STOP
+    TEST_ASSERT_EQUAL(0, rig.wire.hung_transactions);
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().bus_clears);
+    TEST_ASSERT_EQUAL(restarts + 1, rig.wire.restarts);
+    TEST_ASSERT_EQUAL(0, rig.i2c.stats().retries); // cleared before the transaction started
+}
+
+void test_permanently_stuck_bus_fails_fast() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    rig.wire.stick_sda(255);
+    uint16_t word = 0;
+    const uint32_t start = rig.clock.now_us();
+    TEST_ASSERT_EQUAL(I2CStatus::BusStuck, rig.i2c.read(0x33, 0x8000, 1, &word));
+    TEST_ASSERT_EQUAL(I2CAdapter::bus_clear_pulses + 1, rig.wire.scl_pulses);
+    TEST_ASSERT_EQUAL(0, rig.wire.hung_transactions);
+    TEST_ASSERT_LESS_THAN(1000, rig.clock.now_us() - start);
+    TEST_ASSERT_FALSE(rig.sensor.read_frame());
+    TEST_ASSERT_EQUAL(I2CStatus::BusStuck, rig.i2c.last_status());
+}
+
+void test_frame_budget_bounds_recovery_latency() {
+    const I2CRecoveryConfig recovery = {50, 5000, 20000};
+    Rig rig(recovery);
+    TEST_ASSERT_TRUE(rig.init());
+    rig.clock.sleep_until_us(rig.device.next_frame_us);
+    for (uint32_t t = 1; t < 100; t++) { // the status poll (0) succeeds, everything after times out
+        rig.wire.fail(rig.wire.transactions() + t, Fault::Timeout);
+    }
+    const uint32_t start = rig.clock.now_us();
+    TEST_ASSERT_FALSE(rig.sensor.read_frame());
+    TEST_ASSERT_EQUAL(I2CStatus::BudgetExceeded, rig.i2c.last_status());
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().budget_exceeded);
+    // At most one more attempt starts before the budget is checked.
+    TEST_ASSERT_LESS_OR_EQUAL(recovery.frame_budget_us + 2 * recovery.transaction_timeout_us,
+                              rig.clock.now_us() - start);
+}
+
+void test_frame_budget_scales_with_a_slower_clock() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    rig.i2c.set_frequency(100); // as after a step-down: a whole frame read takes ~40 ms
+    rig.device.control() = static_cast<uint16_t>((rig.device.control() & ~0x0380) | 0x04 << 7); // 8 Hz, room for it
+    TEST_ASSERT_EQUAL(4 * I2CAdapter::default_recovery().frame_budget_us, rig.i2c.frame_budget_us());
+    rig.wire.fail(rig.wire.transactions() + frame_transactions - 3, Fault::AddressNack); // the last RAM chunk
+    TEST_ASSERT_TRUE(rig.read_next_frame());
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().retries);
+    TEST_ASSERT_EQUAL(0, rig.i2c.stats().budget_exceeded);
+}
+
+void test_failed_status_write_fails_the_frame() {
+    Rig rig;
+    TEST_ASSERT_TRUE(rig.init());
+    const uint8_t attempts = I2CAdapter::default_recovery().max_retries + 1;
+    for (uint8_t attempt = 0; attempt < attempts; attempt++) { // the data-ready clear, 0x0030 to 0x8000
+        rig.wire.fail(rig.wire.transactions() + 1 + attempt, Fault::BusError);
+    }
+    TEST_ASSERT_FALSE(rig.read_next_frame());
+    TEST_ASSERT_EQUAL(I2CStatus::BusError, rig.i2c.last_status());
+    TEST_ASSERT_EQUAL(I2CAdapter::default_recovery().max_retries, rig.i2c.stats().retries);
+}
+
+void test_missing_device_reports_address_nack() {
+    Rig rig;
+    rig.i2c.init(400);
+    uint16_t word = 0;
+    TEST_ASSERT_EQUAL(I2CStatus::AddressNack, rig.i2c.read(0x40, 0x8000, 1, &word));
+    TEST_ASSERT_EQUAL(I2CAdapter::default_recovery().max_retries, rig.i2c.stats().retries);
+    TEST_ASSERT_EQUAL(I2CAdapter::default_recovery().max_retries + 1, rig.i2c.stats().nacks);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_frame_needs_no_recovery);
+    RUN_TEST(test_nack_retries_only_the_failed_block);
+    RUN_TEST(test_timeout_clears_the_bus_before_the_retry);
+    RUN_TEST(test_stuck_sda_is_released_with_clock_pulses);
+    RUN_TEST(test_permanently_stuck_bus_fails_fast);
+    RUN_TEST(test_frame_budget_bounds_recovery_latency);
+    RUN_TEST(test_frame_budget_scales_with_a_slower_clock);
+    RUN_TEST(test_failed_status_write_fails_the_frame);
+    RUN_TEST(test_missing_device_reports_address_nack);
+    return UNITY_END();
+}
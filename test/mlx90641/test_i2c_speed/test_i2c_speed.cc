@@ -0,0 +1,115 @@
+#include <unity.h>
+#include "fault_injecting_wire.hh"
+#include "i2c_adapter.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Fault = FaultInjectingWire::Fault;
+
+namespace {
+
+constexpr uint16_t eeprom_address = 0x2400;
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus bus;
+    FaultInjectingWire wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+
+    Rig() : bus(clock), wire(bus, clock), i2c(wire), device(bus.add_device(0x33, 100000, test_eeprom_data.data()))
+    {
+        i2c.init(100);
+    }
+
+    I2CStatus tune(int max_khz = 1000)
+    {
+        return i2c.tune_speed(0x33, eeprom_address, test_eeprom_data.data(), max_khz);
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_clean_bus_runs_at_fast_mode_plus() {
+    Rig rig;
+    TEST_ASSERT_EQUAL(I2CStatus::Success, rig.tune());
+    TEST_ASSERT_EQUAL(1000, rig.i2c.frequency_khz());
+    TEST_ASSERT_EQUAL(1000000, rig.wire.frequency);
+    TEST_ASSERT_EQUAL(I2CAdapter::speed_validation_reads, rig.i2c.speed_stats(0).transactions);
+    TEST_ASSERT_EQUAL(0, rig.i2c.speed_stats(0).errors);
+}
+
+void test_configured_maximum_is_respected() {
+    Rig rig;
+    TEST_ASSERT_EQUAL(I2CStatus::Success, rig.tune(400));
+    TEST_ASSERT_EQUAL(400, rig.i2c.frequency_khz());
+    TEST_ASSERT_EQUAL(0, rig.i2c.speed_stats(0).transactions);
+}
+
+void test_corrupted_readback_steps_down_to_fast_mode() {
+    Rig rig;
+    rig.wire.fail_at_speed(1000000, Fault::Corrupt, 3);
+    TEST_ASSERT_EQUAL(I2CStatus::Success, rig.tune());
+    TEST_ASSERT_EQUAL(400, rig.i2c.frequency_khz());
+    TEST_ASSERT_EQUAL(1, rig.i2c.speed_stats(0).errors);
+    TEST_ASSERT_EQUAL(0, rig.i2c.speed_stats(1).errors);
+}
+
+void test_nacks_fall_back_to_standard_mode() {
+    Rig rig;
+    rig.wire.fail_at_speed(400000, Fault::AddressNack);
+    TEST_ASSERT_EQUAL(I2CStatus::Success, rig.tune());
+    TEST_ASSERT_EQUAL(100, rig.i2c.frequency_khz());
+    TEST_ASSERT_EQUAL(1, rig.i2c.speed_stats(0).errors);
+    TEST_ASSERT_EQUAL(1, rig.i2c.speed_stats(1).errors);
+}
+
+void test_no_working_speed_reports_the_failure() {
+    Rig rig;
+    rig.wire.fail_all(Fault::AddressNack);
+    TEST_ASSERT_EQUAL(I2CStatus::AddressNack, rig.tune());
+    TEST_ASSERT_EQUAL(100, rig.i2c.frequency_khz());
+}
+
+void test_rising_error_rate_steps_the_clock_down() {
+    Rig rig;
+    TEST_ASSERT_EQUAL(I2CStatus::Success, rig.tune());
+    rig.wire.fail_at_speed(1000000, Fault::DataNack, 4);
+    uint16_t words[64];
+    for (int i = 0; i < 32; i++) {
+        TEST_ASSERT_EQUAL(I2CStatus::Success, rig.i2c.read(0x33, eeprom_address, 64, words));
+    }
+    TEST_ASSERT_EQUAL(400, rig.i2c.frequency_khz());
+    TEST_ASSERT_EQUAL(1, rig.i2c.stats().speed_downgrades);
+    TEST_ASSERT_EQUAL(I2CAdapter::default_recovery().speed_error_limit, rig.i2c.speed_stats(0).errors);
+    TEST_ASSERT_EQUAL(0, rig.i2c.speed_stats(1).errors);
+    TEST_ASSERT_EQUAL_HEX16(test_eeprom_data[0], words[0]);
+}
+
+void test_sensor_init_validates_the_clock() {
+    Rig rig;
+    rig.wire.fail_at_speed(400000, Fault::Corrupt, 2);
+    MLX90641Sensor sensor(rig.i2c, 0x33);
+    TEST_ASSERT_TRUE(sensor.init());
+    TEST_ASSERT_EQUAL(100, rig.i2c.frequency_khz());
+    TEST_ASSERT_EQUAL(1, rig.i2c.speed_stats(1).errors);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_bus_runs_at_fast_mode_plus);
+    RUN_TEST(test_configured_maximum_is_respected);
+    RUN_TEST(test_corrupted_readback_steps_down_to_fast_mode);
+    RUN_TEST(test_nacks_fall_back_to_standard_mode);
+    RUN_TEST(test_no_working_speed_reports_the_failure);
+    RUN_TEST(test_rising_error_rate_steps_the_clock_down);
+    RUN_TEST(test_sensor_init_validates_the_clock);
+    return UNITY_END();
+}
@@ -0,0 +1,252 @@
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "batch_processor.hh"
+#include "mlx90640_eeprom_parser.hh"
+#include "mlx90641_driver.hh"
+#include "mock_mlx90641_bus.hh"
+#include "virtual_clock.hh"
+#include "zone_reducer.hh"
+
+using namespace mlx90641;
+
+static_assert(MLX90640Sensor::num_pixels == 768, "32x24 pixels");
+static_assert(MLX90640Sensor::frame_read_steps == 14, "data-ready clear + 13 RAM blocks");
+static_assert(MLX90640Traits::block_offset(MLX90640Traits::ram_blocks - 1) == MLX90640Traits::frame_ptat_art,
+              "auxiliary block lands after the pixels");
+static_assert(!MLX90640Traits::subpage_covers_all_pixels, "subpages measure half of the pixels");
+
+namespace {
+
+// Synthetic MLX90640 EEPROM: gain 1, no TGC/KTA/KV, so a pixel reading its offset is at ambient.
+std::array<uint16_t, eeprom_size> ee;
+
+void build_eeprom()
+{
+    ee.fill(0);
+    ee[10] = 0x0000;                                  // chess calibration, device select 0
+    ee[16] = 0x4210;                                  // alphaPTAT 9, offset row scale 2, column scale 1
+    ee[17] = static_cast<uint16_t>(-50);              // offset average
+    for (std::size_t row = 0; row < MLX90640Traits::num_rows; ++row) {
+        ee[18 + row / 4] |= static_cast<uint16_t>(((row % 8) - 4) & 0xF) << (4 * (row % 4));
+    }
+    for (std::size_t col = 0; col < MLX90640Traits::num_columns; ++col) {
+        ee[24 + col / 4] |= static_cast<uint16_t>(((col % 5) - 2) & 0xF) << (4 * (col % 4));
+    }
+    ee[33] = 0x3000;                                  // alpha reference
+    ee[48] = 6383;                                    // gainEE
+    ee[49] = 12273;                                   // vPTAT25
+    ee[50] = 0x5952;                                  // KvPTAT 22 / 4096, KtPTAT 42.25
+    ee[51] = 0x9D68;                                  // kVdd -3168, vdd25 -13056
+    ee[56] = 0x3000;                                  // resolutionEE 3, KTA/KV scales 0
+    ee[61] = 0xFBFB;                                  // ksTo ranges 1-2
+    ee[62] = 0xFBFB;                                  // ksTo ranges 3-4
+    ee[63] = 0x1439;                                  // ksTo scale 17, ct3 30, ct4 70
+    for (std::size_t p = 0; p < MLX90640Traits::num_pixels; ++p) {
+        const uint16_t offset = static_cast<uint16_t>(((p * 7) % 64) - 32) & 0x3F;
+        ee[64 + p] = static_cast<uint16_t>(offset << 10 | 1 << 4);
+    }
+}
+
+int16_t expected_offset(std::size_t p)
+{
+    const int row = static_cast<int>(p / MLX90640Traits::num_columns);
+    const int col = static_cast<int>(p % MLX90640Traits::num_columns);
+    return static_cast<int16_t>(-50 + ((row % 8) - 4) * 4 + ((col % 5) - 2) * 2 + static_cast<int>((p * 7) % 64) - 32);
+}
+
+// Loads the EEPROM and a frame whose pixels read their offsets (object at ambient).
+MockMLX90641Bus::Device& add_sensor(MockMLX90641Bus& wire)
+{
+    MockMLX90641Bus::Device& device = wire.add_device(0x33, 100000, ee.data(), 0x05);
+    for (std::size_t i = 0; i < ee.size(); ++i) {
+        device.memory[0x2400 + i] = ee[i];            // no Hamming coding on the MLX90640
+    }
+    device.write_pixels = false;
+    for (std::size_t p = 0; p < MLX90640Traits::num_pixels; ++p) {
+        device.memory[0x0400 + p] = static_cast<uint16_t>(expected_offset(p));
+    }
+    device.memory[0x0400 + MLX90640Traits::frame_ptat_art] = 21147;
+    device.memory[0x0400 + MLX90640Traits::frame_gain] = 6383;
+    device.memory[0x0400 + MLX90640Traits::frame_ptat] = 1711;
+    device.memory[0x0400 + MLX90640Traits::frame_vdd] = static_cast<uint16_t>(-6528); // 3.3 V
+    device.control() |= 0x1000;                       // chess pattern
+    return device;
+}
+
+} // namespace
+
+void setUp(void) {
+    build_eeprom();
+}
+
+void tearDown(void) {}
+
+void test_parser_decodes_global_parameters() {
+    ParamsMLX90640 params;
+    TEST_ASSERT_TRUE(MLX90640EEpromParser(ee).extract_all(params));
+    TEST_ASSERT_EQUAL(-3168, params.kVdd);
+    TEST_ASSERT_EQUAL(-13056, params.vdd25);
+    TEST_ASSERT_EQUAL_FLOAT(42.25f, params.KtPTAT);
+    TEST_ASSERT_EQUAL_FLOAT(9.0f, params.alphaPTAT);
+    TEST_ASSERT_EQUAL(0x80, params.calibrationModeEE);
+    TEST_ASSERT_EQUAL(3, params.resolutionEE);
+    TEST_ASSERT_EQUAL(30, params.ct[2]);
+    TEST_ASSERT_EQUAL(70, params.ct[3]);
+    TEST_ASSERT_EQUAL_FLOAT(-5.0f / 131072.0f, params.ksTo[0]);
+    for (std::size_t p = 0; p < MLX90640Traits::num_pixels; ++p) {
+        TEST_ASSERT_EQUAL(expected_offset(p), params.offset[p]);
+    }
+    TEST_ASSERT_TRUE(params.brokenPixels.none());
+}
+
+void test_kta_and_kv_split_by_row_and_column_parity() {
+    ee[52] = 0x1234;                                  // KV: odd/odd 1, even/odd 3, odd/even 2, even/even 4 (1-based)
+    ee[54] = 0x0102;                                  // KTA odd column averages
+    ee[55] = 0x0304;                                  // KTA even column averages
+    ParamsMLX90640 params;
+    TEST_ASSERT_TRUE(MLX90640EEpromParser(ee).extract_all(params));
+    // Pixel 0 is row 1, column 1 in the datasheet's numbering.
+    TEST_ASSERT_EQUAL_FLOAT(1.0f / 256, params.kta[0]);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f / 256, params.kta[1]);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f / 256, params.kta[32]);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f / 256, params.kta[33]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, params.kv[0]);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, params.kv[1]);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, params.kv[32]);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, params.kv[33]);
+}
+
+void test_each_subpage_converts_its_chess_half() {
+    VirtualClock clock;
+    MockMLX90641Bus wire(clock);
+    I2CAdapter i2c(wire);
+    MockMLX90641Bus::Device& device = add_sensor(wire);
+
+    MLX90640Sensor sensor(i2c, 0x33);
+    TEST_ASSERT_TRUE(sensor.init());
+    MLX90640Sensor::Reducer reducer;
+    uint8_t first = 0xFF;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer.add_columns(first));
+    TEST_ASSERT_EQUAL(MLX90640Traits::num_columns, reducer.zone_count());
+
+    clock.sleep_until_us(device.next_frame_us);
+    TEST_ASSERT_TRUE(sensor.read_frame());
+    sensor.calculate_temps(&reducer);
+    const float ambient = sensor.get_ambient();
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 25.0f, ambient);
+    const auto& temps = sensor.get_temps();
+    for (std::size_t p = 0; p < temps.size(); ++p) {
+        if (MLX90640Traits::pixel_sub_page(p, true) == 0) {
+            TEST_ASSERT_FLOAT_WITHIN(0.01f, ambient, temps[p]);
+        } else {
+            TEST_ASSERT_EQUAL_FLOAT(0.0f, temps[p]);
+        }
+    }
+
+    clock.sleep_until_us(device.next_frame_us);
+    TEST_ASSERT_TRUE(sensor.read_frame());
+    sensor.calculate_temps(&reducer);
+    for (std::size_t p = 0; p < temps.size(); ++p) {
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, sensor.get_ambient(), temps[p]);
+    }
+    for (std::size_t zone = 0; zone < reducer.zone_count(); ++zone) {
+        TEST_ASSERT_INT_WITHIN(1, MLX90640Sensor::Reducer::to_fixed_point(sensor.get_ambient()),
+                               reducer.means()[first + zone]);
+    }
+}
+
+void test_outlier_pixel_is_corrected_from_neighbours() {
+    const std::size_t outlier = 100;
+    ee[64 + outlier] |= 0x0001;
+    VirtualClock clock;
+    MockMLX90641Bus wire(clock);
+    I2CAdapter i2c(wire);
+    MockMLX90641Bus::Device& device = add_sensor(wire);
+    device.memory[0x0400 + outlier] = static_cast<uint16_t>(expected_offset(outlier) + 3000);
+
+    MLX90640Sensor sensor(i2c, 0x33);
+    TEST_ASSERT_TRUE(sensor.init());
+    for (int sub_page = 0; sub_page < 2; ++sub_page) {
+        clock.sleep_until_us(device.next_frame_us);
+        TEST_ASSERT_TRUE(sensor.read_frame());
+        sensor.calculate_temps();
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, sensor.get_ambient(), sensor.get_temps()[outlier]);
+}
+
+void test_batch_replay_rebuilds_the_other_subpage() {
+    const std::size_t outlier = 100;
+    ee[64 + outlier] |= 0x0001;
+    VirtualClock clock;
+    MockMLX90641Bus wire(clock);
+    I2CAdapter i2c(wire);
+    MockMLX90641Bus::Device& device = add_sensor(wire);
+    MLX90640Sensor sensor(i2c, 0x33);
+    TEST_ASSERT_TRUE(sensor.init());
+    clock.sleep_until_us(device.next_frame_us);
+    TEST_ASSERT_TRUE(sensor.read_frame());
+
+    // Runs of three frames per subpage, so a chunk may start after several of the same one.
+    constexpr std::size_t frames = 40;
+    constexpr std::size_t words = MLX90640Sensor::frame_data_size;
+    std::vector<uint16_t> session(frames * words);
+    for (std::size_t n = 0; n < frames; ++n) {
+        uint16_t* frame = &session[n * words];
+        std::memcpy(frame, sensor.frame_words().data(), words * sizeof(uint16_t));
+        for (std::size_t p = 0; p < MLX90640Traits::num_pixels; ++p) {
+            frame[p] = static_cast<uint16_t>(frame[p] + (n * 11 + p) % 60);
+        }
+        frame[MLX90640Traits::frame_sub_page] = static_cast<uint16_t>((n / 3) % 2);
+    }
+    BasicOffloadEngine<MLX90640Traits> engine;
+    TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.load_eeprom(ee.data(), ee.size()));
+    std::vector<float> expected(frames * MLX90640Traits::num_pixels);
+    for (std::size_t n = 0; n < frames; ++n) {
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, engine.process_frame(&session[n * words], words));
+        std::memcpy(&expected[n * MLX90640Traits::num_pixels], engine.temps().data(),
+                    MLX90640Traits::num_pixels * sizeof(float));
+    }
+
+    const RawFrameSpan span = {reinterpret_cast<const uint8_t*>(session.data()), frames, words * sizeof(uint16_t)};
+    const std::size_t chunk_sizes[] = {1, 4, 5};
+    for (std::size_t chunk_frames : chunk_sizes) {
+        BasicBatchProcessor<MLX90640Traits> batch({2, chunk_frames});
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.load_eeprom(ee.data(), ee.size()));
+        std::vector<float> temps(expected.size());
+        TEST_ASSERT_EQUAL(OffloadStatus::Success, batch.process(span, temps.data()));
+        TEST_ASSERT_EQUAL_MEMORY(expected.data(), temps.data(), temps.size() * sizeof(float));
+        TEST_ASSERT_GREATER_THAN(0, batch.stats().warmup_frames);
+    }
+}
+
+void test_tire_bands_scale_with_the_array() {
+    MLX90640Sensor::Reducer reducer;
+    uint8_t first = 0xFF;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer.add_tire_bands(first));
+    TEST_ASSERT_EQUAL(3, reducer.zone_count());
+    // Pixel value = column: the band means give the 10/12/10 column split.
+    reducer.begin_frame();
+    for (std::size_t p = 0; p < MLX90640Traits::num_pixels; ++p) {
+        reducer.accumulate(p, static_cast<float>(p % MLX90640Traits::num_columns));
+    }
+    reducer.end_frame();
+    TEST_ASSERT_EQUAL(45, reducer.means()[first]);
+    TEST_ASSERT_EQUAL(155, reducer.means()[first + 1]);
+    TEST_ASSERT_EQUAL(265, reducer.means()[first + 2]);
+    TEST_ASSERT_EQUAL(0, reducer.mins()[first]);
+    TEST_ASSERT_EQUAL(310, reducer.maxs()[first + 2]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_parser_decodes_global_parameters);
+    RUN_TEST(test_kta_and_kv_split_by_row_and_column_parity);
+    RUN_TEST(test_each_subpage_converts_its_chess_half);
+    RUN_TEST(test_outlier_pixel_is_corrected_from_neighbours);
+    RUN_TEST(test_batch_replay_rebuilds_the_other_subpage);
+    RUN_TEST(test_tire_bands_scale_with_the_array);
+    return UNITY_END();
+}
@@ -0,0 +1,266 @@
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include "mlx90641_driver.hh"
+#include "mlx90641_eeprom_addr.hh"
+#include "mock_mlx90641_bus.hh"
+#include "pixel_correction.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Correction = MLX90641Sensor::Correction;
+using Mask = MLX90641Sensor::PixelMask;
+
+namespace {
+
+constexpr std::size_t columns = 16;
+
+constexpr std::size_t at(std::size_t row, std::size_t column) { return row * columns + column; }
+
+// A linear ramp, which every symmetric blend reproduces exactly; defective pixels hold junk.
+std::array<float, 192> ramp(const Mask& defective)
+{
+    std::array<float, 192> values;
+    for (std::size_t pixel = 0; pixel < values.size(); pixel++) {
+        values[pixel] = defective.test(pixel) ? 1000.0f : 20.0f + 0.5f * (pixel / columns) + 0.25f * (pixel % columns);
+    }
+    return values;
+}
+
+float weight_sum(const Correction::Entry& entry)
+{
+    float sum = 0.0f;
+    for (float weight : entry.weights) {
+        sum += weight;
+    }
+    return sum;
+}
+
+// The corrected value of `pixel` lies within the range of the neighbours it blends.
+void assert_blended(const MLX90641Sensor& sensor, std::size_t pixel)
+{
+    const std::array<float, 192>& temps = sensor.get_temps();
+    for (std::size_t i = 0; i < sensor.correction().size(); i++) {
+        const Correction::Entry& entry = sensor.correction().entry(i);
+        if (entry.target != pixel) {
+            continue;
+        }
+        float low = temps[entry.neighbours[0]];
+        float high = low;
+        for (std::size_t tap = 1; tap < entry.taps; tap++) {
+            low = std::fmin(low, temps[entry.neighbours[tap]]);
+            high = std::fmax(high, temps[entry.neighbours[tap]]);
+        }
+        TEST_ASSERT_TRUE(temps[pixel] >= low - 1e-3f && temps[pixel] <= high + 1e-3f);
+        return;
+    }
+    TEST_FAIL_MESSAGE("pixel not corrected");
+}
+
+// Sensor on the mock bus whose EEPROM marks `broken` pixels (all calibration words 0).
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    std::array<uint16_t, 832> eeprom;
+    MockMLX90641Bus::Device* device;
+    MLX90641Sensor sensor;
+
+    template <std::size_t N>
+    explicit Rig(const std::array<uint16_t, N>& broken) : wire(clock), i2c(wire), eeprom(test_eeprom_data), device(nullptr),
+                                                        sensor(i2c, 0x33)
+    {
+        for (uint16_t pixel : broken) {
+            const uint16_t words[] = {EepromAddr::offset_even, EepromAddr::alpha_pixel, EepromAddr::kta_pixel,
+                                      EepromAddr::offset_odd};
+            for (uint16_t word : words) {
+                eeprom[word - 0x2400 + pixel] = 0;
+            }
+        }
+        device = &wire.add_device(0x33, 100000, eeprom.data());
+        device->write_pixels = false;
+        for (uint16_t pixel = 0; pixel < 192; pixel++) {
+            set_pixel(pixel, static_cast<uint16_t>(0x0100 + 40 * (pixel % 16)));
+        }
+        device->memory[0x0580 + (192 - 192)] = 19947;  // PTAT art
+        device->memory[0x0580 + (200 - 192)] = 0xFFC0; // compensation pixel
+        device->memory[0x0580 + (202 - 192)] = 7685;   // gain
+        device->memory[0x0580 + (224 - 192)] = 1600;   // PTAT
+        device->memory[0x0580 + (234 - 192)] = 0x9E40; // Vdd ~3.3 V
+    }
+
+    // Both subpages read the same value.
+    void set_pixel(std::size_t pixel, uint16_t value)
+    {
+        for (uint8_t sub_page = 0; sub_page < 2; sub_page++) {
+            device->memory[MLX90641Traits::block_address(sub_page, static_cast<uint8_t>(pixel / 32)) + pixel % 32] = value;
+        }
+    }
+
+    const std::array<float, 192>& frame()
+    {
+        clock.sleep_until_us(device->next_frame_us);
+        TEST_ASSERT_TRUE(sensor.read_frame());
+        sensor.calculate_temps();
+        return sensor.get_temps();
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_interior_pixel_blends_its_four_neighbours() {
+    Mask defective;
+    defective.set(at(5, 7));
+    Correction correction;
+    correction.build(defective, Mask::all());
+    TEST_ASSERT_EQUAL(1, correction.size());
+    const Correction::Entry& entry = correction.entry(0);
+    TEST_ASSERT_EQUAL(at(5, 7), entry.target);
+    TEST_ASSERT_EQUAL(4, entry.taps);
+    TEST_ASSERT_EQUAL(at(5, 6), entry.neighbours[0]);
+    TEST_ASSERT_EQUAL(at(5, 8), entry.neighbours[1]);
+    TEST_ASSERT_EQUAL(at(4, 7), entry.neighbours[2]);
+    TEST_ASSERT_EQUAL(at(6, 7), entry.neighbours[3]);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, entry.weights[0]);
+    TEST_ASSERT_TRUE(correction.sources().test(at(4, 7)));
+    TEST_ASSERT_EQUAL(4, correction.sources().count());
+
+    std::array<float, 192> values = ramp(defective);
+    correction.apply(values);
+    TEST_ASSERT_EQUAL_FLOAT(ramp(Mask())[at(5, 7)], values[at(5, 7)]);
+}
+
+void test_corner_and_adjacent_defects_use_good_neighbours_only() {
+    Mask defective;
+    defective.set(at(0, 0));
+    defective.set(at(8, 3));
+    defective.set(at(8, 4)); // a pair: neither blends the other
+    Correction correction;
+    correction.build(defective, Mask::all());
+    TEST_ASSERT_EQUAL(3, correction.size());
+
+    const Correction::Entry& corner = correction.entry(0);
+    TEST_ASSERT_EQUAL(3, corner.taps); // right, below and the diagonal
+    TEST_ASSERT_EQUAL(at(1, 1), corner.neighbours[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, weight_sum(corner));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, corner.weights[3]);
+    for (std::size_t i = 1; i < 3; i++) {
+        const Correction::Entry& entry = correction.entry(i);
+        TEST_ASSERT_EQUAL(4, entry.taps);
+        for (std::size_t tap = 0; tap < entry.taps; tap++) {
+            TEST_ASSERT_FALSE(defective.test(entry.neighbours[tap]));
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, weight_sum(entry));
+    }
+
+    std::array<float, 192> values = ramp(defective);
+    correction.apply(values);
+    const std::array<float, 192> expected = ramp(Mask());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, expected[at(0, 0)], values[at(0, 0)]);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, expected[at(8, 3)], values[at(8, 3)]);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, expected[at(8, 4)], values[at(8, 4)]);
+}
+
+void test_defective_cluster_reaches_two_pixels_out() {
+    const Mask defective = Mask::rectangle(4, 6, 6, 8);
+    Correction correction;
+    correction.build(defective, Mask::all());
+    TEST_ASSERT_EQUAL(9, correction.size());
+    const Correction::Entry& centre = correction.entry(4);
+    TEST_ASSERT_EQUAL(at(5, 7), centre.target);
+    TEST_ASSERT_EQUAL(4, centre.taps);
+    TEST_ASSERT_EQUAL(at(5, 5), centre.neighbours[0]);
+    TEST_ASSERT_EQUAL(at(7, 7), centre.neighbours[3]);
+
+    std::array<float, 192> values = ramp(defective);
+    correction.apply(values);
+    const std::array<float, 192> expected = ramp(Mask());
+    for (std::size_t pixel = 0; pixel < 192; pixel++) {
+        // Edge pixels of the cluster only see one side: up to one ramp step off.
+        TEST_ASSERT_FLOAT_WITHIN(0.51f, expected[pixel], values[pixel]);
+    }
+}
+
+void test_roi_and_capacity_limit_the_table() {
+    Mask defective = Mask::columns(0, 0); // 12 pixels
+    defective.set(at(3, 9));
+    defective.set(at(9, 12));
+    Correction correction;
+    correction.build(defective, Mask::columns(0, 10));
+    TEST_ASSERT_EQUAL(13, correction.size()); // (9, 12) is outside the ROI
+    TEST_ASSERT_EQUAL(0, correction.uncorrected().count());
+
+    Mask many;
+    for (std::size_t pixel = 0; pixel < 192; pixel += 5) {
+        many.set(pixel);
+    }
+    correction.build(many, Mask::all());
+    TEST_ASSERT_EQUAL(Correction::max_pixels, correction.size());
+    TEST_ASSERT_EQUAL(many.count() - Correction::max_pixels, correction.uncorrected().count());
+
+    correction.build(Mask::all(), Mask::all()); // no good pixel to blend from
+    TEST_ASSERT_EQUAL(0, correction.size());
+    TEST_ASSERT_EQUAL(192, correction.uncorrected().count());
+}
+
+void test_sensor_with_more_than_two_broken_pixels_initializes() {
+    const std::array<uint16_t, 3> broken = {{at(2, 5), at(2, 6), at(7, 0)}};
+    Rig rig(broken);
+    TEST_ASSERT_TRUE(rig.sensor.init());
+    TEST_ASSERT_EQUAL(3, rig.sensor.defective_pixels().count());
+    TEST_ASSERT_EQUAL(3, rig.sensor.correction().size());
+    rig.frame();
+    for (uint16_t pixel : broken) {
+        assert_blended(rig.sensor, pixel);
+    }
+}
+
+void test_flagged_noisy_pixel_is_corrected_and_left_out_of_zones() {
+    const std::array<uint16_t, 0> none = {};
+    Rig rig(none);
+    TEST_ASSERT_TRUE(rig.sensor.init());
+    const std::size_t noisy = at(6, 9);
+    rig.set_pixel(noisy, 0x7000); // stuck high
+    const float raw = rig.frame()[noisy];
+
+    Mask flagged;
+    flagged.set(noisy);
+    rig.sensor.set_flagged_pixels(flagged);
+    TEST_ASSERT_TRUE(rig.sensor.defective_pixels().test(noisy));
+    MLX90641Sensor::Reducer reducer;
+    uint8_t first = 0xFF;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer.add_columns(first));
+    rig.clock.sleep_until_us(rig.device->next_frame_us);
+    TEST_ASSERT_TRUE(rig.sensor.read_frame());
+    rig.sensor.calculate_temps(&reducer);
+    const std::array<float, 192>& temps = rig.sensor.get_temps();
+    assert_blended(rig.sensor, noisy);
+    TEST_ASSERT_TRUE(raw - temps[noisy] > 10.0f);
+    // The column zone holds the corrected value, not the stuck one.
+    float column_max = temps[noisy];
+    for (std::size_t row = 0; row < 12; row++) {
+        column_max = std::fmax(column_max, temps[at(row, 9)]);
+    }
+    TEST_ASSERT_TRUE(column_max < raw);
+    TEST_ASSERT_INT_WITHIN(1, MLX90641Sensor::Reducer::to_fixed_point(column_max), reducer.maxs()[first + 9]);
+
+    rig.sensor.set_flagged_pixels(Mask());
+    TEST_ASSERT_EQUAL(0, rig.sensor.correction().size());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, raw, rig.frame()[noisy]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_interior_pixel_blends_its_four_neighbours);
+    RUN_TEST(test_corner_and_adjacent_defects_use_good_neighbours_only);
+    RUN_TEST(test_defective_cluster_reaches_two_pixels_out);
+    RUN_TEST(test_roi_and_capacity_limit_the_table);
+    RUN_TEST(test_sensor_with_more_than_two_broken_pixels_initializes);
+    RUN_TEST(test_flagged_noisy_pixel_is_corrected_and_left_out_of_zones);
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "mlx90641_driver.hh"
+#include "mlx90641_eeprom_parser.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Output = MLX90641Sensor::Output;
+
+namespace {
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+    MLX90641Sensor sensor;
+    ParamsMLX90641 params;
+
+    Rig() : wire(clock), i2c(wire), device(wire.add_device(0x33, 100000, test_eeprom_data.data())), sensor(i2c, 0x33)
+    {
+        // A left-to-right gradient from ~20 to ~90 °C.
+        device.write_pixels = false;
+        for (uint16_t pixel = 0; pixel < 192; pixel++) {
+            device.memory[0x0400 + pixel] = static_cast<uint16_t>(0x0100 + 40 * (pixel % 16));
+        }
+        device.memory[0x0580 + (192 - 192)] = 19947;  // PTAT art
+        device.memory[0x0580 + (200 - 192)] = 0xFFC0; // compensation pixel
+        device.memory[0x0580 + (202 - 192)] = 7685;   // gain
+        device.memory[0x0580 + (224 - 192)] = 1600;   // PTAT
+        device.memory[0x0580 + (234 - 192)] = 0x9E40; // Vdd ~3.3 V
+        MLX90641EEpromParser(test_eeprom_data).extract_all(params);
+        TEST_ASSERT_TRUE(sensor.init());
+        TEST_ASSERT_TRUE(sensor.read_frame());
+    }
+
+    bool broken(std::size_t pixel) const
+    {
+        return params.brokenPixels[pixel];
+    }
+};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// To follows the image value, up to the per-pixel sensitivity (ksTo) correction of the To
+// conversion, under 1 °C here.
+void test_image_orders_pixels_like_temperature() {
+    Rig rig;
+    rig.sensor.calculate_temps();
+    const std::array<float, 192> temps = rig.sensor.get_temps();
+    rig.sensor.calculate_image();
+    TEST_ASSERT_TRUE(rig.sensor.output() == Output::Image);
+    const std::array<float, 192>& image = rig.sensor.get_temps();
+    for (std::size_t a = 0; a < 192; a++) {
+        for (std::size_t b = 0; b < 192; b++) {
+            if (!rig.broken(a) && !rig.broken(b) && image[a] < image[b]) {
+                TEST_ASSERT_TRUE(temps[a] <= temps[b] + 1.0f);
+            }
+        }
+    }
+}
+
+void test_output_is_selectable_per_frame() {
+    Rig rig;
+    rig.sensor.calculate(Output::Temperature);
+    const std::array<float, 192> reference = rig.sensor.get_temps();
+    rig.sensor.calculate(Output::Image);
+    TEST_ASSERT_TRUE(rig.sensor.output() == Output::Image);
+    TEST_ASSERT_TRUE(rig.sensor.get_temps()[0] > 1000.0f); // not °C
+    rig.sensor.calculate(Output::Temperature);
+    TEST_ASSERT_TRUE(rig.sensor.output() == Output::Temperature);
+    TEST_ASSERT_EQUAL_MEMORY(reference.data(), rig.sensor.get_temps().data(), sizeof(reference));
+}
+
+void test_int16_image_is_scaled_and_saturated() {
+    Rig rig;
+    rig.sensor.calculate_image();
+    const std::array<float, 192>& image = rig.sensor.get_temps();
+    std::array<int16_t, 192> scaled;
+    rig.sensor.get_image_int16(scaled);
+    for (std::size_t pixel = 0; pixel < 192; pixel++) {
+        TEST_ASSERT_INT_WITHIN(1, static_cast<int>(image[pixel] * MLX90641Sensor::image_int16_scale), scaled[pixel]);
+    }
+    rig.sensor.get_image_int16(scaled, 1.0f);
+    TEST_ASSERT_EQUAL(32767, scaled[15]);
+}
+
+// Not a pass/fail on timing beyond "cheaper": prints the per-frame cost of both outputs.
+void test_image_costs_a_fraction_of_temperatures() {
+    Rig rig;
+    constexpr int runs = 5;
+    constexpr int frames = 200;
+    double best[2] = {1e30, 1e30};
+    for (int run = 0; run < runs; run++) {
+        for (int mode = 0; mode < 2; mode++) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; frame++) {
+                rig.sensor.calculate(mode == 0 ? Output::Temperature : Output::Image);
+            }
+            const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            best[mode] = std::min(best[mode], elapsed.count() / frames);
+        }
+    }
+    printf("per frame: temperatures %.1f us, image %.1f us (%.0f %%)\n", best[0], best[1], 100 * best[1] / best[0]);
+    TEST_ASSERT_TRUE(best[1] < best[0]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_image_orders_pixels_like_temperature);
+    RUN_TEST(test_output_is_selectable_per_frame);
+    RUN_TEST(test_int16_image_is_scaled_and_saturated);
+    RUN_TEST(test_image_costs_a_fraction_of_temperatures);
+    return UNITY_END();
+}
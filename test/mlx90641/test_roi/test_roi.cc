@@ -0,0 +1,159 @@
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "acquisition_scheduler.hh"
+#include "mlx90641_driver.hh"
+#include "mlx90641_eeprom_parser.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "virtual_clock.hh"
+
+using namespace mlx90641;
+using Mask = MLX90641Sensor::PixelMask;
+
+namespace {
+
+const uint32_t period_us = AcquisitionScheduler::subpage_period_us(MLX90641Sensor::default_refresh_rate);
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    MockMLX90641Bus::Device& device;
+    MLX90641Sensor sensor;
+
+    explicit Rig(const Mask& roi = Mask::all())
+        : wire(clock), i2c(wire), device(wire.add_device(0x33, 100000, test_eeprom_data.data())), sensor(i2c, 0x33)
+    {
+        device.write_pixels = false;
+        for (uint16_t pixel = 0; pixel < 192; pixel++) {
+            device.memory[0x0400 + pixel] = static_cast<uint16_t>(0x0100 + 40 * (pixel % 16));
+        }
+        device.memory[0x0580 + (192 - 192)] = 19947;  // PTAT art
+        device.memory[0x0580 + (200 - 192)] = 0xFFC0; // compensation pixel
+        device.memory[0x0580 + (202 - 192)] = 7685;   // gain
+        device.memory[0x0580 + (224 - 192)] = 1600;   // PTAT
+        device.memory[0x0580 + (234 - 192)] = 0x9E40; // Vdd ~3.3 V
+        sensor.set_roi(roi);
+        TEST_ASSERT_TRUE(sensor.init());
+    }
+
+    // Reads the next subpage 0 (offsets differ per subpage), returns the transactions it took.
+    uint32_t read_subpage_0()
+    {
+        uint32_t wake_us = device.next_frame_us;
+        if (device.sub_page == 0) {
+            wake_us += period_us;
+        }
+        clock.sleep_until_us(wake_us);
+        const uint32_t before = i2c.stats().transactions;
+        TEST_ASSERT_TRUE(sensor.read_frame());
+        return i2c.stats().transactions - before;
+    }
+
+    // Read by the correction of a broken pixel inside the ROI, so converted.
+    bool correction_neighbour(std::size_t pixel) const { return sensor.correction().sources().test(pixel); }
+};
+
+std::array<float, 192> full_frame_temps()
+{
+    Rig rig;
+    rig.read_subpage_0();
+    rig.sensor.calculate_temps();
+    return rig.sensor.get_temps();
+}
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_roi_pixels_match_the_full_frame_and_others_are_nan() {
+    const std::array<float, 192> reference = full_frame_temps();
+    const Mask roi = Mask::rectangle(2, 7, 4, 11);
+    Rig rig(roi);
+    rig.read_subpage_0();
+    rig.sensor.calculate_temps();
+    const std::array<float, 192>& temps = rig.sensor.get_temps();
+    for (std::size_t pixel = 0; pixel < 192; pixel++) {
+        if (roi.test(pixel)) {
+            TEST_ASSERT_EQUAL_FLOAT(reference[pixel], temps[pixel]);
+        } else if (!rig.correction_neighbour(pixel)) {
+            TEST_ASSERT_TRUE(std::isnan(temps[pixel]));
+        }
+    }
+}
+
+void test_zones_without_roi_pixels_report_no_data() {
+    const Mask roi = Mask::columns(4, 11);
+    Rig rig(roi);
+    MLX90641Sensor::Reducer reducer;
+    uint8_t first_column;
+    TEST_ASSERT_TRUE(reducer.add_columns(first_column) == ZoneStatus::Success);
+    rig.read_subpage_0();
+    rig.sensor.calculate_temps(&reducer);
+    for (uint8_t column = 0; column < 16; column++) {
+        const int16_t mean = reducer.means()[first_column + column];
+        if (column >= 4 && column <= 11) {
+            TEST_ASSERT_TRUE(mean > 0);
+        } else {
+            TEST_ASSERT_EQUAL(MLX90641Sensor::Reducer::no_data, mean);
+        }
+    }
+}
+
+// Full frame: status poll, data-ready clear (write + readback), 12 pixel + 3 auxiliary chunks,
+// status, control. Rows 0-3 are the first two RAM blocks.
+void test_ram_blocks_without_roi_pixels_are_not_read() {
+    Rig full;
+    TEST_ASSERT_EQUAL(20, full.read_subpage_0());
+    Rig top(Mask::rows(0, 3));
+    TEST_ASSERT_EQUAL(20 - 8, top.read_subpage_0());
+    top.sensor.calculate_temps();
+    TEST_ASSERT_TRUE(std::isfinite(top.sensor.get_temps()[3 * 16 + 8]));
+}
+
+void test_clear_roi_restores_the_full_frame() {
+    const std::array<float, 192> reference = full_frame_temps();
+    Rig rig(Mask::rows(5, 6));
+    rig.sensor.clear_roi();
+    rig.read_subpage_0();
+    rig.sensor.calculate_temps();
+    TEST_ASSERT_EQUAL_MEMORY(reference.data(), rig.sensor.get_temps().data(), sizeof(reference));
+}
+
+// Not a pass/fail on timing beyond the trend: prints the per-frame cost against ROI size.
+void test_compute_time_scales_with_roi_size() {
+    const std::size_t rows[] = {12, 6, 3};
+    double best[3];
+    for (std::size_t i = 0; i < 3; i++) {
+        Rig rig(Mask::rows(0, rows[i] - 1));
+        rig.read_subpage_0();
+        best[i] = 1e30;
+        for (int run = 0; run < 5; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < 200; frame++) {
+                rig.sensor.calculate_temps();
+            }
+            const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            best[i] = std::min(best[i], elapsed.count() / 200);
+        }
+        printf("ROI %2zu rows: %.1f us per frame\n", rows[i], best[i]);
+    }
+    TEST_ASSERT_TRUE(best[1] < 0.75 * best[0]);
+    TEST_ASSERT_TRUE(best[2] < 0.75 * best[1]);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_roi_pixels_match_the_full_frame_and_others_are_nan);
+    RUN_TEST(test_zones_without_roi_pixels_report_no_data);
+    RUN_TEST(test_ram_blocks_without_roi_pixels_are_not_read);
+    RUN_TEST(test_clear_roi_restores_the_full_frame);
+    RUN_TEST(test_compute_time_scales_with_roi_size);
+    return UNITY_END();
+}
@@ -0,0 +1,385 @@
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "mlx90641_driver.hh"
+#include "mlx90641_eeprom_parser.hh"
+#include "mock_mlx90641_bus.hh"
+#include "test_data_mlx90641_eeprom.hh"
+#include "test_data_mlx90641_golden.hh"
+#include "virtual_clock.hh"
+
+// Accuracy against runtime of To kernels over the golden corpus.
+//
+// The golden model is the datasheet To computation (MLX90641 11.2) in double precision. Each
+// kernel in `kernels` converts every corpus frame; the report lists its error against the
+// stored golden temperatures (worst pixel maximum and RMS) and its time per frame. A faster or
+// approximate kernel is added to `kernels` and given a tolerance. The reference kernel also runs
+// in native_compact, which covers the compact calibration storage.
+//
+// The corpus is the recorded frame used by the other suites (both subpages) and synthetic frames
+// sweeping the pixels from -40 to 300 °C at Ta -40, 25 and 125 °C. Setting MLX90641_GOLDEN_OUT
+// to a path writes test_data_mlx90641_golden.cc again, after a change to the model or corpus.
+
+using namespace mlx90641;
+using Traits = MLX90641Traits;
+using Frame = std::array<uint16_t, Traits::frame_words>;
+using Temperatures = std::array<float, Traits::num_pixels>;
+
+namespace {
+
+constexpr double sweep_min = -40.0;
+constexpr double sweep_max = 300.0;
+const double sweep_ta[] = {-40.0, 25.0, 125.0};
+
+ParamsMLX90641 params;
+
+double signed_word(const Frame& frame, std::size_t index)
+{
+    return static_cast<int16_t>(frame[index]);
+}
+
+double golden_vdd(const Frame& frame)
+{
+    const int resolution_ram = (frame[Traits::frame_control] & 0x0C00) >> 10;
+    const double resolution_correction = std::ldexp(1.0, params.resolutionEE - resolution_ram);
+    return (resolution_correction * signed_word(frame, Traits::frame_vdd) - params.vdd25) / params.kVdd + 3.3;
+}
+
+double golden_ta(const Frame& frame)
+{
+    const double vdd = golden_vdd(frame);
+    const double ptat = signed_word(frame, Traits::frame_ptat);
+    const double ptat_art =
+        ptat / (ptat * params.alphaPTAT + signed_word(frame, Traits::frame_ptat_art)) * std::ldexp(1.0, 18);
+    return (ptat_art / (1 + params.KvPTAT * (vdd - 3.3)) - params.vPTAT25) / params.KtPTAT + 25;
+}
+
+struct Conditions {
+    double vdd;
+    double ta;
+    double ta_tr;             // (Tr + 273.15)^4 - ((Tr + 273.15)^4 - (Ta + 273.15)^4) / emissivity
+    double gain;
+    double ir_cp;             // compensated compensation pixel
+    double alpha_corr_r[8];
+};
+
+Conditions golden_conditions(const Frame& frame)
+{
+    Conditions c;
+    c.vdd = golden_vdd(frame);
+    c.ta = golden_ta(frame);
+    const double ta4 = std::pow(c.ta + 273.15, 4);
+    const double tr4 = ta4; // Tr = Ta, as calculate_temps()
+    c.ta_tr = tr4 - (tr4 - ta4) / params.emissivityEE;
+    c.gain = params.gainEE / signed_word(frame, Traits::frame_gain);
+    c.ir_cp = signed_word(frame, Traits::frame_cp(0)) * c.gain -
+              params.cpOffset * (1 + params.cpKta * (c.ta - 25)) * (1 + params.cpKv * (c.vdd - 3.3));
+    const std::array<float, 8>& ks = params.ksTo;
+    const std::array<int16_t, 8>& ct = params.ct;
+    c.alpha_corr_r[1] = 1 / (1 + ks[1] * 20.0);
+    c.alpha_corr_r[0] = c.alpha_corr_r[1] / (1 + ks[0] * 20.0);
+    c.alpha_corr_r[2] = 1;
+    c.alpha_corr_r[3] = 1 + ks[2] * static_cast<double>(ct[2]);
+    for (int r = 4; r < 8; r++) {
+        c.alpha_corr_r[r] = c.alpha_corr_r[r - 1] * (1 + ks[r - 1] * static_cast<double>(ct[r] - ct[r - 1]));
+    }
+    return c;
+}
+
+double alpha_compensated(const Conditions& c, std::size_t pixel)
+{
+    return (static_cast<double>(params.alpha[pixel]) - params.tgc * params.cpAlpha) * (1 + params.KsTa * (c.ta - 25));
+}
+
+double pixel_offset(const Conditions& c, std::size_t pixel, uint16_t sub_page)
+{
+    return params.offset[sub_page][pixel] * (1 + params.kta[pixel] * (c.ta - 25)) * (1 + params.kv[pixel] * (c.vdd - 3.3));
+}
+
+int temperature_range(double to)
+{
+    int range = 0;
+    while (range < 7 && to >= params.ct[range + 1]) {
+        range++;
+    }
+    return range;
+}
+
+double golden_pixel(const Conditions& c, double word, std::size_t pixel, uint16_t sub_page)
+{
+    double ir = word * c.gain - pixel_offset(c, pixel, sub_page);
+    ir = (ir - params.tgc * c.ir_cp) / params.emissivityEE;
+    const double alpha = alpha_compensated(c, pixel);
+    const double sx = std::sqrt(std::sqrt(alpha * alpha * alpha * (ir + alpha * c.ta_tr))) * params.ksTo[1];
+    const double estimate = std::sqrt(std::sqrt(ir / (alpha * (1 - params.ksTo[1] * 273.15) + sx) + c.ta_tr)) - 273.15;
+    const int r = temperature_range(estimate);
+    return std::sqrt(std::sqrt(ir / (alpha * c.alpha_corr_r[r] * (1 + params.ksTo[r] * (estimate - params.ct[r]))) +
+                               c.ta_tr)) - 273.15;
+}
+
+void golden_to(const Frame& frame, std::array<double, Traits::num_pixels>& to)
+{
+    const Conditions c = golden_conditions(frame);
+    const uint16_t sub_page = frame[Traits::frame_sub_page];
+    for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+        to[pixel] = golden_pixel(c, signed_word(frame, pixel), pixel, sub_page);
+    }
+}
+
+// --- Corpus -----------------------------------------------------------------------------------
+
+uint16_t to_word(double value)
+{
+    return static_cast<uint16_t>(static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, std::round(value)))));
+}
+
+// The frame the mock bus returns in the other suites: every pixel reads 0x0200.
+Frame recorded_frame(uint16_t sub_page)
+{
+    Frame frame = {};
+    for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+        frame[pixel] = 0x0200;
+    }
+    frame[Traits::frame_ptat_art] = 19947;
+    frame[Traits::frame_cp(0)] = 0xFFC0;
+    frame[Traits::frame_gain] = 7685;
+    frame[Traits::frame_ptat] = 1600;
+    frame[Traits::frame_vdd] = 0x9E40;
+    frame[Traits::frame_control] = 0x0901;
+    frame[Traits::frame_sub_page] = sub_page;
+    return frame;
+}
+
+// A frame at `ta` (Vdd 3.3 V, gain 1) whose pixels read a linear sweep of object temperatures:
+// each pixel gets the RAM word the golden model converts closest to its target. The model
+// picks its temperature range from a first estimate, so it is inverted by search.
+Frame sweep_frame(double ta, uint16_t sub_page)
+{
+    Frame frame = {};
+    frame[Traits::frame_control] = static_cast<uint16_t>((0x0901 & ~0x0C00) | (params.resolutionEE << 10));
+    frame[Traits::frame_sub_page] = sub_page;
+    frame[Traits::frame_vdd] = to_word(params.vdd25);
+    frame[Traits::frame_gain] = to_word(params.gainEE);
+    frame[Traits::frame_ptat] = 1600;
+    const double ptat_art = ((ta - 25) * params.KtPTAT + params.vPTAT25) * (1 + params.KvPTAT * (golden_vdd(frame) - 3.3));
+    frame[Traits::frame_ptat_art] = to_word(1600 * std::ldexp(1.0, 18) / ptat_art - 1600 * params.alphaPTAT);
+    frame[Traits::frame_cp(0)] = to_word(params.cpOffset * (1 + params.cpKta * (golden_ta(frame) - 25)));
+
+    const Conditions c = golden_conditions(frame);
+    for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+        const double target = sweep_min + (sweep_max - sweep_min) * pixel / (Traits::num_pixels - 1);
+        // First word converting to at least the target (NaN below the model's domain counts as colder).
+        int32_t low = -32768;
+        int32_t high = 32767;
+        while (low < high) {
+            const int32_t middle = low + (high - low) / 2;
+            if (golden_pixel(c, middle, pixel, sub_page) >= target) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        if (low > -32768 && target - golden_pixel(c, low - 1, pixel, sub_page) < golden_pixel(c, low, pixel, sub_page) - target) {
+            low--;
+        }
+        frame[pixel] = to_word(low);
+    }
+    return frame;
+}
+
+void write_fixture(const char* path)
+{
+    std::FILE* out = std::fopen(path, "w");
+    TEST_ASSERT_NOT_NULL(out);
+    std::fprintf(out, "#include \"test_data_mlx90641_golden.hh\"\n\nnamespace mlx90641 {\n");
+    std::fprintf(out, "const std::array<GoldenFrame, 8> golden_frames = {{\n");
+    for (int index = 0; index < 8; index++) {
+        char name[32];
+        Frame frame;
+        if (index < 2) {
+            std::snprintf(name, sizeof(name), "recorded, subpage %d", index);
+            frame = recorded_frame(static_cast<uint16_t>(index));
+        } else {
+            const double ta = sweep_ta[(index - 2) / 2];
+            std::snprintf(name, sizeof(name), "sweep Ta %+.0f, subpage %d", ta, index % 2);
+            frame = sweep_frame(ta, static_cast<uint16_t>(index % 2));
+        }
+        std::array<double, Traits::num_pixels> to;
+        golden_to(frame, to);
+        std::fprintf(out, "{\"%s\",\n {{", name);
+        for (std::size_t i = 0; i < frame.size(); i++) {
+            std::fprintf(out, "%s0x%04X,", i % 12 == 0 ? "\n  " : " ", frame[i]);
+        }
+        std::fprintf(out, "\n }},\n {{");
+        for (std::size_t i = 0; i < to.size(); i++) {
+            std::fprintf(out, "%s%.5ff,", i % 8 == 0 ? "\n  " : " ", to[i]);
+        }
+        std::fprintf(out, "\n }}},\n");
+    }
+    std::fprintf(out, "}};\n\n} // namespace mlx90641\n");
+    std::fclose(out);
+}
+
+// --- Kernels ----------------------------------------------------------------------------------
+
+struct Rig {
+    VirtualClock clock;
+    MockMLX90641Bus wire;
+    I2CAdapter i2c;
+    MLX90641Sensor sensor;
+
+    Rig() : wire(clock), i2c(wire), sensor(i2c, 0x33)
+    {
+        wire.add_device(0x33, 100000, test_eeprom_data.data());
+        TEST_ASSERT_TRUE(sensor.init());
+    }
+};
+
+Rig* rig;
+
+void reference_kernel(const Frame& frame, Temperatures& temps)
+{
+    rig->sensor.load_frame(frame);
+    rig->sensor.calculate_temps();
+    temps = rig->sensor.get_temps();
+}
+
+void golden_kernel(const Frame& frame, Temperatures& temps)
+{
+    std::array<double, Traits::num_pixels> to;
+    golden_to(frame, to);
+    std::copy(to.begin(), to.end(), temps.begin());
+}
+
+struct Kernel {
+    const char* name;
+    void (*run)(const Frame&, Temperatures&);
+};
+
+const Kernel kernels[] = {
+    {"golden (double)", golden_kernel},
+    {"calculate_to", reference_kernel},
+};
+
+struct Evaluation {
+    double max_error;       // °C, worst pixel
+    double max_pixel_rms;   // °C, worst pixel
+    double rms;             // °C, all pixels
+    double us_per_frame;
+};
+
+bool broken(std::size_t pixel)
+{
+    return params.brokenPixels[pixel];
+}
+
+// Bad-pixel correction replaces broken pixels with their neighbours, they are not compared.
+Evaluation evaluate(const Kernel& kernel)
+{
+    Evaluation result = {0, 0, 0, 1e30};
+    std::array<double, Traits::num_pixels> sum_squares = {};
+    Temperatures temps;
+    std::size_t compared = 0;
+    double total_squares = 0;
+    for (const GoldenFrame& golden : golden_frames) {
+        kernel.run(golden.words, temps);
+        for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+            if (broken(pixel)) {
+                continue;
+            }
+            const double error = std::fabs(static_cast<double>(temps[pixel]) - golden.to[pixel]);
+            result.max_error = std::max(result.max_error, error);
+            sum_squares[pixel] += error * error;
+            total_squares += error * error;
+            compared++;
+        }
+    }
+    for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+        result.max_pixel_rms = std::max(result.max_pixel_rms, std::sqrt(sum_squares[pixel] / golden_frames.size()));
+    }
+    result.rms = std::sqrt(total_squares / compared);
+
+    constexpr int runs = 5;
+    constexpr int repeats = 50;
+    for (int run = 0; run < runs; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int repeat = 0; repeat < repeats; repeat++) {
+            for (const GoldenFrame& golden : golden_frames) {
+                kernel.run(golden.words, temps);
+            }
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        result.us_per_frame = std::min(result.us_per_frame, elapsed.count() / (repeats * golden_frames.size()));
+    }
+    return result;
+}
+
+} // namespace
+
+void setUp(void) {
+    MLX90641EEpromParser(test_eeprom_data).extract_all(params);
+}
+
+void tearDown(void) {}
+
+void test_golden_model_matches_the_fixtures() {
+    const char* path = std::getenv("MLX90641_GOLDEN_OUT");
+    if (path) {
+        write_fixture(path);
+        printf("wrote %s\n", path);
+    }
+    std::array<double, Traits::num_pixels> to;
+    for (const GoldenFrame& golden : golden_frames) {
+        golden_to(golden.words, to);
+        for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, golden.to[pixel], static_cast<float>(to[pixel]));
+        }
+    }
+}
+
+// The synthetic frames invert the golden model, up to the rounding of the RAM words and the
+// model's step at the range boundaries (ct), under 1 °C.
+void test_sweeps_cover_the_object_range() {
+    for (std::size_t index = 2; index < golden_frames.size(); index++) {
+        const GoldenFrame& golden = golden_frames[index];
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, sweep_ta[(index - 2) / 2], golden_ta(golden.words));
+        for (std::size_t pixel = 0; pixel < Traits::num_pixels; pixel++) {
+            const double target = sweep_min + (sweep_max - sweep_min) * pixel / (Traits::num_pixels - 1);
+            TEST_ASSERT_FLOAT_WITHIN(1.0f, target, golden.to[pixel]);
+        }
+    }
+}
+
+void test_sweeps_are_not_regenerated_differently() {
+    for (std::size_t index = 2; index < golden_frames.size(); index++) {
+        const Frame frame = sweep_frame(sweep_ta[(index - 2) / 2], static_cast<uint16_t>(index % 2));
+        for (std::size_t i = 0; i < frame.size(); i++) {
+            TEST_ASSERT_INT_WITHIN(1, golden_frames[index].words[i], frame[i]);
+        }
+    }
+}
+
+void test_kernel_accuracy_and_speed() {
+    Rig test_rig;
+    rig = &test_rig;
+    printf("%-18s %12s %16s %10s %10s\n", "kernel", "max err (C)", "max pixel rms", "rms (C)", "us/frame");
+    for (const Kernel& kernel : kernels) {
+        const Evaluation result = evaluate(kernel);
+        printf("%-18s %12.5f %16.5f %10.5f %10.1f\n", kernel.name, result.max_error, result.max_pixel_rms, result.rms,
+               result.us_per_frame);
+        TEST_ASSERT_TRUE(result.max_error < 0.01); // float rounding only, 1e-4 °C today
+    }
+    rig = nullptr;
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_golden_model_matches_the_fixtures);
+    RUN_TEST(test_sweeps_cover_the_object_range);
+    RUN_TEST(test_sweeps_are_not_regenerated_differently);
+    RUN_TEST(test_kernel_accuracy_and_speed);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+#include <unity.h>
+#include <vector>
+#include "acquisition_scheduler.hh"
+#include "virtual_clock.hh"
+
+constexpr uint32_t period_us = 31250; // refresh rate code 0x06
+constexpr uint32_t guard_us = 1000;
+constexpr uint32_t work_us = 5000;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_subpage_period_from_refresh_rate() {
+    TEST_ASSERT_EQUAL(2000000, AcquisitionScheduler::subpage_period_us(0x00));
+    TEST_ASSERT_EQUAL(period_us, AcquisitionScheduler::subpage_period_us(0x06));
+    TEST_ASSERT_EQUAL(15625, AcquisitionScheduler::subpage_period_us(0x07));
+}
+
+void test_wakes_guard_before_data_ready() {
+    VirtualClock clock(100);
+    AcquisitionScheduler scheduler(clock, period_us, guard_us);
+
+    // Sensor produces data at 100 + 200 + k * period; the first wait returns immediately.
+    const uint32_t first_ready = 300;
+    TEST_ASSERT_EQUAL(0, scheduler.wait_for_next_frame());
+    clock.advance(first_ready - clock.now_us());
+    scheduler.data_ready_at(clock.now_us());
+    clock.advance(work_us);
+    scheduler.frame_done();
+
+    for (uint32_t k = 1; k <= 5; ++k) {
+        TEST_ASSERT_EQUAL(0, scheduler.wait_for_next_frame());
+        TEST_ASSERT_EQUAL(first_ready + k * period_us - guard_us, clock.now_us());
+        clock.advance(guard_us); // polling until the status bit flips
+        scheduler.data_ready_at(clock.now_us());
+        clock.advance(work_us);
+        scheduler.frame_done();
+    }
+    TEST_ASSERT_EQUAL(6, scheduler.frames());
+    TEST_ASSERT_EQUAL(0, scheduler.missed_frames());
+}
+
+void test_phase_lock_follows_sensor_drift() {
+    VirtualClock clock;
+    AcquisitionScheduler scheduler(clock, period_us, guard_us);
+    scheduler.wait_for_next_frame();
+    scheduler.data_ready_at(clock.now_us());
+    scheduler.frame_done();
+
+    // The sensor oscillator runs 0.3 % slow; wakes must track it instead of drifting early.
+    uint32_t ready = 0;
+    for (int k = 0; k < 50; ++k) {
+        ready += period_us + period_us * 3 / 1000;
+        scheduler.wait_for_next_frame();
+        TEST_ASSERT_TRUE(static_cast<int32_t>(ready - clock.now_us()) > 0);
+        TEST_ASSERT_TRUE(ready - clock.now_us() <= guard_us + period_us * 3 / 1000);
+        clock.advance(ready - clock.now_us());
+        scheduler.data_ready_at(clock.now_us());
+        clock.advance(work_us);
+        scheduler.frame_done();
+    }
+    TEST_ASSERT_EQUAL(0, scheduler.missed_frames());
+}
+
+void test_overrun_counts_missed_frames() {
+    VirtualClock clock;
+    AcquisitionScheduler scheduler(clock, period_us, guard_us);
+    scheduler.wait_for_next_frame();
+    scheduler.data_ready_at(0);
+    // Processing took 2.5 periods: slot 1 was overwritten by slot 2, slot 2 is still readable.
+    clock.advance(period_us * 5 / 2);
+    scheduler.frame_done();
+
+    TEST_ASSERT_EQUAL(1, scheduler.wait_for_next_frame());
+    TEST_ASSERT_EQUAL(period_us * 5 / 2, clock.now_us()); // late: no sleep
+    TEST_ASSERT_EQUAL(1, scheduler.missed_frames());
+
+    // Without a data_ready report the predicted grid is kept.
+    scheduler.frame_done();
+    TEST_ASSERT_EQUAL(0, scheduler.wait_for_next_frame());
+    TEST_ASSERT_EQUAL(3 * period_us - guard_us, clock.now_us());
+}
+
+void test_late_but_valid_frame_is_not_missed() {
+    VirtualClock clock;
+    AcquisitionScheduler scheduler(clock, period_us, guard_us);
+    scheduler.wait_for_next_frame();
+    scheduler.data_ready_at(0);
+    clock.advance(period_us + 10);
+    scheduler.frame_done();
+    TEST_ASSERT_EQUAL(0, scheduler.wait_for_next_frame());
+    TEST_ASSERT_EQUAL(0, scheduler.missed_frames());
+}
+
+void test_clock_wraparound() {
+    VirtualClock clock(0xFFFFFFFFu - period_us / 2);
+    AcquisitionScheduler scheduler(clock, period_us, guard_us);
+    scheduler.wait_for_next_frame();
+    const uint32_t start = clock.now_us();
+    scheduler.data_ready_at(start);
+    scheduler.frame_done();
+    TEST_ASSERT_EQUAL(0, scheduler.wait_for_next_frame());
+    TEST_ASSERT_EQUAL(static_cast<uint32_t>(start + period_us - guard_us), clock.now_us());
+}
+
+void test_duty_cycle_and_active_time() {
+    VirtualClock clock;
+    AcquisitionScheduler scheduler(clock, period_us, guard_us);
+    scheduler.wait_for_next_frame();
+    scheduler.data_ready_at(0);
+    clock.advance(work_us);
+    scheduler.frame_done();
+    for (int k = 1; k <= 9; ++k) {
+        scheduler.wait_for_next_frame();
+        clock.advance(guard_us);
+        scheduler.data_ready_at(clock.now_us());
+        clock.advance(work_us);
+        scheduler.frame_done();
+    }
+    TEST_ASSERT_EQUAL(work_us + guard_us, scheduler.last_active_us());
+    // 9 frames of 6 ms and one of 5 ms over 9 periods + 6 ms
+    const float expected = (9.0f * (work_us + guard_us) + work_us) / (9.0f * period_us + work_us + guard_us);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, scheduler.duty_cycle());
+    TEST_ASSERT_EQUAL((9 * (work_us + guard_us) + work_us) / 10, scheduler.average_active_us());
+}
+
+void test_step_mode_sleeps_through_conversion() {
+    constexpr uint32_t step_period_us = 10000000; // one frame every 10 s
+    constexpr uint32_t conversion_us = 2 * period_us;
+    VirtualClock clock;
+    AcquisitionScheduler scheduler(clock, step_period_us, guard_us, AcquisitionScheduler::Mode::Step);
+    for (int k = 0; k < 3; ++k) {
+        scheduler.wait_for_next_frame();
+        TEST_ASSERT_EQUAL(k * step_period_us, clock.now_us());
+        clock.advance(100);  // trigger
+        scheduler.wait_for_conversion(conversion_us);
+        scheduler.data_ready_at(clock.now_us()); // ignored in step mode
+        clock.advance(work_us);
+        scheduler.frame_done();
+    }
+    TEST_ASSERT_EQUAL(work_us + 100, scheduler.average_active_us());
+    TEST_ASSERT_TRUE(scheduler.duty_cycle() < 0.001f);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_subpage_period_from_refresh_rate);
+    RUN_TEST(test_wakes_guard_before_data_ready);
+    RUN_TEST(test_phase_lock_follows_sensor_drift);
+    RUN_TEST(test_overrun_counts_missed_frames);
+    RUN_TEST(test_late_but_valid_frame_is_not_missed);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_duty_cycle_and_active_time);
+    RUN_TEST(test_step_mode_sleeps_through_conversion);
+    return UNITY_END();
+}
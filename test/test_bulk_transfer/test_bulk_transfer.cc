@@ -0,0 +1,299 @@
+#include <unity.h>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "bulk_transfer.hh"
+#include "file_flash.hh"
+#include "session_recorder.hh"
+#include "virtual_clock.hh"
+
+namespace {
+
+constexpr uint32_t page_size = 4096;
+constexpr uint32_t page_count = 12;
+constexpr uint32_t region_size = page_size * page_count;
+constexpr uint32_t connection_interval_us = 7500;
+
+// One direction of a BLE connection: up to `per_event` messages per connection event, lost
+// with probability loss_per_mille (deterministic), or all of them while disconnected.
+class SimulatedLink : public IBulkLink {
+public:
+    explicit SimulatedLink(std::size_t max_message, std::size_t per_event = 6)
+        : max_message_(max_message), per_event_(per_event) {}
+
+    std::size_t max_message() const override { return max_message_; }
+    bool send(const uint8_t* data, std::size_t size) override
+    {
+        if (size > max_message_ || queue_.size() >= per_event_) {
+            return false;
+        }
+        sent++;
+        queue_.push_back(std::vector<uint8_t>(data, data + size));
+        return true;
+    }
+
+    // Connection event: delivers or loses the queued messages.
+    template <typename Deliver>
+    void deliver(Deliver deliver)
+    {
+        while (!queue_.empty()) {
+            std::vector<uint8_t> message = queue_.front();
+            queue_.pop_front();
+            random_ = random_ * 1103515245 + 12345;
+            if (!connected || (random_ >> 16) % 1000 < loss_per_mille) {
+                lost++;
+                continue;
+            }
+            if (corrupt_next) {
+                message.back() ^= 0x01;
+                corrupt_next = false;
+            }
+            deliver(message.data(), message.size());
+        }
+    }
+
+    bool connected = true;
+    uint32_t loss_per_mille = 0;
+    bool corrupt_next = false;
+    uint32_t sent = 0;
+    uint32_t lost = 0;
+
+private:
+    std::size_t max_message_;
+    std::size_t per_event_;
+    std::deque<std::vector<uint8_t>> queue_;
+    uint32_t random_ = 1;
+};
+
+struct Rig {
+    VirtualClock clock;
+    FileFlash flash;
+    SimulatedLink notifications; // device → host
+    SimulatedLink writes;        // host → device
+    BulkSender sender;
+    std::vector<uint8_t> received;
+    BulkReceiver receiver;
+
+    explicit Rig(const std::string& path, std::size_t mtu = 247)
+        : flash(path, page_size, page_count, nullptr), notifications(mtu - 3), writes(mtu - 3, 4),
+          sender(notifications, flash, clock), received(region_size, 0), receiver(writes, received.data(), region_size)
+    {
+    }
+
+    void fill()
+    {
+        std::vector<uint8_t> pattern(region_size);
+        for (uint32_t i = 0; i < region_size; i++) {
+            pattern[i] = static_cast<uint8_t>(i * 7 + i / 251);
+        }
+        for (uint32_t page = 0; page < page_count; page++) {
+            flash.erase_page(page);
+        }
+        flash.write(0, pattern.data(), pattern.size());
+    }
+
+    void event()
+    {
+        clock.advance(connection_interval_us);
+        writes.deliver([this](const uint8_t* data, std::size_t size) { sender.on_control(data, size); });
+        sender.service();
+        notifications.deliver([this](const uint8_t* data, std::size_t size) { receiver.on_message(data, size); });
+    }
+
+    // Runs connection events until the download completes, at most `limit`.
+    uint32_t run(uint32_t limit = 100000)
+    {
+        uint32_t events = 0;
+        while (!receiver.complete() && receiver.status() == BulkStatus::Success && events < limit) {
+            event();
+            events++;
+        }
+        return events;
+    }
+
+    void check_content()
+    {
+        std::vector<uint8_t> expected(region_size);
+        flash.read(0, expected.data(), expected.size());
+        TEST_ASSERT_EQUAL_MEMORY(expected.data(), received.data(), region_size);
+    }
+};
+
+std::string path;
+
+} // namespace
+
+void setUp(void) {
+    char name[] = "/tmp/bulk_XXXXXX";
+    close(mkstemp(name));
+    std::remove(name);
+    path = name;
+}
+
+void tearDown(void) {
+    std::remove(path.c_str());
+}
+
+void test_clean_link_streams_full_chunks() {
+    Rig rig(path);
+    rig.fill();
+    TEST_ASSERT_TRUE(rig.receiver.start());
+    const uint32_t events = rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+    rig.check_content();
+    TEST_ASSERT_EQUAL(region_size, rig.receiver.region_size());
+    const uint32_t payload = 244 - sizeof(BulkChunkHeader);
+    TEST_ASSERT_EQUAL((region_size + payload - 1) / payload, rig.sender.stats().chunks_sent);
+    TEST_ASSERT_EQUAL(0, rig.sender.stats().chunks_resent);
+    // The 19-byte DataPack path: one notification per 5 ms.
+    const uint32_t datapack_bytes_per_s = 19 * 200;
+    printf("%u bytes in %u connection events: %u bytes/s (DataPack path %u bytes/s)\n", (unsigned)region_size,
+           (unsigned)events, (unsigned)rig.receiver.device_bytes_per_s(), (unsigned)datapack_bytes_per_s);
+    TEST_ASSERT_EQUAL(rig.sender.stats().last_bytes_per_s, rig.receiver.device_bytes_per_s());
+    TEST_ASSERT_GREATER_THAN(40 * datapack_bytes_per_s, rig.receiver.device_bytes_per_s());
+}
+
+void test_small_mtu_still_completes() {
+    Rig rig(path, 23);
+    rig.fill();
+    rig.receiver.start();
+    rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+    rig.check_content();
+}
+
+void test_lossy_link_recovers_every_chunk() {
+    Rig rig(path);
+    rig.fill();
+    rig.notifications.loss_per_mille = 50;
+    rig.writes.loss_per_mille = 50;
+    rig.receiver.start();
+    rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+    rig.check_content();
+    const BulkSenderStats& stats = rig.sender.stats();
+    printf("%u chunks lost, %u resent, %u timeouts, %u bytes/s\n", (unsigned)rig.notifications.lost,
+           (unsigned)stats.chunks_resent, (unsigned)stats.timeouts, (unsigned)stats.last_bytes_per_s);
+    TEST_ASSERT_GREATER_THAN(0, stats.chunks_resent);
+    TEST_ASSERT_LESS_THAN(2 * region_size, stats.bytes_sent);
+}
+
+void test_corrupted_chunk_fails_its_crc() {
+    Rig rig(path);
+    rig.fill();
+    rig.receiver.start();
+    rig.event();                          // the request arrives, the first chunks go out
+    rig.notifications.corrupt_next = true;
+    rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+    TEST_ASSERT_EQUAL(1, rig.receiver.bad_chunks());
+    rig.check_content();
+}
+
+void test_window_bounds_unacknowledged_chunks() {
+    Rig rig(path);
+    rig.fill();
+    rig.receiver.start(0, 0xFFFFFFFF, 4);
+    rig.event();                   // the request arrives
+    rig.writes.connected = false;  // no acknowledgement from now on
+    for (int i = 0; i < 10; i++) {
+        rig.event();
+    }
+    TEST_ASSERT_EQUAL(4, rig.sender.stats().chunks_sent);
+    for (uint32_t i = 0; i < BulkSender::default_ack_timeout_us / connection_interval_us; i++) {
+        rig.event();
+    }
+    TEST_ASSERT_EQUAL(1, rig.sender.stats().timeouts); // went back to the first unacknowledged chunk
+    TEST_ASSERT_EQUAL(4, rig.sender.stats().chunks_resent);
+    rig.writes.connected = true;
+    rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+    rig.check_content();
+}
+
+void test_download_resumes_after_a_disconnect() {
+    Rig rig(path);
+    rig.fill();
+    rig.receiver.start();
+    for (int i = 0; i < 10; i++) {
+        rig.event();
+    }
+    rig.notifications.connected = false;
+    rig.writes.connected = false;
+    for (int i = 0; i < 50; i++) {
+        rig.event();
+    }
+    const uint32_t before = rig.receiver.received();
+    TEST_ASSERT_GREATER_THAN(0, before);
+    TEST_ASSERT_LESS_THAN(region_size, before);
+
+    rig.notifications.connected = true;
+    rig.writes.connected = true;
+    TEST_ASSERT_TRUE(rig.receiver.resume());
+    rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+    rig.check_content();
+    TEST_ASSERT_EQUAL(2, rig.sender.stats().requests);
+    // Resumed, not restarted: only what was in flight at the disconnect is sent twice.
+    TEST_ASSERT_LESS_THAN(region_size + before, rig.sender.stats().bytes_sent);
+}
+
+void test_bad_requests_are_reported() {
+    Rig rig(path);
+    TEST_ASSERT_FALSE(rig.sender.on_control(reinterpret_cast<const uint8_t*>("\x02\x00"), 2));
+    TEST_ASSERT_FALSE(rig.sender.on_control(reinterpret_cast<const uint8_t*>("\x7f"), 1));
+    const BulkRequest request = {static_cast<uint8_t>(BulkOp::Request), region_size + 4, 16, 0};
+    TEST_ASSERT_TRUE(rig.sender.on_control(reinterpret_cast<const uint8_t*>(&request), sizeof(request)));
+    rig.event();
+    TEST_ASSERT_EQUAL(BulkStatus::OutOfRange, rig.receiver.status());
+    TEST_ASSERT_EQUAL(region_size, rig.receiver.region_size());
+    TEST_ASSERT_FALSE(rig.sender.active());
+}
+
+void test_downloaded_recording_decodes_on_the_host() {
+    Rig rig(path);
+    SessionRecorder recorder(rig.flash);
+    recorder.mount();
+    const int16_t zones[4] = {250, 260, 270, 280};
+    for (uint32_t n = 0; n < 500; n++) {
+        recorder.record(n, n * 1000000u, 25.0f, zones, 4);
+        recorder.service();
+    }
+    recorder.request_flush();
+    recorder.service();
+    rig.receiver.start();
+    rig.run();
+    TEST_ASSERT_TRUE(rig.receiver.complete());
+
+    const std::string copy = path + ".copy";
+    std::remove(copy.c_str());
+    {
+        FileFlash host(copy, page_size, page_count);
+        host.write(0, rig.received.data(), region_size); // fresh file: every byte erased
+        RecordingReader reader(host);
+        RecordedFrame frame;
+        uint32_t frames = 0;
+        while (reader.next(frame)) {
+            TEST_ASSERT_EQUAL(frames, frame.sequence);
+            TEST_ASSERT_EQUAL_INT16_ARRAY(zones, frame.zones.data(), 4);
+            frames++;
+        }
+        TEST_ASSERT_EQUAL(500, frames);
+    }
+    std::remove(copy.c_str());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_link_streams_full_chunks);
+    RUN_TEST(test_small_mtu_still_completes);
+    RUN_TEST(test_lossy_link_recovers_every_chunk);
+    RUN_TEST(test_corrupted_chunk_fails_its_crc);
+    RUN_TEST(test_window_bounds_unacknowledged_chunks);
+    RUN_TEST(test_download_resumes_after_a_disconnect);
+    RUN_TEST(test_bad_requests_are_reported);
+    RUN_TEST(test_downloaded_recording_decodes_on_the_host);
+    return UNITY_END();
+}
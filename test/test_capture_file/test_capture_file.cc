@@ -0,0 +1,235 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "capture_file.hh"
+
+namespace {
+
+constexpr uint8_t rows = 12;
+constexpr uint8_t columns = 16;
+constexpr std::size_t pixels = rows * columns;
+
+std::string path;
+
+std::string temporary_path()
+{
+    char name[] = "/tmp/capture_XXXXXX";
+    const int fd = mkstemp(name);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+    return name;
+}
+
+CaptureRecordHeader record_for(uint32_t n, uint32_t timestamp_us)
+{
+    CaptureRecordHeader record = CaptureRecordHeader();
+    record.sequence = n;
+    record.timestamp_us = timestamp_us;
+    record.ta = 25.0f;
+    record.vdd = 3.3f;
+    record.sub_page = static_cast<uint8_t>(n % 2);
+    return record;
+}
+
+std::vector<float> temperatures_for(uint32_t n)
+{
+    std::vector<float> temps(pixels);
+    for (std::size_t pixel = 0; pixel < pixels; pixel++) {
+        temps[pixel] = static_cast<float>(n) + pixel / 1000.0f;
+    }
+    return temps;
+}
+
+// `frames` temperature frames 31250 µs apart (32 Hz subpages) from `first_us`.
+void write_capture(uint32_t frames, uint32_t first_us, const uint16_t* calibration = nullptr, std::size_t words = 0)
+{
+    CaptureWriter writer;
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, writer.open(path.c_str(), rows, columns, SerialPayload::Temperatures,
+                                                          pixels * sizeof(float), calibration, words));
+    for (uint32_t n = 0; n < frames; n++) {
+        const std::vector<float> temps = temperatures_for(n);
+        TEST_ASSERT_EQUAL(CaptureStatus::Success,
+                          writer.append(record_for(n, first_us + n * 31250u), temps.data(), pixels * sizeof(float)));
+    }
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, writer.finish());
+}
+
+void append_serial(std::vector<uint8_t>& stream, SerialPayload payload, uint32_t sequence, const void* data,
+                   std::size_t size)
+{
+    SerialFrameHeader header = SerialFrameHeader();
+    header.magic = serial_frame_magic;
+    header.sequence = sequence;
+    header.timestamp_us = 1000 + sequence * 31250u;
+    header.rows = rows;
+    header.columns = columns;
+    header.payload = static_cast<uint8_t>(payload);
+    header.payload_bytes = static_cast<uint16_t>(size);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&header);
+    stream.insert(stream.end(), bytes, bytes + sizeof(header));
+    bytes = static_cast<const uint8_t*>(data);
+    stream.insert(stream.end(), bytes, bytes + size);
+}
+
+CaptureStatus convert(const std::vector<uint8_t>& stream, CaptureConversion& conversion)
+{
+    const std::string serial_path = temporary_path();
+    std::FILE* file = std::fopen(serial_path.c_str(), "wb");
+    std::fwrite(stream.data(), 1, stream.size(), file);
+    std::fclose(file);
+    file = std::fopen(serial_path.c_str(), "rb");
+    const CaptureStatus status = convert_serial_capture(file, path.c_str(), conversion);
+    std::fclose(file);
+    std::remove(serial_path.c_str());
+    return status;
+}
+
+} // namespace
+
+void setUp(void) {
+    path = temporary_path();
+}
+
+void tearDown(void) {
+    std::remove(path.c_str());
+}
+
+void test_frames_are_read_back_at_random() {
+    uint16_t eeprom[832];
+    for (uint16_t i = 0; i < 832; i++) {
+        eeprom[i] = static_cast<uint16_t>(i * 3);
+    }
+    write_capture(100, 5000, eeprom, 832);
+    CaptureReader reader;
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, reader.open(path.c_str()));
+    TEST_ASSERT_EQUAL(100, reader.frame_count());
+    TEST_ASSERT_EQUAL(pixels * sizeof(float), reader.payload_bytes());
+    TEST_ASSERT_EQUAL(832, reader.calibration_words());
+    TEST_ASSERT_EQUAL_MEMORY(eeprom, reader.calibration(), sizeof(eeprom));
+    TEST_ASSERT_EQUAL(21, reader.header().sensor_id[0]); // EEPROM word 7
+    for (uint32_t n : {73u, 0u, 99u, 12u}) {
+        const CaptureFrame frame = reader.frame(n);
+        TEST_ASSERT_EQUAL(n, frame.record->sequence);
+        TEST_ASSERT_EQUAL(n % 2, frame.record->sub_page);
+        TEST_ASSERT_EQUAL(5000 + n * 31250u, frame.time_us);
+        TEST_ASSERT_EQUAL_MEMORY(temperatures_for(n).data(), frame.payload, pixels * sizeof(float));
+    }
+}
+
+void test_time_lookup_survives_the_clock_wrap() {
+    const uint32_t first_us = 0xFFFFFFFFu - 10 * 31250u; // wraps after frame 10
+    write_capture(40, first_us);
+    CaptureReader reader;
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, reader.open(path.c_str()));
+    TEST_ASSERT_EQUAL(0, reader.find_time(0));
+    TEST_ASSERT_EQUAL(10, reader.find_time(reader.frame(10).time_us));
+    TEST_ASSERT_EQUAL(11, reader.find_time(reader.frame(10).time_us + 1));
+    TEST_ASSERT_TRUE(reader.frame(11).time_us > 0xFFFFFFFFull);
+    TEST_ASSERT_EQUAL(30, reader.find_time(reader.frame(30).time_us - 100));
+    TEST_ASSERT_EQUAL(40, reader.find_time(reader.frame(39).time_us + 1));
+}
+
+void test_invalid_files_are_rejected() {
+    CaptureReader reader;
+    TEST_ASSERT_EQUAL(CaptureStatus::Truncated, reader.open(path.c_str())); // empty
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    const char text[] = "not a capture file, only some serial text from the sensor";
+    std::fwrite(text, 1, sizeof(text), file);
+    std::fclose(file);
+    TEST_ASSERT_EQUAL(CaptureStatus::BadMagic, reader.open(path.c_str()));
+    TEST_ASSERT_EQUAL(CaptureStatus::IoError, reader.open("/nonexistent/session.tcap"));
+
+    // Interrupted before finish(): no index.
+    CaptureWriter writer;
+    TEST_ASSERT_EQUAL(CaptureStatus::Success,
+                      writer.open(path.c_str(), rows, columns, SerialPayload::Temperatures, 8, nullptr, 0));
+    const uint8_t payload[8] = {};
+    TEST_ASSERT_EQUAL(CaptureStatus::WrongSize, writer.append(record_for(0, 0), payload, 4));
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, writer.append(record_for(0, 0), payload, 8));
+    TEST_ASSERT_EQUAL(CaptureStatus::Truncated, reader.open(path.c_str()));
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, writer.finish());
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, reader.open(path.c_str()));
+    TEST_ASSERT_EQUAL(0, truncate(path.c_str(), static_cast<off_t>(reader.header().index_offset)));
+    TEST_ASSERT_EQUAL(CaptureStatus::Truncated, reader.open(path.c_str()));
+}
+
+void test_serial_stream_is_converted() {
+    std::vector<uint8_t> stream;
+    const char log_line[] = "I: Setup complete\r\n";
+    stream.insert(stream.end(), log_line, log_line + sizeof(log_line) - 1);
+    uint16_t frame_words[242] = {};
+    append_serial(stream, SerialPayload::FrameWords, 0, frame_words, sizeof(frame_words)); // before the EEPROM
+    uint16_t eeprom[832] = {};
+    eeprom[7] = 0x101C;
+    append_serial(stream, SerialPayload::EepromWords, 0, eeprom, sizeof(eeprom));
+    for (uint32_t n = 1; n <= 5; n++) {
+        frame_words[0] = static_cast<uint16_t>(n);
+        append_serial(stream, SerialPayload::FrameWords, n, frame_words, sizeof(frame_words));
+        const std::vector<float> temps = temperatures_for(n);
+        append_serial(stream, SerialPayload::Temperatures, n, temps.data(), pixels * sizeof(float));
+    }
+    stream.resize(stream.size() - 10); // cut mid-record by the end of the capture
+
+    CaptureConversion conversion;
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, convert(stream, conversion));
+    TEST_ASSERT_EQUAL(5, conversion.frames);
+    TEST_ASSERT_EQUAL(1 + 4, conversion.skipped_records);
+
+    CaptureReader reader;
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, reader.open(path.c_str()));
+    TEST_ASSERT_EQUAL(static_cast<uint8_t>(SerialPayload::FrameWords), reader.header().payload);
+    TEST_ASSERT_EQUAL(832, reader.calibration_words());
+    TEST_ASSERT_EQUAL_HEX16(0x101C, reader.header().sensor_id[0]);
+    TEST_ASSERT_EQUAL(3, reader.frame(2).record->sequence);
+    uint16_t first_word;
+    std::memcpy(&first_word, reader.frame(4).payload, sizeof(first_word));
+    TEST_ASSERT_EQUAL(5, first_word);
+    TEST_ASSERT_EQUAL(2, reader.find_time(1000 + 3 * 31250u));
+
+    CaptureConversion nothing;
+    const std::vector<uint8_t> text(log_line, log_line + sizeof(log_line));
+    TEST_ASSERT_EQUAL(CaptureStatus::NoFrames, convert(text, nothing));
+}
+
+// Not a pass/fail on timing: prints the open time and scan rate of a 20-minute session (open
+// and lookups do not depend on the length).
+void test_long_session_opens_without_parsing() {
+    constexpr uint32_t frames = 20 * 60 * 32;
+    write_capture(frames, 0);
+    CaptureReader reader;
+    const auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL(CaptureStatus::Success, reader.open(path.c_str()));
+    const auto opened = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL(frames / 2, reader.find_time(static_cast<uint64_t>(frames / 2) * 31250u));
+    const auto found = std::chrono::steady_clock::now();
+    float sum = 0;
+    for (uint64_t n = 0; n < reader.frame_count(); n++) {
+        const float* temps = reinterpret_cast<const float*>(reader.frame(n).payload);
+        for (std::size_t pixel = 0; pixel < pixels; pixel++) {
+            sum += temps[pixel];
+        }
+    }
+    const auto scanned = std::chrono::steady_clock::now();
+    const std::chrono::duration<double, std::micro> open_us = opened - start;
+    const std::chrono::duration<double, std::micro> find_us = found - opened;
+    const std::chrono::duration<double> scan_s = scanned - found;
+    printf("%u frames (%.0f MB): open %.0f us, time lookup %.1f us, scan %.0f MB/s\n", frames,
+           frames * (sizeof(CaptureRecordHeader) + pixels * sizeof(float)) / 1e6, open_us.count(), find_us.count(),
+           frames * pixels * sizeof(float) / 1e6 / scan_s.count());
+    TEST_ASSERT_TRUE(sum > 0);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_frames_are_read_back_at_random);
+    RUN_TEST(test_time_lookup_survives_the_clock_wrap);
+    RUN_TEST(test_invalid_files_are_rejected);
+    RUN_TEST(test_serial_stream_is_converted);
+    RUN_TEST(test_long_session_opens_without_parsing);
+    return UNITY_END();
+}
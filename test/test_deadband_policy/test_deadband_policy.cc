@@ -0,0 +1,84 @@
+#include <unity.h>
+#include <array>
+#include "deadband_policy.hh"
+
+constexpr int16_t deadband = 2;
+constexpr uint32_t max_silence_ms = 1000;
+
+DeadbandPolicy* policy = nullptr;
+std::array<int16_t, 8> values;
+
+void setUp(void) {
+    policy = new DeadbandPolicy(deadband, max_silence_ms);
+    values.fill(250);
+}
+
+void tearDown(void) {
+    delete policy;
+    policy = nullptr;
+}
+
+void test_first_update_is_sent() {
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 0));
+    TEST_ASSERT_EQUAL(1, policy->sent_count());
+    TEST_ASSERT_EQUAL(0, policy->suppressed_count());
+}
+
+void test_changes_within_deadband_are_suppressed() {
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 0));
+    values[3] = 250 + deadband;
+    TEST_ASSERT_FALSE(policy->should_send(0, values.size(), values.data(), 100));
+    values[3] = 250 - deadband;
+    TEST_ASSERT_FALSE(policy->should_send(0, values.size(), values.data(), 200));
+    TEST_ASSERT_EQUAL(2, policy->suppressed_count());
+}
+
+void test_change_beyond_deadband_is_sent() {
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 0));
+    values[7] = 250 + deadband + 1;
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 100));
+    // The new value becomes the reference: drifting back within the band stays quiet.
+    values[7] = 250 + deadband;
+    TEST_ASSERT_FALSE(policy->should_send(0, values.size(), values.data(), 200));
+}
+
+void test_heartbeat_after_max_silence() {
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 0));
+    TEST_ASSERT_FALSE(policy->should_send(0, values.size(), values.data(), max_silence_ms - 1));
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), max_silence_ms));
+}
+
+void test_heartbeat_across_millis_wraparound() {
+    const uint32_t start = 0xFFFFFF00u;
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), start));
+    TEST_ASSERT_FALSE(policy->should_send(0, values.size(), values.data(), start + 500));
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), start + max_silence_ms));
+}
+
+void test_groups_are_tracked_per_zone() {
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 0));
+    TEST_ASSERT_TRUE(policy->should_send(8, values.size(), values.data(), 0));
+    values[0] = 300;
+    // Zones 8..15 never saw the change, zones 0..7 did.
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 10));
+    values[0] = 250;
+    TEST_ASSERT_FALSE(policy->should_send(8, values.size(), values.data(), 10));
+}
+
+void test_reset_forces_resend() {
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 0));
+    policy->reset();
+    TEST_ASSERT_TRUE(policy->should_send(0, values.size(), values.data(), 10));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_update_is_sent);
+    RUN_TEST(test_changes_within_deadband_are_suppressed);
+    RUN_TEST(test_change_beyond_deadband_is_sent);
+    RUN_TEST(test_heartbeat_after_max_silence);
+    RUN_TEST(test_heartbeat_across_millis_wraparound);
+    RUN_TEST(test_groups_are_tracked_per_zone);
+    RUN_TEST(test_reset_forces_resend);
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+#include <unity.h>
+#include <cstring>
+#include <string>
+#include "deferred_logger.hh"
+#include "log_record.hh"
+
+class FixedClock : public IClock {
+public:
+    uint32_t now_us() override { return now; }
+    void sleep_until_us(uint32_t wake_us) override { now = wake_us; }
+    uint32_t now = 0;
+};
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_message_id_matches_string_table_generator() {
+    // Same FNV-1a value as scripts/logging/generate_log_strings.py emits for this string
+    TEST_ASSERT_EQUAL_HEX32(0x1C953342u, log_message_id("Starting setup..."));
+    TEST_ASSERT_EQUAL_HEX32(0x1C953342u, LOG_MESSAGE_ID("Starting setup..."));
+}
+
+void test_record_round_trip() {
+    LogRecord record = {0xDEADBEEFu, 123456u, 3, 2, {0xFFFFFFF9u, 42u}};
+    uint8_t buffer[log_record_max_size];
+    size_t size = encode_log_record(record, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(log_record_header_size + 8 + 1, size);
+
+    LogRecord decoded;
+    size_t consumed = 0;
+    TEST_ASSERT_TRUE(decode_log_record(buffer, size - 1, decoded, consumed) == LogDecodeStatus::NeedMoreData);
+    TEST_ASSERT_TRUE(decode_log_record(buffer, size, decoded, consumed) == LogDecodeStatus::Success);
+    TEST_ASSERT_EQUAL(size, consumed);
+    TEST_ASSERT_EQUAL_HEX32(record.message_id, decoded.message_id);
+    TEST_ASSERT_EQUAL(record.timestamp_us, decoded.timestamp_us);
+    TEST_ASSERT_EQUAL(3, decoded.level);
+    TEST_ASSERT_EQUAL(2, decoded.arg_count);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFF9u, decoded.args[0]);
+    TEST_ASSERT_EQUAL(42u, decoded.args[1]);
+}
+
+void test_corrupted_record_is_skipped() {
+    LogRecord record = {1u, 2u, 1, 0, {}};
+    uint8_t buffer[log_record_max_size];
+    size_t size = encode_log_record(record, buffer, sizeof(buffer));
+    buffer[4] ^= 0x10;
+
+    LogRecord decoded;
+    size_t consumed = 0;
+    TEST_ASSERT_TRUE(decode_log_record(buffer, size, decoded, consumed) == LogDecodeStatus::BadChecksum);
+    TEST_ASSERT_EQUAL(1, consumed);
+    TEST_ASSERT_TRUE(decode_log_record(buffer + 1, size - 1, decoded, consumed) == LogDecodeStatus::BadSync);
+    TEST_ASSERT_EQUAL(1, consumed);
+}
+
+void test_format_with_raw_words() {
+    float value = 36.625f;
+    uint32_t value_bits;
+    std::memcpy(&value_bits, &value, sizeof(value_bits));
+    const uint32_t args[] = {static_cast<uint32_t>(-12), value_bits, 0xBEEFu, 0u};
+    char out[96];
+    format_log_record("a=%d t=%.2f reg=0x%04X name=%s %%", args, 4, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("a=-12 t=36.62 reg=0xBEEF name=<str> %", out);
+
+    format_log_record("missing %d", args, 0, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("missing ?", out);
+}
+
+void test_macros_store_records_without_formatting() {
+    FixedClock clock;
+    clock.now = 5000;
+    DeferredLogger logger(clock, Logger::Level::INFO);
+    LOG_INFO(&logger, "frame %d took %.1f ms", 7, 12.5f);
+    LOG_DEBUG(&logger, "filtered %d", 1);
+
+    uint8_t buffer[2 * log_record_max_size];
+    size_t size = logger.drain(buffer, sizeof(buffer));
+    LogRecord decoded;
+    size_t consumed = 0;
+    TEST_ASSERT_TRUE(decode_log_record(buffer, size, decoded, consumed) == LogDecodeStatus::Success);
+    TEST_ASSERT_EQUAL(size, consumed);
+    TEST_ASSERT_EQUAL_HEX32(LOG_MESSAGE_ID("frame %d took %.1f ms"), decoded.message_id);
+    TEST_ASSERT_EQUAL(5000u, decoded.timestamp_us);
+    TEST_ASSERT_EQUAL(static_cast<int>(Logger::Level::INFO), decoded.level);
+
+    char text[64];
+    format_log_record("frame %d took %.1f ms", decoded.args, decoded.arg_count, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("frame 7 took 12.5 ms", text);
+}
+
+void test_full_ring_drops_and_counts_overruns() {
+    FixedClock clock;
+    DeferredLogger logger(clock, Logger::Level::INFO);
+    for (int i = 0; i < static_cast<int>(DeferredLogger::capacity) + 5; i++) {
+        LOG_INFO(&logger, "record %d", i);
+    }
+    TEST_ASSERT_EQUAL(5u, logger.overruns());
+
+    // Partial drains only emit whole records, in order
+    uint8_t buffer[log_record_max_size + 3];
+    size_t total = 0;
+    size_t size;
+    while ((size = logger.drain(buffer, sizeof(buffer))) > 0) {
+        size_t offset = 0;
+        while (offset < size) {
+            LogRecord decoded;
+            size_t consumed = 0;
+            TEST_ASSERT_TRUE(decode_log_record(buffer + offset, size - offset, decoded, consumed) ==
+                             LogDecodeStatus::Success);
+            TEST_ASSERT_EQUAL(total, decoded.args[0]);
+            offset += consumed;
+            total++;
+        }
+    }
+    TEST_ASSERT_EQUAL(DeferredLogger::capacity, total);
+
+    // Space is reclaimed after draining
+    LOG_INFO(&logger, "record %d", 99);
+    TEST_ASSERT_TRUE(logger.drain(buffer, sizeof(buffer)) > 0);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_message_id_matches_string_table_generator);
+    RUN_TEST(test_record_round_trip);
+    RUN_TEST(test_corrupted_record_is_skipped);
+    RUN_TEST(test_format_with_raw_words);
+    RUN_TEST(test_macros_store_records_without_formatting);
+    RUN_TEST(test_full_ring_drops_and_counts_overruns);
+    return UNITY_END();
+}
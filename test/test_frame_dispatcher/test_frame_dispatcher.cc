@@ -0,0 +1,230 @@
+#include <unity.h>
+#include <vector>
+#include "frame_dispatcher.hh"
+#include "sink_queue.hh"
+#include "virtual_clock.hh"
+
+namespace {
+
+// Remembers what it was shown; each call costs `cost_us` on the clock.
+class FakeSink : public IFrameSink {
+public:
+    FakeSink(VirtualClock& clock, SinkResult result = SinkResult::Sent, uint32_t cost_us = 0)
+        : result(result), cost_us(cost_us), clock_(clock) {}
+
+    SinkResult consume(const FrameView& frame) override
+    {
+        clock_.advance(cost_us);
+        sequences.push_back(frame.header->sequence);
+        pixels.push_back(frame.pixels);
+        means.push_back(frame.zone_means);
+        return result;
+    }
+
+    SinkResult result;
+    uint32_t cost_us;
+    std::vector<uint32_t> sequences;
+    std::vector<const float*> pixels;
+    std::vector<const int16_t*> means;
+
+private:
+    VirtualClock& clock_;
+};
+
+// Queues the sequence and a copy of the first pixel, sends one element per service() call.
+class QueuedSink : public IFrameSink {
+public:
+    struct Record {
+        uint32_t sequence;
+        float first_pixel;
+    };
+
+    SinkResult consume(const FrameView& frame) override
+    {
+        if (queue.free_slots() == 0) {
+            return SinkResult::Dropped;
+        }
+        Record& record = queue.slot();
+        record.sequence = frame.header->sequence;
+        record.first_pixel = frame.pixels[0];
+        queue.push();
+        return SinkResult::Sent;
+    }
+
+    bool service() override
+    {
+        const Record* record = queue.front();
+        if (!record) {
+            return false;
+        }
+        sent.push_back(*record);
+        queue.pop();
+        return true;
+    }
+
+    SinkQueue<Record, 2> queue;
+    std::vector<Record> sent;
+};
+
+struct Frame {
+    mlx90641::FrameHeader header = {};
+    float pixels[12 * 16] = {};
+    int16_t zones[16] = {};
+
+    FrameView view(uint32_t sequence, bool temperatures = true)
+    {
+        header.sequence = sequence;
+        FrameView frame = {&header, pixels, 12, 16, temperatures ? frame_content_temperatures : frame_content_image,
+                           nullptr, nullptr, nullptr, nullptr, 0};
+        if (temperatures) {
+            frame.zone_means = frame.zone_mins = frame.zone_maxs = frame.zone_percentiles = zones;
+            frame.zone_count = 16;
+        }
+        return frame;
+    }
+};
+
+constexpr SinkPolicy every_frame = {frame_content_temperatures | frame_content_image, false, 1, 0};
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_every_sink_sees_the_same_buffers() {
+    VirtualClock clock;
+    FrameDispatcher dispatcher(&clock);
+    FakeSink serial(clock);
+    FakeSink ble(clock);
+    uint8_t index;
+    TEST_ASSERT_EQUAL(DispatchStatus::Success, dispatcher.add_sink(serial, every_frame, index));
+    TEST_ASSERT_EQUAL(0, index);
+    TEST_ASSERT_EQUAL(DispatchStatus::Success, dispatcher.add_sink(ble, every_frame, index));
+    TEST_ASSERT_EQUAL(1, index);
+    Frame frame;
+    dispatcher.publish(frame.view(7));
+    TEST_ASSERT_EQUAL(1, serial.sequences.size());
+    TEST_ASSERT_EQUAL_PTR(frame.pixels, serial.pixels[0]);
+    TEST_ASSERT_EQUAL_PTR(frame.pixels, ble.pixels[0]);
+    TEST_ASSERT_EQUAL_PTR(frame.zones, ble.means[0]);
+    TEST_ASSERT_EQUAL(1, dispatcher.stats(1).sent);
+}
+
+void test_policies_select_content_and_rate() {
+    VirtualClock clock;
+    FrameDispatcher dispatcher(&clock);
+    FakeSink serial(clock);
+    FakeSink zones(clock);
+    FakeSink recorder(clock);
+    uint8_t index;
+    dispatcher.add_sink(serial, every_frame, index);
+    dispatcher.add_sink(zones, {frame_content_temperatures, true, 1, 0}, index);
+    dispatcher.add_sink(recorder, {frame_content_temperatures, true, 4, 0}, index);
+    Frame frame;
+    for (uint32_t n = 0; n < 16; n++) {
+        dispatcher.publish(frame.view(n, n % 2 == 0)); // every other frame is an image
+    }
+    TEST_ASSERT_EQUAL(16, serial.sequences.size());
+    TEST_ASSERT_EQUAL(8, zones.sequences.size());
+    const std::vector<uint32_t> recorded = {0, 8};
+    TEST_ASSERT_TRUE(recorded == recorder.sequences); // every 4th temperature frame
+    for (const int16_t* means : zones.means) {
+        TEST_ASSERT_NOT_NULL(means);
+    }
+}
+
+void test_slow_sink_is_suspended_for_its_overrun() {
+    VirtualClock clock;
+    FrameDispatcher dispatcher(&clock);
+    FakeSink serial(clock, SinkResult::Sent, 1000);
+    FakeSink ble(clock, SinkResult::Sent, 30000); // 3 × its budget
+    uint8_t serial_index;
+    uint8_t ble_index;
+    dispatcher.add_sink(serial, every_frame, serial_index);
+    dispatcher.add_sink(ble, {frame_content_temperatures, true, 1, 10000}, ble_index);
+    Frame frame;
+    constexpr uint32_t frame_period_us = 31250;
+    for (uint32_t n = 0; n < 30; n++) {
+        dispatcher.publish(frame.view(n));
+        clock.sleep_until_us((n + 1) * frame_period_us);
+    }
+    TEST_ASSERT_EQUAL(30, serial.sequences.size());
+    const SinkStats& stats = dispatcher.stats(ble_index);
+    TEST_ASSERT_EQUAL(30, stats.sent + stats.dropped);
+    TEST_ASSERT_EQUAL(stats.sent, stats.overruns);
+    TEST_ASSERT_EQUAL(30000, stats.max_us);
+    // The 20 ms excess covers the next frame: every other frame gets through.
+    TEST_ASSERT_EQUAL(15, stats.sent);
+    TEST_ASSERT_EQUAL(0, dispatcher.stats(serial_index).dropped);
+}
+
+void test_sink_results_are_counted() {
+    VirtualClock clock;
+    FrameDispatcher dispatcher(&clock);
+    FakeSink busy(clock, SinkResult::Dropped);
+    FakeSink idle(clock, SinkResult::Skipped);
+    uint8_t index;
+    dispatcher.add_sink(busy, every_frame, index);
+    dispatcher.add_sink(idle, every_frame, index);
+    Frame frame;
+    dispatcher.publish(frame.view(0));
+    dispatcher.publish(frame.view(1));
+    TEST_ASSERT_EQUAL(2, dispatcher.stats(0).dropped);
+    TEST_ASSERT_EQUAL(2, dispatcher.stats(1).skipped);
+    TEST_ASSERT_EQUAL(0, dispatcher.stats(1).sent);
+}
+
+void test_sink_table_is_bounded() {
+    VirtualClock clock;
+    FrameDispatcher dispatcher;
+    FakeSink sink(clock);
+    uint8_t index;
+    for (std::size_t i = 0; i < FrameDispatcher::max_sinks; i++) {
+        TEST_ASSERT_EQUAL(DispatchStatus::Success, dispatcher.add_sink(sink, every_frame, index));
+    }
+    TEST_ASSERT_EQUAL(DispatchStatus::TooManySinks, dispatcher.add_sink(sink, every_frame, index));
+    TEST_ASSERT_EQUAL(FrameDispatcher::max_sinks, dispatcher.sink_count());
+}
+
+void test_queued_sink_drops_when_full_and_drains_later() {
+    VirtualClock clock;
+    FrameDispatcher dispatcher(&clock);
+    QueuedSink queued;
+    FakeSink other(clock);
+    uint8_t index;
+    TEST_ASSERT_EQUAL(DispatchStatus::Success, dispatcher.add_sink(queued, every_frame, index));
+    TEST_ASSERT_EQUAL(DispatchStatus::Success, dispatcher.add_sink(other, every_frame, index));
+    Frame frame;
+    for (uint32_t sequence = 1; sequence <= 3; sequence++) {
+        frame.pixels[0] = static_cast<float>(sequence);
+        dispatcher.publish(frame.view(sequence));
+    }
+    frame.pixels[0] = -1.0f; // the queue holds copies, not the driver's buffer
+    TEST_ASSERT_EQUAL(2, dispatcher.stats(0).sent);
+    TEST_ASSERT_EQUAL(1, dispatcher.stats(0).dropped);
+    TEST_ASSERT_EQUAL(3, other.sequences.size()); // not held back by the full queue
+
+    TEST_ASSERT_TRUE(dispatcher.service());
+    TEST_ASSERT_TRUE(dispatcher.service());
+    TEST_ASSERT_FALSE(dispatcher.service());
+    TEST_ASSERT_EQUAL(2, queued.sent.size());
+    TEST_ASSERT_EQUAL(1, queued.sent[0].sequence);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, queued.sent[1].first_pixel);
+
+    dispatcher.publish(frame.view(4));
+    TEST_ASSERT_TRUE(dispatcher.service());
+    TEST_ASSERT_EQUAL(4, queued.sent[2].sequence);
+    TEST_ASSERT_EQUAL(1, dispatcher.stats(0).dropped);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_sink_sees_the_same_buffers);
+    RUN_TEST(test_policies_select_content_and_rate);
+    RUN_TEST(test_slow_sink_is_suspended_for_its_overrun);
+    RUN_TEST(test_sink_results_are_counted);
+    RUN_TEST(test_sink_table_is_bounded);
+    RUN_TEST(test_queued_sink_drops_when_full_and_drains_later);
+    return UNITY_END();
+}
@@ -0,0 +1,82 @@
+#include <unity.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Compile DEBUG statements out of this translation unit
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#include "logger.hh"
+
+class CapturingLogger : public Logger {
+public:
+    CapturingLogger(Level level) : Logger(level) {}
+    void log(Level level, const char* message) override {
+        levels.push_back(level);
+        messages.push_back(message);
+    }
+    std::vector<Level> levels;
+    std::vector<std::string> messages;
+};
+
+int evaluations = 0;
+
+int counted(int value) {
+    evaluations++;
+    return value;
+}
+
+void setUp(void) {
+    evaluations = 0;
+}
+
+void tearDown(void) {}
+
+void test_enabled_levels_are_formatted() {
+    CapturingLogger logger(Logger::Level::INFO);
+    LOG_INFO(&logger, "value %d, %c", 42, 'k');
+    LOG_ERROR(&logger, "error %d", -7);
+    TEST_ASSERT_EQUAL(2, logger.messages.size());
+    TEST_ASSERT_TRUE(logger.messages[0] == "value 42, k");
+    TEST_ASSERT_TRUE(logger.levels[1] == Logger::Level::ERROR);
+}
+
+void test_compiled_out_level_does_not_evaluate_arguments() {
+    CapturingLogger logger(Logger::Level::DEBUG);
+    LOG_DEBUG(&logger, "never %d", counted(1));
+    TEST_ASSERT_EQUAL(0, evaluations);
+    TEST_ASSERT_EQUAL(0, logger.messages.size());
+}
+
+void test_runtime_filter_runs_before_formatting() {
+    CapturingLogger logger(Logger::Level::ERROR);
+    LOG_WARN(&logger, "filtered %d", 1);
+    TEST_ASSERT_EQUAL(0, logger.messages.size());
+    logger.set_level(Logger::Level::WARN);
+    TEST_ASSERT_TRUE(logger.enabled(Logger::Level::WARN));
+    TEST_ASSERT_FALSE(logger.enabled(Logger::Level::INFO));
+    logger.logf(Logger::Level::WARN, "kept %d", 2);
+    TEST_ASSERT_TRUE(logger.messages[0] == "kept 2");
+}
+
+void test_null_logger_is_ignored() {
+    Logger* logger = nullptr;
+    LOG_ERROR(logger, "dropped %d", 3);
+    TEST_ASSERT_TRUE(true);
+}
+
+void test_long_messages_are_truncated() {
+    CapturingLogger logger(Logger::Level::INFO);
+    std::string long_text(Logger::max_message_length * 2, 'x');
+    logger.logf(Logger::Level::INFO, "%s", long_text.c_str()); // LOG_INFO takes numbers only
+    TEST_ASSERT_EQUAL(Logger::max_message_length - 1, logger.messages[0].size());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_enabled_levels_are_formatted);
+    RUN_TEST(test_compiled_out_level_does_not_evaluate_arguments);
+    RUN_TEST(test_runtime_filter_runs_before_formatting);
+    RUN_TEST(test_null_logger_is_ignored);
+    RUN_TEST(test_long_messages_are_truncated);
+    return UNITY_END();
+}
@@ -0,0 +1,64 @@
+#include <unity.h>
+#include <string>
+#include "queued_logger.hh"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_lines_are_formatted_when_logged() {
+    QueuedLogger logger(Logger::Level::INFO);
+    LOG_INFO(&logger, "frame %d took %.1f ms", 7, 12.5f);
+    LOG_DEBUG(&logger, "filtered %d", 1);
+    logger.log(Logger::Level::ERROR, "bus stuck");
+
+    uint8_t buffer[2 * QueuedLogger::max_line];
+    const size_t size = logger.drain(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("INFO: frame 7 took 12.5 ms\r\nERROR: bus stuck\r\n",
+                             std::string(reinterpret_cast<char*>(buffer), size).c_str());
+    TEST_ASSERT_EQUAL(0, logger.drain(buffer, sizeof(buffer)));
+}
+
+void test_long_message_keeps_its_line_ending() {
+    QueuedLogger logger(Logger::Level::INFO);
+    const std::string message(300, 'x');
+    logger.log(Logger::Level::ERROR, message.c_str());
+
+    uint8_t buffer[QueuedLogger::max_line];
+    const size_t size = logger.drain(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(QueuedLogger::max_line - 1, size);
+    TEST_ASSERT_EQUAL('\r', buffer[size - 2]);
+    TEST_ASSERT_EQUAL('\n', buffer[size - 1]);
+}
+
+void test_full_ring_drops_and_counts_overruns() {
+    QueuedLogger logger(Logger::Level::INFO);
+    for (int i = 0; i < static_cast<int>(QueuedLogger::capacity) + 3; i++) {
+        LOG_INFO(&logger, "line %d", i);
+    }
+    TEST_ASSERT_EQUAL(3u, logger.overruns());
+
+    // Partial drains only emit whole lines, in order
+    uint8_t buffer[16];
+    std::string text;
+    size_t size;
+    while ((size = logger.drain(buffer, sizeof(buffer))) > 0) {
+        TEST_ASSERT_EQUAL('\n', buffer[size - 1]);
+        text.append(reinterpret_cast<char*>(buffer), size);
+    }
+    TEST_ASSERT_EQUAL_STRING("INFO: line 0\r\nINFO: line 1\r\nINFO: line 2\r\nINFO: line 3\r\n"
+                             "INFO: line 4\r\nINFO: line 5\r\nINFO: line 6\r\nINFO: line 7\r\n",
+                             text.c_str());
+
+    // Space is reclaimed after draining
+    LOG_INFO(&logger, "line %d", 99);
+    TEST_ASSERT_EQUAL(15, logger.drain(buffer, sizeof(buffer)));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_lines_are_formatted_when_logged);
+    RUN_TEST(test_long_message_keeps_its_line_ending);
+    RUN_TEST(test_full_ring_drops_and_counts_overruns);
+    return UNITY_END();
+}
@@ -0,0 +1,212 @@
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "file_flash.hh"
+#include "session_recorder.hh"
+#include "virtual_clock.hh"
+
+namespace {
+
+constexpr uint32_t page_size = 4096;
+constexpr uint32_t page_count = 4;
+constexpr std::size_t zones = 16;
+
+std::string path;
+
+// Slowly warming columns, like a tire settling in.
+std::vector<int16_t> zones_for(uint32_t n)
+{
+    std::vector<int16_t> values(zones);
+    for (std::size_t zone = 0; zone < zones; zone++) {
+        values[zone] = static_cast<int16_t>(250 + n / 4 + zone * 3 + (n + zone) % 3);
+    }
+    return values;
+}
+
+bool record(SessionRecorder& recorder, uint32_t n)
+{
+    const std::vector<int16_t> values = zones_for(n);
+    return recorder.record(n, 1000 + n * 62500u, 24.5f + n / 1000.0f, values.data(), values.size());
+}
+
+void record_frames(SessionRecorder& recorder, uint32_t first, uint32_t count)
+{
+    for (uint32_t n = first; n < first + count; n++) {
+        TEST_ASSERT_TRUE(record(recorder, n));
+        recorder.service();
+    }
+}
+
+void check_frame(const RecordedFrame& frame, uint32_t n)
+{
+    TEST_ASSERT_EQUAL(n, frame.sequence);
+    TEST_ASSERT_EQUAL(1000 + n * 62500u, frame.timestamp_us);
+    TEST_ASSERT_EQUAL(static_cast<int16_t>(lroundf((24.5f + n / 1000.0f) * 100.0f)), frame.ta);
+    TEST_ASSERT_EQUAL(zones, frame.zone_count);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(zones_for(n).data(), frame.zones.data(), zones);
+}
+
+} // namespace
+
+void setUp(void) {
+    char name[] = "/tmp/flash_XXXXXX";
+    const int fd = mkstemp(name);
+    close(fd);
+    std::remove(name); // FileFlash creates it erased
+    path = name;
+}
+
+void tearDown(void) {
+    std::remove(path.c_str());
+}
+
+void test_frames_read_back_in_order() {
+    FileFlash flash(path, page_size, page_count);
+    SessionRecorder recorder(flash);
+    TEST_ASSERT_EQUAL(RecorderStatus::Success, recorder.mount());
+    record_frames(recorder, 0, 300);
+    recorder.request_flush();
+    recorder.service();
+
+    RecordingReader reader(flash);
+    RecordedFrame frame;
+    for (uint32_t n = 0; n < 300; n++) {
+        TEST_ASSERT_TRUE(reader.next(frame));
+        check_frame(frame, n);
+    }
+    TEST_ASSERT_FALSE(reader.next(frame));
+    TEST_ASSERT_EQUAL(0, flash.misuse);
+}
+
+void test_delta_coding_compresses_slow_changes() {
+    FileFlash flash(path, page_size, page_count);
+    SessionRecorder recorder(flash);
+    recorder.mount();
+    record_frames(recorder, 0, 300);
+    recorder.request_flush();
+    recorder.service();
+    const RecorderStats stats = recorder.stats();
+    const std::size_t raw_bytes = 300 * (4 + 4 + 2 + 1 + 2 * zones);
+    printf("%u bytes for %u frames (%.1f per frame, raw %u)\n", (unsigned)stats.bytes_written, (unsigned)stats.records,
+           stats.bytes_written / 300.0, (unsigned)(raw_bytes / 300));
+    TEST_ASSERT_LESS_THAN(raw_bytes * 3 / 5, stats.bytes_written);
+    // Writes go out in whole batches, not per frame.
+    TEST_ASSERT_LESS_OR_EQUAL(stats.bytes_written / SessionRecorder::batch_bytes + 1 + 2, flash.writes - 1);
+}
+
+void test_recording_never_touches_flash() {
+    VirtualClock clock;
+    FileFlash flash(path, page_size, page_count, &clock);
+    SessionRecorder recorder(flash, &clock);
+    recorder.mount();
+    const uint32_t writes = flash.writes;
+    for (uint32_t n = 0; n < SessionRecorder::queue_capacity; n++) {
+        TEST_ASSERT_TRUE(record(recorder, n));
+    }
+    TEST_ASSERT_FALSE(record(recorder, 99)); // queue full: dropped, not waited for
+    TEST_ASSERT_EQUAL(1, recorder.stats().dropped);
+    TEST_ASSERT_EQUAL(writes, flash.writes);
+    TEST_ASSERT_EQUAL(0, clock.now_us());
+
+    TEST_ASSERT_TRUE(recorder.service()); // the flash work happens here
+    TEST_ASSERT_EQUAL(SessionRecorder::queue_capacity, recorder.stats().records);
+    TEST_ASSERT_EQUAL(FileFlash::erase_us + 2 * FileFlash::write_us_per_word, recorder.stats().busy_us);
+    TEST_ASSERT_TRUE(record(recorder, 8));
+}
+
+void test_reboot_resumes_after_the_last_record() {
+    {
+        FileFlash flash(path, page_size, page_count);
+        SessionRecorder recorder(flash);
+        recorder.mount();
+        record_frames(recorder, 0, 80);
+        recorder.request_flush();
+        recorder.service();
+        record_frames(recorder, 80, 3); // still in RAM at the "power loss"
+    }
+    FileFlash flash(path, page_size, page_count);
+    SessionRecorder recorder(flash);
+    TEST_ASSERT_EQUAL(RecorderStatus::Success, recorder.mount());
+    record_frames(recorder, 200, 80);
+    recorder.request_flush();
+    recorder.service();
+    TEST_ASSERT_EQUAL(0, flash.misuse);
+    TEST_ASSERT_EQUAL(0, flash.erase_counts[1]); // continued in page 0
+
+    RecordingReader reader(flash);
+    RecordedFrame frame;
+    for (uint32_t n = 0; n < 80; n++) {
+        TEST_ASSERT_TRUE(reader.next(frame));
+        check_frame(frame, n);
+    }
+    for (uint32_t n = 200; n < 280; n++) {
+        TEST_ASSERT_TRUE(reader.next(frame));
+        check_frame(frame, n);
+    }
+    TEST_ASSERT_FALSE(reader.next(frame));
+}
+
+void test_full_region_reuses_the_oldest_page_evenly() {
+    FileFlash flash(path, page_size, page_count);
+    SessionRecorder recorder(flash);
+    recorder.mount();
+    const uint32_t empty = recorder.remaining_bytes();
+    TEST_ASSERT_EQUAL(page_count * (page_size - SessionRecorder::page_header_bytes), empty);
+    record_frames(recorder, 0, 100);
+    TEST_ASSERT_LESS_THAN(empty, recorder.remaining_bytes());
+
+    constexpr uint32_t frames = 5000; // several passes over the region
+    record_frames(recorder, 100, frames - 100);
+    recorder.request_flush();
+    recorder.service();
+    TEST_ASSERT_GREATER_THAN(0, recorder.stats().pages_overwritten);
+    TEST_ASSERT_EQUAL(0, flash.misuse);
+    uint32_t least = flash.erase_counts[0];
+    uint32_t most = flash.erase_counts[0];
+    for (uint32_t count : flash.erase_counts) {
+        least = count < least ? count : least;
+        most = count > most ? count : most;
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(1, most - least);
+
+    // The newest frames survive, contiguous up to the last one.
+    RecordingReader reader(flash);
+    RecordedFrame frame;
+    TEST_ASSERT_TRUE(reader.next(frame));
+    uint32_t expected = frame.sequence;
+    check_frame(frame, expected);
+    while (reader.next(frame)) {
+        check_frame(frame, ++expected);
+    }
+    TEST_ASSERT_EQUAL(frames - 1, expected);
+}
+
+void test_flash_errors_are_counted_and_recovered() {
+    FileFlash flash(path, page_size, page_count);
+    SessionRecorder recorder(flash);
+    recorder.mount();
+    flash.fail_erases = true;
+    record_frames(recorder, 0, 5);
+    TEST_ASSERT_EQUAL(5, recorder.stats().flash_errors);
+    flash.fail_erases = false;
+    record_frames(recorder, 5, 5);
+    recorder.request_flush();
+    recorder.service();
+    RecordingReader reader(flash);
+    RecordedFrame frame;
+    TEST_ASSERT_TRUE(reader.next(frame));
+    check_frame(frame, 5);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_frames_read_back_in_order);
+    RUN_TEST(test_delta_coding_compresses_slow_changes);
+    RUN_TEST(test_recording_never_touches_flash);
+    RUN_TEST(test_reboot_resumes_after_the_last_record);
+    RUN_TEST(test_full_region_reuses_the_oldest_page_evenly);
+    RUN_TEST(test_flash_errors_are_counted_and_recovered);
+    return UNITY_END();
+}
@@ -0,0 +1,188 @@
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "session_stats.hh"
+#include "session_stats_control.hh"
+
+constexpr float float_epsilon = 0.001f;
+
+// Keeps what was sent, refuses everything once `capacity` messages are queued.
+class RecordingLink : public IBulkLink {
+public:
+    RecordingLink(std::size_t max_message, std::size_t capacity) : capacity_(capacity), max_message_(max_message) {}
+    std::size_t max_message() const override { return max_message_; }
+    bool send(const uint8_t* data, std::size_t size) override
+    {
+        if (messages.size() >= capacity_) {
+            return false;
+        }
+        messages.push_back(std::vector<uint8_t>(data, data + size));
+        return true;
+    }
+
+    std::vector<std::vector<uint8_t>> messages;
+    std::size_t capacity_;
+
+private:
+    std::size_t max_message_;
+};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_running_stat_matches_two_pass() {
+    const std::array<float, 8> samples = {{25.0f, 27.5f, 31.0f, 29.25f, 80.0f, 79.5f, 24.0f, 26.0f}};
+    RunningStat stat;
+    stat.reset();
+    double sum = 0.0;
+    for (float sample : samples) {
+        stat.add(sample);
+        sum += sample;
+    }
+    const double mean = sum / samples.size();
+    double squares = 0.0;
+    for (float sample : samples) {
+        squares += (sample - mean) * (sample - mean);
+    }
+    TEST_ASSERT_EQUAL(samples.size(), stat.count);
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, mean, stat.mean);
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, squares / (samples.size() - 1), stat.variance());
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, 24.0f, stat.min);
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, 80.0f, stat.max);
+}
+
+void test_running_stat_stable_with_large_offset() {
+    // A naive sum of squares in float loses the variance completely at this offset.
+    RunningStat stat;
+    stat.reset();
+    for (int i = 0; i < 10000; ++i) {
+        stat.add(i % 2 == 0 ? 1000.5f : 999.5f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, 1000.0f, stat.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.25f, stat.variance());
+}
+
+void test_non_finite_samples_are_skipped() {
+    RunningStat stat;
+    stat.reset();
+    stat.add(NAN);
+    stat.add(30.0f);
+    TEST_ASSERT_EQUAL(1, stat.count);
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, 0.0f, stat.variance());
+}
+
+void test_pixel_stats_update_and_reset() {
+    PixelSessionStats stats;
+    std::array<float, PixelMask::num_pixels> frame;
+    for (int f = 0; f < 4; ++f) {
+        for (std::size_t p = 0; p < frame.size(); ++p) {
+            frame[p] = static_cast<float>(p) + f;
+        }
+        stats.update(frame.data(), frame.size());
+    }
+    TEST_ASSERT_EQUAL(4, stats.frames());
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, 101.5f, stats.stat(100).mean);
+    TEST_ASSERT_FLOAT_WITHIN(float_epsilon, 103.0f, stats.stat(100).max);
+
+    std::array<StatSnapshot, 2> snapshot;
+    TEST_ASSERT_EQUAL(SessionStatsStatus::Success, stats.snapshot(100, 2, snapshot.data()));
+    TEST_ASSERT_EQUAL(1015, snapshot[0].mean);
+    TEST_ASSERT_EQUAL(13, snapshot[0].stddev); // sqrt(5/3) = 1.29
+    TEST_ASSERT_EQUAL(1000, snapshot[0].min);
+    TEST_ASSERT_EQUAL(1040, snapshot[1].max);
+    TEST_ASSERT_EQUAL(SessionStatsStatus::OutOfRange, stats.snapshot(191, 2, snapshot.data()));
+
+    stats.reset();
+    TEST_ASSERT_EQUAL(0, stats.frames());
+    TEST_ASSERT_EQUAL(0, stats.stat(100).count);
+}
+
+void test_zone_stats_track_extreme_pixels() {
+    ZoneReducer reducer;
+    uint8_t first = 0;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer.add_columns(first));
+    ZoneSessionStats stats;
+    for (int f = 0; f < 2; ++f) {
+        reducer.begin_frame();
+        for (std::size_t p = 0; p < PixelMask::num_pixels; ++p) {
+            // Column 0 has one hot pixel in the second frame.
+            reducer.accumulate(p, (f == 1 && p == 0) ? 120.0f : 20.0f);
+        }
+        reducer.end_frame();
+        stats.update(reducer);
+    }
+    TEST_ASSERT_EQUAL(2, stats.stat(0).count);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 120.0f, stats.stat(0).max);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 20.0f, stats.stat(1).max);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, (20.0f + (11 * 20.0f + 120.0f) / 12) / 2, stats.stat(0).mean);
+}
+
+void test_memory_is_bounded() {
+    TEST_ASSERT_TRUE(ZoneSessionStats::memory_bytes() < PixelSessionStats::memory_bytes());
+    TEST_ASSERT_TRUE(PixelSessionStats::memory_bytes() <= PixelMask::num_pixels * sizeof(RunningStat) + 8);
+}
+
+void test_control_fetches_and_resets() {
+    ZoneSessionStats stats;
+    SessionStatsControl<ZoneSessionStats::capacity> control(stats, 16);
+    std::array<float, 16> frame;
+    for (std::size_t zone = 0; zone < frame.size(); ++zone) {
+        frame[zone] = 20.0f + zone;
+    }
+    stats.update(frame.data(), frame.size());
+    stats.update(frame.data(), frame.size());
+
+    const uint8_t bulk_request = 0x01;
+    TEST_ASSERT_FALSE(control.on_control(&bulk_request, 1)); // left to the bulk download
+    const uint8_t fetch_and_reset = static_cast<uint8_t>(StatsOp::FetchAndReset);
+    TEST_ASSERT_TRUE(control.on_control(&fetch_and_reset, 1));
+    TEST_ASSERT_FALSE(control.on_control(&fetch_and_reset, 1)); // one command at a time
+    RecordingLink link(sizeof(StatsReplyHeader) + 4 * sizeof(StatSnapshot) + 7, 2); // 4 entries per message
+    TEST_ASSERT_FALSE(control.service(link)); // nothing until the acquisition task takes the snapshot
+    control.on_frame();
+    TEST_ASSERT_EQUAL(0, stats.frames());
+    stats.update(frame.data(), frame.size()); // the next session, not in the reply
+
+    TEST_ASSERT_TRUE(control.service(link)); // the link takes two messages only
+    TEST_ASSERT_EQUAL(2, link.messages.size());
+    link.capacity_ = 8;
+    TEST_ASSERT_TRUE(control.service(link));
+    TEST_ASSERT_EQUAL(4, link.messages.size());
+    TEST_ASSERT_FALSE(control.service(link));
+
+    for (std::size_t i = 0; i < link.messages.size(); ++i) {
+        const std::vector<uint8_t>& message = link.messages[i];
+        TEST_ASSERT_EQUAL(sizeof(StatsReplyHeader) + 4 * sizeof(StatSnapshot), message.size());
+        StatsReplyHeader header;
+        std::memcpy(&header, message.data(), sizeof(header));
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(StatsOp::Reply), header.op);
+        TEST_ASSERT_EQUAL(2, header.frames);
+        TEST_ASSERT_EQUAL(4 * i, header.first);
+        TEST_ASSERT_EQUAL(4, header.count);
+        TEST_ASSERT_EQUAL(16, header.total);
+        StatSnapshot last;
+        std::memcpy(&last, message.data() + sizeof(header) + 3 * sizeof(StatSnapshot), sizeof(last));
+        TEST_ASSERT_EQUAL(10 * (20 + 4 * i + 3), last.mean);
+        TEST_ASSERT_EQUAL(0, last.stddev);
+    }
+
+    // A plain fetch leaves the session running.
+    const uint8_t fetch = static_cast<uint8_t>(StatsOp::Fetch);
+    TEST_ASSERT_TRUE(control.on_control(&fetch, 1));
+    control.on_frame();
+    TEST_ASSERT_EQUAL(1, stats.frames());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_running_stat_matches_two_pass);
+    RUN_TEST(test_running_stat_stable_with_large_offset);
+    RUN_TEST(test_non_finite_samples_are_skipped);
+    RUN_TEST(test_pixel_stats_update_and_reset);
+    RUN_TEST(test_zone_stats_track_extreme_pixels);
+    RUN_TEST(test_memory_is_bounded);
+    RUN_TEST(test_control_fetches_and_resets);
+    return UNITY_END();
+}
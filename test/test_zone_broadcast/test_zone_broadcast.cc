@@ -0,0 +1,129 @@
+#include <unity.h>
+#include <cstdint>
+#include "zone_broadcast.hh"
+
+namespace {
+
+constexpr uint32_t interval_ms = 250;
+
+// 16 columns warming from the inner edge, as ZoneReducer::means()
+void columns(int16_t* zones, std::size_t count, int16_t base)
+{
+    for (std::size_t zone = 0; zone < count; zone++) {
+        zones[zone] = static_cast<int16_t>(base + 7 * zone);
+    }
+}
+
+} // namespace
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_payload_fits_legacy_advertising() {
+    // flags (3) + manufacturer data header (2) + company id and payload
+    TEST_ASSERT_LESS_OR_EQUAL(31, 3 + 2 + zone_broadcast_data_bytes);
+    TEST_ASSERT_GREATER_OR_EQUAL(4 + (ZoneBroadcaster::zones_per_page * 10 + 7) / 8, zone_broadcast_payload_bytes);
+}
+
+void test_sixteen_zones_round_trip_in_one_page() {
+    ZoneBroadcaster broadcaster(0x2A, interval_ms);
+    int16_t zones[16];
+    columns(zones, 16, 255);
+    zones[3] = INT16_MIN; // outside the region of interest
+    broadcaster.update(zones, 16);
+    uint8_t data[zone_broadcast_data_bytes];
+    TEST_ASSERT_TRUE(broadcaster.next(0, data));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, data[1]);
+
+    BroadcastPage page;
+    TEST_ASSERT_TRUE(decode_zone_broadcast(data, sizeof(data), page));
+    TEST_ASSERT_EQUAL(0x2A, page.sensor_id);
+    TEST_ASSERT_EQUAL(0, page.sequence);
+    TEST_ASSERT_EQUAL(0, page.page);
+    TEST_ASSERT_TRUE(page.last);
+    TEST_ASSERT_EQUAL(16, page.zone_count);
+    for (std::size_t zone = 0; zone < 16; zone++) {
+        if (zone == 3) {
+            TEST_ASSERT_EQUAL(INT16_MIN, page.zones[zone]);
+        } else {
+            TEST_ASSERT_INT_WITHIN(1, zones[zone], page.zones[zone]); // 0.25 °C steps
+        }
+    }
+}
+
+void test_encoding_covers_tire_temperatures() {
+    for (int16_t tenths = -400; tenths <= 2150; tenths++) {
+        const int16_t decoded = ZoneBroadcaster::decode_zone(ZoneBroadcaster::encode_zone(tenths));
+        TEST_ASSERT_INT_WITHIN(1, tenths, decoded);
+    }
+    // Saturates rather than wrapping
+    TEST_ASSERT_EQUAL(-400, ZoneBroadcaster::decode_zone(ZoneBroadcaster::encode_zone(-900)));
+    TEST_ASSERT_EQUAL(2155, ZoneBroadcaster::decode_zone(ZoneBroadcaster::encode_zone(3000)));
+}
+
+void test_payload_rotates_at_the_interval() {
+    ZoneBroadcaster broadcaster(1, interval_ms);
+    uint8_t data[zone_broadcast_data_bytes];
+    TEST_ASSERT_FALSE(broadcaster.next(0, data)); // no values yet
+    int16_t zones[16];
+    columns(zones, 16, 300);
+    broadcaster.update(zones, 16);
+    TEST_ASSERT_TRUE(broadcaster.next(10, data));
+    TEST_ASSERT_FALSE(broadcaster.next(10 + interval_ms - 1, data));
+    TEST_ASSERT_TRUE(broadcaster.next(10 + interval_ms, data));
+    BroadcastPage page;
+    TEST_ASSERT_TRUE(decode_zone_broadcast(data, sizeof(data), page));
+    TEST_ASSERT_EQUAL(1, page.sequence);
+    TEST_ASSERT_EQUAL(2, broadcaster.sequence());
+}
+
+void test_many_zones_are_paged_from_one_snapshot() {
+    ZoneBroadcaster broadcaster(7, interval_ms);
+    int16_t zones[32];
+    columns(zones, 32, 200); // 32 columns of the MLX90640
+    broadcaster.update(zones, 32);
+    uint8_t data[zone_broadcast_data_bytes];
+    BroadcastPage page;
+    TEST_ASSERT_TRUE(broadcaster.next(0, data));
+    TEST_ASSERT_TRUE(decode_zone_broadcast(data, sizeof(data), page));
+    TEST_ASSERT_EQUAL(0, page.page);
+    TEST_ASSERT_FALSE(page.last);
+
+    int16_t newer[32];
+    columns(newer, 32, 500);
+    broadcaster.update(newer, 32); // mid-rotation: the second page still comes from the first frame
+    TEST_ASSERT_TRUE(broadcaster.next(interval_ms, data));
+    TEST_ASSERT_TRUE(decode_zone_broadcast(data, sizeof(data), page));
+    TEST_ASSERT_EQUAL(1, page.page);
+    TEST_ASSERT_TRUE(page.last);
+    TEST_ASSERT_EQUAL(16, page.zone_count);
+    TEST_ASSERT_INT_WITHIN(1, zones[16], page.zones[0]);
+
+    TEST_ASSERT_TRUE(broadcaster.next(2 * interval_ms, data));
+    TEST_ASSERT_TRUE(decode_zone_broadcast(data, sizeof(data), page));
+    TEST_ASSERT_EQUAL(0, page.page);
+    TEST_ASSERT_INT_WITHIN(1, newer[0], page.zones[0]);
+}
+
+void test_foreign_manufacturer_data_is_rejected() {
+    uint8_t data[zone_broadcast_data_bytes] = {0x59, 0x00, zone_broadcast_version}; // another company
+    BroadcastPage page;
+    TEST_ASSERT_FALSE(decode_zone_broadcast(data, sizeof(data), page));
+    data[0] = data[1] = 0xFF;
+    data[2] = zone_broadcast_version + 1;
+    TEST_ASSERT_FALSE(decode_zone_broadcast(data, sizeof(data), page));
+    TEST_ASSERT_FALSE(decode_zone_broadcast(data, 3, page));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_payload_fits_legacy_advertising);
+    RUN_TEST(test_sixteen_zones_round_trip_in_one_page);
+    RUN_TEST(test_encoding_covers_tire_temperatures);
+    RUN_TEST(test_payload_rotates_at_the_interval);
+    RUN_TEST(test_many_zones_are_paged_from_one_snapshot);
+    RUN_TEST(test_foreign_manufacturer_data_is_rejected);
+    return UNITY_END();
+}
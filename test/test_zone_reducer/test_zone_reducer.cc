@@ -0,0 +1,136 @@
+#include <unity.h>
+#include <array>
+#include "zone_reducer.hh"
+
+constexpr std::size_t num_pixels = PixelMask::num_pixels;
+constexpr std::size_t num_columns = PixelMask::num_columns;
+constexpr std::size_t num_rows = PixelMask::num_rows;
+
+LayeredZoneReducer* reducer = nullptr;
+std::array<float, num_pixels> frame;
+
+void setUp(void) {
+    reducer = new LayeredZoneReducer(90);
+    // Temperature rises with the column and slightly with the row: 20.0 + col + row / 10
+    for (std::size_t row = 0; row < num_rows; ++row) {
+        for (std::size_t col = 0; col < num_columns; ++col) {
+            frame[row * num_columns + col] = 20.0f + col + row / 10.0f;
+        }
+    }
+}
+
+void tearDown(void) {
+    delete reducer;
+    reducer = nullptr;
+}
+
+void feed_frame() {
+    reducer->begin_frame();
+    for (std::size_t pixel = 0; pixel < num_pixels; ++pixel) {
+        reducer->accumulate(pixel, frame[pixel]);
+    }
+    reducer->end_frame();
+}
+
+void test_pixel_mask_helpers() {
+    TEST_ASSERT_EQUAL(num_rows, PixelMask::columns(3, 3).count());
+    TEST_ASSERT_EQUAL(num_columns * 2, PixelMask::rows(0, 1).count());
+    TEST_ASSERT_TRUE(PixelMask::columns(3, 3).test(5 * num_columns + 3));
+    TEST_ASSERT_FALSE(PixelMask::columns(3, 3).test(5 * num_columns + 4));
+}
+
+void test_column_means_match_manual_average() {
+    uint8_t first = 0xFF;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_columns(first));
+    TEST_ASSERT_EQUAL(0, first);
+    TEST_ASSERT_EQUAL(num_columns, reducer->zone_count());
+    feed_frame();
+
+    for (std::size_t col = 0; col < num_columns; ++col) {
+        float sum = 0.0f;
+        for (std::size_t row = 0; row < num_rows; ++row) {
+            sum += frame[row * num_columns + col];
+        }
+        TEST_ASSERT_EQUAL(ZoneReducer::to_fixed_point(sum / num_rows), reducer->means()[first + col]);
+        TEST_ASSERT_EQUAL(ZoneReducer::to_fixed_point(frame[col]), reducer->mins()[first + col]);
+        TEST_ASSERT_EQUAL(ZoneReducer::to_fixed_point(frame[(num_rows - 1) * num_columns + col]),
+                          reducer->maxs()[first + col]);
+    }
+}
+
+void test_rows_and_bands_share_one_pass() {
+    uint8_t first_row = 0;
+    uint8_t first_band = 0;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_rows(first_row));
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_tire_bands(first_band));
+    TEST_ASSERT_EQUAL(num_rows, first_band);
+    feed_frame();
+
+    // Row 0: columns 0..15 at 20.0 + col -> mean 27.5
+    TEST_ASSERT_EQUAL(275, reducer->means()[first_row]);
+    // Inner band: columns 0..4, outer band: columns 11..15
+    const auto inner = first_band + static_cast<uint8_t>(ZoneReducer::TireBand::Inner);
+    const auto outer = first_band + static_cast<uint8_t>(ZoneReducer::TireBand::Outer);
+    TEST_ASSERT_EQUAL(200, reducer->mins()[inner]);
+    TEST_ASSERT_EQUAL(251, reducer->maxs()[inner]);
+    TEST_ASSERT_EQUAL(310, reducer->mins()[outer]);
+}
+
+void test_percentile_nearest_rank() {
+    PixelMask mask;
+    for (std::size_t pixel = 0; pixel < 10; ++pixel) {
+        mask.set(pixel);
+        frame[pixel] = static_cast<float>(10 - pixel); // 10, 9, ..., 1
+    }
+    uint8_t zone = 0;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_zone(mask, zone));
+    feed_frame();
+    TEST_ASSERT_EQUAL(90, reducer->percentiles()[zone]);
+    TEST_ASSERT_EQUAL(10, reducer->mins()[zone]);
+    TEST_ASSERT_EQUAL(100, reducer->maxs()[zone]);
+    TEST_ASSERT_EQUAL(55, reducer->means()[zone]);
+}
+
+void test_zone_limits() {
+    uint8_t zone = 0;
+    TEST_ASSERT_EQUAL(ZoneStatus::EmptyZone, reducer->add_zone(PixelMask(), zone));
+
+    uint8_t first = 0;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_columns(first));
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_rows(first));
+    TEST_ASSERT_EQUAL(ZoneStatus::TooManyZones, reducer->add_columns(first));
+
+    reducer->clear();
+    TEST_ASSERT_EQUAL(0, reducer->zone_count());
+    const PixelMask all = PixelMask::rows(0, num_rows - 1);
+    for (std::size_t i = 0; i < 2; ++i) {
+        TEST_ASSERT_EQUAL(ZoneStatus::Success, reducer->add_zone(all, zone));
+    }
+    TEST_ASSERT_EQUAL(ZoneStatus::TooManyMemberships, reducer->add_zone(all, zone));
+}
+
+void test_default_reducer_fits_one_layout() {
+    ZoneReducer single;
+    uint8_t first = 0;
+    TEST_ASSERT_EQUAL(ZoneStatus::Success, single.add_columns(first));
+    TEST_ASSERT_EQUAL(ZoneStatus::TooManyMemberships, single.add_tire_bands(first));
+    TEST_ASSERT_EQUAL(PixelMask::num_columns, single.zone_count());
+}
+
+void test_fixed_point_saturates() {
+    TEST_ASSERT_EQUAL(-400, ZoneReducer::to_fixed_point(-40.0f));
+    TEST_ASSERT_EQUAL(32767, ZoneReducer::to_fixed_point(5000.0f));
+    TEST_ASSERT_EQUAL(-32768, ZoneReducer::to_fixed_point(-5000.0f));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_pixel_mask_helpers);
+    RUN_TEST(test_column_means_match_manual_average);
+    RUN_TEST(test_rows_and_bands_share_one_pass);
+    RUN_TEST(test_percentile_nearest_rank);
+    RUN_TEST(test_zone_limits);
+    RUN_TEST(test_default_reducer_fits_one_layout);
+    RUN_TEST(test_fixed_point_saturates);
+    return UNITY_END();
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "i_clock.hh"
+
+// Clock that only moves when the code under test sleeps or the test simulates work.
+class VirtualClock : public IClock {
+public:
+    explicit VirtualClock(uint32_t start_us = 0) : now_(start_us) {}
+    uint32_t now_us() override { return now_; }
+    void sleep_until_us(uint32_t wake_us) override {
+        if (static_cast<int32_t>(wake_us - now_) > 0) {
+            slept_us += wake_us - now_;
+            now_ = wake_us;
+        }
+        wakes.push_back(now_);
+    }
+    void advance(uint32_t us) { now_ += us; }
+
+    uint64_t slept_us = 0;
+    std::vector<uint32_t> wakes;
+
+private:
+    uint32_t now_;
+};
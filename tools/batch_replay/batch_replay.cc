@@ -0,0 +1,140 @@
+// Recomputes the temperatures of a whole capture file of raw frames (HOST_OFFLOAD firmware,
+// converted with capture_convert) on every core, e.g. after a change to the calibration math.
+//
+// Usage: batch_replay [--threads N] [--bench] <session.tcap> [temperatures.f32]
+// Writes rows × columns float32 values per frame, in frame order. --bench replays the
+// session with 1, 2, 4 ... threads up to the number of cores and prints the throughput of each.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "batch_processor.hh"
+#include "capture_file.hh"
+
+namespace {
+
+struct Replay {
+    double seconds;
+    BatchStats stats;
+};
+
+template <typename Traits>
+bool replay(const CaptureReader& reader, unsigned threads, std::vector<float>& temps, Replay& result)
+{
+    BatchOptions options = BasicBatchProcessor<Traits>::default_options();
+    options.threads = threads;
+    BasicBatchProcessor<Traits> batch(options);
+    const OffloadStatus calibration = batch.load_eeprom(reader.calibration(), reader.calibration_words());
+    if (calibration != OffloadStatus::Success) {
+        std::fprintf(stderr, "no usable calibration in the capture (status %d)\n", static_cast<int>(calibration));
+        return false;
+    }
+    const RawFrameSpan frames = {reader.frame(0).payload, static_cast<std::size_t>(reader.frame_count()),
+                                 reader.header().record_bytes};
+    temps.resize(frames.count * Traits::num_pixels);
+    const auto start = std::chrono::steady_clock::now();
+    const OffloadStatus status = batch.process(frames, temps.data());
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.stats = batch.stats();
+    if (status != OffloadStatus::Success) {
+        std::fprintf(stderr, "replay failed (status %d)\n", static_cast<int>(status));
+        return false;
+    }
+    return true;
+}
+
+bool replay(const CaptureReader& reader, unsigned threads, std::vector<float>& temps, Replay& result)
+{
+    const CaptureFileHeader& header = reader.header();
+    if (header.rows == MLX90640Traits::num_rows && header.columns == MLX90640Traits::num_columns) {
+        return replay<MLX90640Traits>(reader, threads, temps, result);
+    }
+    return replay<MLX90641Traits>(reader, threads, temps, result);
+}
+
+// `one_thread_seconds` > 0: also prints the speedup over one thread.
+void print_replay(const Replay& result, double one_thread_seconds = 0.0)
+{
+    std::fprintf(stderr, "%2u threads: %llu frames in %.3f s, %.0f frames/s", result.stats.threads,
+                 static_cast<unsigned long long>(result.stats.frames), result.seconds,
+                 result.stats.frames / result.seconds);
+    if (one_thread_seconds > 0.0) {
+        std::fprintf(stderr, ", x%.2f", one_thread_seconds / result.seconds);
+    }
+    std::fprintf(stderr, " (%llu warm-up frames)\n", static_cast<unsigned long long>(result.stats.warmup_frames));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned threads = 0;
+    bool bench = false;
+    const char* paths[2] = {nullptr, nullptr};
+    int path_count = 0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (path_count < 2 && argv[i][0] != '-') {
+            paths[path_count++] = argv[i];
+        } else {
+            path_count = 0;
+            break;
+        }
+    }
+    if (path_count == 0) {
+        std::fprintf(stderr, "usage: %s [--threads N] [--bench] <session.tcap> [temperatures.f32]\n", argv[0]);
+        return 2;
+    }
+
+    CaptureReader reader;
+    const CaptureStatus status = reader.open(paths[0]);
+    if (status != CaptureStatus::Success) {
+        std::fprintf(stderr, "cannot open capture %s (status %d)\n", paths[0], static_cast<int>(status));
+        return 1;
+    }
+    if (reader.header().payload != static_cast<uint8_t>(SerialPayload::FrameWords) || reader.frame_count() == 0) {
+        std::fprintf(stderr, "%s holds no raw frames\n", paths[0]);
+        return 1;
+    }
+
+    std::vector<float> temps;
+    Replay result;
+    if (bench) {
+        const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+        double one_thread_seconds = 0.0;
+        for (unsigned count = 1; count <= cores; count *= 2) {
+            if (!replay(reader, count, temps, result)) {
+                return 1;
+            }
+            if (count == 1) {
+                one_thread_seconds = result.seconds;
+            }
+            print_replay(result, one_thread_seconds);
+        }
+    } else {
+        if (!replay(reader, threads, temps, result)) {
+            return 1;
+        }
+        print_replay(result);
+    }
+
+    if (paths[1]) {
+        std::FILE* output = std::fopen(paths[1], "wb");
+        if (!output || std::fwrite(temps.data(), sizeof(float), temps.size(), output) != temps.size()) {
+            std::fprintf(stderr, "cannot write %s\n", paths[1]);
+            if (output) {
+                std::fclose(output);
+            }
+            return 1;
+        }
+        std::fclose(output);
+    }
+    return 0;
+}
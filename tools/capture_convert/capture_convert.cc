@@ -0,0 +1,37 @@
+// Converts a serial capture (the raw byte stream of the firmware's serial port) to an indexed
+// capture file, see lib/host_capture/capture_file.hh.
+//
+// Usage: capture_convert [serial.bin] <session.tcap>
+// Reads the serial stream from stdin when no input file is given.
+
+#include <cstdio>
+#include "capture_file.hh"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s [serial.bin] <session.tcap>\n", argv[0]);
+        return 2;
+    }
+    std::FILE* input = stdin;
+    if (argc == 3) {
+        input = std::fopen(argv[1], "rb");
+        if (!input) {
+            std::fprintf(stderr, "cannot read capture %s\n", argv[1]);
+            return 1;
+        }
+    }
+    CaptureConversion conversion;
+    const CaptureStatus status = convert_serial_capture(input, argv[argc - 1], conversion);
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    if (status != CaptureStatus::Success) {
+        std::fprintf(stderr, "conversion failed (status %d)\n", static_cast<int>(status));
+        return 1;
+    }
+    std::fprintf(stderr, "%llu frames, %llu records of another kind skipped\n",
+                 static_cast<unsigned long long>(conversion.frames),
+                 static_cast<unsigned long long>(conversion.skipped_records));
+    return 0;
+}
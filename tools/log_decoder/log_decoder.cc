@@ -0,0 +1,134 @@
+// Decodes binary log records written by DeferredLogger.
+//
+// Usage: log_decoder <log_strings.csv> [capture.bin]
+// Reads the capture from stdin when no file is given. Bytes that are not part of a valid
+// record (e.g. other serial traffic) are skipped.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include "log_record.hh"
+
+namespace {
+
+struct LogString {
+    std::string level;
+    std::string format;
+};
+
+// Parses one CSV field starting at `pos`, handling "quoted ""fields""".
+std::string read_field(const std::string& line, std::size_t& pos)
+{
+    std::string field;
+    if (pos < line.size() && line[pos] == '"') {
+        pos++;
+        while (pos < line.size()) {
+            if (line[pos] == '"') {
+                if (pos + 1 < line.size() && line[pos + 1] == '"') {
+                    field += '"';
+                    pos += 2;
+                    continue;
+                }
+                pos++;
+                break;
+            }
+            field += line[pos++];
+        }
+    } else {
+        while (pos < line.size() && line[pos] != ',') {
+            field += line[pos++];
+        }
+    }
+    if (pos < line.size() && line[pos] == ',') {
+        pos++;
+    }
+    return field;
+}
+
+bool load_table(const char* path, std::map<uint32_t, LogString>& table)
+{
+    std::ifstream input(path);
+    if (!input) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::size_t pos = 0;
+        const std::string id = read_field(line, pos);
+        LogString entry;
+        entry.level = read_field(line, pos);
+        entry.format = read_field(line, pos);
+        table[static_cast<uint32_t>(std::stoul(id, nullptr, 16))] = entry;
+    }
+    return true;
+}
+
+const char* level_name(uint8_t level)
+{
+    static const char* const names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+    return level < 4 ? names[level] : "?";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <log_strings.csv> [capture.bin]\n", argv[0]);
+        return 2;
+    }
+    std::map<uint32_t, LogString> table;
+    if (!load_table(argv[1], table)) {
+        std::fprintf(stderr, "cannot read string table %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    if (argc > 2) {
+        std::ifstream input(argv[2], std::ios::binary);
+        if (!input) {
+            std::fprintf(stderr, "cannot read capture %s\n", argv[2]);
+            return 1;
+        }
+        data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    } else {
+        data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+
+    std::size_t offset = 0;
+    std::size_t skipped = 0;
+    while (offset < data.size()) {
+        LogRecord record;
+        std::size_t consumed = 0;
+        const LogDecodeStatus status = decode_log_record(data.data() + offset, data.size() - offset, record, consumed);
+        if (status == LogDecodeStatus::NeedMoreData) {
+            break;
+        }
+        offset += consumed;
+        if (status != LogDecodeStatus::Success) {
+            skipped += consumed;
+            continue;
+        }
+
+        char message[256];
+        const auto entry = table.find(record.message_id);
+        if (entry == table.end()) {
+            std::snprintf(message, sizeof(message), "<unknown message 0x%08X, %u args>",
+                          static_cast<unsigned>(record.message_id), static_cast<unsigned>(record.arg_count));
+        } else {
+            format_log_record(entry->second.format.c_str(), record.args, record.arg_count, message, sizeof(message));
+        }
+        std::printf("[%10.6f] %s: %s\n", record.timestamp_us / 1e6, level_name(record.level), message);
+    }
+    if (skipped > 0) {
+        std::fprintf(stderr, "skipped %zu bytes outside log records\n", skipped);
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Computes temperatures from a serial capture of firmware built with -DHOST_OFFLOAD.
+//
+// Usage: offload_decoder [capture.bin] > temperatures.csv
+// Reads the capture from stdin when no file is given. Prints one CSV line per frame:
+// sequence, timestamp_us, sub_page, ta, then the pixel temperatures in row-major order.
+// Temperature records of a firmware without HOST_OFFLOAD are printed as they are.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "offload_engine.hh"
+
+namespace {
+
+template <typename Traits>
+void print_line(const SerialFrameHeader& header, float ta, const float* temps)
+{
+    std::printf("%u,%u,%u,%.2f", static_cast<unsigned>(header.sequence), static_cast<unsigned>(header.timestamp_us),
+                static_cast<unsigned>(header.sub_page), ta);
+    for (std::size_t i = 0; i < Traits::num_pixels; i++) {
+        std::printf(",%.2f", temps[i]);
+    }
+    std::printf("\n");
+}
+
+// Handles one record for a sensor model; false if the record does not belong to it.
+template <typename Traits>
+bool process(BasicOffloadEngine<Traits>& engine, const SerialFrameHeader& header, const std::vector<uint8_t>& payload)
+{
+    if (header.rows != Traits::num_rows || header.columns != Traits::num_columns) {
+        return false;
+    }
+    const SerialPayload kind = static_cast<SerialPayload>(header.payload);
+    if (kind == SerialPayload::Temperatures) {
+        if (payload.size() == Traits::num_pixels * sizeof(float)) {
+            std::vector<float> temps(Traits::num_pixels);
+            std::memcpy(temps.data(), payload.data(), payload.size());
+            print_line<Traits>(header, header.ta, temps.data());
+        }
+        return true;
+    }
+    if (kind != SerialPayload::EepromWords && kind != SerialPayload::FrameWords) {
+        return true;
+    }
+    std::vector<uint16_t> words(payload.size() / sizeof(uint16_t));
+    std::memcpy(words.data(), payload.data(), words.size() * sizeof(uint16_t));
+    if (kind == SerialPayload::EepromWords) {
+        if (engine.load_eeprom(words.data(), words.size()) != OffloadStatus::Success) {
+            std::fprintf(stderr, "invalid EEPROM image, frames are skipped until the next one\n");
+        }
+        return true;
+    }
+    const OffloadStatus status = engine.process_frame(words.data(), words.size());
+    if (status == OffloadStatus::Success) {
+        print_line<Traits>(header, engine.ambient(), engine.temps().data());
+    } else if (status == OffloadStatus::NotCalibrated) {
+        std::fprintf(stderr, "frame %u before the EEPROM image, skipped\n", static_cast<unsigned>(header.sequence));
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<uint8_t> data;
+    if (argc > 1) {
+        std::ifstream input(argv[1], std::ios::binary);
+        if (!input) {
+            std::fprintf(stderr, "cannot read capture %s\n", argv[1]);
+            return 1;
+        }
+        data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    } else {
+        data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+
+    SerialRecordParser parser;
+    parser.feed(data.data(), data.size());
+    // Large members (calibration, frame), kept off the stack.
+    static OffloadEngine mlx90641;
+    static BasicOffloadEngine<MLX90640Traits> mlx90640;
+    SerialFrameHeader header;
+    std::vector<uint8_t> payload;
+    std::size_t unknown = 0;
+    while (parser.next(header, payload)) {
+        if (!process(mlx90641, header, payload) && !process(mlx90640, header, payload)) {
+            unknown++;
+        }
+    }
+    if (unknown > 0) {
+        std::fprintf(stderr, "skipped %zu records of an unknown sensor geometry\n", unknown);
+    }
+    return 0;
+}